@@ -338,6 +338,12 @@ macro(add_src_and_test_main NAME INSTALL_BIN INSTALL_PYTHON)
 				add_subdirectory(${NAME}/test)
 			endif()
 		endif()
+
+		if (BUILD_BENCHMARKS)
+			if(EXISTS ${CMAKE_CURRENT_SOURCE_DIR}/${NAME}/benchmark)
+				add_subdirectory(${NAME}/benchmark)
+			endif()
+		endif()
 	endif()
 
 	if(${INSTALL_PYTHON})
@@ -593,6 +599,36 @@ macro(create_tests DEPS)
 
 endmacro()
 
+# Benchmarks are plain executables, run by hand rather than by ctest, as
+# their timings depend on the machine and what else it's doing.
+macro(create_benchmark PATH DEPS)
+
+	get_filename_component(NAME ${PATH} NAME_WE)
+	get_filename_component(FILENAME ${PATH} NAME)
+
+	add_executable(${NAME} ${FILENAME})
+	default_options_local(${NAME})
+	target_link_libraries(${NAME}
+		PRIVATE
+		xstudio::global
+		"${DEPS}"
+	)
+	set_target_properties(${NAME} PROPERTIES LINK_DEPENDS_NO_SHARED true)
+
+endmacro()
+
+macro(create_benchmarks DEPS)
+
+	file(GLOB SOURCES  ${CMAKE_CURRENT_SOURCE_DIR}/*.cpp)
+
+	foreach(BENCHMARK ${SOURCES})
+
+		create_benchmark(${BENCHMARK} "${DEPS}")
+
+	endforeach()
+
+endmacro()
+
 macro(create_qml_component NAME VERSION DEPS EXTRAMOC)
 	create_qml_component_with_alias(${NAME} xstudio::ui::qml::${NAME} ${VERSION} "${DEPS}" "${EXTRAMOC}")
 endmacro()
@@ -81,6 +81,7 @@ namespace utility {
     class MediaReference;
     class Notification;
     class PlaylistTree;
+    class SharedJson;
     class Timecode;
     class UuidActor;
 
@@ -101,6 +102,7 @@ namespace media {
     class MediaDetail;
     class MediaKey;
     class AVFrameID;
+    struct AVFrameIDsAndTimePointsDelta;
     class StreamDetail;
     typedef std::shared_ptr<const std::map<timebase::flicks, std::shared_ptr<const AVFrameID>>>
         FrameTimeMapPtr;
@@ -200,6 +202,7 @@ CAF_ALLOW_UNSAFE_MESSAGE_TYPE(xstudio::media::FrameTimeMapPtr)
 CAF_ALLOW_UNSAFE_MESSAGE_TYPE(xstudio::media::AVFrameID)
 CAF_ALLOW_UNSAFE_MESSAGE_TYPE(xstudio::media::AVFrameIDs)
 CAF_ALLOW_UNSAFE_MESSAGE_TYPE(xstudio::media::AVFrameIDsAndTimePoints)
+CAF_ALLOW_UNSAFE_MESSAGE_TYPE(xstudio::media::AVFrameIDsAndTimePointsDelta)
 CAF_ALLOW_UNSAFE_MESSAGE_TYPE(xstudio::media_reader::AudioBuffer)
 CAF_ALLOW_UNSAFE_MESSAGE_TYPE(xstudio::media_reader::AudioBufPtr)
 CAF_ALLOW_UNSAFE_MESSAGE_TYPE(xstudio::media_reader::ImageBufPtr)
@@ -301,6 +304,8 @@ CAF_BEGIN_TYPE_ID_BLOCK(xstudio_simple_types, FIRST_CUSTOM_ID)
     CAF_ADD_TYPE_ID(xstudio_simple_types, (xstudio::timeline::ItemType))
     CAF_ADD_TYPE_ID(xstudio_simple_types, (xstudio::utility::ColourTriplet))
     CAF_ADD_TYPE_ID(xstudio_simple_types, (spdlog::level::level_enum))
+    CAF_ADD_TYPE_ID(xstudio_simple_types, (xstudio::media::AVFrameIDsAndTimePointsDelta))
+    CAF_ADD_TYPE_ID(xstudio_simple_types, (xstudio::utility::SharedJson))
 
 CAF_END_TYPE_ID_BLOCK(xstudio_simple_types)
 
@@ -441,9 +446,11 @@ CAF_BEGIN_TYPE_ID_BLOCK(xstudio_framework_atoms, FIRST_CUSTOM_ID + (200 * 2))
     CAF_ADD_ATOM(xstudio_framework_atoms, xstudio::global_store, autosave_atom)
     CAF_ADD_ATOM(xstudio_framework_atoms, xstudio::global_store, do_autosave_atom)
     CAF_ADD_ATOM(xstudio_framework_atoms, xstudio::global_store, save_atom)
+    CAF_ADD_ATOM(xstudio_framework_atoms, xstudio::history, budget_atom)
     CAF_ADD_ATOM(xstudio_framework_atoms, xstudio::history, history_atom)
     CAF_ADD_ATOM(xstudio_framework_atoms, xstudio::history, log_atom)
     CAF_ADD_ATOM(xstudio_framework_atoms, xstudio::history, redo_atom)
+    CAF_ADD_ATOM(xstudio_framework_atoms, xstudio::history, stats_atom)
     CAF_ADD_ATOM(xstudio_framework_atoms, xstudio::history, undo_atom)
     CAF_ADD_ATOM(xstudio_framework_atoms, xstudio::json_store, erase_json_atom)
     CAF_ADD_ATOM(xstudio_framework_atoms, xstudio::json_store, get_json_atom)
@@ -727,6 +734,8 @@ CAF_BEGIN_TYPE_ID_BLOCK(xstudio_session_atoms, FIRST_CUSTOM_ID + (200 * 4))
 
     CAF_ADD_ATOM(xstudio_session_atoms, xstudio::timeline, item_selection_atom)
     CAF_ADD_ATOM(xstudio_session_atoms, xstudio::timeline, item_type_atom)
+    CAF_ADD_ATOM(xstudio_session_atoms, xstudio::timeline, item_actor_atom)
+    CAF_ADD_ATOM(xstudio_session_atoms, xstudio::timeline, item_lightweight_atom)
 
     CAF_ADD_ATOM(xstudio_session_atoms, xstudio::bookmark, remove_annotation_atom)
 
@@ -751,6 +760,7 @@ CAF_BEGIN_TYPE_ID_BLOCK(xstudio_playback_atoms, FIRST_CUSTOM_ID + (200 * 5))
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::colour_pipeline, set_colour_pipe_params_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_cache, cached_frames_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_cache, count_atom)
+    CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_cache, dedup_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_cache, erase_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_cache, keys_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_cache, preserve_atom)
@@ -758,6 +768,7 @@ CAF_BEGIN_TYPE_ID_BLOCK(xstudio_playback_atoms, FIRST_CUSTOM_ID + (200 * 5))
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_cache, size_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_cache, store_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_cache, unpreserve_atom)
+    CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_reader, audio_waveform_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_reader, clear_precache_queue_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_reader, do_precache_work_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_reader, get_audio_atom)
@@ -766,10 +777,14 @@ CAF_BEGIN_TYPE_ID_BLOCK(xstudio_playback_atoms, FIRST_CUSTOM_ID + (200 * 5))
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_reader, get_media_detail_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_reader, get_reader_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_reader, get_thumbnail_atom)
+    CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_reader, image_diff_atom)
+    CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_reader, image_scopes_atom)
+    CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_reader, pixel_sample_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_reader, playback_precache_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_reader, precache_audio_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_reader, process_thumbnail_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_reader, push_image_atom)
+    CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_reader, read_concurrency_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_reader, read_precache_audio_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_reader, read_precache_image_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_reader, retire_readers_atom)
@@ -911,6 +926,7 @@ CAF_BEGIN_TYPE_ID_BLOCK(xstudio_ui_atoms,  FIRST_CUSTOM_ID + (200 * 6))
     CAF_ADD_ATOM(xstudio_ui_atoms, xstudio::ui, open_external_atom)
     CAF_ADD_ATOM(xstudio_ui_atoms, xstudio::ui::viewport, viewport_reset_atom)
     CAF_ADD_ATOM(xstudio_ui_atoms, xstudio::ui::viewport, viewport_mask_atom)
+    CAF_ADD_ATOM(xstudio_ui_atoms, xstudio::ui::viewport, frame_pacing_telemetry_atom)
 
 CAF_END_TYPE_ID_BLOCK(xstudio_ui_atoms)
 
@@ -60,6 +60,14 @@ template <typename V> utility::JsonStore History<V>::serialise() const {
     return jsn;
 }
 
+// JSON events are kept compactly, within a byte budget
+template <typename K, typename V> struct UndoRedoMapType {
+    using type = utility::UndoRedoMap<K, V>;
+};
+template <typename K> struct UndoRedoMapType<K, utility::JsonStore> {
+    using type = utility::JsonUndoRedoMap<K>;
+};
+
 template <typename K, typename V> class HistoryMap : public utility::Container {
   public:
     HistoryMap(const std::string &name = "HistoryMap");
@@ -72,6 +80,11 @@ template <typename K, typename V> class HistoryMap : public utility::Container {
 
     void set_max_count(const size_t value) { undo_redo_.set_max_count(value); };
 
+    // JsonStore histories only, their budget is utility::UndoRedoBudget
+    void trim() { undo_redo_.trim(); }
+    [[nodiscard]] size_t bytes() const { return undo_redo_.bytes(); }
+    [[nodiscard]] utility::JsonStore stats() const { return undo_redo_.stats(); }
+
     void push(const K &key, const V &value) { undo_redo_.push(key, value); }
 
     std::optional<V> undo() { return undo_redo_.undo(); }
@@ -91,7 +104,7 @@ template <typename K, typename V> class HistoryMap : public utility::Container {
     }
 
   private:
-    utility::UndoRedoMap<K, V> undo_redo_;
+    typename UndoRedoMapType<K, V>::type undo_redo_;
     bool enabled_{true};
 };
 
@@ -237,6 +237,17 @@ HistoryMapActor<utility::sys_time_point, utility::JsonStore>::message_handler()
             return true;
         },
 
+        [=](budget_atom) -> size_t { return base_.bytes(); },
+
+        // shared by all the histories, the others apply it on their next change
+        [=](budget_atom, const size_t bytes) -> bool {
+            UndoRedoBudget::set_max_bytes(bytes);
+            base_.trim();
+            return true;
+        },
+
+        [=](stats_atom) -> utility::JsonStore { return base_.stats(); },
+
         [=](undo_atom) -> result<utility::JsonStore> {
             auto i = base_.undo();
             if (i)
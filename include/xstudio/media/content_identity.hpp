@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <atomic>
+#include <caf/uri.hpp>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "xstudio/utility/json_store.hpp"
+
+namespace xstudio::media {
+
+/**
+ *  @brief Names files by where they are rather than how they were reached.
+ *
+ *  @details MediaKeys are built from the location of a file, so references
+ *  to the same file through symlinked or remapped directories, or with
+ *  redundant separators, share their cached frames. Directories are resolved
+ *  once and remembered, as keys are made for every frame.
+ *
+ *  Only directories are resolved. A symlink to a single file keys apart from
+ *  its target, as following it would mean a filesystem call per frame.
+ */
+class ContentIdentity {
+  public:
+    ContentIdentity()  = default;
+    ~ContentIdentity() = default;
+
+    // the identity MediaKeys use
+    static ContentIdentity &instance();
+
+    // the file uri with its directory resolved, any other uri as it is
+    [[nodiscard]] std::string location(const caf::uri &uri);
+
+    // whether uri resolves to somewhere other than it says
+    [[nodiscard]] bool aliased(const caf::uri &uri);
+
+    // locations made, how many of those were aliased, and the directories
+    // remembered
+    [[nodiscard]] utility::JsonStore stats() const;
+
+    // forget the directories, as when the filesystem has changed under us
+    void clear();
+
+  private:
+    std::string resolve(const std::string &directory);
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::string> directories_;
+    std::atomic<size_t> locations_{0};
+    std::atomic<size_t> aliased_{0};
+};
+
+} // namespace xstudio::media
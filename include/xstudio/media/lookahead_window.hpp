@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+#include "xstudio/media/media.hpp"
+
+namespace xstudio::media {
+
+/**
+ *  @brief Holds the lookahead window of frames for one playhead, as last
+ *  sent (SubPlayhead) or as last received (GlobalMediaReaderActor) and
+ *  converts between full windows and deltas.
+ */
+class LookaheadWindow {
+
+  public:
+    LookaheadWindow(
+        const std::chrono::microseconds time_tolerance = std::chrono::milliseconds(2),
+        const uint64_t full_refresh_interval           = 16)
+        : time_tolerance_(time_tolerance), full_refresh_interval_(full_refresh_interval) {}
+
+    /**
+     *  @brief Make the delta that turns the current window into 'frames'.
+     *  'frames' then becomes the current window.
+     *
+     *  @details A full (reset) delta is made if the new window does not
+     *  continue on from the current one, if the retained frames have not all
+     *  moved by the same time offset or every 'full_refresh_interval' updates
+     *  so that a receiver can never drift too far out of step.
+     */
+    AVFrameIDsAndTimePointsDelta make_delta(const AVFrameIDsAndTimePoints &frames);
+
+    /**
+     *  @brief Make the delta that drops 'drop_front' frames from the front of
+     *  the current window, moves the rest by 'time_offset' and appends
+     *  'appended', for a sender that keeps track of its own window as it
+     *  moves rather than building a new one every update.
+     *
+     *  @details Returns nothing when a full window is due (see above), the
+     *  sender then sends one with make_delta(frames). frames() is not kept
+     *  up to date by this.
+     */
+    std::optional<AVFrameIDsAndTimePointsDelta> make_delta(
+        const size_t drop_front,
+        const std::chrono::microseconds time_offset,
+        AVFrameIDsAndTimePoints appended);
+
+    /**
+     *  @brief Apply a delta made by another LookaheadWindow's make_delta.
+     *
+     *  @details Returns false, and leaves the window unchanged, if the delta
+     *  is not based on our current window. The sender must then send a full
+     *  window.
+     */
+    bool apply_delta(const AVFrameIDsAndTimePointsDelta &delta);
+
+    /**
+     *  @brief Forget the current window, the next make_delta will be a full
+     *  (reset) delta.
+     */
+    void reset();
+
+    [[nodiscard]] const AVFrameIDsAndTimePoints &frames() const { return frames_; }
+    [[nodiscard]] uint64_t sequence() const { return sequence_; }
+
+  private:
+    AVFrameIDsAndTimePoints frames_;
+    uint64_t sequence_ = {0};
+    bool valid_        = {false};
+    const std::chrono::microseconds time_tolerance_;
+    const uint64_t full_refresh_interval_;
+};
+
+} // namespace xstudio::media
@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: Apache-2.0
 #pragma once
 
+#include <chrono>
 #include <fmt/format.h>
 #include <limits>
 #include <list>
@@ -149,6 +150,12 @@ class MediaDetail {
     utility::Timecode timecode_;
 };
 
+// used to persist MediaDetail, e.g. in the media probe cache
+void to_json(nlohmann::json &j, const StreamDetail &sd);
+void from_json(const nlohmann::json &j, StreamDetail &sd);
+void to_json(nlohmann::json &j, const MediaDetail &md);
+void from_json(const nlohmann::json &j, MediaDetail &md);
+
 class MediaKey : private std::string {
 
   public:
@@ -388,6 +395,39 @@ class AVFrameID {
 typedef std::pair<utility::time_point, std::shared_ptr<const AVFrameID>>
     MediaPointerAndTimePoint;
 typedef std::vector<MediaPointerAndTimePoint> AVFrameIDsAndTimePoints;
+
+/**
+ *  @brief The change to a playhead's lookahead window of frames between one
+ *  precache update and the next.
+ *
+ *  @details During playback the window mostly slides along: frames fall off
+ *  the front, new frames enter at the back and the frames in the middle keep
+ *  (more or less) the same display time points. Rather than re-sending the
+ *  whole window we send the number of frames dropped from the front, a single
+ *  time offset for the retained frames and the frames that were appended.
+ */
+struct AVFrameIDsAndTimePointsDelta {
+
+    // sequence number of the window that this delta is applied to
+    uint64_t base_sequence_ = {0};
+
+    // sequence number of the window after the delta is applied
+    uint64_t sequence_ = {0};
+
+    // if true, appended_ is the complete window and nothing is retained
+    bool reset_ = {true};
+
+    // number of frames that have left the front of the window
+    size_t drop_front_ = {0};
+
+    // shift applied to the time points of the frames that are retained
+    std::chrono::microseconds time_offset_ = std::chrono::microseconds(0);
+
+    // frames entering at the back of the window (or the whole window if
+    // reset_ is true)
+    AVFrameIDsAndTimePoints appended_;
+};
+
 typedef std::map<timebase::flicks, std::shared_ptr<const AVFrameID>> FrameTimeMap;
 typedef std::shared_ptr<const std::map<timebase::flicks, std::shared_ptr<const AVFrameID>>>
     FrameTimeMapPtr;
@@ -1,10 +1,13 @@
 // SPDX-License-Identifier: Apache-2.0
 #pragma once
 
+#include <atomic>
 #include <caf/all.hpp>
 #include <limits>
+#include <optional>
 
 #include "xstudio/media/media.hpp"
+#include "xstudio/utility/compact_json.hpp"
 #include "xstudio/utility/container.hpp"
 #include "xstudio/utility/json_store.hpp"
 #include "xstudio/json_store/json_store_handler.hpp"
@@ -32,18 +35,26 @@ class MediaActor : public caf::event_based_actor {
 
     caf::message_handler message_handler();
 
-    caf::behavior make_behavior() override {
-        return message_handler().or_else(base_.container_message_handler(this));
-    }
+    caf::behavior make_behavior() override;
     [[nodiscard]] const char *name() const override { return NAME.c_str(); }
     static caf::message_handler default_event_handler();
 
+    // media loaded from a session keep their sources as a compact record,
+    // and only spawn them when first asked for something the record can't
+    // answer. Applies to media loaded after it is changed.
+    static void set_lazy_load(const bool value) { lazy_load_ = value; }
+    [[nodiscard]] static bool lazy_load() { return lazy_load_; }
+
   private:
     inline static const std::string NAME = "MediaActor";
     void init();
 
     void deserialise(const utility::JsonStore &jsn);
 
+    // handlers for a media that hasn't built its sources yet
+    caf::message_handler dormant_message_handler();
+    void wake();
+
     void add_or_rename_media_source(
         const utility::MediaReference &ref,
         const std::string &name,
@@ -87,6 +98,11 @@ class MediaActor : public caf::event_based_actor {
     utility::JsonStore human_readable_info_;
     utility::JsonStore media_list_columns_info_;
     utility::time_point creation_time_ = {utility::clock::now()};
+
+    inline static std::atomic<bool> lazy_load_{false};
+    // serialised media, less base_, until woken
+    std::optional<utility::CompactJson> record_;
+    caf::behavior behaviour_;
 };
 
 class MediaSourceActor : public caf::event_based_actor {
@@ -5,6 +5,8 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "xstudio/media_reader/media_reader.hpp"
 #include "xstudio/utility/time_cache.hpp"
@@ -34,6 +36,12 @@ class GlobalImageCacheActor : public caf::event_based_actor {
     std::vector<media::MediaKey> good_images_in_cache_;
     std::vector<media::MediaKey> error_images_in_cache_;
 
+    // the source that first asked for each cached frame, then the others
+    // that got it without decoding it again, each counted once
+    std::unordered_map<media::MediaKey, std::vector<utility::Uuid>> key_sources_;
+    size_t shared_frames_{0};
+    size_t shared_bytes_{0};
+
     bool update_pending_{false};
     std::chrono::minutes reset_idle_{0};
     utility::time_point last_activity_{utility::clock::now()};
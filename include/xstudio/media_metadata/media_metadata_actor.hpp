@@ -4,6 +4,7 @@
 #include <caf/all.hpp>
 
 #include "xstudio/media_metadata/media_metadata.hpp"
+#include "xstudio/utility/file_probe_cache.hpp"
 #include "xstudio/utility/uuid.hpp"
 
 // media actor will be a collection of actors..
@@ -19,7 +20,10 @@
 namespace xstudio::media_metadata {
 class MediaMetadataWorkerActor : public caf::event_based_actor {
   public:
-    MediaMetadataWorkerActor(caf::actor_config &cfg, const utility::JsonStore &prefs);
+    MediaMetadataWorkerActor(
+        caf::actor_config &cfg,
+        const utility::JsonStore &prefs,
+        std::shared_ptr<utility::FileProbeCache> probe_cache = nullptr);
     ~MediaMetadataWorkerActor() override = default;
 
     caf::behavior make_behavior() override { return behavior_; }
@@ -30,6 +34,12 @@ class MediaMetadataWorkerActor : public caf::event_based_actor {
     caf::behavior behavior_;
     std::vector<caf::actor> plugins_;
     std::map<std::string, caf::actor> name_plugin_;
+
+    // metadata already read, shared by all workers. The fingerprint
+    // identifies the plugins (and their prefs) that produced it.
+    std::shared_ptr<utility::FileProbeCache> probe_cache_;
+    std::string probe_fingerprint_;
+    nlohmann::json probe_prefs_;
 };
 
 class GlobalMediaMetadataActor : public caf::event_based_actor {
@@ -44,8 +54,11 @@ class GlobalMediaMetadataActor : public caf::event_based_actor {
     void on_exit() override;
 
   private:
+    void update_probe_cache_preferences(const utility::JsonStore &prefs);
+
     inline static const std::string NAME = "GlobalMediaMetadataActor";
     caf::behavior behavior_;
     utility::Uuid uuid_;
+    std::shared_ptr<utility::FileProbeCache> probe_cache_;
 };
 } // namespace xstudio::media_metadata
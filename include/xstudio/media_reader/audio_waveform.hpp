@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace xstudio::media_reader {
+
+class AudioBuffer;
+
+// min, max and RMS level of a run of samples, on a 16 bit scale
+struct WaveformPeak {
+    int16_t min_{0};
+    int16_t max_{0};
+    uint16_t rms_{0};
+};
+
+/**
+ *  @brief Multi resolution min/max/RMS summary of an audio source, for
+ *  drawing waveforms at any zoom without decoding the audio again.
+ *
+ *  @details Samples are added in order, a frame (as in AVFrameID) at a time,
+ *  and reduced to one peak per samples_per_peak samples per channel. finish()
+ *  then builds coarser levels, each with half as many peaks as the one
+ *  before. Lookups pick the coarsest level that still has a few peaks per
+ *  column. Frame positions are kept, so frames map to exact sample positions
+ *  and a column's edges are accurate to half a peak.
+ */
+class AudioWaveformSummary {
+  public:
+    AudioWaveformSummary() = default;
+    AudioWaveformSummary(
+        const uint64_t sample_rate, const int num_channels, const int samples_per_peak = 256);
+
+    // Mark the start of the next frame of the source.
+    void start_frame();
+
+    // Append count samples per channel, interleaved and in the range -1 to 1.
+    void add_samples(const float *samples, const size_t count);
+
+    // Append the samples of an audio buffer, in any of the sample formats.
+    void add_samples(const AudioBuffer &buffer);
+
+    // Call when all samples are added, builds the coarser levels.
+    void finish();
+
+    // columns peaks covering samples [start, end) of a channel, or of all
+    // channels mixed if channel < 0. Columns past the end are zero.
+    [[nodiscard]] std::vector<WaveformPeak> peaks(
+        const int channel, const uint64_t start, const uint64_t end, const int columns) const;
+
+    // Sample position of a frame, fractional frames are interpolated. Frames
+    // past the end are extrapolated from the average frame length.
+    [[nodiscard]] uint64_t frame_to_sample(const double frame) const;
+
+    [[nodiscard]] uint64_t sample_rate() const { return sample_rate_; }
+    [[nodiscard]] int num_channels() const { return num_channels_; }
+    [[nodiscard]] uint64_t num_samples() const { return num_samples_; }
+    [[nodiscard]] size_t num_frames() const { return frame_starts_.size(); }
+    [[nodiscard]] int samples_per_peak() const { return samples_per_peak_; }
+    [[nodiscard]] size_t num_levels() const { return levels_.size(); }
+    [[nodiscard]] size_t size_bytes() const;
+
+    // Write to, or read from, a file. key identifies the source, a file made
+    // for a different key isn't loaded.
+    bool save(const std::string &path, const std::string &key) const;
+    [[nodiscard]] static std::shared_ptr<AudioWaveformSummary>
+    load(const std::string &path, const std::string &key);
+
+  private:
+    void end_peak();
+    void build_levels();
+
+    uint64_t sample_rate_{0};
+    int num_channels_{0};
+    int samples_per_peak_{256};
+    uint64_t num_samples_{0};
+
+    // peak being accumulated, per channel
+    std::vector<float> min_;
+    std::vector<float> max_;
+    std::vector<double> sum_squares_;
+    int count_{0};
+
+    std::vector<uint64_t> frame_starts_;
+    // levels_[l] holds peaks for samples_per_peak << l samples, interleaved
+    // by channel
+    std::vector<std::vector<WaveformPeak>> levels_;
+};
+
+typedef std::shared_ptr<const AudioWaveformSummary> AudioWaveformSummaryPtr;
+
+} // namespace xstudio::media_reader
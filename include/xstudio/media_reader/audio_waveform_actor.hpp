@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <caf/all.hpp>
+
+#include <functional>
+#include <map>
+
+#include "xstudio/media/media.hpp"
+#include "xstudio/media_reader/audio_waveform.hpp"
+#include "xstudio/utility/chrono.hpp"
+#include "xstudio/utility/json_store.hpp"
+
+namespace xstudio::media_reader {
+
+/**
+ *  @brief Builds, keeps and persists AudioWaveformSummary for audio sources.
+ *
+ *  @details The first request for a source decodes all of its audio once,
+ *  with a reader of its own so the audio cache isn't disturbed, and writes
+ *  the summary to the cache directory keyed on the file and its size and
+ *  modification time. Later requests, in this session or the next, are
+ *  answered from memory or disk.
+ *
+ *  (audio_waveform_atom, media, start_frame, end_frame, columns, channel)
+ *  returns columns min/max/RMS peaks between two frames of the audio of a
+ *  media or media source, channel -1 mixing all channels. Frames are
+ *  positions in the source's audio frame list and may be fractional.
+ */
+class AudioWaveformActor : public caf::event_based_actor {
+  public:
+    AudioWaveformActor(caf::actor_config &cfg, caf::actor reader_pool);
+    ~AudioWaveformActor() override = default;
+
+    caf::behavior make_behavior() override { return behavior_; }
+    [[nodiscard]] const char *name() const override { return NAME.c_str(); }
+
+  private:
+    inline static const std::string NAME = "AudioWaveformActor";
+
+    typedef std::function<void(const AudioWaveformSummaryPtr &, const caf::error &)> Waiter;
+
+    struct Build;
+
+    void get_summary(const caf::actor &media, Waiter waiter);
+    void build_summary(const std::string &key, const std::vector<media::AVFrameID> &frames);
+    void continue_build(const std::shared_ptr<Build> &build);
+    void finish_build(const std::string &key, AudioWaveformSummaryPtr summary, caf::error err);
+
+    [[nodiscard]] std::string summary_key(const media::AVFrameID &frame);
+    [[nodiscard]] std::string summary_path(const std::string &key) const;
+    void remember(const std::string &key, const AudioWaveformSummaryPtr &summary);
+
+  private:
+    caf::behavior behavior_;
+    caf::actor reader_pool_;
+
+    std::string directory_;
+    bool enabled_{true};
+    size_t max_in_memory_{64};
+
+    std::map<std::string, std::pair<AudioWaveformSummaryPtr, uint64_t>> summaries_;
+    std::map<std::string, std::vector<Waiter>> waiting_;
+    uint64_t usage_counter_{0};
+
+    // summary keys by source, and when the file was last looked at
+    std::map<std::string, std::pair<std::string, utility::time_point>> keys_;
+};
+
+} // namespace xstudio::media_reader
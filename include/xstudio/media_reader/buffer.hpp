@@ -7,6 +7,7 @@
 #include "xstudio/utility/blind_data.hpp"
 
 #include <cassert>
+#include <chrono>
 #include <cstdint>
 #include <iostream>
 #include <new>
@@ -59,6 +60,10 @@ class Buffer {
 
     void set_display_timestamp_flicks(const timebase::flicks dts) { dts_ = dts; }
     void set_display_timestamp_seconds(const double dts) { dts_ = timebase::to_flicks(dts); }
+    // time taken by the reader to load and decode the buffer
+    [[nodiscard]] std::chrono::microseconds read_duration() const { return read_duration_; }
+    void set_read_duration(const std::chrono::microseconds d) { read_duration_ = d; }
+
     void set_error(const std::string &err) {
         error_message_ = err;
         error_state_   = HAS_ERROR;
@@ -89,7 +94,8 @@ class Buffer {
     utility::JsonStore params_;
     std::string error_message_;
     BufferErrorState error_state_{NO_ERROR};
-    timebase::flicks dts_ = timebase::k_flicks_zero_seconds;
+    timebase::flicks dts_                    = timebase::k_flicks_zero_seconds;
+    std::chrono::microseconds read_duration_ = std::chrono::microseconds(0);
 };
 
 /* Lower level dumb cache that hangs onto BufferDataPtrs after deletion
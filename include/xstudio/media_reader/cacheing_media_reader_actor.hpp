@@ -6,6 +6,7 @@
 #include "xstudio/media/media.hpp"
 #include "xstudio/media_reader/media_reader.hpp"
 #include "xstudio/utility/chrono.hpp"
+#include "xstudio/utility/json_store.hpp"
 #include "xstudio/utility/uuid.hpp"
 
 namespace xstudio::media_reader {
@@ -56,15 +57,19 @@ class CachingMediaReaderActor : public caf::event_based_actor {
 
     bool urgent_worker_busy_ = {false};
 
-    caf::actor pick_precache_worker() {
-        auto r                = precache_workers_[next_precache_worker_];
-        next_precache_worker_ = (next_precache_worker_ + 1) % precache_workers_.size();
-        return r;
-    }
+    // the least busy precache worker, adding another if they all are
+    size_t pick_precache_worker();
+    void add_precache_worker();
 
     caf::actor urgent_worker_;
     std::vector<caf::actor> precache_workers_;
-    size_t next_precache_worker_ = {0};
+    std::vector<size_t> precache_worker_reads_;
+    // the GlobalMediaReaderActor decides how many precache reads we get at
+    // once, workers are added to match up to this many
+    size_t max_precache_workers_{1};
+    bool adding_precache_worker_{false};
+    utility::Uuid plugin_uuid_;
+    utility::JsonStore plugin_prefs_;
     caf::actor audio_worker_;
 
     ImageBufPtr blank_image_;
@@ -0,0 +1,187 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "xstudio/utility/chrono.hpp"
+#include "xstudio/utility/json_store.hpp"
+
+namespace xstudio::media_reader {
+
+class FileBufferPool;
+
+/**
+ *  @brief The whole of a file, in memory aligned for direct IO.
+ */
+class FileBytes {
+  public:
+    FileBytes(std::shared_ptr<FileBufferPool> pool, const size_t capacity);
+    ~FileBytes();
+
+    FileBytes(const FileBytes &)            = delete;
+    FileBytes &operator=(const FileBytes &) = delete;
+
+    [[nodiscard]] const char *data() const { return data_; }
+    [[nodiscard]] size_t size() const { return size_; }
+    [[nodiscard]] size_t capacity() const { return capacity_; }
+
+  private:
+    friend class FrameFileReader;
+
+    std::shared_ptr<FileBufferPool> pool_;
+    char *data_{nullptr};
+    size_t size_{0};
+    size_t capacity_{0};
+};
+
+using FileBytesPtr = std::shared_ptr<const FileBytes>;
+
+/**
+ *  @brief Reads whole frame files ahead of their decoders.
+ *
+ *  @details Readers of a file per frame (EXR, DPX, TIFF ...) normally go
+ *  through their libraries' buffered IO, a syscall at a time, in the thread
+ *  that then decodes, and leave the frames in the page cache. Here the
+ *  precache pipeline names the files it will want next, and they are read
+ *  whole into pooled aligned buffers, bypassing the page cache where the
+ *  filesystem allows, through an io_uring kept full of reads if we were
+ *  built with it or else by a few threads. Readers then take the bytes and
+ *  decode from memory.
+ *
+ *  This is the IO stage of the precache pipeline, running as far ahead of
+ *  decoding as the byte budget allows. Files are read in the order they are
+ *  wanted. Once the budget is used up, a file wanted sooner than one held
+ *  takes its place, and files no longer wanted are dropped. Shared by all
+ *  readers, use instance().
+ */
+class FrameFileReader {
+  public:
+    FrameFileReader();
+    ~FrameFileReader();
+
+    static FrameFileReader &instance();
+
+    void set_enabled(const bool enabled);
+    void set_budget(const size_t bytes);
+    void set_direct_io(const bool direct);
+    // applies when reading next starts
+    void set_threads(const size_t threads);
+
+    [[nodiscard]] bool enabled() const;
+
+    // Readers that take their files from us, by MediaReader::name(). Files
+    // are only prefetched for these.
+    void add_reader(const std::string &reader);
+    [[nodiscard]] bool reads_for(const std::string &reader) const;
+
+    // The files wanted after those being decoded, soonest first. Replaces
+    // the last list, files on neither are dropped unless being read.
+    void prefetch(const std::vector<std::string> &paths);
+
+    // The decode stage is about to take path, read it next if it isn't
+    // already and keep it until it's taken.
+    void claim(const std::string &path);
+
+    // The frame of path was found cached, it won't be taken.
+    void discard(const std::string &path);
+
+    // About how many files fit in the budget, at the size of those read.
+    [[nodiscard]] size_t lookahead() const;
+
+    // The prefetched bytes of path, reading them now if the read hasn't
+    // started. Null if path wasn't prefetched, couldn't be read or is being
+    // read, the caller then reads it as it would have rather than wait. The
+    // bytes are handed over, a frame is decoded once.
+    [[nodiscard]] FileBytesPtr take(const std::string &path);
+
+    // True while path is being read ahead, when take would miss it.
+    [[nodiscard]] bool reading(const std::string &path) const;
+
+    // Drop everything prefetched and waiting.
+    void clear();
+
+    [[nodiscard]] utility::JsonStore stats() const;
+
+    // Read the whole of path now. Null if it can't be.
+    [[nodiscard]] FileBytesPtr read(const std::string &path, bool *direct = nullptr) const;
+
+  private:
+    struct Entry {
+        enum class State { Queued, Reading, Done };
+        State state_{State::Queued};
+        // the place in the last list, claimed files come first
+        size_t rank_{0};
+        bool claimed_{false};
+        FileBytesPtr bytes_;
+        utility::time_point done_;
+    };
+
+    using Entries = std::map<std::string, std::shared_ptr<Entry>>;
+    using Next    = std::pair<std::string, std::shared_ptr<Entry>>;
+
+    // the io_uring and the reads in it, if we were built with it
+    struct Ring;
+
+    void start();
+    void stop();
+    void worker();
+    // reaps the ring's completions
+    void uring_worker();
+    // opens files and submits their reads to the ring while it has room,
+    // and reads those it couldn't
+    void uring_opener();
+    // The next file to read, if wait then waiting for one and for room in
+    // the budget. No entry when there isn't one or we are stopping.
+    Next next(std::unique_lock<std::mutex> &lock, const bool wait);
+    // reserved is what the read added to reading_
+    void finish(
+        const Next &read,
+        FileBytesPtr bytes,
+        const bool direct,
+        const utility::clock::duration &duration,
+        const size_t reserved = 0);
+    void evict(const utility::time_point &now);
+    // drop a file held for later than rank, true if there was one
+    bool make_room(const size_t rank);
+    Entries::iterator drop(Entries::iterator it);
+    void count(
+        const FileBytesPtr &bytes, const bool direct, const utility::clock::duration &duration);
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    Entries entries_;
+    std::deque<std::string> queue_;
+    std::set<std::string> readers_;
+    std::vector<std::thread> threads_;
+    std::shared_ptr<FileBufferPool> pool_;
+    std::unique_ptr<Ring> ring_;
+
+    bool enabled_{true};
+    bool direct_io_{true};
+    bool stopping_{false};
+    size_t budget_{1024 * 1024 * 1024};
+    size_t threads_count_{4};
+    // bytes held by entries waiting to be taken, and of ring reads under way
+    size_t held_{0};
+    size_t reading_{0};
+
+    size_t reads_{0};
+    size_t direct_reads_{0};
+    size_t failed_{0};
+    size_t taken_{0};
+    size_t missed_{0};
+    size_t evicted_{0};
+    size_t dropped_{0};
+    size_t bytes_read_{0};
+    double read_seconds_{0.0};
+};
+
+} // namespace xstudio::media_reader
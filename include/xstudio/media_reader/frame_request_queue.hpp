@@ -9,6 +9,7 @@
 #include "xstudio/utility/chrono.hpp"
 #include "xstudio/utility/uuid.hpp"
 
+#include <functional>
 #include <map>
 #include <vector>
 
@@ -87,6 +88,15 @@ class FrameRequestQueue {
         const std::map<utility::Uuid, int> &exclude_playheads,
         const size_t max_num_inflight_requests);
 
+    /**
+     *   @brief Get the next ordered frame request, where admit decides if
+     *   a request can go while its playhead has others in flight
+     *
+     */
+    std::optional<FrameRequest> pop_request(
+        const std::map<utility::Uuid, int> &exclude_playheads,
+        const std::function<bool(const FrameRequest &, const int in_flight)> &admit);
+
     /**
      *   @brief Add a request to the queue
      *
@@ -104,6 +114,21 @@ class FrameRequestQueue {
         const media::AVFrameIDsAndTimePoints &frames_info,
         const utility::Uuid &requesting_playhead_uuid);
 
+    /**
+     *   @brief The frames of the next requests, soonest first, without
+     *   taking them from the queue
+     */
+    [[nodiscard]] std::vector<std::shared_ptr<const media::AVFrameID>>
+    upcoming(const size_t count) const;
+
+    /**
+     *   @brief Bring the requests from a playhead into line with its
+     *   lookahead window. Requests for frames that have left the window are
+     *   removed, the rest take the time that the window needs them by.
+     */
+    void retain_frame_requests(
+        const media::AVFrameIDsAndTimePoints &window, const utility::Uuid &playhead_uuid);
+
     /**
      *   @brief Remove all frame requests in the queue originating from
      *   the indicated playhead
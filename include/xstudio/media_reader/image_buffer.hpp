@@ -7,6 +7,7 @@
 #include "xstudio/media_reader/pixel_info.hpp"
 #include "xstudio/ui/viewport/shader.hpp"
 #include "xstudio/colour_pipeline/colour_pipeline.hpp"
+#include "xstudio/utility/json_interner.hpp"
 
 namespace xstudio::media_reader {
 
@@ -16,7 +17,10 @@ class ImageBuffer : public Buffer {
         const utility::Uuid &uuid               = utility::Uuid(),
         const utility::JsonStore &shader_params = utility::JsonStore(),
         const utility::JsonStore &params        = utility::JsonStore())
-        : Buffer(params), shader_id_(uuid), shader_params_(shader_params) {}
+        : Buffer(params), shader_id_(uuid) {
+        if (not shader_params.is_null())
+            set_shader_params(shader_params);
+    }
 
     ImageBuffer(const std::string &error_message) : Buffer(error_message) {
         // provide fallback image size for error image of 16:9
@@ -27,14 +31,31 @@ class ImageBuffer : public Buffer {
 
     byte *allocate(const size_t size) override;
 
+    // bytes asked for by the reader, size() includes padding for upload
+    [[nodiscard]] size_t data_size() const { return data_size_; }
+
     void set_shader(const ui::viewport::GPUShaderPtr &shader) { shader_ = shader; }
     [[nodiscard]] ui::viewport::GPUShaderPtr shader() const { return shader_; }
 
-    void set_shader_params(const utility::JsonStore &params) { shader_params_ = params; }
-    [[nodiscard]] const utility::JsonStore &shader_params() const { return shader_params_; }
+    // Shader parameters and metadata are interned, frames of a sequence with
+    // the same values share them. Metadata is interned per top level key, so
+    // a frame only holds the values that differ from other frames. Readers
+    // pass the source interner of the stream, so unchanged values are reused
+    // without hashing them.
+    void set_shader_params(
+        const utility::JsonStore &params, utility::JsonSourceInterner *source = nullptr);
+    [[nodiscard]] const utility::JsonStore &shader_params() const;
+
+    void set_metadata(
+        const utility::JsonStore &metadata, utility::JsonSourceInterner *source = nullptr);
+    [[nodiscard]] utility::JsonStore metadata() const;
+
+    // memory of the parameters and metadata that the frame doesn't share
+    [[nodiscard]] size_t metadata_size_bytes() const;
 
-    void set_metadata(const utility::JsonStore &metadata) { metadata_ = metadata; }
-    [[nodiscard]] const utility::JsonStore &metadata() const { return metadata_; }
+    // the interned values, which caches count once however many frames
+    // hold them
+    [[nodiscard]] std::vector<utility::InternedJson> shared_values() const;
 
     [[nodiscard]] Imath::V2i image_size_in_pixels() const { return image_size_in_pixels_; }
     [[nodiscard]] Imath::Box2i image_pixels_bounding_box() const { return pixels_bounds_; }
@@ -57,6 +78,12 @@ class ImageBuffer : public Buffer {
     [[nodiscard]] bool has_alpha() const { return has_alpha_; }
     void set_has_alpha(const bool b) { has_alpha_ = b; }
 
+    // A quick, low quality stand in for the image that a reader can return
+    // while it makes the real one. Drafts aren't cached, reading the frame
+    // again gives the full image.
+    [[nodiscard]] bool is_draft() const { return draft_; }
+    void set_draft(const bool b) { draft_ = b; }
+
     typedef std::function<PixelInfo(
         const ImageBuffer &buf,
         const utility::JsonStore &pixel_unpack_uniforms,
@@ -77,17 +104,49 @@ class ImageBuffer : public Buffer {
         return {pixel_location};
     }
 
+    // Decode count pixels of row y, starting at x, to float RGBA written to
+    // rgba (4 * count floats). Coordinates are image coordinates, pixels
+    // outside the data window are zero.
+    typedef std::function<void(
+        const ImageBuffer &buf,
+        const utility::JsonStore &pixel_unpack_uniforms,
+        const int x,
+        const int y,
+        const int count,
+        float *rgba)>
+        PixelUnpackFunc;
+
+    void set_pixel_unpack_func(PixelUnpackFunc func) { pixel_unpack_ = func; }
+
+    // True if pixels can be decoded on the CPU, by the reader's unpack
+    // function or, more slowly, its pixel picker.
+    [[nodiscard]] bool can_unpack_pixels() const {
+        return bool(pixel_unpack_) or bool(pixel_picker_);
+    }
+
+    void unpack_pixels(
+        const int x,
+        const int y,
+        const int count,
+        const utility::JsonStore &pixel_unpack_uniforms,
+        float *rgba) const;
+
   private:
     utility::Uuid shader_id_;
-    utility::JsonStore shader_params_;
-    utility::JsonStore metadata_;
+    utility::InternedJson shader_params_;
+    // the metadata's keys, or null if it isn't an object, and its values
+    utility::InternedJson metadata_keys_;
+    std::vector<utility::InternedJson> metadata_values_;
+    size_t data_size_{0};
     Imath::V2i image_size_in_pixels_;
     Imath::Box2i pixels_bounds_;
     media::MediaKey media_key_;
     int frame_num_ = -1;
     ui::viewport::GPUShaderPtr shader_;
     PixelPickerFunc pixel_picker_;
+    PixelUnpackFunc pixel_unpack_;
     bool has_alpha_ = false;
+    bool draft_     = false;
 };
 
 /* ImageBuffer is used to store the decoded image (single frame) data in
@@ -315,6 +374,21 @@ class ImageBufPtr : public std::shared_ptr<ImageBuffer> {
     }
 };
 
+// what an image counts for in the image cache, its pixels and metadata
+inline size_t cache_entry_size(const ImageBufPtr &v) {
+    return v ? v->size() + v->metadata_size_bytes() : 0;
+}
+
+// the values an image shares with others, counted by the cache on their own
+inline std::vector<std::pair<const void *, size_t>> cache_entry_shared(const ImageBufPtr &v) {
+    std::vector<std::pair<const void *, size_t>> result;
+    if (v) {
+        for (const auto &i : v->shared_values())
+            result.emplace_back(i.value.get(), i.bytes);
+    }
+    return result;
+}
+
 inline float image_aspect(const ImageBufPtr &v) {
 
     return v ? v->image_size_in_pixels().y
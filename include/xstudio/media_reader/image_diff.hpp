@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include "xstudio/media_reader/image_buffer.hpp"
+#include "xstudio/utility/helpers.hpp"
+#include "xstudio/utility/json_store.hpp"
+
+namespace xstudio::media_reader {
+
+// 64 bit hash of the decoded pixels and the layout needed to interpret them,
+// two buffers with the same hash hold the same image.
+[[nodiscard]] uint64_t image_content_hash(const ImageBufPtr &image);
+
+using utility::hash_bytes;
+
+/**
+ *  @brief Pixel statistics of the difference between two images.
+ *
+ *  @details Channels are RGBA, as decoded by the readers' pixel unpackers
+ *  (so raw values, before any colour management). PSNR is over RGB with a
+ *  peak value of 1.0 and is infinite for identical images.
+ */
+struct ImageDiffStats {
+    [[nodiscard]] utility::JsonStore to_json() const;
+
+    std::array<double, 4> max_abs_diff_{0.0, 0.0, 0.0, 0.0};
+    std::array<double, 4> mean_abs_diff_{0.0, 0.0, 0.0, 0.0};
+    double psnr_{0.0};
+    // pixels with any channel differing by more than the tolerance
+    size_t differing_pixels_{0};
+    size_t pixel_count_{0};
+    uint64_t hash_a_{0};
+    uint64_t hash_b_{0};
+    bool identical_{false};
+    // set if the images couldn't be compared
+    std::string error_;
+};
+
+// Compare two images pixel by pixel over the union of their data windows.
+// Images of different sizes, or that can't be decoded on the CPU, give stats
+// with the error set.
+[[nodiscard]] ImageDiffStats
+compare_images(const ImageBufPtr &a, const ImageBufPtr &b, const float tolerance = 0.0f);
+
+} // namespace xstudio::media_reader
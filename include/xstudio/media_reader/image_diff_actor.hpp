@@ -0,0 +1,66 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <caf/all.hpp>
+
+#include <functional>
+
+#include "xstudio/media/media.hpp"
+#include "xstudio/media_reader/image_diff.hpp"
+#include "xstudio/media_reader/pixel_sampler.hpp"
+#include "xstudio/utility/json_store.hpp"
+
+namespace xstudio::media_reader {
+
+/**
+ *  @brief Compares one pair of frames, or samples pixels from one frame. The
+ *  images are read through the global media reader (so come from the cache
+ *  if they're there).
+ */
+class ImageDiffWorkerActor : public caf::event_based_actor {
+  public:
+    ImageDiffWorkerActor(caf::actor_config &cfg);
+    ~ImageDiffWorkerActor() override = default;
+
+    caf::behavior make_behavior() override { return behavior_; }
+    [[nodiscard]] const char *name() const override { return NAME.c_str(); }
+
+  private:
+    inline static const std::string NAME = "ImageDiffWorkerActor";
+    caf::behavior behavior_;
+};
+
+/**
+ *  @brief Per frame QC comparison of two media, or media sources.
+ *
+ *  @details Frames are matched by their position in each source's frame
+ *  list and compared in parallel by a pool of workers, with a bounded number
+ *  in flight so a long sequence doesn't flood the readers. The result lists
+ *  the stats of every compared frame (see ImageDiffStats::to_json) plus a
+ *  summary.
+ *
+ *  Batch pixel sampling (see PixelSampleRequest) of a frame, or of every
+ *  frame of a media, runs through the same workers.
+ */
+class ImageDiffActor : public caf::event_based_actor {
+  public:
+    ImageDiffActor(caf::actor_config &cfg, const size_t worker_count = 4);
+    ~ImageDiffActor() override = default;
+
+    caf::behavior make_behavior() override { return behavior_; }
+    [[nodiscard]] const char *name() const override { return NAME.c_str(); }
+
+  private:
+    inline static const std::string NAME = "ImageDiffActor";
+
+    struct SequenceJob;
+
+    void continue_sequence(const std::shared_ptr<SequenceJob> &job);
+
+  private:
+    caf::behavior behavior_;
+    caf::actor pool_;
+    size_t max_in_flight_{8};
+};
+
+} // namespace xstudio::media_reader
@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "xstudio/media_reader/image_buffer.hpp"
+#include "xstudio/utility/json_store.hpp"
+
+namespace xstudio::media_reader {
+
+struct ImageScopesSettings {
+
+    ImageScopesSettings() = default;
+    ImageScopesSettings(const utility::JsonStore &js);
+
+    [[nodiscard]] utility::JsonStore to_json() const;
+
+    bool operator==(const ImageScopesSettings &o) const {
+        return histogram_bins_ == o.histogram_bins_ and
+               waveform_columns_ == o.waveform_columns_ and
+               waveform_rows_ == o.waveform_rows_ and range_min_ == o.range_min_ and
+               range_max_ == o.range_max_ and max_samples_ == o.max_samples_;
+    }
+    bool operator!=(const ImageScopesSettings &o) const { return not(*this == o); }
+
+    int histogram_bins_{256};
+    int waveform_columns_{256};
+    int waveform_rows_{128};
+    // values outside the range go in the first or last bin
+    float range_min_{0.0f};
+    float range_max_{1.0f};
+    // the image is sampled on a regular grid with no more than this many
+    // points, 0 samples every pixel
+    size_t max_samples_{size_t(1) << 16};
+    // 0 for one per core
+    int max_threads_{0};
+};
+
+/**
+ *  @brief Histograms, luma waveform and RGB parade of an image.
+ *
+ *  @details Computed from the raw (not colour managed) RGB values that the
+ *  reader's pixel unpacker decodes, so half, float and integer formats are
+ *  all measured on the same normalised scale. Luma uses Rec.709 weights.
+ *
+ *  Waveforms are waveform_rows_ rows of waveform_columns_ counts, row 0 at
+ *  range_min_, column 0 at the left of the data window.
+ */
+struct ImageScopes {
+    enum Channel { RED = 0, GREEN, BLUE, LUMA };
+
+    [[nodiscard]] utility::JsonStore to_json() const;
+
+    ImageScopesSettings settings_;
+    std::array<std::vector<uint32_t>, 4> histograms_;
+    std::vector<uint32_t> luma_waveform_;
+    std::array<std::vector<uint32_t>, 3> rgb_parade_;
+    size_t samples_{0};
+    int step_x_{1};
+    int step_y_{1};
+    // set if the image couldn't be measured
+    std::string error_;
+};
+
+typedef std::shared_ptr<const ImageScopes> ImageScopesPtr;
+
+[[nodiscard]] ImageScopes
+compute_image_scopes(const ImageBufPtr &image, const ImageScopesSettings &settings = {});
+
+/**
+ *  @brief Most recently used scopes, by the MediaKey of the image they were
+ *  computed from. Thread safe.
+ */
+class ImageScopesCache {
+  public:
+    ImageScopesCache(const size_t capacity = 32) : capacity_(capacity) {}
+
+    // Cached scopes for the image if there are some with the same settings,
+    // otherwise computes and caches them. Images without a key aren't cached.
+    ImageScopesPtr get(const ImageBufPtr &image, const ImageScopesSettings &settings = {});
+
+    void clear();
+    [[nodiscard]] size_t size() const;
+    [[nodiscard]] size_t hits() const { return hits_; }
+
+  private:
+    typedef std::pair<media::MediaKey, ImageScopesPtr> Entry;
+
+    mutable std::mutex mutex_;
+    size_t capacity_;
+    std::atomic<size_t> hits_{0};
+    // most recent first
+    std::list<Entry> entries_;
+    std::unordered_map<media::MediaKey, std::list<Entry>::iterator> index_;
+};
+
+} // namespace xstudio::media_reader
@@ -7,6 +7,7 @@
 
 #include "xstudio/media/media.hpp"
 #include "xstudio/media_reader/media_reader.hpp"
+#include "xstudio/utility/file_probe_cache.hpp"
 #include "xstudio/utility/uuid.hpp"
 
 // MediaDetail is crucial to the set-up of a media source so that it is playable.
@@ -25,7 +26,9 @@ class MediaDetailAndThumbnailReaderActor : public caf::event_based_actor {
 
   public:
     MediaDetailAndThumbnailReaderActor(
-        caf::actor_config &cfg, const utility::Uuid &uuid = utility::Uuid::generate());
+        caf::actor_config &cfg,
+        const utility::Uuid &uuid                            = utility::Uuid::generate(),
+        std::shared_ptr<utility::FileProbeCache> probe_cache = nullptr);
     ~MediaDetailAndThumbnailReaderActor() override = default;
     caf::behavior make_behavior() override { return behavior_; }
     [[nodiscard]] const char *name() const override { return NAME.c_str(); }
@@ -77,5 +80,11 @@ class MediaDetailAndThumbnailReaderActor : public caf::event_based_actor {
     utility::Uuid uuid_;
     std::vector<caf::actor> plugins_;
     std::map<utility::Uuid, caf::actor> plugins_map_;
+
+    // persistent MediaDetail cache shared by the pool of detail readers.
+    // Entries are only valid for the reader plugins (and their prefs) that
+    // made them, as identified by probe_fingerprint_
+    std::shared_ptr<utility::FileProbeCache> probe_cache_;
+    std::string probe_fingerprint_;
 };
 } // namespace xstudio::media_reader
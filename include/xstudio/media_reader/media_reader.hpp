@@ -78,6 +78,12 @@ namespace media_reader {
         [[nodiscard]] virtual ImageBuffer::PixelPickerFunc pixel_picker_func() const {
             return &MediaReader::default_pixel_picker;
         }
+        // Readers whose pixel layout can be decoded a row at a time should
+        // provide this, otherwise CPU side image analysis falls back to the
+        // pixel picker.
+        [[nodiscard]] virtual ImageBuffer::PixelUnpackFunc pixel_unpack_func() const {
+            return ImageBuffer::PixelUnpackFunc();
+        }
 
         virtual MRCertainty
         supported(const caf::uri &uri, const std::array<uint8_t, 16> &signature);
@@ -161,30 +167,15 @@ namespace media_reader {
                 },
 
                 [=](get_image_atom, const media::AVFrameID &mptr) -> result<ImageBufPtr> {
-                    ImageBufPtr mb;
-                    try {
-                        std::string path = utility::uri_to_posix_path(mptr.uri());
-                        mb               = media_reader_.image(mptr);
-                        if (mb) {
-                            if (mb->media_key().is_null())
-                                mb->set_media_key(mptr.key());
-                            mb->set_pixel_picker_func(media_reader_.pixel_picker_func());
-                            mb->params()["path"]   = path;
-                            mb->params()["frame"]  = mptr.frame();
-                            mb->params()["reader"] = media_reader_.name();
-                        }
-                    } catch (const media_missing_error &e) {
-                        return make_error(media::media_error::missing, e.what());
-                    } catch (const media_corrupt_error &e) {
-                        return make_error(media::media_error::corrupt, e.what());
-                    } catch (const media_unsupported_error &e) {
-                        return make_error(media::media_error::unsupported, e.what());
-                    } catch (const media_unreadable_error &e) {
-                        return make_error(media::media_error::unreadable, e.what());
-                    } catch (const std::exception &e) {
-                        return make_error(xstudio_error::error, e.what());
-                    }
-                    return mb;
+                    return read_image(mptr, false);
+                },
+
+                // If allow_draft the reader may return a draft (see
+                // ImageBuffer::is_draft)
+                [=](get_image_atom,
+                    const media::AVFrameID &mptr,
+                    const bool allow_draft) -> result<ImageBufPtr> {
+                    return read_image(mptr, allow_draft);
                 },
 
                 [=](get_media_detail_atom, const caf::uri &_uri) -> result<media::MediaDetail> {
@@ -283,6 +274,41 @@ namespace media_reader {
         caf::behavior make_behavior() override { return behavior_; }
 
       private:
+        // Unless allow_draft we read until we get the full image
+        caf::result<ImageBufPtr>
+        read_image(const media::AVFrameID &mptr, const bool allow_draft) {
+            ImageBufPtr mb;
+            try {
+                std::string path = utility::uri_to_posix_path(mptr.uri());
+                const auto t0    = utility::clock::now();
+                mb               = media_reader_.image(mptr);
+                if (mb && mb->is_draft() && !allow_draft)
+                    mb = media_reader_.image(mptr);
+                if (mb) {
+                    mb->set_read_duration(std::chrono::duration_cast<std::chrono::microseconds>(
+                        utility::clock::now() - t0));
+                    if (mb->media_key().is_null())
+                        mb->set_media_key(mptr.key());
+                    mb->set_pixel_picker_func(media_reader_.pixel_picker_func());
+                    mb->set_pixel_unpack_func(media_reader_.pixel_unpack_func());
+                    mb->params()["path"]   = path;
+                    mb->params()["frame"]  = mptr.frame();
+                    mb->params()["reader"] = media_reader_.name();
+                }
+            } catch (const media_missing_error &e) {
+                return make_error(media::media_error::missing, e.what());
+            } catch (const media_corrupt_error &e) {
+                return make_error(media::media_error::corrupt, e.what());
+            } catch (const media_unsupported_error &e) {
+                return make_error(media::media_error::unsupported, e.what());
+            } catch (const media_unreadable_error &e) {
+                return make_error(media::media_error::unreadable, e.what());
+            } catch (const std::exception &e) {
+                return make_error(xstudio_error::error, e.what());
+            }
+            return mb;
+        }
+
         caf::behavior behavior_;
         T media_reader_;
     };
@@ -3,9 +3,12 @@
 
 #include <caf/all.hpp>
 
+#include "xstudio/media/lookahead_window.hpp"
 #include "xstudio/media/media.hpp"
 #include "xstudio/media_reader/media_reader.hpp"
+#include "xstudio/media_reader/read_concurrency.hpp"
 #include "xstudio/utility/chrono.hpp"
+#include "xstudio/utility/file_probe_cache.hpp"
 #include "xstudio/utility/uuid.hpp"
 
 // media actor will be a collection of actors..
@@ -45,6 +48,7 @@ class GlobalMediaReaderActor : public caf::event_based_actor {
     caf::actor
     get_reader(const caf::uri &_uri, const caf::actor_addr &_key, const std::string &hint = "");
     bool do_precache();
+    bool admit_precache_request(const FrameRequest &fr);
 
     void keep_cache_hot(
         const media::MediaKey &new_entry,
@@ -65,18 +69,41 @@ class GlobalMediaReaderActor : public caf::event_based_actor {
 
     void continue_precacheing();
 
-    void mark_playhead_waiting_for_precache_result(const utility::Uuid &playhead_uuid);
+    void mark_playhead_waiting_for_precache_result(
+        const utility::Uuid &playhead_uuid, const std::string &source);
 
-    void mark_playhead_received_precache_result(const utility::Uuid &playhead_uuid);
+    void mark_playhead_received_precache_result(
+        const utility::Uuid &playhead_uuid, const std::string &source);
 
     void send_error_to_source(const caf::actor_addr &addr, const caf::error &err);
 
+    // Send an image to the playhead that asked for it. If it's a draft we
+    // then read the full image and send that too.
+    void push_image(
+        caf::actor reader,
+        caf::actor playhead,
+        const media_reader::ImageBufPtr &buf,
+        const media::AVFrameID &mptr,
+        const utility::Uuid &playhead_uuid,
+        const utility::time_point &tp,
+        const timebase::flicks playhead_position);
+
     void process_get_media_detail_queue();
 
+    void update_probe_cache_preferences(const utility::JsonStore &prefs);
+
+    void update_frame_file_preferences(const utility::JsonStore &prefs);
+
+    // The IO stage of precaching, for readers that decode from memory. The
+    // file of the frame about to be decoded is read first, then those of
+    // the frames queued after it as far as the FrameFileReader budget goes.
+    void prefetch_frame_files(const FrameRequest &fr, const FrameRequestQueue &queue);
+
   private:
     caf::actor pool_;
     caf::actor image_cache_;
     caf::actor audio_cache_;
+    caf::actor audio_waveform_;
     caf::behavior behavior_;
     utility::Uuid uuid_;
     std::map<std::string, caf::actor> readers_;
@@ -87,12 +114,25 @@ class GlobalMediaReaderActor : public caf::event_based_actor {
 
     std::map<utility::Uuid, int> playheads_with_precache_requests_in_flight_;
 
+    // how many precache reads each reader may have in flight
+    ReadConcurrency read_concurrency_;
+    caf::actor_addr last_admitted_addr_;
+    caf::uri last_admitted_uri_;
+    std::string last_admitted_source_;
+
+    // the lookahead window of each playhead (image and audio), as built from
+    // the deltas that the playheads send us during playback
+    std::map<std::pair<utility::Uuid, media::MediaType>, media::LookaheadWindow>
+        playback_precache_windows_;
+
     std::vector<caf::actor> plugins_;
     std::map<std::string, utility::Uuid> plugins_map_;
 
+    // persistent MediaDetail cache, shared with the media detail reader pool
+    std::shared_ptr<utility::FileProbeCache> probe_cache_;
+
     size_t max_source_count_{256};
     size_t max_source_age_{600};
-    size_t max_num_inflight_requests_{1};
     size_t num_inflight_requests_{0};
 
     FrameRequestQueue playback_precache_request_queue_;
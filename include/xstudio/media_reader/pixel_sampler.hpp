@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include <Imath/ImathBox.h>
+
+#include "xstudio/media_reader/image_buffer.hpp"
+#include "xstudio/utility/json_store.hpp"
+
+namespace xstudio::media_reader {
+
+/**
+ *  @brief The pixels and regions to read from an image.
+ *
+ *  @details Coordinates are image pixel coordinates, the same as the pixel
+ *  picker's. Regions have an exclusive max. As json:
+ *
+ *      {"points": [[x, y], ...],
+ *       "regions": [[x0, y0, x1, y1], ...],
+ *       "data_window": true}
+ *
+ *  where data_window asks for stats over the whole data window as well.
+ *  Regions are clipped to the data window, the region in the result is the
+ *  part measured.
+ */
+struct PixelSampleRequest {
+
+    PixelSampleRequest() = default;
+    PixelSampleRequest(const utility::JsonStore &js);
+
+    [[nodiscard]] utility::JsonStore to_json() const;
+
+    std::vector<Imath::V2i> points_;
+    std::vector<Imath::Box2i> regions_;
+    bool data_window_{false};
+};
+
+struct PixelRegionStats {
+    [[nodiscard]] utility::JsonStore to_json() const;
+
+    Imath::Box2i region_;
+    std::array<double, 4> mean_{0.0, 0.0, 0.0, 0.0};
+    std::array<float, 4> min_{0.0f, 0.0f, 0.0f, 0.0f};
+    std::array<float, 4> max_{0.0f, 0.0f, 0.0f, 0.0f};
+    size_t pixel_count_{0};
+};
+
+/**
+ *  @brief Raw RGBA values and region stats read from an image.
+ *
+ *  @details Values are as decoded by the reader's pixel unpacker, so before
+ *  any colour management. Pixels outside the data window read as zero.
+ */
+struct PixelSamples {
+    [[nodiscard]] utility::JsonStore to_json() const;
+
+    // in the order requested
+    std::vector<std::array<float, 4>> points_;
+    std::vector<PixelRegionStats> regions_;
+    PixelRegionStats data_window_;
+    // set if the image couldn't be sampled
+    std::string error_;
+};
+
+// Read the requested pixels and regions. Points on the same row are decoded
+// together and large regions are split across threads.
+[[nodiscard]] PixelSamples
+sample_pixels(const ImageBufPtr &image, const PixelSampleRequest &request);
+
+} // namespace xstudio::media_reader
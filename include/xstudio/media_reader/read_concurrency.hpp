@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <deque>
+#include <limits>
+#include <map>
+#include <string>
+
+#include "xstudio/utility/chrono.hpp"
+#include "xstudio/utility/json_store.hpp"
+
+namespace xstudio::media_reader {
+
+/**
+ *  @brief Decides how many precache reads each source may have in flight.
+ *
+ *  @details The right number differs a lot between, say, EXRs on local NVMe,
+ *  DPX over NFS and long GOP movies, so rather than a fixed count we measure.
+ *  Reads are sampled in windows of about one read per allowed slot. While a
+ *  source has more work than slots and isn't comfortably ahead of the
+ *  playhead, it is allowed another slot. If the extra slot didn't buy more
+ *  frames per second the source is put back and held there for a while
+ *  before trying again, as the storage or decoder is saturated.
+ *
+ *  Sources are named by the GlobalMediaReaderActor reader key. Not thread
+ *  safe, it lives in one actor.
+ */
+class ReadConcurrency {
+  public:
+    ReadConcurrency(const size_t max_in_flight = 1, const bool adaptive = true);
+
+    // The most reads a source may have in flight, and whether to adapt
+    // below that or always allow it.
+    void set_max_in_flight(const size_t max_in_flight);
+    void set_adaptive(const bool adaptive);
+
+    // Whether source may start another read. A refusal is remembered as
+    // evidence the source could use more slots.
+    bool admit(const std::string &source);
+
+    // A read was started, or has finished in any way.
+    void started(const std::string &source);
+    void finished(const std::string &source);
+
+    // A read that delivered a frame, with when it was needed.
+    void sample(
+        const std::string &source,
+        const utility::time_point &started,
+        const utility::time_point &finished,
+        const utility::time_point &required_by);
+
+    // The reader for source was retired.
+    void forget(const std::string &source);
+
+    [[nodiscard]] size_t max_in_flight() const { return max_in_flight_; }
+    [[nodiscard]] size_t limit(const std::string &source) const;
+    [[nodiscard]] size_t in_flight(const std::string &source) const;
+
+    // Per source limits and measurements, and the recent decisions.
+    [[nodiscard]] utility::JsonStore stats() const;
+
+  private:
+    struct Source {
+        size_t limit_{1};
+        size_t in_flight_{0};
+        // the limit before the last increase, while we see if it helped
+        size_t previous_{0};
+        bool probing_{false};
+        // doubling until an increase doesn't help, then one at a time
+        bool slow_start_{true};
+        // no higher than this until probe_after_ windows have passed
+        size_t ceiling_{0};
+        size_t windows_{0};
+        size_t probe_after_{0};
+        size_t hold_{0};
+        // the window the limit last changed in, the next is left to settle
+        size_t changed_at_{0};
+
+        // the current window
+        size_t reads_{0};
+        size_t late_{0};
+        bool refused_{false};
+        double latency_sum_{0.0};
+        double min_slack_{std::numeric_limits<double>::max()};
+        utility::time_point window_start_;
+        utility::time_point last_finish_;
+
+        // smoothed frames per second at each limit tried
+        std::map<size_t, double> throughput_;
+        double latency_{0.0};
+        size_t total_reads_{0};
+        size_t total_late_{0};
+    };
+
+    struct Decision {
+        std::string source_;
+        size_t from_{0};
+        size_t to_{0};
+        std::string reason_;
+        double throughput_{0.0};
+        double latency_{0.0};
+    };
+
+    Source &source(const std::string &source);
+    void end_window(const std::string &name, Source &source);
+    void change(
+        const std::string &name,
+        Source &source,
+        const size_t limit,
+        const std::string &reason,
+        const double throughput);
+
+    size_t max_in_flight_{1};
+    bool adaptive_{true};
+    std::map<std::string, Source> sources_;
+    std::deque<Decision> decisions_;
+};
+
+} // namespace xstudio::media_reader
@@ -175,7 +175,7 @@ class Attribute {
     template <typename T>
     void set_role_data(const int role, const T &data, const bool owner_notify = true) {
         if (role_data_[role].set(data)) {
-            Attribute::notify_change(role, data, owner_notify);
+            Attribute::notify_change(role, owner_notify);
         }
     }
 
@@ -203,9 +203,9 @@ class Attribute {
     Attribute(
         const std::string &title, const std::string &abbr_title, const std::string &type_name);
 
-    void notify_change(const int r, const nlohmann::json &data, const bool owner_notify);
+    void notify_change(const int r, const bool owner_notify);
 
-    std::map<int, AttributeData> role_data_;
+    AttributeRoleTable role_data_;
 
   private:
     Module *owner_{nullptr};
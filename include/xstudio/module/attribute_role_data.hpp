@@ -9,72 +9,51 @@
 #include <sstream>
 #include <iostream>
 #include <vector>
-#include <any>
+#include <algorithm>
+#include <array>
+#include <limits>
 #include <typeinfo>
-#include <typeindex>
+#include <variant>
 #include <Imath/ImathVec.h>
 
 namespace xstudio::module {
 
-template <class T, class F>
-inline std::pair<const std::type_index, std::function<nlohmann::json(std::any const &)>>
-to_any_to_json(F const &f) {
-    return {std::type_index(typeid(T)), [g = f](std::any const &a) -> nlohmann::json {
-                return g(std::any_cast<T const &>(a));
-            }};
-}
-
 /*
-Map of functions to convert certain types wrapped by std::any to nlohmann::json
+The set of types that AttributeData holds natively. Anything else is stored
+as nlohmann::json. Scalar and small vector types are held inline, so setting
+the value of, say, a float attribute never allocates.
 */
+typedef std::variant<
+    std::monostate,
+    bool,
+    int64_t,
+    float,
+    double,
+    std::string,
+    utility::Uuid,
+    std::array<float, 4>,
+    Imath::V3f,
+    Imath::V4f,
+    utility::ColourTriplet,
+    std::vector<float>,
+    std::vector<int>,
+    std::vector<bool>,
+    std::vector<std::string>,
+    std::vector<utility::Uuid>,
+    nlohmann::json>
+    AttributeValue;
+
+template <typename T, typename V> struct is_variant_member;
+template <typename T, typename... Ts>
+struct is_variant_member<T, std::variant<Ts...>>
+    : std::disjunction<std::is_same<T, Ts>...> {};
+
+template <typename T>
+inline constexpr bool is_attribute_value_type = is_variant_member<T, AttributeValue>::value;
 
-inline const std::
-    unordered_map<std::type_index, std::function<nlohmann::json(std::any const &)>> &
-    any_to_json() {
-
-    static std::unordered_map<std::type_index, std::function<nlohmann::json(std::any const &)>>
-        _any_to_json{
-            to_any_to_json<nlohmann::json>(
-                [](nlohmann::json x) -> nlohmann::json { return x; }),
-            to_any_to_json<int64_t>(
-                [](int64_t x) -> nlohmann::json { return nlohmann::json(x); }),
-            to_any_to_json<float>([](float x) -> nlohmann::json { return nlohmann::json(x); }),
-            to_any_to_json<double>(
-                [](double x) -> nlohmann::json { return nlohmann::json(x); }),
-            to_any_to_json<bool>([](bool x) -> nlohmann::json { return nlohmann::json(x); }),
-            to_any_to_json<utility::Uuid>(
-                [](utility::Uuid x) -> nlohmann::json { return nlohmann::json(x); }),
-            to_any_to_json<std::string>(
-                [](std::string x) -> nlohmann::json { return nlohmann::json(x); }),
-            to_any_to_json<std::array<float, 4>>(
-                [](std::array<float, 4> x) -> nlohmann::json { return nlohmann::json(x); }),
-            to_any_to_json<Imath::V3f>([](Imath::V3f x) -> nlohmann::json {
-                return nlohmann::json{"vec3", 1, x.x, x.y, x.z};
-            }),
-            to_any_to_json<Imath::V4f>([](Imath::V4f x) -> nlohmann::json {
-                return nlohmann::json{"vec4", 1, x.x, x.y, x.z, x.w};
-            }),
-            to_any_to_json<utility::ColourTriplet>(
-                [](utility::ColourTriplet x) -> nlohmann::json {
-                    return nlohmann::json{"colour", 1, x.r, x.g, x.b};
-                }),
-            to_any_to_json<std::vector<float>>(
-                [](std::vector<float> x) -> nlohmann::json { return nlohmann::json(x); }),
-            to_any_to_json<std::vector<int>>(
-                [](std::vector<int> x) -> nlohmann::json { return nlohmann::json(x); }),
-            to_any_to_json<std::vector<bool>>(
-                [](std::vector<bool> x) -> nlohmann::json { return nlohmann::json(x); }),
-            to_any_to_json<std::vector<std::string>>(
-                [](std::vector<std::string> x) -> nlohmann::json { return nlohmann::json(x); }),
-            to_any_to_json<std::vector<utility::Uuid>>(
-                [](std::vector<utility::Uuid> x) -> nlohmann::json {
-                    return nlohmann::json(x);
-                }),
-        };
-    return _any_to_json;
-}
 /*
-    Class using 'type erasure' pattern to handle multiple types of data via std::any
+    Class holding role data of one of the types in AttributeValue. Conversion
+    to json only happens when the data is sent out to the UI or Python layers.
 */
 class AttributeData {
 
@@ -83,70 +62,86 @@ class AttributeData {
 
     AttributeData(const AttributeData &) = default;
 
-    template <typename T> AttributeData(const T &d) : data_(d) {}
+    template <typename T> AttributeData(const T &d) { set(d); }
 
     template <typename T> [[nodiscard]] const T get() const {
-        try {
-
-            return std::any_cast<T>(data_);
 
-        } catch ([[maybe_unused]] std::exception &e) {
+        if constexpr (is_attribute_value_type<T>) {
+            if (const T *v = std::get_if<T>(&data_))
+                return *v;
+        }
 
-            // may request, say, T=std::vector<std::string> ... data_ is
-            // json, but json that CAN be cast to std::vector<std::string>
-            if (data_.type() == typeid(nlohmann::json)) {
-                try {
+        // may request, say, T=std::vector<std::string> ... data_ is
+        // json, but json that CAN be cast to std::vector<std::string>
+        if (const auto *j = std::get_if<nlohmann::json>(&data_)) {
+            try {
 
-                    return std::any_cast<nlohmann::json>(data_).get<T>();
+                return j->get<T>();
 
-                } catch ([[maybe_unused]] std::exception &e2) {
-                }
+            } catch ([[maybe_unused]] std::exception &e2) {
             }
-            spdlog::warn(
-                "{} Attempt to get AttributeData with type {} as type {}",
-                __PRETTY_FUNCTION__,
-                data_.type().name(),
-                typeid(T).name());
-            throw;
         }
+        spdlog::warn(
+            "{} Attempt to get AttributeData with type {} as type {}",
+            __PRETTY_FUNCTION__,
+            type_name(),
+            typeid(T).name());
+        throw std::bad_variant_access();
+    }
+
+    [[nodiscard]] bool has_value() const {
+        return !std::holds_alternative<std::monostate>(data_);
+    }
+
+    [[nodiscard]] const char *type_name() const {
+        return std::visit([](const auto &v) { return typeid(v).name(); }, data_);
     }
 
     template <typename T> bool __set(const T &v) { // NOLINT
-        if (data_.has_value() && typeid(v) != data_.type()) {
 
-            if (data_.type() == typeid(nlohmann::json)) {
+        if constexpr (!is_attribute_value_type<T>) {
+
+            // not a type that we hold natively - go via json
+            return set(nlohmann::json(v));
+
+        } else {
+
+            if (has_value() && !std::holds_alternative<T>(data_)) {
+
+                if (auto *j = std::get_if<nlohmann::json>(&data_)) {
 
-                try {
-                    const auto j = nlohmann::json(v);
-                    if (j != std::any_cast<nlohmann::json>(data_)) {
-                        data_ = j;
-                        return true;
+                    try {
+                        auto nj = nlohmann::json(v);
+                        if (nj != *j) {
+                            *j = std::move(nj);
+                            return true;
+                        }
+                        return false;
+                    } catch ([[maybe_unused]] std::exception &e2) {
                     }
-                    return false;
-                } catch ([[maybe_unused]] std::exception &e2) {
                 }
-            }
-            spdlog::warn(
-                "{} Attempt to set AttributeData with type {} with data of type {} and "
-                "value {}",
-                __PRETTY_FUNCTION__,
-                data_.type().name(),
-                typeid(v).name(),
-                to_json().dump());
+                spdlog::warn(
+                    "{} Attempt to set AttributeData with type {} with data of type {} and "
+                    "value {}",
+                    __PRETTY_FUNCTION__,
+                    type_name(),
+                    typeid(v).name(),
+                    to_json().dump());
 
-            return false;
+                return false;
 
-        } else if ((data_.has_value() && get<T>() != v) || !data_.has_value()) {
-            data_ = v;
-            return true;
+            } else if (!has_value() || std::get<T>(data_) != v) {
+                data_.emplace<T>(v);
+                return true;
+            }
+            return false;
         }
-        return false;
     }
 
     template <typename T> bool set(const T &v) { return __set(v); }
 
     bool set(const std::string &data) {
-        if (typeid(utility::Uuid) == data_.type()) {
+        if (std::holds_alternative<utility::Uuid>(data_)) {
             return set(utility::Uuid(data));
         } else {
             return __set(data);
@@ -159,10 +154,12 @@ class AttributeData {
 
     bool set(const nlohmann::json &data) {
 
+        const bool holds_json = std::holds_alternative<nlohmann::json>(data_);
+
         bool rt = false;
         if (data.is_string()) {
 
-            if (typeid(utility::Uuid) == data_.type()) {
+            if (std::holds_alternative<utility::Uuid>(data_)) {
                 rt = set(utility::Uuid(data.get<std::string>()));
             } else {
                 rt = set(data.get<std::string>());
@@ -186,13 +183,11 @@ class AttributeData {
 
             rt = set(data.get<utility::ColourTriplet>());
 
-        } else if (
-            (data.is_array() || data.is_object()) &&
-            (data_.type() == typeid(nlohmann::json) || data_.type() == typeid(void))) {
+        } else if ((data.is_array() || data.is_object()) && (holds_json || !has_value())) {
 
-            if (data_.type() == typeid(void) || get<nlohmann::json>() != data) {
-                data_ = data;
-                rt    = true;
+            if (!has_value() || std::get<nlohmann::json>(data_) != data) {
+                data_.emplace<nlohmann::json>(data);
+                rt = true;
             }
 
         } else if (data.is_array() && data.size() && data.begin().value().is_string()) {
@@ -231,17 +226,17 @@ class AttributeData {
             rt = set(data.get<int64_t>());
         } else if (data.is_number_float()) {
             rt = set(data.get<float>());
-        } else if (data_.type() == typeid(nlohmann::json) && get<nlohmann::json>() != data) {
-            data_ = data;
-            rt    = true;
-        } else if (!data_.has_value()) {
-            data_ = data;
-            rt    = true;
+        } else if (holds_json && std::get<nlohmann::json>(data_) != data) {
+            data_.emplace<nlohmann::json>(data);
+            rt = true;
+        } else if (!has_value()) {
+            data_.emplace<nlohmann::json>(data);
+            rt = true;
         } else if (data.is_null()) {
             rt = true;
         } else {
             std::stringstream msg;
-            msg << "Attribute role data is type " << data_.type().name()
+            msg << "Attribute role data is type " << type_name()
                 << " doesn't match incoming data.";
             throw std::runtime_error(msg.str().c_str());
         }
@@ -251,19 +246,20 @@ class AttributeData {
     // not pretty, must be a better way of letting an int64_t set a float and vice versa
     // without violating type checking
     bool set(const float &v) {
-        if (data_.has_value()) {
-            if (data_.type() == typeid(float) && get<float>() != v) {
+        if (has_value()) {
+            if (const auto *f = std::get_if<float>(&data_); f && *f != v) {
                 data_ = v;
                 return true;
-            } else if (data_.type() == typeid(int64_t) && get<int64_t>() != (int64_t)v) {
+            } else if (const auto *i = std::get_if<int64_t>(&data_); i && *i != (int64_t)v) {
                 data_ = (int64_t)v;
                 return true;
-            } else if (!(data_.type() == typeid(int64_t) || data_.type() == typeid(float))) {
+            } else if (!(std::holds_alternative<int64_t>(data_) ||
+                         std::holds_alternative<float>(data_))) {
                 spdlog::warn(
                     "{} Attempt to set AttributeData with type {} with data of type {} "
                     "and value {}",
                     __PRETTY_FUNCTION__,
-                    data_.type().name(),
+                    type_name(),
                     typeid(v).name(),
                     v);
             }
@@ -276,19 +272,20 @@ class AttributeData {
     bool set(const int v) { return set(int64_t(v)); }
 
     bool set(const int64_t &v) {
-        if (data_.has_value()) {
-            if (data_.type() == typeid(float) && get<float>() != (float)v) {
+        if (has_value()) {
+            if (const auto *f = std::get_if<float>(&data_); f && *f != (float)v) {
                 data_ = (float)v;
                 return true;
-            } else if (data_.type() == typeid(int64_t) && get<int64_t>() != v) {
+            } else if (const auto *i = std::get_if<int64_t>(&data_); i && *i != v) {
                 data_ = v;
                 return true;
-            } else if (!(data_.type() == typeid(int64_t) || data_.type() == typeid(float))) {
+            } else if (!(std::holds_alternative<int64_t>(data_) ||
+                         std::holds_alternative<float>(data_))) {
                 spdlog::warn(
                     "{} Attempt to set AttributeData with type {} with data of type {} "
                     "and value {}",
                     __PRETTY_FUNCTION__,
-                    data_.type().name(),
+                    type_name(),
                     typeid(v).name(),
                     v);
             }
@@ -304,21 +301,100 @@ class AttributeData {
     }
 
     [[nodiscard]] inline nlohmann::json to_json() const {
-        if (data_.has_value()) {
-            auto atj = any_to_json();
-            if (const auto it = atj.find(std::type_index(data_.type())); it != atj.cend()) {
-                return it->second(data_);
-            } else {
-                spdlog::warn(
-                    "{} Unregistered type {}", __PRETTY_FUNCTION__, data_.type().name());
-            }
-        }
+        return std::visit(
+            [](const auto &v) -> nlohmann::json {
+                using V = std::decay_t<decltype(v)>;
+                if constexpr (std::is_same_v<V, std::monostate>) {
+                    return {};
+                } else if constexpr (std::is_same_v<V, Imath::V3f>) {
+                    return nlohmann::json{"vec3", 1, v.x, v.y, v.z};
+                } else if constexpr (std::is_same_v<V, Imath::V4f>) {
+                    return nlohmann::json{"vec4", 1, v.x, v.y, v.z, v.w};
+                } else if constexpr (std::is_same_v<V, utility::ColourTriplet>) {
+                    return nlohmann::json{"colour", 1, v.r, v.g, v.b};
+                } else {
+                    return nlohmann::json(v);
+                }
+            },
+            data_);
+    }
 
-        return {};
+  private:
+    AttributeValue data_;
+};
+
+/*
+Role data for an Attribute, held inline in one vector with a small table
+from role to position, so looking a role up is a single index. Roles past
+the table are few and found by a scan. Adding or removing a role may move
+the others, so don't keep references across that.
+*/
+class AttributeRoleTable {
+
+  public:
+    typedef std::pair<int, AttributeData> Entry;
+    typedef std::vector<Entry>::iterator iterator;
+    typedef std::vector<Entry>::const_iterator const_iterator;
+
+    AttributeData &operator[](const int role) {
+        if (const auto i = index(role); i != npos)
+            return entries_[i].second;
+        set_index(role, entries_.size());
+        entries_.emplace_back(role, AttributeData());
+        return entries_.back().second;
     }
 
+    [[nodiscard]] iterator find(const int role) {
+        const auto i = index(role);
+        return i == npos ? entries_.end() : entries_.begin() + i;
+    }
+
+    [[nodiscard]] const_iterator find(const int role) const {
+        const auto i = index(role);
+        return i == npos ? entries_.end() : entries_.begin() + i;
+    }
+
+    // the last role takes the place of the one erased
+    iterator erase(const_iterator p) {
+        const auto i = size_t(p - entries_.cbegin());
+        set_index(p->first, npos);
+        if (i + 1 != entries_.size()) {
+            entries_[i] = std::move(entries_.back());
+            set_index(entries_[i].first, i);
+        }
+        entries_.pop_back();
+        return entries_.begin() + i;
+    }
+
+    [[nodiscard]] iterator begin() { return entries_.begin(); }
+    [[nodiscard]] iterator end() { return entries_.end(); }
+    [[nodiscard]] const_iterator begin() const { return entries_.begin(); }
+    [[nodiscard]] const_iterator end() const { return entries_.end(); }
+    [[nodiscard]] size_t size() const { return entries_.size(); }
+    [[nodiscard]] bool empty() const { return entries_.empty(); }
+
   private:
-    std::any data_;
+    // covers the roles Attribute defines
+    static constexpr int indexed_roles = 64;
+    static constexpr size_t npos       = std::numeric_limits<size_t>::max();
+
+    [[nodiscard]] size_t index(const int role) const {
+        if (role >= 0 and role < indexed_roles)
+            return slots_[role] ? size_t(slots_[role] - 1) : npos;
+        for (size_t i = 0; i < entries_.size(); ++i)
+            if (entries_[i].first == role)
+                return i;
+        return npos;
+    }
+
+    void set_index(const int role, const size_t i) {
+        if (role >= 0 and role < indexed_roles)
+            slots_[role] = i == npos ? 0 : uint16_t(i + 1);
+    }
+
+    std::vector<Entry> entries_;
+    // position + 1 of each role in entries_, 0 if it has none
+    std::array<uint16_t, indexed_roles> slots_{};
 };
 
 } // namespace xstudio::module
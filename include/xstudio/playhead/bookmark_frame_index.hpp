@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "xstudio/bookmark/bookmark.hpp"
+#include "xstudio/media/media.hpp"
+#include "xstudio/utility/uuid.hpp"
+
+namespace xstudio::playhead {
+
+// bookmark uuid, colour, first and last logical (playhead) frame
+typedef std::vector<std::tuple<utility::Uuid, std::string, int, int>> BookmarkRanges;
+
+/**
+ *  @brief The playhead timeline described as runs of logical frames that
+ *  show consecutive frames of one piece of media.
+ *
+ *  @details Built once, frame by frame, whenever the playhead timeline is
+ *  rebuilt. Working out where bookmarks land on the timeline is then done
+ *  per segment rather than per frame, so it scales with the number of clips
+ *  rather than the number of frames.
+ */
+class MediaSegments {
+  public:
+    struct Segment {
+        utility::Uuid media_uuid_;
+        int logical_start_ = {0};
+        int media_start_   = {0};
+        int length_        = {0};
+    };
+
+    void clear() { segments_.clear(); }
+
+    // Add the next logical frame of the timeline. nullptr for an empty frame.
+    void add_frame(const int logical_frame, const media::AVFrameID *frame);
+
+    // The logical frame ranges covered by each bookmark, given the bookmarks
+    // for each piece of media. A bookmark on media that appears more than once
+    // in the timeline gets a range for each appearance.
+    [[nodiscard]] BookmarkRanges bookmark_ranges(
+        const std::map<utility::Uuid, std::vector<bookmark::BookmarkDetail>> &bookmarks) const;
+
+    [[nodiscard]] const std::vector<Segment> &segments() const { return segments_; }
+
+  private:
+    std::vector<Segment> segments_;
+};
+
+/**
+ *  @brief Static interval tree over bookmarks' logical frame ranges, for
+ *  looking up the bookmarks on a given frame.
+ *
+ *  @details Bookmarks are sorted by start frame and each node of the implicit
+ *  binary tree over that array stores the maximum end frame in its subtree,
+ *  so a lookup costs O(log n + number of hits).
+ */
+class BookmarkFrameIndex {
+  public:
+    void build(const bookmark::BookmarkAndAnnotations &bookmarks);
+
+    void clear();
+
+    // bookmarks that include frame, ordered by start frame
+    [[nodiscard]] bookmark::BookmarkAndAnnotations at_frame(const int frame) const;
+
+    [[nodiscard]] bool empty() const { return bookmarks_.empty(); }
+
+  private:
+    int build_node(const size_t begin, const size_t end);
+    void collect(
+        const size_t begin,
+        const size_t end,
+        const int frame,
+        bookmark::BookmarkAndAnnotations &result) const;
+
+    bookmark::BookmarkAndAnnotations bookmarks_;
+    std::vector<int> max_end_frame_;
+};
+
+} // namespace xstudio::playhead
@@ -2,12 +2,15 @@
 #pragma once
 
 #include <caf/all.hpp>
+#include <deque>
 // #include <chrono>
 
 #include "xstudio/audio/audio_output.hpp"
 #include "xstudio/colour_pipeline/colour_pipeline.hpp"
+#include "xstudio/media/lookahead_window.hpp"
 #include "xstudio/media/media.hpp"
 #include "xstudio/media_reader/media_reader.hpp"
+#include "xstudio/playhead/bookmark_frame_index.hpp"
 #include "xstudio/utility/chrono.hpp"
 #include "xstudio/utility/json_store.hpp"
 #include "xstudio/utility/timecode.hpp"
@@ -79,6 +82,12 @@ class SubPlayhead : public caf::event_based_actor {
 
     void update_playback_precache_requests(caf::typed_response_promise<bool> &rp);
 
+    media::FrameTimeMap::iterator lookahead_start_frame(const timebase::flicks headroom);
+
+    media::AVFrameIDsAndTimePointsDelta move_precache_window();
+
+    [[nodiscard]] media::AVFrameIDsAndTimePoints precache_window_requests() const;
+
     void make_static_precache_request(
         caf::typed_response_promise<bool> &rp, const bool start_precache);
 
@@ -114,13 +123,6 @@ class SubPlayhead : public caf::event_based_actor {
 
     void set_in_and_out_frames();
 
-    typedef std::vector<std::tuple<utility::Uuid, std::string, int, int>> BookmarkRanges;
-
-    void extend_bookmark_frame(
-        const bookmark::BookmarkDetail &detail,
-        const int logical_playhead_frame,
-        BookmarkRanges &bookmark_ranges);
-
     void full_bookmarks_update(caf::typed_response_promise<bool> done);
 
     void fetch_bookmark_annotations(
@@ -188,14 +190,36 @@ class SubPlayhead : public caf::event_based_actor {
     media::MediaType media_type_;
     std::shared_ptr<const media::AVFrameID> previous_frame_;
     utility::UuidSet all_media_uuids_;
+    media::LookaheadWindow precache_window_;
+
+    // The playback precache window as the frames that were stepped through to
+    // build it, so that it can be moved along with the playhead rather than
+    // rebuilt every update. Offsets are from when the window was first built,
+    // at the playback velocity.
+    struct PrecacheStep {
+        media::FrameTimeMap::iterator frame_;
+        std::chrono::microseconds offset_;
+        bool requested_;
+    };
+    std::deque<PrecacheStep> precache_steps_;
+    media::FrameTimeMap::iterator precache_start_;
+    utility::time_point precache_start_time_;
+    std::chrono::microseconds precache_origin_ = {0};
+    size_t precache_num_requested_             = {0};
+    std::shared_ptr<const media::AVFrameID> precache_last_requested_;
+    bool precache_forwards_                    = {true};
+    float precache_velocity_                   = {1.0f};
+    bool precache_steps_valid_                 = {false};
 
     std::map<timebase::flicks, int> logical_frames_;
     media::FrameTimeMap full_timeline_frames_;
     media::FrameTimeMap retimed_frames_;
     media::FrameTimeMap::iterator in_frame_, out_frame_, first_frame_, last_frame_;
     xstudio::bookmark::BookmarkAndAnnotations bookmarks_;
+    BookmarkFrameIndex bookmark_index_;
     BookmarkRanges bookmark_ranges_;
     std::vector<int> media_ranges_;
+    MediaSegments media_segments_;
 
     typedef std::pair<media_reader::ImageBufPtr, colour_pipeline::ColourPipelineDataPtr>
         ImageAndLut;
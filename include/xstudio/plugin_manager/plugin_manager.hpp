@@ -1,10 +1,13 @@
 // SPDX-License-Identifier: Apache-2.0
 #pragma once
 
+#include <algorithm>
 #include <list>
 #include <string>
+#include <vector>
 
 #include "xstudio/plugin_manager/plugin_factory.hpp"
+#include "xstudio/utility/helpers.hpp"
 
 namespace xstudio::plugin_manager {
 
@@ -67,6 +70,33 @@ class PluginDetail {
     }
 };
 
+// Name and version of each enabled plugin of the given type, plus the
+// (optional) preferences that configure them. Identifies the plugins that
+// produced some data, so that cached data can be invalidated when plugins
+// are upgraded, added, removed or reconfigured.
+inline std::string plugin_fingerprint(
+    const std::vector<PluginDetail> &details,
+    const PluginType type,
+    const nlohmann::json &prefs = nlohmann::json()) {
+    std::vector<std::string> items;
+    for (const auto &i : details) {
+        if (i.enabled_ && (i.type_ & type))
+            items.push_back(i.name_ + "@" + i.version_.to_string());
+    }
+    std::sort(items.begin(), items.end());
+
+    std::string result;
+    for (const auto &i : items)
+        result += i + ";";
+    // the hash is persisted with the cached data, so it must not change
+    // between builds (std::hash may)
+    if (!prefs.is_null()) {
+        const auto dump = prefs.dump();
+        result += fmt::format("{:016x}", utility::hash_bytes(dump.data(), dump.size()));
+    }
+    return result;
+}
+
 class PluginManager {
   public:
     PluginManager(std::list<std::string> plugin_paths = std::list<std::string>());
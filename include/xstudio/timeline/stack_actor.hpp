@@ -64,6 +64,8 @@ class StackActor : public caf::event_based_actor {
 
   private:
     Stack base_;
+    // passed down to the tracks, see TrackActor
+    bool lightweight_{false};
     std::map<utility::Uuid, caf::actor> actors_;
     // might need to prune.. ?
     std::set<utility::Uuid> events_processed_;
@@ -3,6 +3,8 @@
 
 #include <caf/all.hpp>
 
+#include <atomic>
+
 #include "xstudio/timeline/timeline.hpp"
 #include "xstudio/utility/notification_handler.hpp"
 #include "xstudio/json_store/json_store_handler.hpp"
@@ -27,8 +29,13 @@ class TimelineActor : public caf::event_based_actor {
 
     static caf::message_handler default_event_handler();
 
+    // gaps and clips of timelines made after this is set are kept as items, see
+    // TrackActor, item_lightweight_atom changes it for one timeline
+    static void set_lightweight_items(const bool value) { lightweight_items_default_ = value; }
+
   private:
     inline static const std::string NAME = "TimelineActor";
+    inline static std::atomic<bool> lightweight_items_default_{false};
     void init();
 
     caf::message_handler message_handler();
@@ -118,6 +125,7 @@ class TimelineActor : public caf::event_based_actor {
 
     caf::actor_addr playlist_;
     bool content_changed_{false};
+    bool lightweight_items_{lightweight_items_default_};
     utility::UuidActor playhead_;
     // might need to prune.. ?
     std::set<utility::Uuid> events_processed_;
@@ -48,6 +48,27 @@ class TrackActor : public caf::event_based_actor {
     void deserialise();
     void item_event_callback(const utility::JsonStore &event, Item &item);
 
+    // actor of a child, spawning one for a lightweight gap or clip
+    caf::actor materialise(const utility::Uuid &uuid);
+    // spawn actors for all the lightweight clips, returns the address updates
+    utility::JsonStore materialise_clips();
+    // keep a child added from its serialisation as an item
+    void keep_lightweight(Item &item, const utility::JsonStore &value);
+    [[nodiscard]] bool is_lightweight(const Item &item) const;
+    [[nodiscard]] utility::JsonStore lightweight_serialise(const Item &item) const;
+    utility::UuidActor duplicate_lightweight(const Item &item);
+    void link_clip_media(const caf::actor &clip, const utility::Uuid &media_uuid);
+    utility::JsonStore serialise_child(caf::scoped_actor &sys, const Item &item);
+    std::pair<Item, utility::JsonStore> make_gap(
+        caf::scoped_actor &sys,
+        const std::string &name,
+        const utility::FrameRateDuration &duration);
+    void split_lightweight_item(
+        caf::typed_response_promise<utility::JsonStore> rp,
+        const Items::const_iterator &itemit,
+        const utility::FrameRange &range1,
+        const utility::FrameRange &range2);
+
     void split_item(
         caf::typed_response_promise<utility::JsonStore> rp,
         const Items::const_iterator &item,
@@ -121,6 +142,12 @@ class TrackActor : public caf::event_based_actor {
 
   private:
     Track base_;
+    // Gaps and clips are kept as plain items, with no actor, until one is
+    // asked for with item_actor_atom. Set by the timeline, see TimelineActor.
+    bool lightweight_{false};
+    // what a ClipActor would hold for a lightweight clip, media isn't kept alive by us
+    std::map<utility::Uuid, caf::actor_addr> media_;
+    std::map<utility::Uuid, utility::FrameRate> media_rates_;
     std::map<utility::Uuid, caf::actor> actors_;
     // might need to prune.. ?
     std::set<utility::Uuid> events_processed_;
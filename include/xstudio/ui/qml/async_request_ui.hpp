@@ -0,0 +1,332 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <caf/all.hpp>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+CAF_PUSH_WARNINGS
+#include <QFuture>
+#include <QObject>
+#include <QPersistentModelIndex>
+#include <QPointer>
+#include <QPromise>
+CAF_POP_WARNINGS
+
+#include "xstudio/atoms.hpp"
+#include "xstudio/utility/logging.hpp"
+
+#include "helper_qml_export.h"
+
+// Record the time the Qt thread spends in the enclosing scope against the
+// enclosing function, see BlockedCallMonitor.
+#define BLOCKED_CALL_WATCHER()                                                                 \
+    xstudio::ui::qml::BlockedCallTimer _blocked_call_timer(__PRETTY_FUNCTION__);
+
+namespace xstudio::ui::qml {
+
+struct BlockedCallStats {
+    std::string site_;
+    size_t count_{0};
+    double total_{0.0};
+    double max_{0.0};
+};
+
+/**
+ *  @brief Time spent by the Qt thread blocked waiting on actors, per call
+ *  site.
+ *
+ *  @details Filled in by BLOCKED_CALL_WATCHER, so the calls that still
+ *  request_receive on the Qt thread can be found and kept track of. Calls
+ *  longer than the warn threshold are also logged as they happen.
+ */
+class HELPER_QML_EXPORT BlockedCallMonitor {
+  public:
+    static BlockedCallMonitor &instance();
+
+    // site must outlive the monitor, it's keyed by address
+    void record(const char *site, const double seconds);
+
+    // worst total first
+    [[nodiscard]] std::vector<BlockedCallStats> stats() const;
+    void reset();
+
+    [[nodiscard]] double warn_threshold() const { return warn_threshold_; }
+    void set_warn_threshold(const double seconds) { warn_threshold_ = seconds; }
+
+  private:
+    BlockedCallMonitor() = default;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<const char *, BlockedCallStats> stats_;
+    std::atomic<double> warn_threshold_{0.25};
+};
+
+class HELPER_QML_EXPORT BlockedCallTimer {
+  public:
+    BlockedCallTimer(const char *site);
+    ~BlockedCallTimer();
+
+  private:
+    const char *site_;
+    // only calls on the Qt thread block the UI
+    const bool gui_thread_;
+    spdlog::stopwatch sw_;
+};
+
+/**
+ *  @brief Requests to actors made from the Qt thread without blocking it.
+ *
+ *  @details Each request is sent from a short lived actor and the response
+ *  is delivered back on the context object's thread, through the callback
+ *  and the returned future. A callback tied to a model index is dropped if
+ *  the index has gone by the time the response arrives.
+ *
+ *  Requests with a (non empty) key are sent one at a time per key. A
+ *  request made while another with its key is in flight waits for it, and
+ *  is sent once it has been answered:
+ *  - request() joins the one waiting, if any, so a burst of requests for
+ *    the same state sends two, the last answered after the last change.
+ *  - replace() cancels the one in flight and the one waiting, only the
+ *    newest is sent, after the one in flight so the receiver sees them in
+ *    order.
+ *
+ *  The owner of the context must own this, or outlive it.
+ */
+class HELPER_QML_EXPORT AsyncRequests {
+  public:
+    AsyncRequests(QObject *context) : context_(context) {}
+    virtual ~AsyncRequests() { cancel_all(); }
+
+    template <typename R, typename F, typename... Ts>
+    QFuture<R> request(
+        const std::string &key,
+        const QPersistentModelIndex &index,
+        F &&on_result,
+        caf::actor_system &system,
+        const caf::actor &dest,
+        Ts... args) {
+        return send<R>(
+            key,
+            false,
+            index,
+            std::forward<F>(on_result),
+            system,
+            dest,
+            std::move(args)...);
+    }
+
+    template <typename R, typename F, typename... Ts>
+    QFuture<R> request(
+        const std::string &key,
+        F &&on_result,
+        caf::actor_system &system,
+        const caf::actor &dest,
+        Ts... args) {
+        return send<R>(
+            key,
+            false,
+            QPersistentModelIndex(),
+            std::forward<F>(on_result),
+            system,
+            dest,
+            std::move(args)...);
+    }
+
+    // For setters, where only the newest value matters.
+    template <typename R, typename F, typename... Ts>
+    QFuture<R> replace(
+        const std::string &key,
+        F &&on_result,
+        caf::actor_system &system,
+        const caf::actor &dest,
+        Ts... args) {
+        return send<R>(
+            key,
+            true,
+            QPersistentModelIndex(),
+            std::forward<F>(on_result),
+            system,
+            dest,
+            std::move(args)...);
+    }
+
+    // The response to a cancelled request is dropped, its future is cancelled.
+    void cancel(const std::string &key);
+    // Cancel requests whose callbacks are all tied to indexes that have gone.
+    void cancel_invalid();
+    void cancel_all();
+
+    [[nodiscard]] size_t in_flight() const { return in_flight_.size(); }
+    [[nodiscard]] size_t waiting() const { return waiting_.size(); }
+
+  private:
+    // the index a callback is tied to, if any
+    struct Target {
+        Target(const QPersistentModelIndex &index) : tied_(index.isValid()), index_(index) {}
+        [[nodiscard]] bool wanted() const { return not tied_ or index_.isValid(); }
+
+        bool tied_;
+        QPersistentModelIndex index_;
+    };
+
+    struct Pending {
+        virtual ~Pending() = default;
+        virtual void cancel() = 0;
+
+        [[nodiscard]] bool wanted() const {
+            return std::any_of(
+                targets_.begin(), targets_.end(), [](const auto &i) { return i.wanted(); });
+        }
+
+        bool cancelled_{false};
+        // one per callback
+        std::vector<Target> targets_;
+        // sends the request, the newest asked for if it's waiting
+        std::function<void()> send_;
+    };
+
+    template <typename R> struct TypedPending : public Pending {
+        void cancel() override {
+            if (cancelled_)
+                return;
+            cancelled_ = true;
+            promise_.future().cancel();
+            promise_.finish();
+            callbacks_.clear();
+        }
+
+        QPromise<R> promise_;
+        std::vector<std::function<void(const R &)>> callbacks_;
+    };
+
+    template <typename R, typename F, typename... Ts>
+    QFuture<R> send(
+        const std::string &key,
+        const bool replace,
+        const QPersistentModelIndex &index,
+        F &&on_result,
+        caf::actor_system &system,
+        const caf::actor &dest,
+        Ts... args);
+
+    void finished(const std::string &key, const std::shared_ptr<Pending> &pending);
+    // send the request waiting on key, if any
+    void send_waiting(const std::string &key);
+
+    QObject *context_;
+    std::unordered_map<std::string, std::shared_ptr<Pending>> in_flight_;
+    std::unordered_map<std::string, std::shared_ptr<Pending>> waiting_;
+};
+
+template <typename R, typename F, typename... Ts>
+QFuture<R> AsyncRequests::send(
+    const std::string &key,
+    const bool replace,
+    const QPersistentModelIndex &index,
+    F &&on_result,
+    caf::actor_system &system,
+    const caf::actor &dest,
+    Ts... args) {
+
+    if (not dest) {
+        QPromise<R> promise;
+        promise.start();
+        promise.setException(std::make_exception_ptr(XStudioError("Request to invalid actor")));
+        promise.finish();
+        return promise.future();
+    }
+
+    const auto busy = not key.empty() and in_flight_.count(key);
+
+    if (busy) {
+        auto it = waiting_.find(key);
+        if (it != waiting_.end()) {
+            auto pending = std::dynamic_pointer_cast<TypedPending<R>>(it->second);
+            if (pending and not replace) {
+                pending->targets_.emplace_back(index);
+                pending->callbacks_.emplace_back(std::forward<F>(on_result));
+                return pending->promise_.future();
+            }
+            it->second->cancel();
+            waiting_.erase(it);
+        }
+        // superseded, but its response is still waited for before the next is sent
+        if (replace)
+            in_flight_[key]->cancel();
+    }
+
+    auto pending = std::make_shared<TypedPending<R>>();
+    pending->targets_.emplace_back(index);
+    pending->callbacks_.emplace_back(std::forward<F>(on_result));
+    pending->promise_.start();
+    auto future = pending->promise_.future();
+
+    // weak, as pending holds it
+    pending->send_ = [this,
+                      key,
+                      weak    = std::weak_ptr<TypedPending<R>>(pending),
+                      context = QPointer<QObject>(context_),
+                      sys     = &system,
+                      dest,
+                      args...]() {
+        auto pending = weak.lock();
+        if (not pending)
+            return;
+
+        // delivery is queued on the context, so nothing runs if it's gone
+        auto deliver = [this, context, key, pending](std::function<void()> f) {
+            if (context)
+                QMetaObject::invokeMethod(
+                    context.data(),
+                    [this, key, pending, f = std::move(f)]() {
+                        if (not pending->cancelled_)
+                            f();
+                        finished(key, pending);
+                    },
+                    Qt::QueuedConnection);
+        };
+
+        sys->spawn([=](caf::event_based_actor *self) {
+            self->mail(args...)
+                .request(dest, caf::infinite)
+                .then(
+                    [=](const R &result) {
+                        deliver([=]() {
+                            pending->promise_.addResult(result);
+                            pending->promise_.finish();
+                            for (size_t i = 0; i < pending->callbacks_.size(); ++i) {
+                                if (pending->targets_[i].wanted())
+                                    pending->callbacks_[i](result);
+                            }
+                        });
+                    },
+                    [=](const caf::error &err) {
+                        deliver([=]() {
+                            spdlog::warn("Async request {} failed {}", key, to_string(err));
+                            pending->promise_.setException(
+                                std::make_exception_ptr(XStudioError(err)));
+                            pending->promise_.finish();
+                        });
+                    });
+        });
+    };
+
+    if (busy) {
+        waiting_[key] = pending;
+    } else {
+        if (not key.empty())
+            in_flight_[key] = pending;
+        pending->send_();
+    }
+
+    return future;
+}
+
+} // namespace xstudio::ui::qml
@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <caf/all.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+CAF_PUSH_WARNINGS
+#include <QVariant>
+CAF_POP_WARNINGS
+
+#include "xstudio/utility/tree.hpp"
+
+#include "helper_qml_export.h"
+
+namespace xstudio::ui::qml {
+
+/**
+ *  @brief Cache of the values a JSONTreeModel returns from data() for its
+ *  most used roles, so they aren't rebuilt from the json on every call.
+ *
+ *  @details Each cached role is a column and each row (tree node) gets a
+ *  slot in every column the first time one of its values is stored, so a
+ *  lookup is one hash of the node pointer plus an array index. The model
+ *  owns the invalidation: rows must be invalidated when their json changes
+ *  and before their nodes are destroyed.
+ */
+class HELPER_QML_EXPORT JSONTreeRowCache {
+  public:
+    // at most 64 roles
+    JSONTreeRowCache(const std::vector<int> &roles = {});
+    virtual ~JSONTreeRowCache() = default;
+
+    void set_roles(const std::vector<int> &roles);
+
+    [[nodiscard]] bool is_cached_role(const int role) const { return column(role) >= 0; }
+
+    // nullptr if not cached
+    [[nodiscard]] const QVariant *find(const utility::JsonTree *node, const int role) const;
+
+    void store(const utility::JsonTree *node, const int role, const QVariant &value);
+
+    // forget the values for node and, if recursive, all its descendants
+    void invalidate(const utility::JsonTree *node, const bool recursive = false);
+    void clear();
+
+    [[nodiscard]] size_t size() const { return slots_.size(); }
+    [[nodiscard]] size_t hits() const { return hits_; }
+    [[nodiscard]] size_t misses() const { return misses_; }
+
+  private:
+    [[nodiscard]] int column(const int role) const {
+        const auto i = role - first_role_;
+        return i >= 0 and i < static_cast<int>(role_column_.size()) ? role_column_[i] : -1;
+    }
+
+    int first_role_{0};
+    // role - first_role_ to column, -1 for roles we don't cache
+    std::vector<int> role_column_;
+
+    std::vector<std::vector<QVariant>> columns_;
+    // bit per column, set if the slot's value in that column is valid
+    std::vector<uint64_t> valid_;
+    std::vector<uint32_t> free_slots_;
+    std::unordered_map<const utility::JsonTree *, uint32_t> slots_;
+
+    mutable size_t hits_{0};
+    mutable size_t misses_{0};
+};
+
+} // namespace xstudio::ui::qml
@@ -9,6 +9,8 @@
 
 #include "xstudio/ui/qml/helper_ui.hpp"
 #include "xstudio/ui/qml/json_tree_model_ui.hpp"
+#include "xstudio/ui/qml/async_request_ui.hpp"
+#include "xstudio/ui/qml/json_tree_row_cache_ui.hpp"
 #include "xstudio/timeline/item.hpp"
 
 
@@ -504,6 +506,11 @@ class SESSION_QML_EXPORT SessionModel : public caf::mixin::actor_object<JSONTree
     Q_INVOKABLE void updateCurrentMediaContainerIndexFromBackend();
     Q_INVOKABLE void updateViewportCurrentMediaContainerIndexFromBackend();
 
+    // Time the UI thread spent blocked in calls to actors, per call site,
+    // worst first. Each entry has site, count, total and max (seconds).
+    Q_INVOKABLE [[nodiscard]] QVariantList blockedCallStats() const;
+    Q_INVOKABLE void resetBlockedCallStats() const;
+
   public slots:
     void updateMedia();
 
@@ -549,6 +556,9 @@ class SESSION_QML_EXPORT SessionModel : public caf::mixin::actor_object<JSONTree
     //     const int hits) const;
 
   private:
+    // data() without the row cache, builds the value from the row's json
+    [[nodiscard]] QVariant jsonData(const QModelIndex &index, int role) const;
+
     [[nodiscard]] bool isChildOf(const QModelIndex &parent, const QModelIndex &child) const;
     [[nodiscard]] int depthOfChild(const QModelIndex &parent, const QModelIndex &child) const;
 
@@ -667,6 +677,8 @@ class SESSION_QML_EXPORT SessionModel : public caf::mixin::actor_object<JSONTree
     QPersistentModelIndex current_playhead_owner_index_;
 
     QMap<QString, QImage> media_thumbnails_; // key is actor string
+    mutable JSONTreeRowCache row_cache_;
+    AsyncRequests async_requests_{this};
     utility::UuidSet processed_events_;
     std::queue<utility::Uuid> processed_events_queue_;
 };
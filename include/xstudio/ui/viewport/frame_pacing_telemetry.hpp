@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <map>
+#include <string>
+
+#include "flicks.hpp"
+#include "xstudio/utility/chrono.hpp"
+#include "xstudio/utility/json_store.hpp"
+#include "xstudio/utility/uuid.hpp"
+
+namespace xstudio::ui::viewport {
+
+/**
+ *  @brief A record of one frame selection made by the ViewportFrameQueueActor
+ *  for one (sub) playhead at one video refresh.
+ */
+struct FramePacingSample {
+
+    // the time point (steady clock) at which the frame will go on screen
+    utility::time_point refresh_tp_;
+
+    // where the playhead is predicted to be at refresh_tp_ - the ideal
+    // position for the frame we pick
+    timebase::flicks ideal_position_ = timebase::k_flicks_zero_seconds;
+
+    // the timeline timestamp of the frame that we actually picked
+    timebase::flicks chosen_position_ = timebase::k_flicks_zero_seconds;
+
+    // the duration of one frame for the media that the frame came from
+    timebase::flicks frame_duration_ = timebase::k_flicks_zero_seconds;
+
+    int chosen_frame_ = 0; // playhead logical frame of the picked image
+    int media_frame_  = 0; // media (decoder) frame of the picked image
+    int queue_depth_  = 0; // number of frames queued for the playhead
+
+    // the time that the reader took to load/decode the picked image
+    std::chrono::microseconds read_duration_ = std::chrono::microseconds(0);
+
+    // was the frame that should be on screen available in the queue, i.e.
+    // had it made it through the cache in time?
+    bool ideal_frame_available_ = {true};
+
+    bool playing_ = {false};
+
+    // Computed on recording, by comparison with the previous sample
+
+    // whole frames between the ideal frame and the picked frame. Positive
+    // means the picked frame is behind the playhead
+    int frames_off_ = 0;
+
+    // same frame picked as the previous refresh even though the playhead
+    // has moved onto a new frame
+    bool repeated_ = {false};
+
+    // number of frames that were never shown between the previous pick and
+    // this one
+    int dropped_ = 0;
+};
+
+/**
+ *  @brief Ring buffer of FramePacingSample, one per sub-playhead, that
+ *  allows playback smoothness to be measured and reported.
+ *
+ *  @details The ViewportFrameQueueActor records a sample every time it is
+ *  asked which frame(s) to draw. Samples are only taken while playing unless
+ *  record_when_stopped is set. The data can be retrieved as json (a summary
+ *  plus per-sample records) or as CSV.
+ */
+class FramePacingTelemetry {
+  public:
+    FramePacingTelemetry(const size_t capacity = 1024) : capacity_(capacity) {}
+
+    void record(const utility::Uuid &playhead_id, FramePacingSample sample);
+
+    void clear() { samples_per_playhead_.clear(); }
+
+    void set_capacity(const size_t capacity);
+    [[nodiscard]] size_t capacity() const { return capacity_; }
+
+    void set_enabled(const bool enabled) { enabled_ = enabled; }
+    [[nodiscard]] bool enabled() const { return enabled_; }
+
+    void set_record_when_stopped(const bool record) { record_when_stopped_ = record; }
+    [[nodiscard]] bool record_when_stopped() const { return record_when_stopped_; }
+
+    [[nodiscard]] const std::deque<FramePacingSample> &
+    samples(const utility::Uuid &playhead_id) const;
+
+    [[nodiscard]] size_t size() const;
+
+    // summary stats (late, repeated, dropped frames etc) for each sub-playhead
+    [[nodiscard]] utility::JsonStore summary() const;
+
+    // summary plus the full record of samples
+    [[nodiscard]] utility::JsonStore as_json() const;
+
+    [[nodiscard]] std::string as_csv() const;
+
+  private:
+    typedef std::deque<FramePacingSample> Samples;
+    std::map<utility::Uuid, Samples> samples_per_playhead_;
+    size_t capacity_;
+    bool enabled_             = {true};
+    bool record_when_stopped_ = {false};
+};
+
+} // namespace xstudio::ui::viewport
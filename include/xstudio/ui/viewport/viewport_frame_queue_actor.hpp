@@ -1,5 +1,6 @@
 // SPDX-License-Identifier: Apache-2.0
 #include "xstudio/ui/viewport/viewport.hpp"
+#include "xstudio/ui/viewport/frame_pacing_telemetry.hpp"
 
 namespace xstudio {
 
@@ -70,6 +71,13 @@ namespace ui::viewport {
         media_reader::ImageBufPtr
         get_least_old_image_in_set(const OrderedImagesToDraw &image_set);
 
+        void record_frame_pacing(
+            const utility::Uuid &playhead_id,
+            const OrderedImagesToDraw &frames_queued_for_display,
+            const OrderedImagesToDraw::const_iterator &chosen,
+            const timebase::flicks &ideal_position,
+            const utility::time_point &refresh_tp);
+
         void drop_old_frames(const utility::time_point out_of_date_threshold);
 
         [[nodiscard]] timebase::flicks compute_video_refresh() const;
@@ -120,6 +128,8 @@ namespace ui::viewport {
         std::string viewport_layout_mode_name_;
 
         double playhead_velocity_ = {1.0};
+
+        FramePacingTelemetry pacing_telemetry_;
     };
 
 } // namespace ui::viewport
@@ -0,0 +1,43 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "xstudio/utility/json_store.hpp"
+
+namespace xstudio::utility {
+
+/**
+ *  @brief A JSON value held as MessagePack, optionally deflated.
+ *
+ *  @details For keeping many rarely read JSON values, like undo history,
+ *  in a fraction of the memory of nlohmann::json. Values are decoded back to
+ *  JSON on each read.
+ */
+class CompactJson {
+  public:
+    CompactJson() = default;
+    explicit CompactJson(const nlohmann::json &value);
+
+    [[nodiscard]] JsonStore json() const;
+
+    // deflate the MessagePack, keeping it as it is if that saves nothing
+    void compress(const int level = 1);
+
+    // compress() has been called
+    [[nodiscard]] bool cold() const { return cold_; }
+    [[nodiscard]] bool compressed() const { return compressed_; }
+
+    // memory held, and the size of the MessagePack
+    [[nodiscard]] size_t size_bytes() const { return data_.capacity(); }
+    [[nodiscard]] size_t encoded_size() const { return encoded_size_; }
+
+  private:
+    std::vector<uint8_t> data_;
+    size_t encoded_size_{0};
+    bool cold_{false};
+    bool compressed_{false};
+};
+
+} // namespace xstudio::utility
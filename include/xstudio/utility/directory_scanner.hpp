@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "xstudio/utility/sequence.hpp"
+
+namespace xstudio::utility {
+
+struct DirectoryScanOptions {
+    // -1 for no limit, 0 scans only the start directory
+    int max_depth{-1};
+    size_t thread_count{4};
+    bool include_hidden{false};
+    bool follow_symlinks{true};
+    // fill in Entry::stat_ for files, needed for sizes, dates and owners of the
+    // resulting sequences. Directory entry types come from readdir so without
+    // this files are never stat'd.
+    bool stat_files{true};
+    // lower case, including the dot. Empty for all files.
+    std::set<std::string> extensions;
+    std::set<std::string> ignore_directories;
+};
+
+struct DirectoryScanProgress {
+    size_t directories_scanned_{0};
+    size_t directories_pending_{0};
+    size_t files_found_{0};
+    // 0 - 1, each directory's share is split between its subdirectories
+    double progress_{0.0};
+};
+
+struct DirectoryScanResult {
+    std::string path_;
+    int depth_{0};
+    // position of each directory on the way down from the start directory,
+    // among its siblings sorted by name
+    std::vector<size_t> index_path_;
+    // sorted, full paths
+    std::vector<std::string> subdirectories_;
+    // files in path_ collapsed into sequences, names are full paths
+    std::vector<Sequence> sequences_;
+};
+
+/**
+ *  @brief Multithreaded directory tree scanner.
+ *
+ *  @details Directories are read by a pool of threads, using the entry type
+ *  from readdir rather than a stat per entry where the filesystem provides
+ *  it. The files in each directory are collapsed into sequences and handed
+ *  to the callback as each directory completes.
+ */
+class DirectoryScanner {
+  public:
+    using ResultCallback =
+        std::function<void(const DirectoryScanResult &, const DirectoryScanProgress &)>;
+
+    DirectoryScanner(DirectoryScanOptions options = DirectoryScanOptions());
+    virtual ~DirectoryScanner() = default;
+
+    // Scan the tree under path, blocking until it's done. callback is called
+    // from the worker threads, but never concurrently. Returns false if
+    // cancelled.
+    bool scan(const std::string &path, const ResultCallback &callback);
+
+    // Stop a scan, may be called from any thread including the callback.
+    void cancel() { cancelled_ = true; }
+    [[nodiscard]] bool cancelled() const { return cancelled_; }
+
+    [[nodiscard]] const DirectoryScanOptions &options() const { return options_; }
+
+  private:
+    void read_directory(
+        const std::string &path,
+        std::vector<std::string> &subdirectories,
+        std::vector<Entry> &files) const;
+
+    [[nodiscard]] bool wanted_file(const std::string_view name) const;
+
+    const DirectoryScanOptions options_;
+    std::atomic<bool> cancelled_{false};
+};
+
+} // namespace xstudio::utility
@@ -0,0 +1,150 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+namespace xstudio::utility {
+
+/**
+ *  @brief Persistent cache of json data that was expensive to get from a
+ *  file, such as the MediaDetail or metadata that a reader plugin finds by
+ *  opening (probing) a piece of media.
+ *
+ *  @details Entries are keyed on the file path, plus an optional sub key (a
+ *  frame number, say). For an image sequence path ({:04d}, #### or @@@@)
+ *  the first frame's file stands in for the sequence. An entry is only
+ *  returned if the file's size and modification time are unchanged and if
+ *  the fingerprint given for the lookup matches the one it was stored with.
+ *  The fingerprint should identify whatever produced the data, for example
+ *  the names and versions of the plugins. The cache is held in memory and
+ *  persisted in the cache directory as a json file of all the entries plus
+ *  a log of the changes made since, one json object per line. A background
+ *  thread appends new changes to the log every flush_period and rewrites
+ *  the whole file when the log has grown as long as the cache, so callers
+ *  never wait on the disk. It is thread safe so one instance can be shared
+ *  by a pool of workers.
+ */
+class FileProbeCache {
+  public:
+    FileProbeCache(
+        std::string name,
+        const size_t max_count                  = 100000,
+        const std::chrono::seconds flush_period = std::chrono::seconds(10));
+    virtual ~FileProbeCache();
+
+    // Use the cache file in directory, loading its entries. Changes not yet
+    // written are flushed to the old directory first. Empty disables
+    // persistence, the cache is then in memory only.
+    void set_directory(const std::string &directory);
+    [[nodiscard]] std::string directory() const;
+
+    void set_enabled(const bool enabled);
+    [[nodiscard]] bool enabled() const;
+
+    void set_max_count(const size_t max_count);
+    [[nodiscard]] size_t max_count() const;
+
+    [[nodiscard]] std::optional<nlohmann::json> find(
+        const std::string &path,
+        const std::string &fingerprint,
+        const std::string &sub_key = "");
+
+    void store(
+        const std::string &path,
+        const std::string &fingerprint,
+        const nlohmann::json &data,
+        const std::string &sub_key = "");
+
+    void erase(const std::string &path, const std::string &sub_key = "");
+    void clear();
+
+    [[nodiscard]] size_t size() const;
+    [[nodiscard]] size_t hits() const;
+    [[nodiscard]] size_t misses() const;
+
+    // Write any changes not yet written to disk, now. Returns false if the
+    // write failed.
+    bool flush();
+
+    [[nodiscard]] std::string cache_file() const;
+
+  private:
+    struct Entry {
+        uintmax_t size_   = {0};
+        int64_t mtime_    = {0};
+        std::string fingerprint_;
+        nlohmann::json data_;
+        uint64_t last_used_ = {0};
+    };
+
+    struct FileIdentity {
+        uintmax_t size_ = {0};
+        int64_t mtime_  = {0};
+    };
+
+    // stats the file, or the first frame of a sequence
+    std::optional<FileIdentity> file_identity(const std::string &path);
+    static std::string entry_key(const std::string &path, const std::string &sub_key);
+
+    void load();
+    void prune();
+
+    static nlohmann::json entry_json(const Entry &entry);
+    static Entry entry_from_json(const nlohmann::json &json);
+
+    // queue the log line for a change to key, null entry for an erase.
+    // Caller holds mutex_.
+    void log_change(const std::string &key, const Entry *entry);
+
+    // The entries as written to the cache file, taken under mutex_ so that
+    // the (slow) write can happen without it. Starts a new log.
+    nlohmann::json snapshot();
+    bool write(const std::string &directory, const nlohmann::json &snapshot) const;
+    bool append(
+        const std::string &directory,
+        const std::string &log_name,
+        const std::vector<std::string> &lines) const;
+
+    void run_writer();
+
+    const std::string name_;
+    const std::chrono::seconds flush_period_;
+
+    mutable std::mutex mutex_;
+    // held from taking a snapshot until it is written, so that writes land
+    // in the order they were taken
+    std::mutex write_mutex_;
+    std::map<std::string, Entry> entries_;
+    // sequence path to the path of its first frame
+    std::map<std::string, std::string> first_frames_;
+    std::string directory_;
+    size_t max_count_;
+    bool enabled_           = {true};
+    uint64_t usage_counter_ = {0};
+    size_t hits_            = {0};
+    size_t misses_          = {0};
+
+    // changes not yet written, as log lines. If rewrite_ the whole file is
+    // written instead (after a clear or prune, say).
+    std::vector<std::string> changes_;
+    bool rewrite_ = {false};
+    // name of the log that follows the cache file, and its length
+    std::string log_name_;
+    size_t log_lines_ = {0};
+
+    std::condition_variable wake_writer_;
+    bool stopping_ = {false};
+    std::thread writer_;
+};
+
+} // namespace xstudio::utility
@@ -1,10 +1,14 @@
 // SPDX-License-Identifier: Apache-2.0
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdio>
 #include <filesystem>
+#include <future>
+#include <thread>
 
 #include <fstream>
 #include <iostream>
@@ -611,6 +615,57 @@ std::vector<typename V::value_type> concatenate_vector(const V &a, const V &b) {
     return result;
 }
 
+namespace detail {
+    // threads running parallel_for work besides their callers, across all calls
+    inline std::atomic<size_t> parallel_for_helpers{0};
+
+    // takes up to wanted helpers from those left of the shared limit
+    inline size_t reserve_parallel_for_helpers(const size_t wanted) {
+        const size_t limit = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+        auto held          = parallel_for_helpers.load();
+        size_t result      = 0;
+        do {
+            result = held < limit ? std::min(wanted, limit - held) : 0;
+        } while (result and
+                 not parallel_for_helpers.compare_exchange_weak(held, held + result));
+        return result;
+    }
+} // namespace detail
+
+// calls func(i) for each i in [0, count) on up to max_threads threads, this
+// one included, returning when all are done. func must be safe to call
+// concurrently. Helper threads are shared by all calls, nested or not, so
+// no more than the hardware's threads run at once, the callers aside.
+template <typename F>
+void parallel_for(
+    const size_t count,
+    F &&func,
+    const size_t max_threads = std::thread::hardware_concurrency()) {
+    const auto helpers = detail::reserve_parallel_for_helpers(
+        std::clamp<size_t>(max_threads, 1, std::max<size_t>(count, 1)) - 1);
+
+    std::atomic<size_t> next{0};
+    auto work = [&]() {
+        for (auto i = next++; i < count; i = next++)
+            func(i);
+    };
+
+    std::vector<std::future<void>> workers;
+    try {
+        for (size_t t = 0; t < helpers; ++t)
+            workers.emplace_back(std::async(std::launch::async, work));
+        work();
+        for (auto &w : workers)
+            w.get();
+    } catch (...) {
+        // async futures wait for their threads when destroyed
+        workers.clear();
+        detail::parallel_for_helpers -= helpers;
+        throw;
+    }
+    detail::parallel_for_helpers -= helpers;
+}
+
 //  this is annoying.. we now have to create all these silly UuidActor functions..
 
 
@@ -679,4 +734,8 @@ void setup_filepath_remap_regex(const utility::JsonStore &);
 // MD5_* API on older versions.
 std::array<unsigned char, 16> md5_hash(const void *data, std::size_t size);
 
+// Fast 64 bit hash of size bytes of data, seeded. Stable across builds and
+// platforms, so it can be used for keys that are persisted.
+[[nodiscard]] uint64_t hash_bytes(const void *data, const size_t size, uint64_t seed = 0);
+
 } // namespace xstudio::utility
\ No newline at end of file
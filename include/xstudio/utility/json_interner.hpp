@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "xstudio/utility/json_store.hpp"
+
+namespace xstudio::utility {
+
+typedef std::shared_ptr<const JsonStore> JsonStorePtr;
+
+// an interned value with an estimate of its heap memory, made once with it
+struct InternedJson {
+    JsonStorePtr value;
+    size_t bytes{0};
+};
+
+/**
+ *  @brief Shares one immutable copy of equal JSON values.
+ *
+ *  @details For values that repeat across many objects, like the shader
+ *  parameters and metadata of the frames of an image sequence. Values are
+ *  held weakly, so they are freed with the last object using them. The table
+ *  is split in shards by hash, each with its own lock.
+ */
+class JsonInterner {
+  public:
+    JsonInterner()  = default;
+    ~JsonInterner() = default;
+
+    // the interner that ImageBuffers use
+    static JsonInterner &instance();
+
+    // a value equal to value, shared with earlier calls if one is still
+    // in use. created is set if this call made it.
+    InternedJson intern(nlohmann::json value, bool *created = nullptr);
+
+    // values held
+    [[nodiscard]] size_t count() const;
+
+  private:
+    struct Held {
+        std::weak_ptr<const JsonStore> value;
+        size_t bytes{0};
+    };
+
+    struct Shard {
+        void prune();
+
+        mutable std::mutex mutex_;
+        std::unordered_multimap<size_t, Held> values_;
+        size_t prune_at_{64};
+    };
+
+    static constexpr size_t SHARDS = 16;
+    std::array<Shard, SHARDS> shards_;
+};
+
+/**
+ *  @brief Interns the values of one source, like the frames of a stream.
+ *
+ *  @details Each value is compared with the last one given for its slot
+ *  first, so values that don't change from frame to frame are never hashed
+ *  and don't take the shared interner's locks. Not thread safe, readers keep
+ *  one per stream.
+ */
+class JsonSourceInterner {
+  public:
+    JsonSourceInterner(JsonInterner &interner = JsonInterner::instance())
+        : interner_(&interner) {}
+
+    // slot names the value's place in the source, like its metadata key
+    InternedJson intern(const std::string &slot, nlohmann::json value);
+
+  private:
+    JsonInterner *interner_;
+    std::unordered_map<std::string, InternedJson> last_;
+};
+
+// estimate of the heap memory of a JSON tree
+size_t json_size_bytes(const nlohmann::json &value);
+
+} // namespace xstudio::utility
@@ -319,6 +319,14 @@ namespace fs = std::filesystem;
 JsonStore open_session(const caf::uri &path);
 JsonStore open_session(const std::string &path);
 
+/**
+ *  @brief Parse a session.
+ *  @details Each of the top level actors is parsed on its own thread.
+ *  @param text  Serialised session.
+ *  @result Session JSON or exception.
+ */
+JsonStore parse_session(const std::string &text);
+
 nlohmann::json sort_by(const nlohmann::json &jsn, const nlohmann::json::json_pointer &ptr);
 
 inline JsonStore merge_json_from_path(const std::string &path, JsonStore merged = JsonStore()) {
@@ -1,20 +1,37 @@
 // SPDX-License-Identifier: Apache-2.0
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
 #include <regex>
 #include <vector>
 #include <string>
 #include <mutex>
 
+#include "xstudio/utility/json_store.hpp"
+
 // std::string forward_remap_file_path(const std::string path);
 
 // std::string reverse_remap_file_path(const std::string path);
 namespace xstudio::utility {
 
+/**
+ *  @brief Maps file paths between sites, forwards to local paths and
+ *  backwards to the original ones.
+ *
+ *  @details Rules are regex search/replace pairs applied in order. Rules that
+ *  only replace a literal prefix ("^/mnt/site_a/" -> "/mnt/site_b/") are
+ *  looked up in a trie rather than run as regexes. configure() and
+ *  add_path_mapping() build a new immutable set of rules, swap it in and bump
+ *  a generation. Each reader thread keeps its own copy of the rules and its
+ *  recent results, and only goes back for the rules when the generation moves.
+ */
 class PathRemapper {
 
   public:
-    PathRemapper()          = default;
+    PathRemapper();
     virtual ~PathRemapper() = default;
 
     std::string forwards(const std::string &path);
@@ -24,16 +41,23 @@ class PathRemapper {
 
     void add_path_mapping(const std::string &from, const std::string &to);
 
+    // results remembered per thread, 0 to not remember any
+    void set_memo_size(const size_t value) { memo_size_ = value; }
+
   private:
+    struct Rules;
+    struct Cache;
+
     std::string remap(const std::string &path, const bool forwards);
+    void publish(std::shared_ptr<Rules> rules);
+    // this thread's copy of our rules and results
+    Cache &cache();
 
+    // guards rules_, lookups only take it when generation_ has moved
     std::mutex mutex_;
-
-    std::vector<std::pair<std::regex, std::string>> forward_regex_;
-    std::vector<std::pair<std::regex, std::string>> backward_regex_;
-
-    std::map<std::string, std::string> forward_map_;
-    std::map<std::string, std::string> backward_map_;
+    std::shared_ptr<const Rules> rules_;
+    std::atomic<uint64_t> generation_{0};
+    std::atomic<size_t> memo_size_{4096};
 };
 
-} // namespace xstudio::utility
\ No newline at end of file
+} // namespace xstudio::utility
@@ -15,7 +15,9 @@ using gid_t = DWORD; // Use DWORD type for group ID
 // #include <set>
 #include <ctime>
 #include <functional>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <sys/stat.h>
 #include <vector>
 
@@ -54,6 +56,21 @@ struct Sequence {
     Sequence(const Entry &entry);
     // Sequence(const DFile &file);
 };
+// A file name split around its frame number, e.g. "shot." "0001" ".exr"
+struct FrameNumberSplit {
+    std::string_view head_;
+    std::string_view frame_;
+    std::string_view tail_;
+};
+
+// Find the frame number in name, the views point into name. Recognises, in
+// order of preference, "0001", "0001.ext", "body.0001.ext1.ext",
+// "body.0001.ext" and "body0001.ext". Frame numbers may be negative when
+// preceded by a dot.
+std::optional<FrameNumberSplit> split_frame_number(const std::string_view name);
+
+UriSequence uri_from_sequence(const Sequence &sequence);
+
 int pad_size(const std::string &frame);
 std::string pad_spec(const int pad);
 std::string escape_percentage(const std::string &str);
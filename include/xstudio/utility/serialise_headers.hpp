@@ -13,3 +13,4 @@
 #include "xstudio/utility/caf_helpers.hpp"
 #include "xstudio/utility/frame_range.hpp"
 #include "xstudio/utility/notification_handler.hpp"
+#include "xstudio/utility/shared_json.hpp"
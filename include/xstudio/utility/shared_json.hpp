@@ -0,0 +1,136 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "xstudio/utility/json_store.hpp"
+
+namespace xstudio::utility {
+
+/**
+ *  @brief Immutable JSON value that shares unchanged subtrees between copies.
+ *
+ *  @details Copying is a pointer copy, so it is cheap to pass in messages and
+ *  keep as a snapshot. set(), remove(), merge() and patch() return a new value
+ *  that copies the nodes on the way to the change and shares everything else
+ *  with the original. Paths are JSON pointers, as for JsonStore. Missing paths
+ *  throw std::out_of_range, malformed ones std::invalid_argument.
+ */
+class SharedJson {
+  public:
+    SharedJson(const nlohmann::json &json = nlohmann::json());
+    SharedJson(nlohmann::json &&json);
+
+    /**
+     *  @brief Build the JSON value.
+     *  @result Copy of the whole tree.
+     */
+    [[nodiscard]] JsonStore json() const;
+
+    /**
+     *  @brief Get value at JSON pointer path.
+     *  @param path  JSON pointer path.
+     *  @result Value sharing its nodes with this one, or exception.
+     */
+    [[nodiscard]] SharedJson get(const std::string &path) const;
+
+    template <typename result_type>
+    [[nodiscard]] inline result_type get(const std::string &path = "") const {
+        return get(path).json().get<result_type>();
+    }
+
+    [[nodiscard]] bool contains(const std::string &path) const;
+
+    /**
+     *  @brief Set value at JSON pointer path.
+     *  @param value  Value to insert.
+     *  @param path  JSON pointer path, created if missing.
+     *  @result New value.
+     */
+    [[nodiscard]] SharedJson set(const SharedJson &value, const std::string &path = "") const;
+
+    /**
+     *  @brief Remove value at JSON pointer path.
+     *  @param path  JSON pointer path.
+     *  @param removed  Set if there was a value to remove.
+     *  @result New value, or this one if nothing was removed.
+     */
+    [[nodiscard]] SharedJson remove(const std::string &path, bool *removed = nullptr) const;
+
+    /**
+     *  @brief Merge value at JSON pointer path, as JsonStore::merge.
+     *  @details Objects are merged by key and arrays by index, anything else
+     *  is replaced.
+     *  @param value  Value to merge.
+     *  @param path  JSON pointer path.
+     *  @result New value.
+     */
+    [[nodiscard]] SharedJson merge(const SharedJson &value, const std::string &path = "") const;
+
+    /**
+     *  @brief Apply a JSON patch (RFC 6902).
+     *  @param patch  Array of operations.
+     *  @result New value, or exception if an operation fails.
+     */
+    [[nodiscard]] SharedJson patch(const nlohmann::json &patch) const;
+
+    [[nodiscard]] nlohmann::json::value_t type() const;
+    [[nodiscard]] bool is_null() const { return type() == nlohmann::json::value_t::null; }
+    [[nodiscard]] bool is_object() const { return type() == nlohmann::json::value_t::object; }
+    [[nodiscard]] bool is_array() const { return type() == nlohmann::json::value_t::array; }
+
+    // as nlohmann::json::size
+    [[nodiscard]] size_t size() const;
+
+    // same nodes, so equal without comparing
+    [[nodiscard]] bool shares(const SharedJson &other) const { return node_ == other.node_; }
+
+    bool operator==(const SharedJson &other) const;
+    bool operator!=(const SharedJson &other) const { return not(*this == other); }
+
+  private:
+    struct Node;
+    typedef std::shared_ptr<const Node> NodePtr;
+
+    explicit SharedJson(NodePtr node) : node_(std::move(node)) {}
+
+    static const NodePtr &null_node();
+    template <typename J> static NodePtr make_node(J &&json);
+    static nlohmann::json make_json(const Node &node);
+    static bool equal(const NodePtr &a, const NodePtr &b);
+
+    static NodePtr
+    set_at(const NodePtr &node, const std::vector<std::string> &path, size_t depth,
+           const NodePtr &value, const bool insert);
+    static NodePtr
+    remove_at(const NodePtr &node, const std::vector<std::string> &path, size_t depth);
+    static NodePtr merge_nodes(const NodePtr &node, const NodePtr &value);
+
+    [[nodiscard]] NodePtr find(const std::vector<std::string> &path) const;
+    [[nodiscard]] SharedJson add(const SharedJson &value, const std::string &path) const;
+
+    NodePtr node_;
+};
+
+template <class Inspector> bool inspect(Inspector &f, SharedJson &x) {
+    auto get_jsn = [&x] { return x.json().dump(-1); };
+    auto set_jsn = [&x](const std::string &val) {
+        try {
+            x = SharedJson(nlohmann::json::parse(val));
+        } catch (const std::exception &err) {
+            spdlog::warn("{} {}", __PRETTY_FUNCTION__, err.what());
+            return false;
+        }
+
+        return true;
+    };
+    return f.object(x).fields(f.field("jsn", get_jsn, set_jsn));
+}
+
+void to_json(nlohmann::json &j, const SharedJson &c);
+void from_json(const nlohmann::json &j, SharedJson &c);
+
+} // namespace xstudio::utility
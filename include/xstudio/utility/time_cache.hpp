@@ -50,7 +50,10 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "xstudio/utility/chrono.hpp"
 #include "xstudio/utility/helpers.hpp"
@@ -59,12 +62,29 @@
 #include "xstudio/media/media.hpp"
 
 namespace xstudio::utility {
+
+// what a value counts for against the cache's max size, overloaded for
+// values holding more than their size()
+template <typename V> size_t cache_entry_size(const V &value) {
+    return value ? value->size() : 0;
+}
+
+// parts of a value that other values may share, by address and size. The
+// cache counts each once, while any entry holds it, instead of in the entry
+// size.
+template <typename V>
+std::vector<std::pair<const void *, size_t>> cache_entry_shared(const V &) {
+    return {};
+}
+
 template <typename K, typename V> class TimeCache {
   public:
     struct CacheEntry {
         CacheEntry() = default;
         CacheEntry(const V _v) : value(_v) {}
         V value;
+        // as counted when stored
+        size_t size{0};
         std::unordered_set<utility::Uuid> uuids;
         std::set<time_point> timepoints;
     };
@@ -143,6 +163,11 @@ template <typename K, typename V> class TimeCache {
     typename cache_type::iterator erase(const typename cache_type::iterator &it);
 
     [[nodiscard]] size_t size() const { return size_; }
+    // as counted for key when stored, 0 if it isn't cached
+    [[nodiscard]] size_t size(const K &key) const {
+        auto it = cache_.find(key);
+        return it == std::end(cache_) ? 0 : it->second->size;
+    }
     [[nodiscard]] size_t count() const { return count_; }
     [[nodiscard]] bool empty() const { return count_ == 0; }
 
@@ -202,10 +227,18 @@ template <typename K, typename V> class TimeCache {
         const utility::Uuid &uuid,
         const size_t size);
 
+    // size of value plus its shared parts that aren't counted yet
+    size_t store_size(const V &value) const;
+    void add_shared(const V &value);
+    void remove_shared(const V &value);
+
     size_t max_size_;
     size_t max_count_;
     size_t size_{0};
     size_t count_{0};
+    // shared parts of the cached values, with how many entries hold them
+    // and their size
+    std::unordered_map<const void *, std::pair<size_t, size_t>> shared_;
 };
 
 template <typename K, typename V>
@@ -232,7 +265,10 @@ void TimeCache<K, V>::add_cache_entry(
     count_++;
     size_ += size;
 
-    cache_[key] = std::make_shared<CacheEntry>(value);
+    auto entry  = std::make_shared<CacheEntry>(value);
+    entry->size = size;
+    cache_[key] = entry;
+    add_shared(value);
 
     call_change_callback({key}, {});
 
@@ -298,7 +334,7 @@ bool TimeCache<K, V>::store(
         add_timepoint_reference(key, time, uuid);
         clean_timepoints(key);
     } else {
-        size_t _size = (value ? value->size() : 0);
+        size_t _size = store_size(value);
 
         if (not shrink(
                 (max_size_ > _size ? max_size_ - _size : 0),
@@ -307,7 +343,7 @@ bool TimeCache<K, V>::store(
                 force_eviction))
             return false;
 
-        add_cache_entry(key, value, time, uuid, _size);
+        add_cache_entry(key, value, time, uuid, cache_entry_size(value));
     }
     return true;
 }
@@ -325,17 +361,46 @@ bool TimeCache<K, V>::store(
         add_timepoint_reference(key, time, uuid);
         clean_timepoints(key);
     } else {
-        size_t _size = (value ? value->size() : 0);
+        size_t _size = store_size(value);
 
         if (not shrink_using_out_of_date(
                 (max_size_ > _size ? max_size_ - _size : 0), max_count_ - 1, out_of_date_time))
             return false;
 
-        add_cache_entry(key, value, time, uuid, _size);
+        add_cache_entry(key, value, time, uuid, cache_entry_size(value));
     }
     return true;
 }
 
+template <typename K, typename V> size_t TimeCache<K, V>::store_size(const V &value) const {
+    auto result = cache_entry_size(value);
+    for (const auto &i : cache_entry_shared(value)) {
+        if (not shared_.count(i.first))
+            result += i.second;
+    }
+    return result;
+}
+
+template <typename K, typename V> void TimeCache<K, V>::add_shared(const V &value) {
+    for (const auto &i : cache_entry_shared(value)) {
+        auto &held = shared_[i.first];
+        if (not held.first++) {
+            held.second = i.second;
+            size_ += i.second;
+        }
+    }
+}
+
+template <typename K, typename V> void TimeCache<K, V>::remove_shared(const V &value) {
+    for (const auto &i : cache_entry_shared(value)) {
+        auto it = shared_.find(i.first);
+        if (it != std::end(shared_) and not --(it->second.first)) {
+            size_ -= it->second.second;
+            shared_.erase(it);
+        }
+    }
+}
+
 template <typename K, typename V>
 bool TimeCache<K, V>::shrink(
     const size_t required_size,
@@ -375,6 +440,7 @@ template <typename K, typename V> void TimeCache<K, V>::clear() {
     call_change_callback({}, keys());
 
     cache_.clear();
+    shared_.clear();
     count_ = 0;
     size_  = 0;
 }
@@ -420,8 +486,10 @@ template <typename K, typename V>
 typename TimeCache<K, V>::cache_type::iterator
 TimeCache<K, V>::erase(const typename cache_type::iterator &it) {
     typename cache_type::iterator nit;
-    if (it->second)
-        size_ -= it->second->value ? it->second->value->size() : 0;
+    if (it->second) {
+        size_ -= it->second->size;
+        remove_shared(it->second->value);
+    }
     count_--;
     call_change_callback({}, {it->first});
     nit = cache_.erase(it);
@@ -1,10 +1,14 @@
 // SPDX-License-Identifier: Apache-2.0
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <deque>
 #include <map>
 #include <optional>
 
+#include "xstudio/utility/compact_json.hpp"
 #include "xstudio/utility/json_store.hpp"
 
 namespace xstudio::utility {
@@ -221,4 +225,314 @@ template <typename K, typename V> void UndoRedoMap<K, V>::clear() {
     redo_.clear();
 }
 
+// Byte budget shared by all the JsonUndoRedoMaps of the process. Over it, a
+// map drops its own oldest entries while it holds more than an even share.
+class UndoRedoBudget {
+  public:
+    static void set_max_bytes(const size_t value) { max_bytes_ = value; }
+    [[nodiscard]] static size_t max_bytes() { return max_bytes_; }
+    [[nodiscard]] static size_t bytes() { return bytes_; }
+
+    [[nodiscard]] static bool over(const size_t own) {
+        const size_t max = max_bytes_;
+        return bytes_ > max and own > max / std::max(size_t(users_), size_t(1));
+    }
+
+    static void join() { users_++; }
+    static void leave() { users_--; }
+    static void add(const size_t value) { bytes_ += value; }
+    static void remove(const size_t value) { bytes_ -= value; }
+
+  private:
+    inline static std::atomic<size_t> max_bytes_{std::numeric_limits<size_t>::max()};
+    inline static std::atomic<size_t> bytes_{0};
+    inline static std::atomic<size_t> users_{0};
+};
+
+// UndoRedoMap for JSON events, held as CompactJson within the UndoRedoBudget.
+// The newest undo entries stay as MessagePack so the next few undos are quick,
+// older ones are deflated. Over budget redo entries are dropped, then the
+// oldest undo entries.
+template <typename K> class JsonUndoRedoMap {
+  public:
+    JsonUndoRedoMap() { UndoRedoBudget::join(); }
+    JsonUndoRedoMap(const utility::JsonStore &jsn);
+    JsonUndoRedoMap(const JsonUndoRedoMap &other);
+    JsonUndoRedoMap &operator=(const JsonUndoRedoMap &other);
+    ~JsonUndoRedoMap();
+
+    [[nodiscard]] utility::JsonStore serialise() const;
+    [[nodiscard]] auto count() const { return undo_.size(); }
+    [[nodiscard]] bool empty() const { return undo_.empty(); }
+
+    void set_max_count(const size_t value);
+    void set_hot_count(const size_t value);
+    [[nodiscard]] size_t bytes() const { return bytes_; }
+
+    // drop entries if over count or budget, for when the budget changes
+    void trim();
+
+    void push(const K &key, const utility::JsonStore &value);
+
+    std::optional<utility::JsonStore> undo();
+    std::optional<utility::JsonStore> redo();
+    std::optional<utility::JsonStore> undo(const K &key);
+    std::optional<utility::JsonStore> redo(const K &key);
+
+    std::optional<K> peek_undo();
+    std::optional<K> peek_redo();
+
+    void clear();
+
+    // memory use and encode/decode times
+    [[nodiscard]] utility::JsonStore stats() const;
+
+  private:
+    utility::JsonStore decode(const CompactJson &value);
+    void cool();
+    void add_bytes(const size_t value);
+    void remove_bytes(const size_t value);
+
+    std::multimap<K, CompactJson> undo_;
+    std::multimap<K, CompactJson> redo_;
+
+    size_t max_count_{std::numeric_limits<size_t>::max()};
+    size_t hot_count_{8};
+    size_t bytes_{0};
+
+    size_t evicted_{0};
+    size_t encodes_{0};
+    size_t decodes_{0};
+    std::chrono::microseconds encode_time_{0};
+    std::chrono::microseconds decode_time_{0};
+    std::chrono::microseconds max_decode_time_{0};
+};
+
+template <typename K> JsonUndoRedoMap<K>::JsonUndoRedoMap(const utility::JsonStore &jsn) {
+    UndoRedoBudget::join();
+}
+
+template <typename K>
+JsonUndoRedoMap<K>::JsonUndoRedoMap(const JsonUndoRedoMap &other)
+    : undo_(other.undo_),
+      redo_(other.redo_),
+      max_count_(other.max_count_),
+      hot_count_(other.hot_count_) {
+    UndoRedoBudget::join();
+    add_bytes(other.bytes_);
+}
+
+template <typename K>
+JsonUndoRedoMap<K> &JsonUndoRedoMap<K>::operator=(const JsonUndoRedoMap &other) {
+    if (this != &other) {
+        remove_bytes(bytes_);
+        undo_      = other.undo_;
+        redo_      = other.redo_;
+        max_count_ = other.max_count_;
+        hot_count_ = other.hot_count_;
+        add_bytes(other.bytes_);
+    }
+    return *this;
+}
+
+template <typename K> JsonUndoRedoMap<K>::~JsonUndoRedoMap() {
+    remove_bytes(bytes_);
+    UndoRedoBudget::leave();
+}
+
+template <typename K> utility::JsonStore JsonUndoRedoMap<K>::serialise() const {
+    utility::JsonStore jsn;
+    return jsn;
+}
+
+template <typename K> void JsonUndoRedoMap<K>::set_max_count(const size_t value) {
+    max_count_ = value;
+    trim();
+}
+
+template <typename K> void JsonUndoRedoMap<K>::set_hot_count(const size_t value) {
+    hot_count_ = value;
+    cool();
+    trim();
+}
+
+template <typename K>
+void JsonUndoRedoMap<K>::push(const K &key, const utility::JsonStore &value) {
+    const auto start = std::chrono::steady_clock::now();
+
+    for (const auto &i : redo_)
+        remove_bytes(i.second.size_bytes());
+    redo_.clear();
+
+    auto it = undo_.emplace(key, CompactJson(value));
+    add_bytes(it->second.size_bytes());
+    cool();
+    trim();
+
+    encodes_++;
+    encode_time_ += std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+}
+
+template <typename K> std::optional<K> JsonUndoRedoMap<K>::peek_undo() {
+    if (undo_.empty())
+        return {};
+
+    return undo_.rbegin()->first;
+}
+
+template <typename K> std::optional<K> JsonUndoRedoMap<K>::peek_redo() {
+    if (redo_.empty())
+        return {};
+
+    return redo_.begin()->first;
+}
+
+template <typename K> std::optional<utility::JsonStore> JsonUndoRedoMap<K>::undo() {
+    if (undo_.empty())
+        return {};
+
+    auto it = std::next(undo_.rbegin()).base();
+    auto kv = redo_.insert(std::move(*it));
+    undo_.erase(it);
+
+    auto result = decode(kv->second);
+    trim();
+    return result;
+}
+
+template <typename K> std::optional<utility::JsonStore> JsonUndoRedoMap<K>::redo() {
+    if (redo_.empty())
+        return {};
+
+    auto it = redo_.begin();
+    auto kv = undo_.insert(std::move(*it));
+    redo_.erase(it);
+
+    auto result = decode(kv->second);
+    trim();
+    return result;
+}
+
+template <typename K>
+std::optional<utility::JsonStore> JsonUndoRedoMap<K>::undo(const K &max) {
+    if (undo_.empty() or max >= undo_.rbegin()->first)
+        return {};
+
+    return undo();
+}
+
+template <typename K>
+std::optional<utility::JsonStore> JsonUndoRedoMap<K>::redo(const K &min) {
+    if (redo_.empty())
+        return {};
+
+    auto it = redo_.begin();
+
+    if (min > it->first)
+        return {};
+
+    // as UndoRedoMap, of entries with the same key take the last
+    auto key_count = redo_.count(it->first);
+    if (key_count > 1)
+        std::advance(it, key_count - 1);
+
+    auto kv = undo_.insert(std::move(*it));
+    redo_.erase(it);
+
+    auto result = decode(kv->second);
+    trim();
+    return result;
+}
+
+template <typename K> void JsonUndoRedoMap<K>::clear() {
+    undo_.clear();
+    redo_.clear();
+    remove_bytes(bytes_);
+}
+
+template <typename K> utility::JsonStore JsonUndoRedoMap<K>::stats() const {
+    utility::JsonStore jsn;
+
+    size_t encoded    = 0;
+    size_t compressed = 0;
+    for (const auto *m : {&undo_, &redo_}) {
+        for (const auto &i : *m) {
+            encoded += i.second.encoded_size();
+            if (i.second.compressed())
+                compressed++;
+        }
+    }
+
+    jsn["count"]            = undo_.size();
+    jsn["redo_count"]       = redo_.size();
+    jsn["compressed_count"] = compressed;
+    jsn["bytes"]            = bytes_;
+    jsn["encoded_bytes"]    = encoded;
+    jsn["shared_bytes"]     = UndoRedoBudget::bytes();
+    jsn["max_bytes"]        = UndoRedoBudget::max_bytes();
+    jsn["evicted"]          = evicted_;
+    jsn["mean_encode_us"]   = encodes_ ? encode_time_.count() / encodes_ : 0;
+    jsn["mean_decode_us"]   = decodes_ ? decode_time_.count() / decodes_ : 0;
+    jsn["max_decode_us"]    = max_decode_time_.count();
+    return jsn;
+}
+
+template <typename K>
+utility::JsonStore JsonUndoRedoMap<K>::decode(const CompactJson &value) {
+    const auto start = std::chrono::steady_clock::now();
+    auto result      = value.json();
+    const auto time  = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+
+    decodes_++;
+    decode_time_ += time;
+    max_decode_time_ = std::max(max_decode_time_, time);
+    return result;
+}
+
+template <typename K> void JsonUndoRedoMap<K>::cool() {
+    // compress undo entries past the newest hot_count_, stopping at ones
+    // already done
+    if (undo_.size() <= hot_count_)
+        return;
+
+    for (auto it = std::next(undo_.rbegin(), hot_count_);
+         it != undo_.rend() and not it->second.cold();
+         ++it) {
+        remove_bytes(it->second.size_bytes());
+        it->second.compress();
+        add_bytes(it->second.size_bytes());
+    }
+}
+
+template <typename K> void JsonUndoRedoMap<K>::add_bytes(const size_t value) {
+    bytes_ += value;
+    UndoRedoBudget::add(value);
+}
+
+template <typename K> void JsonUndoRedoMap<K>::remove_bytes(const size_t value) {
+    bytes_ -= value;
+    UndoRedoBudget::remove(value);
+}
+
+template <typename K> void JsonUndoRedoMap<K>::trim() {
+    // redo entries first, furthest from where we are first
+    while (not redo_.empty() and UndoRedoBudget::over(bytes_)) {
+        auto it = std::prev(redo_.end());
+        remove_bytes(it->second.size_bytes());
+        redo_.erase(it);
+        evicted_++;
+    }
+
+    // then the oldest undo entries, the newest is kept whatever its size
+    while (not undo_.empty() and
+           (undo_.size() > max_count_ or
+            (UndoRedoBudget::over(bytes_) and undo_.size() > 1))) {
+        remove_bytes(undo_.begin()->second.size_bytes());
+        undo_.erase(undo_.begin());
+        evicted_++;
+    }
+}
+
 } // namespace xstudio::utility
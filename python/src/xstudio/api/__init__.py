@@ -10,6 +10,10 @@ from xstudio.api.intrinsic import Thumbnail
 from xstudio.api.intrinsic import MediaCache
 from xstudio.api.intrinsic import PluginManager
 from xstudio.api.intrinsic import Scanner
+from xstudio.api.intrinsic import ImageDiff
+from xstudio.api.intrinsic import ImageScopes, IMAGE_SCOPES_PLUGIN_UUID
+from xstudio.api.intrinsic import PixelSampler
+from xstudio.api.intrinsic import AudioWaveform
 from xstudio.api.auxiliary.helpers import Filesize
 from xstudio.api.auxiliary import ActorConnection
 
@@ -32,6 +36,10 @@ class API(CommonAPI):
         self._thumbnail = None
         self._scanner = None
         self._plugin_manager = None
+        self._image_diff = None
+        self._image_scopes = None
+        self._pixel_sampler = None
+        self._audio_waveform = None
 
     @property
     def app(self):
@@ -223,6 +231,66 @@ class API(CommonAPI):
 
         return self._scanner
 
+    @property
+    def image_diff(self):
+        """Image comparison engine, see ImageDiff.
+
+        Returns:
+            ImageDiff(object): If connected, `None` otherwise
+        """
+        if self._image_diff is None:
+            self._image_diff = ImageDiff(
+                self.connection,
+                self.get_actor_from_registry("MEDIAREADER").remote
+            )
+
+        return self._image_diff
+
+    @property
+    def image_scopes(self):
+        """Histograms and waveforms of the image on screen, see ImageScopes.
+
+        Returns:
+            ImageScopes(object): If connected, `None` otherwise
+        """
+        if self._image_scopes is None:
+            self._image_scopes = ImageScopes(
+                self.connection,
+                self.plugin_manager.get_plugin_instance(IMAGE_SCOPES_PLUGIN_UUID)
+            )
+
+        return self._image_scopes
+
+    @property
+    def pixel_sampler(self):
+        """Batch pixel and region sampling, see PixelSampler.
+
+        Returns:
+            PixelSampler(object): If connected, `None` otherwise
+        """
+        if self._pixel_sampler is None:
+            self._pixel_sampler = PixelSampler(
+                self.connection,
+                self.get_actor_from_registry("MEDIAREADER").remote
+            )
+
+        return self._pixel_sampler
+
+    @property
+    def audio_waveform(self):
+        """Audio waveform peaks, see AudioWaveform.
+
+        Returns:
+            AudioWaveform(object): If connected, `None` otherwise
+        """
+        if self._audio_waveform is None:
+            self._audio_waveform = AudioWaveform(
+                self.connection,
+                self.get_actor_from_registry("MEDIAREADER").remote
+            )
+
+        return self._audio_waveform
+
     @property
     def plugin_manager(self):
         """Global plugin manager actor.
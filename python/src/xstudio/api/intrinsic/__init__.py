@@ -5,5 +5,9 @@ from xstudio.api.intrinsic.thumbnail import Thumbnail
 from xstudio.api.intrinsic.plugin_manager import PluginManager
 from xstudio.api.intrinsic.history import History
 from xstudio.api.intrinsic.scanner import Scanner
+from xstudio.api.intrinsic.image_diff import ImageDiff
+from xstudio.api.intrinsic.image_scopes import ImageScopes, IMAGE_SCOPES_PLUGIN_UUID
+from xstudio.api.intrinsic.pixel_sampler import PixelSampler
+from xstudio.api.intrinsic.audio_waveform import AudioWaveform
 from xstudio.api.intrinsic.viewport import Viewport, OffscreenViewport
 from xstudio.api.intrinsic.colour_pipeline import ColourPipeline
@@ -0,0 +1,48 @@
+# SPDX-License-Identifier: Apache-2.0
+import json
+from xstudio.api.auxiliary import ActorConnection
+from xstudio.core import audio_waveform_atom
+
+class AudioWaveform(ActorConnection):
+    """Min/max/RMS waveform peaks of the audio of a media, at any zoom."""
+
+    def __init__(self, connection, remote):
+        """Create AudioWaveform object.
+
+        Args:
+            connection(Connection): Connection object
+            remote(actor): Global media reader actor object
+        """
+        ActorConnection.__init__(self, connection, remote)
+
+    def peaks(self, media, start_frame, end_frame, columns, channel=-1):
+        """Waveform peaks between two frames of the audio of a media.
+
+        The audio is decoded once, the first time it is asked for, and the
+        summary kept on disk for later sessions.
+
+        Args:
+            media(Media/MediaSource): Media to get the waveform of.
+            start_frame(float): First audio frame, may be fractional.
+            end_frame(float): Audio frame to end at (exclusive).
+            columns(int): Number of peaks to return.
+
+        Kwargs:
+            channel(int): Channel, or -1 to mix all channels.
+
+        Returns:
+            result(dict): "min", "max" and "rms" lists (-1 to 1) of columns
+            values, "sample_rate", "num_channels", "num_frames",
+            "num_samples", "start_sample" and "end_sample".
+        """
+        return json.loads(
+            self.connection.request_receive(
+                self.remote,
+                audio_waveform_atom(),
+                media.remote,
+                float(start_frame),
+                float(end_frame),
+                int(columns),
+                int(channel)
+            )[0].dump()
+        )
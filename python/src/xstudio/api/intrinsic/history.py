@@ -1,5 +1,6 @@
 # SPDX-License-Identifier: Apache-2.0
 from xstudio.core import clear_atom, enable_atom, count_atom, undo_atom, redo_atom
+from xstudio.core import budget_atom, stats_atom
 from xstudio.api.session import Container
 
 class History(Container):
@@ -61,6 +62,34 @@ class History(Container):
         """
         return self.connection.request_receive(self.remote, count_atom(), value)[0]
 
+    @property
+    def bytes(self):
+        """Get memory used by a sequence history
+
+        Returns:
+            bytes(int): Bytes.
+        """
+        return self.connection.request_receive(self.remote, budget_atom())[0]
+
+    def set_max_bytes(self, value):
+        """Sets memory budget shared by all sequence histories, dropping events beyond it
+        Args:
+            value(int): Set max bytes.
+
+        Returns:
+            success(bool): Budget set.
+        """
+        return self.connection.request_receive(self.remote, budget_atom(), value)[0]
+
+    @property
+    def stats(self):
+        """Get memory use and encode/decode times of a sequence history
+
+        Returns:
+            stats(JsonStore): Stats.
+        """
+        return self.connection.request_receive(self.remote, stats_atom())[0]
+
     def undo(self):
         """Undo
 
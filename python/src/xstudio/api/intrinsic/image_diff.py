@@ -0,0 +1,41 @@
+# SPDX-License-Identifier: Apache-2.0
+import json
+from xstudio.api.auxiliary import ActorConnection
+from xstudio.core import image_diff_atom
+
+class ImageDiff(ActorConnection):
+    """Compare the decoded images of two media, frame by frame."""
+
+    def __init__(self, connection, remote):
+        """Create ImageDiff object.
+
+        Args:
+            connection(Connection): Connection object
+            remote(actor): Global media reader actor object
+        """
+        ActorConnection.__init__(self, connection, remote)
+
+    def compare(self, media_a, media_b, tolerance=0.0):
+        """Compare two media, or media sources, frame by frame.
+
+        Frames are matched by position and compared on their raw (not colour
+        managed) RGBA values.
+
+        Args:
+            media_a(Media/MediaSource): First media.
+            media_b(Media/MediaSource): Second media.
+
+        Kwargs:
+            tolerance(float): Channel difference below which pixels count as the same.
+
+        Returns:
+            result(dict): Per frame stats ("frames") and a "summary". Each
+            frame has max_abs_diff, mean_abs_diff (RGBA), psnr (None if
+            identical), differing_pixels, pixel_count, hash_a, hash_b,
+            identical and error.
+        """
+        return json.loads(
+            self.connection.request_receive(
+                self.remote, image_diff_atom(), media_a.remote, media_b.remote, float(tolerance)
+            )[0].dump()
+        )
@@ -0,0 +1,49 @@
+# SPDX-License-Identifier: Apache-2.0
+import json
+from xstudio.api.auxiliary import ActorConnection
+from xstudio.core import image_scopes_atom, JsonStore, Uuid
+
+IMAGE_SCOPES_PLUGIN_UUID = Uuid("3c1d8e52-7a4f-4b0e-9d61-2f85c0a7e914")
+
+class ImageScopes(ActorConnection):
+    """Histograms and waveforms of the image on screen in a viewport."""
+
+    def __init__(self, connection, remote):
+        """Create ImageScopes object.
+
+        Args:
+            connection(Connection): Connection object
+            remote(actor): Image scopes HUD plugin actor object
+        """
+        ActorConnection.__init__(self, connection, remote)
+
+    def scopes(self, viewport_name="viewport0", settings=None):
+        """Measure the image currently on screen in a viewport.
+
+        Scopes are computed from the raw (not colour managed) RGB values,
+        sampled on a grid of at most max_samples points (64K by default).
+
+        Kwargs:
+            viewport_name(str): Name of the viewport.
+            settings(dict): Any of histogram_bins, waveform_columns,
+                waveform_rows, range_min, range_max, max_samples (0 to sample
+                every pixel) and max_threads.
+
+        Returns:
+            result(dict): "histograms" (red, green, blue and luma lists of
+            counts), "luma_waveform" (waveform_rows rows of waveform_columns
+            counts, bottom row first), "rgb_parade" (the same per channel),
+            "samples", "step", "settings" and "error".
+        """
+        if settings is None:
+            result = self.connection.request_receive(
+                self.remote, image_scopes_atom(), viewport_name
+            )[0]
+        else:
+            js = JsonStore()
+            js.parse_string(json.dumps(settings))
+            result = self.connection.request_receive(
+                self.remote, image_scopes_atom(), viewport_name, js
+            )[0]
+
+        return json.loads(result.dump())
@@ -0,0 +1,55 @@
+# SPDX-License-Identifier: Apache-2.0
+import json
+from xstudio.api.auxiliary import ActorConnection
+from xstudio.core import pixel_sample_atom, JsonStore
+
+class PixelSampler(ActorConnection):
+    """Read raw pixel values and region stats from every frame of a media."""
+
+    def __init__(self, connection, remote):
+        """Create PixelSampler object.
+
+        Args:
+            connection(Connection): Connection object
+            remote(actor): Global media reader actor object
+        """
+        ActorConnection.__init__(self, connection, remote)
+
+    def sample(self, media, points=None, regions=None, data_window=False, frames=None):
+        """Sample pixels and regions from a media, or media source.
+
+        Values are raw (not colour managed) RGBA as decoded by the reader.
+        Coordinates are image pixel coordinates, pixels outside the data
+        window read as zero.
+
+        Args:
+            media(Media/MediaSource): Media to sample.
+
+        Kwargs:
+            points(list): [x, y] pixels to read.
+            regions(list): [x0, y0, x1, y1] boxes (max exclusive) to measure.
+            data_window(bool): Also measure the whole data window.
+            frames(list): Indexes of the frames to sample, all if None.
+
+        Returns:
+            result(dict): "frame_count" and "frames", one per sampled frame
+            with "frame", "points" (RGBA per point), "regions" (region,
+            pixel_count, mean, min and max per region), "data_window" if
+            asked for, and "error".
+        """
+        request = {
+            "points": points or [],
+            "regions": regions or [],
+            "data_window": data_window
+        }
+        if frames is not None:
+            request["frames"] = list(frames)
+
+        js = JsonStore()
+        js.parse_string(json.dumps(request))
+
+        return json.loads(
+            self.connection.request_receive(
+                self.remote, pixel_sample_atom(), media.remote, js
+            )[0].dump()
+        )
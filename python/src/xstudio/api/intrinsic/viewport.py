@@ -1,9 +1,11 @@
 # SPDX-License-Identifier: Apache-2.0
+import json
 from xstudio.core import colour_pipeline_atom
 from xstudio.core import viewport_playhead_atom, quickview_media_atom
 from xstudio.core import UuidActorVec, UuidActor, viewport_atom
 from xstudio.core import get_global_playhead_events_atom, active_viewport_atom
 from xstudio.core import URI, render_viewport_to_image_atom
+from xstudio.core import frame_pacing_telemetry_atom, clear_atom
 from xstudio.api.session.playhead import Playhead
 from xstudio.api.module import ModuleBase
 from xstudio.api.intrinsic.colour_pipeline import ColourPipeline
@@ -96,6 +98,58 @@ class Viewport(ModuleBase):
         self.connection.request_receive(self.remote, viewport_playhead_atom(), playhead.remote)
         self.__playhead = Playhead(self.connection, self.connection.request_receive(self.remote, viewport_playhead_atom())[0])
 
+    def frame_pacing_telemetry(self, summary_only=True):
+        """Get frame pacing telemetry for the viewport. For every video refresh
+        during playback the viewport records which frame it should have shown
+        and which frame it did show, for each playhead that supplies it with
+        images.
+
+        Args:
+            summary_only(bool): Return only the per-playhead summary (late,
+                repeated and dropped frames, cache misses, read latency)
+
+        Returns:
+            telemetry(dict): Summary and (optionally) per refresh samples
+        """
+        return json.loads(
+            self.connection.request_receive(
+                self.remote,
+                frame_pacing_telemetry_atom(),
+                "summary" if summary_only else "json")[0])
+
+    def dump_frame_pacing_telemetry(self, path):
+        """Write the frame pacing telemetry samples to a CSV file.
+
+        Args:
+            path(str): The filesystem path to write to.
+        """
+        csv = self.connection.request_receive(
+            self.remote,
+            frame_pacing_telemetry_atom(),
+            "csv")[0]
+        with open(path, "w", newline="") as f:
+            f.write(csv)
+
+    def set_frame_pacing_telemetry(self, enabled=True, record_when_stopped=False, capacity=None):
+        """Configure frame pacing telemetry recording.
+
+        Args:
+            enabled(bool): Record telemetry
+            record_when_stopped(bool): Record samples when not playing
+            capacity(int): Number of samples kept per playhead (ring buffer size)
+        """
+        self.connection.send(
+            self.remote,
+            frame_pacing_telemetry_atom(),
+            enabled,
+            record_when_stopped)
+        if capacity is not None:
+            self.connection.send(self.remote, frame_pacing_telemetry_atom(), capacity)
+
+    def clear_frame_pacing_telemetry(self):
+        """Clear recorded frame pacing telemetry."""
+        self.connection.send(self.remote, frame_pacing_telemetry_atom(), clear_atom())
+
 class OffscreenViewport(Viewport):
 
     def __init__(self, connection, viewport_name = "snapshot_viewport"):
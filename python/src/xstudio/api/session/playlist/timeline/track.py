@@ -1,7 +1,7 @@
 # SPDX-License-Identifier: Apache-2.0
 from xstudio.core import insert_item_atom, remove_item_atom, erase_item_atom, move_item_atom
 from xstudio.core import split_item_at_frame_atom, split_item_atom, erase_item_at_frame_atom
-from xstudio.core import move_item_at_frame_atom
+from xstudio.core import move_item_at_frame_atom, item_actor_atom
 from xstudio.core import Uuid, actor, UuidActor, ItemType, UuidActorVec, FrameRateDuration
 from xstudio.api.session.playlist.timeline.item import Item
 from xstudio.api.session.playlist.timeline import create_item_container
@@ -243,4 +243,23 @@ class Track(Item, NotificationHandler):
         Returns:
             children([item]): Children.
         """
-        return [create_item_container(self.connection,i) for i in self.item.children() if i.item_type() in types]
+        return [self._child_container(i) for i in self.item.children() if i.item_type() in types]
+
+    @property
+    def children(self):
+        """Get children.
+
+        Returns:
+            children([Gap/Clip]): Children.
+        """
+        return [self._child_container(i) for i in self.item.children()]
+
+    def _child_container(self, item):
+        # gaps and clips of lightweight tracks get an actor when first asked for
+        if item.item_type() == ItemType.IT_GAP:
+            ua = self.connection.request_receive(self.remote, item_actor_atom(), item.uuid())[0]
+            return Gap(self.connection, ua.actor, ua.uuid)
+        if item.item_type() == ItemType.IT_CLIP:
+            ua = self.connection.request_receive(self.remote, item_actor_atom(), item.uuid())[0]
+            return Clip(self.connection, ua.actor, ua.uuid)
+        return create_item_container(self.connection, item)
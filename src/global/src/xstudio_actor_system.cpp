@@ -26,6 +26,7 @@ namespace detail {
 #include "xstudio/timeline/stack_actor.hpp"
 #include "xstudio/utility/helpers.hpp"
 #include "xstudio/utility/caf_helpers.hpp"
+#include "xstudio/utility/shared_json.hpp"
 #include "xstudio/conform/conformer.hpp"
 #include "xstudio/media_reader/audio_buffer.hpp"
 #include "xstudio/media_reader/image_buffer.hpp"
@@ -0,0 +1,147 @@
+// SPDX-License-Identifier: Apache-2.0
+
+// Memory and time to load media from a session, with their sources built
+// as actors and kept as a compact record until needed
+// (/core/session/lazy_media). Not run as part of the tests.
+//
+//   media_lazy_benchmark [media]
+
+#include <caf/all.hpp>
+#include <cstdlib>
+#include <fstream>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+#include "xstudio/atoms.hpp"
+#include "xstudio/global/global_actor.hpp"
+#include "xstudio/global/xstudio_actor_system.hpp"
+#include "xstudio/media/media_actor.hpp"
+#include "xstudio/utility/compact_json.hpp"
+#include "xstudio/utility/helpers.hpp"
+#include "xstudio/utility/json_interner.hpp"
+#include "xstudio/utility/logging.hpp"
+
+using namespace xstudio;
+using namespace xstudio::utility;
+using namespace xstudio::media;
+using namespace xstudio::global;
+
+using namespace caf;
+
+namespace {
+
+// resident memory, where we can tell
+size_t resident_bytes() {
+#ifdef __linux__
+    size_t pages    = 0;
+    size_t resident = 0;
+    std::ifstream statm("/proc/self/statm");
+    if (statm >> pages >> resident)
+        return resident * size_t(sysconf(_SC_PAGESIZE));
+#endif
+    return 0;
+}
+
+// a serialised media with a source, its detail and metadata, as a session
+// would hold it
+JsonStore media_record(caf::scoped_actor &self) {
+    auto source = self->spawn<MediaSourceActor>(
+        "test", posix_path_to_uri(TEST_RESOURCE "/media/test.{:04d}.exr"), FrameList(1, 10));
+    auto media = self->spawn<MediaActor>(
+        "test", Uuid(), UuidActorVector({UuidActor(Uuid::generate(), source)}));
+
+    request_receive<bool>(*self, media, media_metadata::get_metadata_atom_v);
+    request_receive<bool>(*self, media, acquire_media_detail_atom_v, FrameRate());
+    auto result = request_receive<JsonStore>(*self, media, serialise_atom_v);
+
+    self->send_exit(media, caf::exit_reason::user_shutdown);
+    return result;
+}
+
+struct Result {
+    long memory_{0};
+    double load_{0.0};
+    double serialise_{0.0};
+};
+
+// count media from record, as a playlist loads them
+Result
+load(caf::scoped_actor &self, const JsonStore &record, const int count, const bool lazy) {
+    Result result;
+    MediaActor::set_lazy_load(lazy);
+
+    const auto before = resident_bytes();
+    spdlog::stopwatch sw;
+
+    std::vector<caf::actor> media;
+    for (int i = 0; i < count; i++) {
+        auto jsn                         = record;
+        jsn["base"]["container"]["uuid"] = Uuid::generate();
+        media.emplace_back(self->spawn<MediaActor>(jsn, true));
+    }
+    // loaded once they answer
+    for (const auto &i : media)
+        request_receive<std::string>(*self, i, name_atom_v);
+    result.load_ = sw.elapsed().count();
+
+    sw.reset();
+    for (const auto &i : media)
+        request_receive<JsonStore>(*self, i, serialise_atom_v);
+    result.serialise_ = sw.elapsed().count();
+    result.memory_    = long(resident_bytes()) - long(before);
+
+    for (const auto &i : media)
+        self->send_exit(i, caf::exit_reason::user_shutdown);
+    MediaActor::set_lazy_load(false);
+    return result;
+}
+
+void report(const std::string &name, const Result &r) {
+    spdlog::info(
+        "{}: {:.1f}MB more resident, load {:.3f}s serialise {:.3f}s",
+        name,
+        double(r.memory_) / (1024.0 * 1024.0),
+        r.load_,
+        r.serialise_);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+
+    start_logger(spdlog::level::info);
+    CafActorSystem::instance();
+
+    const int count = argc > 1 ? std::max(std::atoi(argv[1]), 1) : 500;
+
+    caf::actor_system_config cfg;
+    caf::actor_system system(cfg);
+    caf::scoped_actor self(system);
+
+    auto gsa          = self->spawn<GlobalActor>();
+    const auto record = media_record(self);
+
+    // lazy first, so the actor run can't reuse memory it freed
+    const auto lazy   = load(self, record, count, true);
+    const auto actors = load(self, record, count, false);
+
+    // the dormant media keep a compact copy of what the actors would hold
+    auto source = static_cast<const nlohmann::json &>(record);
+    source.erase("base");
+    CompactJson compact(source);
+    compact.compress();
+
+    spdlog::info("{} media", count);
+    report("actors", actors);
+    report("lazy", lazy);
+    spdlog::info(
+        "record: {} bytes as json, {} bytes compact",
+        json_size_bytes(source),
+        compact.size_bytes());
+
+    self->send_exit(gsa, caf::exit_reason::user_shutdown);
+
+    return EXIT_SUCCESS;
+}
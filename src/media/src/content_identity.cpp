@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <filesystem>
+
+#include "xstudio/media/content_identity.hpp"
+#include "xstudio/utility/helpers.hpp"
+
+using namespace xstudio::media;
+using namespace xstudio::utility;
+
+namespace fs = std::filesystem;
+
+namespace {
+// a directory per sequence or movie folder, this is plenty
+constexpr size_t max_directories = 100000;
+} // namespace
+
+ContentIdentity &ContentIdentity::instance() {
+    static ContentIdentity s_identity;
+    return s_identity;
+}
+
+std::string ContentIdentity::resolve(const std::string &directory) {
+    {
+        std::scoped_lock lock(mutex_);
+        auto it = directories_.find(directory);
+        if (it != directories_.end())
+            return it->second;
+    }
+
+    // outside the lock, this may wait on the filesystem
+    std::error_code ec;
+    const auto canonical = fs::canonical(directory.empty() ? "/" : directory, ec);
+    auto result          = ec ? directory : canonical.generic_string();
+    if (result == "/")
+        result.clear();
+
+    std::scoped_lock lock(mutex_);
+    if (directories_.size() >= max_directories)
+        directories_.clear();
+    directories_.emplace(directory, result);
+    return result;
+}
+
+std::string ContentIdentity::location(const caf::uri &uri) {
+    if (uri.scheme() != "file")
+        return to_string(uri);
+
+    const auto path  = uri_to_posix_path(uri);
+    const auto slash = path.rfind('/');
+    if (slash == std::string::npos)
+        return to_string(uri);
+
+    const auto directory = path.substr(0, slash);
+    const auto resolved  = resolve(directory);
+
+    locations_++;
+    if (resolved != directory)
+        aliased_++;
+
+    return "file://" + resolved + path.substr(slash);
+}
+
+bool ContentIdentity::aliased(const caf::uri &uri) {
+    if (uri.scheme() != "file")
+        return false;
+
+    const auto path  = uri_to_posix_path(uri);
+    const auto slash = path.rfind('/');
+    if (slash == std::string::npos)
+        return false;
+
+    const auto directory = path.substr(0, slash);
+    return resolve(directory) != directory;
+}
+
+JsonStore ContentIdentity::stats() const {
+    std::scoped_lock lock(mutex_);
+    JsonStore result;
+    result["locations"]   = locations_.load();
+    result["aliased"]     = aliased_.load();
+    result["directories"] = directories_.size();
+    return result;
+}
+
+void ContentIdentity::clear() {
+    std::scoped_lock lock(mutex_);
+    directories_.clear();
+}
@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: Apache-2.0
+#include "xstudio/media/lookahead_window.hpp"
+
+using namespace xstudio::media;
+using namespace xstudio;
+
+AVFrameIDsAndTimePointsDelta
+LookaheadWindow::make_delta(const AVFrameIDsAndTimePoints &frames) {
+
+    AVFrameIDsAndTimePointsDelta delta;
+    delta.base_sequence_ = sequence_;
+    delta.sequence_      = ++sequence_;
+
+    const bool refresh_due =
+        !valid_ || !full_refresh_interval_ || !(sequence_ % full_refresh_interval_);
+
+    if (!refresh_due && !frames.empty()) {
+
+        // find where the new window starts in the current window. Frames are
+        // matched by pointer as the playhead hands out the same AVFrameID
+        // instances every time until its timeline is rebuilt
+        size_t drop_front = 0;
+        while (drop_front < frames_.size() &&
+               frames_[drop_front].second != frames.front().second) {
+            drop_front++;
+        }
+
+        if (drop_front < frames_.size()) {
+
+            const auto offset = std::chrono::duration_cast<std::chrono::microseconds>(
+                frames.front().first - frames_[drop_front].first);
+
+            // the rest of the current window must be at the start of the new
+            // window, and have moved by the same offset
+            bool retained = true;
+            size_t i      = 0;
+            for (auto p = frames_.begin() + drop_front; p != frames_.end(); ++p, ++i) {
+                if (i == frames.size() || p->second != frames[i].second) {
+                    retained = false;
+                    break;
+                }
+                const auto shift = std::chrono::duration_cast<std::chrono::microseconds>(
+                    frames[i].first - p->first);
+                if (std::chrono::abs(shift - offset) > time_tolerance_) {
+                    retained = false;
+                    break;
+                }
+            }
+
+            if (retained) {
+                delta.reset_       = false;
+                delta.drop_front_  = drop_front;
+                delta.time_offset_ = offset;
+                delta.appended_.assign(frames.begin() + i, frames.end());
+            }
+        }
+    }
+
+    if (delta.reset_)
+        delta.appended_ = frames;
+
+    frames_ = frames;
+    valid_  = true;
+    return delta;
+}
+
+std::optional<AVFrameIDsAndTimePointsDelta> LookaheadWindow::make_delta(
+    const size_t drop_front,
+    const std::chrono::microseconds time_offset,
+    AVFrameIDsAndTimePoints appended) {
+
+    const auto sequence = sequence_ + 1;
+    if (!valid_ || !full_refresh_interval_ || !(sequence % full_refresh_interval_))
+        return {};
+
+    AVFrameIDsAndTimePointsDelta delta;
+    delta.base_sequence_ = sequence_;
+    delta.sequence_      = sequence;
+    delta.reset_         = false;
+    delta.drop_front_    = drop_front;
+    delta.time_offset_   = time_offset;
+    delta.appended_      = std::move(appended);
+
+    // we no longer know the whole window, so a make_delta(frames) that
+    // follows this can't be diffed against it and will be a full window
+    frames_.clear();
+    sequence_ = sequence;
+    return delta;
+}
+
+bool LookaheadWindow::apply_delta(const AVFrameIDsAndTimePointsDelta &delta) {
+
+    if (delta.reset_) {
+        frames_   = delta.appended_;
+        sequence_ = delta.sequence_;
+        valid_    = true;
+        return true;
+    }
+
+    if (!valid_ || delta.base_sequence_ != sequence_ || delta.drop_front_ > frames_.size())
+        return false;
+
+    frames_.erase(frames_.begin(), frames_.begin() + delta.drop_front_);
+    if (delta.time_offset_ != std::chrono::microseconds(0)) {
+        for (auto &f : frames_)
+            f.first += delta.time_offset_;
+    }
+    frames_.insert(frames_.end(), delta.appended_.begin(), delta.appended_.end());
+    sequence_ = delta.sequence_;
+    return true;
+}
+
+void LookaheadWindow::reset() {
+    frames_.clear();
+    valid_ = false;
+}
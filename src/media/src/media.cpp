@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: Apache-2.0
 #include <iostream>
 
+#include "xstudio/media/content_identity.hpp"
 #include "xstudio/media/media.hpp"
 #include "xstudio/utility/json_store.hpp"
 
@@ -21,7 +22,7 @@ MediaKey::MediaKey(
     : std::string(
           fmt::format(
               fmt::runtime(key_format),
-              to_string(uri),
+              ContentIdentity::instance().location(uri),
               (frame == std::numeric_limits<int>::min() ? 0 : frame),
               stream_id,
               mod_timestamp,
@@ -29,6 +30,39 @@ MediaKey::MediaKey(
     hash_ = std::hash<std::string>{}(static_cast<const std::string &>(*this));
 }
 
+void xstudio::media::to_json(nlohmann::json &j, const StreamDetail &sd) {
+    j = nlohmann::json{
+        {"duration", sd.duration_},
+        {"name", sd.name_},
+        {"media_type", sd.media_type_},
+        {"key_format", sd.key_format_},
+        {"resolution", {sd.resolution_.x, sd.resolution_.y}},
+        {"pixel_aspect", sd.pixel_aspect_},
+        {"index", sd.index_}};
+}
+
+void xstudio::media::from_json(const nlohmann::json &j, StreamDetail &sd) {
+    j.at("duration").get_to(sd.duration_);
+    j.at("name").get_to(sd.name_);
+    sd.media_type_ = static_cast<MediaType>(j.at("media_type").get<int>());
+    j.at("key_format").get_to(sd.key_format_);
+    sd.resolution_ =
+        Imath::V2i(j.at("resolution").at(0).get<int>(), j.at("resolution").at(1).get<int>());
+    j.at("pixel_aspect").get_to(sd.pixel_aspect_);
+    j.at("index").get_to(sd.index_);
+}
+
+void xstudio::media::to_json(nlohmann::json &j, const MediaDetail &md) {
+    j = nlohmann::json{
+        {"reader", md.reader_}, {"streams", md.streams_}, {"timecode", md.timecode_}};
+}
+
+void xstudio::media::from_json(const nlohmann::json &j, MediaDetail &md) {
+    j.at("reader").get_to(md.reader_);
+    j.at("streams").get_to(md.streams_);
+    j.at("timecode").get_to(md.timecode_);
+}
+
 Media::Media(const JsonStore &jsn)
     : Container(static_cast<utility::JsonStore>(jsn["container"])) {
 
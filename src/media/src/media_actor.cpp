@@ -70,7 +70,12 @@ MediaActor::MediaActor(caf::actor_config &cfg, const JsonStore &jsn, const bool
 
     init();
 
-    if (async)
+    if (lazy_load_) {
+        auto record = static_cast<const nlohmann::json &>(jsn);
+        record.erase("base");
+        record_ = CompactJson(record);
+        record_->compress();
+    } else if (async)
         anon_mail(module::deserialise_atom_v, jsn).send(this);
     else
         deserialise(jsn);
@@ -1520,6 +1525,64 @@ caf::message_handler MediaActor::message_handler() {
         }};
 }
 
+caf::behavior MediaActor::make_behavior() {
+    // only make this once, it spawns our event group
+    auto container_handler = base_.container_message_handler(this);
+
+    if (not record_)
+        return message_handler().or_else(container_handler);
+
+    behaviour_ = message_handler().or_else(container_handler);
+    return dormant_message_handler().or_else(container_handler).or_else(
+        [=](caf::message &msg) -> caf::message {
+            // anything else needs our sources, build them and handle it here,
+            // ahead of anything already behind it in the mailbox. Handlers
+            // that answer later have taken their response promise by now.
+            wake();
+            if (auto result = behaviour_(msg))
+                return std::move(*result);
+            return caf::make_message(make_error(caf::sec::unexpected_message));
+        });
+}
+
+caf::message_handler MediaActor::dormant_message_handler() {
+    return caf::message_handler{
+        [=](xstudio::broadcast::broadcast_down_atom, const caf::actor_addr &) {},
+
+        // keep the filters, display info is built when woken
+        [=](utility::event_atom,
+            media::media_display_info_atom,
+            const utility::JsonStore &metadata_filter_sets) {
+            media_list_columns_config_ =
+                utility::json_to_tree(metadata_filter_sets, "children");
+        },
+
+        [=](bookmark::get_bookmarks_atom) -> utility::UuidList { return bookmark_uuids_; },
+
+        [=](playlist::reflag_container_atom) -> std::tuple<std::string, std::string> {
+            return std::make_tuple(base_.flag(), base_.flag_text());
+        },
+
+        [=](utility::serialise_atom) -> JsonStore {
+            auto jsn    = record_->json();
+            jsn["base"] = base_.serialise();
+            return jsn;
+        }};
+}
+
+void MediaActor::wake() {
+    const auto jsn = record_->json();
+    record_.reset();
+    become(behaviour_);
+
+    try {
+        deserialise(jsn);
+    } catch (const std::exception &err) {
+        spdlog::warn("{} {} {}", __PRETTY_FUNCTION__, err.what(), to_string(base_.uuid()));
+    }
+
+    anon_mail(media_display_info_atom_v).send(this);
+}
 
 void MediaActor::init() {
     // only parial..
@@ -10,6 +10,7 @@
 #include "xstudio/broadcast/broadcast_actor.hpp"
 #include "xstudio/global_store/global_store.hpp"
 #include "xstudio/json_store/json_store_actor.hpp"
+#include "xstudio/media/content_identity.hpp"
 #include "xstudio/media/media_actor.hpp"
 #include "xstudio/playhead/sub_playhead.hpp"
 #include "xstudio/utility/helpers.hpp"
@@ -1006,6 +1007,9 @@ caf::message_handler MediaSourceActor::message_handler() {
             media::MediaKeyVector keys(all_requested_frames_.size());
             std::copy(all_requested_frames_.begin(), all_requested_frames_.end(), keys.begin());
 
+            // directories may have been relinked since we resolved them
+            media::ContentIdentity::instance().clear();
+
             auto image_cache =
                 system().registry().template get<caf::actor>(image_cache_registry);
             auto audio_cache =
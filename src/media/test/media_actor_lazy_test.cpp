@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <caf/all.hpp>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+
+#include "xstudio/atoms.hpp"
+#include "xstudio/global/global_actor.hpp"
+#include "xstudio/media/media_actor.hpp"
+#include "xstudio/utility/helpers.hpp"
+
+using namespace xstudio;
+using namespace xstudio::utility;
+using namespace xstudio::media;
+using namespace xstudio::media_metadata;
+using namespace xstudio::global;
+
+using namespace caf;
+using namespace std::chrono_literals;
+
+#include "xstudio/utility/serialise_headers.hpp"
+
+ACTOR_TEST_SETUP()
+
+namespace {
+
+// a serialised media with a source, its detail and metadata, as a session
+// would hold it
+JsonStore media_record(fixture &f) {
+    auto source = f.self->spawn<MediaSourceActor>(
+        "test", posix_path_to_uri(TEST_RESOURCE "/media/test.{:04d}.exr"), FrameList(1, 10));
+    auto media = f.self->spawn<MediaActor>(
+        "test", Uuid(), UuidActorVector({UuidActor(Uuid::generate(), source)}));
+
+    request_receive<bool>(*(f.self), media, get_metadata_atom_v);
+    request_receive<bool>(*(f.self), media, acquire_media_detail_atom_v, FrameRate());
+    auto result = request_receive<JsonStore>(*(f.self), media, serialise_atom_v);
+
+    f.self->send_exit(media, caf::exit_reason::user_shutdown);
+    std::this_thread::sleep_for(200ms);
+    return result;
+}
+
+} // namespace
+
+TEST(MediaActorLazyTest, Test) {
+    fixture f;
+    auto gsa          = f.self->spawn<GlobalActor>();
+    const auto record = media_record(f);
+
+    MediaActor::set_lazy_load(true);
+    const auto before = f.system.registry().running();
+    auto media        = f.self->spawn<MediaActor>(record, true);
+    MediaActor::set_lazy_load(false);
+
+    // answered from the record, no sources built
+    EXPECT_EQ(request_receive<std::string>(*(f.self), media, name_atom_v), "test");
+    EXPECT_EQ(
+        request_receive<Uuid>(*(f.self), media, uuid_atom_v),
+        record.at("base").at("container").at("uuid").get<Uuid>());
+    EXPECT_EQ(request_receive<JsonStore>(*(f.self), media, serialise_atom_v), record);
+    const auto dormant = f.system.registry().running() - before;
+
+    // renamed while dormant
+    f.self->mail(name_atom_v, "renamed").send(media);
+    EXPECT_EQ(request_receive<std::string>(*(f.self), media, name_atom_v), "renamed");
+
+    // asking for a source wakes it
+    const auto sources =
+        request_receive<std::vector<UuidActor>>(*(f.self), media, get_media_source_atom_v);
+    ASSERT_EQ(sources.size(), size_t(1));
+    EXPECT_EQ(sources.front().uuid(), record.at("base").at("current").get<Uuid>());
+    EXPECT_GT(f.system.registry().running() - before, dormant);
+
+    // and it is the same media
+    auto woken = request_receive<JsonStore>(*(f.self), media, serialise_atom_v);
+    EXPECT_EQ(woken.at("base").at("container").at("name"), "renamed");
+    woken["base"]["container"]["name"] = "test";
+    EXPECT_EQ(woken, record);
+
+    // woken by a request answered later, the answer still comes back
+    MediaActor::set_lazy_load(true);
+    auto other = f.self->spawn<MediaActor>(record, true);
+    MediaActor::set_lazy_load(false);
+    EXPECT_EQ(
+        request_receive<MediaStatus>(*(f.self), other, media_status_atom_v),
+        request_receive<MediaStatus>(*(f.self), media, media_status_atom_v));
+
+    f.self->send_exit(other, caf::exit_reason::user_shutdown);
+    f.self->send_exit(media, caf::exit_reason::user_shutdown);
+    f.self->send_exit(gsa, caf::exit_reason::user_shutdown);
+}
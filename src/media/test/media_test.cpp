@@ -1,6 +1,10 @@
 // SPDX-License-Identifier: Apache-2.0
 #include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
 
+#include "xstudio/media/content_identity.hpp"
+#include "xstudio/media/lookahead_window.hpp"
 #include "xstudio/media/media.hpp"
 #include "xstudio/utility/frame_list.hpp"
 #include "xstudio/utility/helpers.hpp"
@@ -77,3 +81,172 @@ TEST(MediaSourceTest, Test) {
 }
 
 TEST(MediaStreamTest, Test) {}
+
+TEST(MediaDetailTest, JsonTest) {
+
+    MediaDetail md(
+        "FFMPEG",
+        {StreamDetail(
+             FrameRateDuration(100, FrameRate(timebase::k_flicks_24fps)),
+             "video",
+             MT_IMAGE,
+             "{0}@{1}/{2},{3}",
+             Imath::V2i(1920, 1080),
+             1.0f,
+             0),
+         StreamDetail(
+             FrameRateDuration(100, FrameRate(timebase::k_flicks_24fps)),
+             "audio",
+             MT_AUDIO,
+             "{0}@{1}/{2},{3}",
+             Imath::V2i(0, 0),
+             1.0f,
+             1)},
+        Timecode("01:00:00:00", 24.0));
+
+    nlohmann::json j = md;
+    EXPECT_EQ(j.get<MediaDetail>(), md);
+}
+
+TEST(LookaheadWindowTest, Test) {
+
+    std::vector<std::shared_ptr<const AVFrameID>> ids;
+    for (int i = 0; i < 64; ++i)
+        ids.push_back(std::make_shared<const AVFrameID>(
+            posix_path_to_uri("/tmp/test/test.{:04d}.exr"), i, 0));
+
+    const auto t0 = xstudio::utility::clock::now();
+    auto window   = [&](const int start, const int count, const int offset_us) {
+        AVFrameIDsAndTimePoints result;
+        for (int i = start; i < start + count; ++i)
+            result.emplace_back(
+                t0 + std::chrono::milliseconds(40 * i) + std::chrono::microseconds(offset_us),
+                ids[i]);
+        return result;
+    };
+
+    LookaheadWindow sender(std::chrono::milliseconds(2), 0xffff);
+    LookaheadWindow receiver;
+
+    // first update is always the full window
+    auto delta = sender.make_delta(window(0, 10, 0));
+    EXPECT_TRUE(delta.reset_);
+    EXPECT_EQ(delta.appended_.size(), size_t(10));
+    EXPECT_TRUE(receiver.apply_delta(delta));
+
+    // window slides on by two frames
+    delta = sender.make_delta(window(2, 10, 0));
+    EXPECT_FALSE(delta.reset_);
+    EXPECT_EQ(delta.drop_front_, size_t(2));
+    EXPECT_EQ(delta.time_offset_, std::chrono::microseconds(0));
+    EXPECT_EQ(delta.appended_.size(), size_t(2));
+    EXPECT_TRUE(receiver.apply_delta(delta));
+    EXPECT_EQ(receiver.frames(), window(2, 10, 0));
+
+    // and again, with the timing shifted
+    delta = sender.make_delta(window(3, 12, 500));
+    EXPECT_FALSE(delta.reset_);
+    EXPECT_EQ(delta.drop_front_, size_t(1));
+    EXPECT_EQ(delta.time_offset_, std::chrono::microseconds(500));
+    EXPECT_EQ(delta.appended_.size(), size_t(3));
+    EXPECT_TRUE(receiver.apply_delta(delta));
+    EXPECT_EQ(receiver.frames(), window(3, 12, 500));
+
+    // jump to somewhere else entirely
+    delta = sender.make_delta(window(20, 10, 0));
+    EXPECT_TRUE(delta.reset_);
+    EXPECT_TRUE(receiver.apply_delta(delta));
+    EXPECT_EQ(receiver.frames(), window(20, 10, 0));
+
+    // retained frames with inconsistent timing
+    auto frames = window(21, 10, 0);
+    frames[3].first += std::chrono::milliseconds(10);
+    delta = sender.make_delta(frames);
+    EXPECT_TRUE(delta.reset_);
+    EXPECT_TRUE(receiver.apply_delta(delta));
+
+    // receiver that has lost track must refuse a delta
+    receiver.reset();
+    delta = sender.make_delta(window(25, 10, 0));
+    EXPECT_FALSE(delta.reset_);
+    EXPECT_FALSE(receiver.apply_delta(delta));
+
+    // sender resets, receiver is back in step
+    sender.reset();
+    delta = sender.make_delta(window(25, 10, 0));
+    EXPECT_TRUE(delta.reset_);
+    EXPECT_TRUE(receiver.apply_delta(delta));
+    EXPECT_EQ(receiver.frames(), window(25, 10, 0));
+
+    // periodic full refresh
+    LookaheadWindow refreshing(std::chrono::milliseconds(2), 4);
+    int resets = 0;
+    for (int i = 0; i < 16; ++i)
+        resets += refreshing.make_delta(window(i, 10, 0)).reset_ ? 1 : 0;
+    EXPECT_EQ(resets, 5);
+
+    // a sender that moves its own window along
+    LookaheadWindow moving(std::chrono::milliseconds(2), 4);
+    receiver.reset();
+    EXPECT_FALSE(moving.make_delta(1, std::chrono::microseconds(0), window(10, 1, 0)));
+    EXPECT_TRUE(receiver.apply_delta(moving.make_delta(window(0, 10, 0))));
+
+    auto moved = moving.make_delta(2, std::chrono::microseconds(500), window(10, 2, 500));
+    ASSERT_TRUE(moved);
+    EXPECT_FALSE(moved->reset_);
+    EXPECT_TRUE(receiver.apply_delta(*moved));
+    EXPECT_EQ(receiver.frames(), window(2, 10, 500));
+    EXPECT_TRUE(moving.frames().empty());
+
+    // until a full refresh is due
+    moved = moving.make_delta(0, std::chrono::microseconds(0), {});
+    ASSERT_TRUE(moved);
+    EXPECT_TRUE(receiver.apply_delta(*moved));
+    EXPECT_FALSE(moving.make_delta(0, std::chrono::microseconds(0), {}));
+    delta = moving.make_delta(window(2, 10, 500));
+    EXPECT_TRUE(delta.reset_);
+    EXPECT_TRUE(receiver.apply_delta(delta));
+}
+
+TEST(ContentIdentityTest, Test) {
+    namespace fs   = std::filesystem;
+    const auto dir = fs::canonical(fs::temp_directory_path()) /
+                     ("xstudio_identity_" + to_string(Uuid::generate()));
+    fs::create_directories(dir / "plates");
+    std::ofstream(dir / "plates" / "a.0001.exr") << "pixels";
+    fs::create_directory_symlink(dir / "plates", dir / "link");
+
+    const auto real = posix_path_to_uri((dir / "plates" / "a.0001.exr").string());
+    const auto link = posix_path_to_uri((dir / "link" / "a.0001.exr").string());
+    const auto dots =
+        posix_path_to_uri((dir / "link" / ".." / "plates" / "a.0001.exr").string());
+
+    auto &identity = ContentIdentity::instance();
+    EXPECT_EQ(identity.location(link), identity.location(real));
+    EXPECT_EQ(identity.location(dots), identity.location(real));
+    EXPECT_TRUE(identity.aliased(link));
+    EXPECT_FALSE(identity.aliased(real));
+
+    // keys name the frame, not the reference to it
+    const auto key = [](const caf::uri &uri, const int frame) {
+        return MediaKey("{0}@{1}/{2},{3}", uri, frame, "stream 0", 10, FrameRate());
+    };
+    EXPECT_EQ(key(link, 1), key(real, 1));
+    EXPECT_NE(key(link, 2), key(real, 1));
+
+    // a symlinked file isn't followed, only its directory is
+    fs::create_symlink(dir / "plates" / "a.0001.exr", dir / "plates" / "b.0001.exr");
+    const auto file_link = posix_path_to_uri((dir / "plates" / "b.0001.exr").string());
+    EXPECT_NE(identity.location(file_link), identity.location(real));
+    EXPECT_FALSE(identity.aliased(file_link));
+
+    // missing directories and other schemes are left as they are
+    const auto missing = posix_path_to_uri((dir / "missing" / "a.0001.exr").string());
+    EXPECT_FALSE(identity.aliased(missing));
+    const auto web = *caf::make_uri("http://example.com/a.0001.exr");
+    EXPECT_EQ(identity.location(web), to_string(web));
+
+    EXPECT_GE(identity.stats().at("aliased").get<size_t>(), size_t(2));
+
+    fs::remove_all(dir);
+}
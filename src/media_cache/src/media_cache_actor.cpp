@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: Apache-2.0
 #include <caf/actor_registry.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <functional>
 #ifndef __apple__
@@ -11,6 +12,7 @@
 #include "xstudio/broadcast/broadcast_actor.hpp"
 #include "xstudio/colour_pipeline/colour_pipeline.hpp"
 #include "xstudio/global_store/global_store.hpp"
+#include "xstudio/media/content_identity.hpp"
 #include "xstudio/media_cache/media_cache_actor.hpp"
 #include "xstudio/utility/helpers.hpp"
 #include "xstudio/utility/json_store.hpp"
@@ -118,6 +120,14 @@ GlobalImageCacheActor::GlobalImageCacheActor(caf::actor_config &cfg)
 
         [=](count_atom) -> size_t { return cache_.count(); },
 
+        [=](dedup_atom) -> JsonStore {
+            JsonStore result;
+            result["shared_frames"] = shared_frames_;
+            result["shared_bytes"]  = shared_bytes_;
+            result["identity"]      = media::ContentIdentity::instance().stats();
+            return result;
+        },
+
         [=](erase_atom, const media::MediaKey &key) { cache_.erase(key); },
 
         [=](erase_atom, const media::MediaKey &key, const utility::Uuid &uuid) {
@@ -199,8 +209,31 @@ GlobalImageCacheActor::GlobalImageCacheActor(caf::actor_config &cfg)
             media::AVFrameIDsAndTimePoints result;
             result.reserve(mpts.size());
             for (const auto &p : mpts) {
-                if (!cache_.preserve(p.second->key(), p.first, uuid)) {
+                const auto &key = p.second->key();
+                if (!cache_.preserve(key, p.first, uuid)) {
+                    // frames asked for but never stored would stay otherwise
+                    if (key_sources_.size() > 2 * cache_.count() + 1024) {
+                        for (auto it = key_sources_.begin(); it != key_sources_.end();) {
+                            if (cache_.cache_.count(it->first))
+                                ++it;
+                            else
+                                it = key_sources_.erase(it);
+                        }
+                    }
+                    key_sources_.try_emplace(
+                        key, std::vector<utility::Uuid>({p.second->source_uuid()}));
                     result.push_back(p);
+                } else {
+                    auto sources = key_sources_.find(key);
+                    if (sources != key_sources_.end() and
+                        std::find(
+                            sources->second.begin(),
+                            sources->second.end(),
+                            p.second->source_uuid()) == sources->second.end()) {
+                        sources->second.push_back(p.second->source_uuid());
+                        shared_frames_++;
+                        shared_bytes_ += cache_.size(key);
+                    }
                 }
             }
             return result;
@@ -299,8 +332,10 @@ void GlobalImageCacheActor::update_changes(
         erased_keys_.erase(i);
 
     erased_keys_.insert(erase.begin(), erase.end());
-    for (const auto &i : erase)
+    for (const auto &i : erase) {
         new_keys_.erase(i);
+        key_sources_.erase(i);
+    }
 
     if (not update_pending_ and (not new_keys_.empty() or not erased_keys_.empty())) {
         update_pending_ = true;
@@ -21,8 +21,10 @@ using namespace xstudio::media_metadata;
 using namespace caf;
 
 MediaMetadataWorkerActor::MediaMetadataWorkerActor(
-    caf::actor_config &cfg, const utility::JsonStore &prefs)
-    : caf::event_based_actor(cfg) {
+    caf::actor_config &cfg,
+    const utility::JsonStore &prefs,
+    std::shared_ptr<utility::FileProbeCache> probe_cache)
+    : caf::event_based_actor(cfg), probe_cache_(std::move(probe_cache)) {
 
     auto pm = system().registry().template get<caf::actor>(plugin_manager_registry);
     // get plugins
@@ -45,6 +47,13 @@ MediaMetadataWorkerActor::MediaMetadataWorkerActor(
                 name_plugin_[i.name_] = actor;
             }
         }
+
+        try {
+            probe_prefs_ = prefs.get("/plugin/media_metadata");
+        } catch (...) {
+        }
+        probe_fingerprint_ = plugin_manager::plugin_fingerprint(
+            details, plugin_manager::PluginFlags::PF_MEDIA_METADATA, probe_prefs_);
     }
 
     behavior_.assign(
@@ -74,6 +83,8 @@ MediaMetadataWorkerActor::MediaMetadataWorkerActor(
                     }
                 }
             }
+            probe_fingerprint_ = plugin_manager::plugin_fingerprint(
+                detail, plugin_manager::PluginFlags::PF_MEDIA_METADATA, probe_prefs_);
         },
 
         [=](get_metadata_atom atom,
@@ -83,6 +94,20 @@ MediaMetadataWorkerActor::MediaMetadataWorkerActor(
 
             if (plugins_.empty())
                 return make_error(xstudio_error::error, "Unsupported format");
+
+            const auto path    = uri_to_posix_path(_uri);
+            const auto sub_key = std::to_string(frame);
+            if (probe_cache_) {
+                if (auto hit = probe_cache_->find(path, probe_fingerprint_, sub_key)) {
+                    try {
+                        return std::make_pair(
+                            JsonStore((*hit)["metadata"]), (*hit)["frame"].get<int>());
+                    } catch (...) {
+                        probe_cache_->erase(path, sub_key);
+                    }
+                }
+            }
+
             // supported ?
             // fanout and find best match.
             try {
@@ -108,8 +133,26 @@ MediaMetadataWorkerActor::MediaMetadataWorkerActor(
                             if (best_match == MMC_NO) {
                                 rp.deliver(
                                     make_error(xstudio_error::error, "Unsupported format"));
-                            } else {
+                            } else if (not probe_cache_) {
                                 rp.delegate(name_plugin_.at(selected), atom, _uri, frame);
+                            } else {
+                                const auto fingerprint = probe_fingerprint_;
+                                mail(atom, _uri, frame)
+                                    .request(name_plugin_.at(selected), infinite)
+                                    .then(
+                                        [=](const std::pair<JsonStore, int> &result) mutable {
+                                            probe_cache_->store(
+                                                path,
+                                                fingerprint,
+                                                nlohmann::json{
+                                                    {"metadata", result.first},
+                                                    {"frame", result.second}},
+                                                sub_key);
+                                            rp.deliver(result);
+                                        },
+                                        [=](error &err) mutable {
+                                            rp.deliver(std::move(err));
+                                        });
                             }
                         },
                         [=](error &err) mutable { rp.deliver(std::move(err)); });
@@ -154,13 +197,16 @@ GlobalMediaMetadataActor::GlobalMediaMetadataActor(caf::actor_config &cfg)
     } catch (...) {
     }
 
+    probe_cache_ = std::make_shared<FileProbeCache>("media_metadata");
+    update_probe_cache_preferences(j);
+
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
 
     auto pool = caf::actor_pool::make(
         system(),
         worker_count,
-        [&] { return system().spawn<MediaMetadataWorkerActor>(j); },
+        [&] { return system().spawn<MediaMetadataWorkerActor>(j, probe_cache_); },
         caf::actor_pool::round_robin());
 
 #pragma GCC diagnostic pop
@@ -202,6 +248,7 @@ GlobalMediaMetadataActor::GlobalMediaMetadataActor(caf::actor_config &cfg)
         },
 
         [=](json_store::update_atom, const JsonStore &j) mutable {
+            update_probe_cache_preferences(j);
             try {
                 auto count =
                     preference_value<size_t>(j, "/core/media_metadata/max_worker_count");
@@ -213,7 +260,9 @@ GlobalMediaMetadataActor::GlobalMediaMetadataActor(caf::actor_config &cfg)
                         count);
                     while (worker_count < count) {
                         anon_mail(
-                            sys_atom_v, put_atom_v, system().spawn<MediaMetadataWorkerActor>(j))
+                            sys_atom_v,
+                            put_atom_v,
+                            system().spawn<MediaMetadataWorkerActor>(j, probe_cache_))
                             .send(pool);
                         worker_count++;
                     }
@@ -242,4 +291,21 @@ GlobalMediaMetadataActor::GlobalMediaMetadataActor(caf::actor_config &cfg)
         });
 }
 
-void GlobalMediaMetadataActor::on_exit() { system().registry().erase(media_metadata_registry); }
+void GlobalMediaMetadataActor::on_exit() {
+    probe_cache_->flush();
+    system().registry().erase(media_metadata_registry);
+}
+
+void GlobalMediaMetadataActor::update_probe_cache_preferences(const utility::JsonStore &prefs) {
+    // shares its settings with the media detail cache
+    try {
+        probe_cache_->set_enabled(
+            preference_value<bool>(prefs, "/core/media_reader/probe_cache/enabled"));
+        probe_cache_->set_max_count(
+            preference_value<size_t>(prefs, "/core/media_reader/probe_cache/max_count"));
+        probe_cache_->set_directory(expand_envvars(
+            preference_value<std::string>(prefs, "/core/media_reader/probe_cache/path")));
+    } catch (const std::exception &e) {
+        spdlog::warn("{} {}", __PRETTY_FUNCTION__, e.what());
+    }
+}
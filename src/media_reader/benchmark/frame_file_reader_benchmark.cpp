@@ -0,0 +1,136 @@
+// SPDX-License-Identifier: Apache-2.0
+
+// Throughput reading frames not read before, one after another as a decoder
+// would, against the FrameFileReader reading ahead. Not run as part of the
+// tests.
+//
+//   frame_file_reader_benchmark [frames]
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "xstudio/media_reader/frame_file_reader.hpp"
+#include "xstudio/utility/logging.hpp"
+
+using namespace xstudio;
+using namespace xstudio::utility;
+using namespace xstudio::media_reader;
+
+namespace fs = std::filesystem;
+
+#ifndef _WIN32
+
+namespace {
+
+// A sequence of count files of size bytes, each filled with its index.
+class Sequence {
+  public:
+    Sequence(const std::string &name, const size_t count, const size_t size) {
+        directory_ = fs::temp_directory_path() / (name + "_" + std::to_string(::getpid()));
+        fs::create_directories(directory_);
+        std::vector<char> data(size);
+        for (size_t i = 0; i < count; i++) {
+            std::memset(data.data(), int('a' + i % 26), size);
+            paths_.push_back((directory_ / (std::to_string(i) + ".exr")).string());
+            std::ofstream(paths_.back(), std::ios::binary).write(data.data(), size);
+        }
+    }
+    ~Sequence() { fs::remove_all(directory_); }
+
+    // out of the page cache, as frames not read before would be
+    void drop_cache() const {
+        for (const auto &i : paths_) {
+            auto fd = ::open(i.c_str(), O_RDONLY);
+            fdatasync(fd);
+#ifdef POSIX_FADV_DONTNEED
+            posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+#endif
+            ::close(fd);
+        }
+    }
+
+    fs::path directory_;
+    std::vector<std::string> paths_;
+};
+
+} // namespace
+
+int main(int argc, char **argv) {
+
+    start_logger(spdlog::level::info);
+
+    const size_t count = argc > 1 ? std::max(std::atoi(argv[1]), 1) : 32;
+    const size_t size  = 8 * 1024 * 1024;
+    Sequence seq("frame_file_reader_benchmark", count, size);
+    std::vector<char> data(size);
+
+    auto mb_per_second = [&](const double seconds) {
+        return double(count * size) / (1024.0 * 1024.0) / seconds;
+    };
+
+    seq.drop_cache();
+    spdlog::stopwatch sw;
+    size_t read = 0;
+    for (const auto &i : seq.paths_) {
+        std::ifstream inp(i, std::ios::binary);
+        inp.read(data.data(), size);
+        read += size_t(inp.gcount());
+    }
+    const auto buffered = mb_per_second(sw.elapsed().count());
+
+    FrameFileReader reader;
+    seq.drop_cache();
+    sw.reset();
+    reader.prefetch(seq.paths_);
+    std::vector<FileBytesPtr> taken;
+    for (const auto &i : seq.paths_) {
+        // as a decoder would if it had nothing else to do
+        while (reader.reading(i))
+            std::this_thread::yield();
+        taken.push_back(reader.take(i));
+    }
+    const auto prefetched = mb_per_second(sw.elapsed().count());
+
+    const auto stats = reader.stats();
+    spdlog::info(
+        "{} frames of {}MB, buffered {:.0f} MB/s, read ahead {:.0f} MB/s ({}, {} direct)",
+        count,
+        size / (1024 * 1024),
+        buffered,
+        prefetched,
+        stats.at("backend").get<std::string>(),
+        stats.at("direct_reads").get<size_t>());
+
+    for (size_t i = 0; i < count; i++) {
+        if (not taken[i] or taken[i]->size() != size or
+            taken[i]->data()[size - 1] != char('a' + i % 26)) {
+            spdlog::error("Frame {} wasn't read", i);
+            return EXIT_FAILURE;
+        }
+    }
+    if (read != count * size) {
+        spdlog::error("Buffered reads came up short");
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+#else
+
+int main(int, char **) {
+    start_logger(spdlog::level::info);
+    spdlog::warn("frame_file_reader_benchmark is POSIX only");
+    return EXIT_SUCCESS;
+}
+
+#endif
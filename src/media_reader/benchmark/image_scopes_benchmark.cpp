@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: Apache-2.0
+
+// Time to compute the scopes of a 4K UHD float image, sampled with the
+// default settings and at every pixel. Not run as part of the tests.
+//
+//   image_scopes_benchmark [iterations]
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "xstudio/media_reader/image_scopes.hpp"
+#include "xstudio/utility/logging.hpp"
+
+using namespace xstudio;
+using namespace xstudio::utility;
+using namespace xstudio::media_reader;
+
+namespace {
+
+// float RGBA, tightly packed over the data window
+void float_rgba_unpack(
+    const ImageBuffer &buf,
+    const JsonStore &,
+    const int x,
+    const int y,
+    const int count,
+    float *rgba) {
+    const auto box   = buf.image_pixels_bounding_box();
+    const auto width = box.max.x - box.min.x;
+    const auto *data = reinterpret_cast<const float *>(buf.buffer());
+    std::copy(
+        data + (size_t(y - box.min.y) * width + (x - box.min.x)) * 4,
+        data + (size_t(y - box.min.y) * width + (x - box.min.x) + count) * 4,
+        rgba);
+}
+
+// a ramp across the image
+ImageBufPtr make_image(const int width, const int height) {
+    ImageBufPtr result(new ImageBuffer());
+    result->set_image_dimensions(Imath::V2i(width, height));
+    auto *data =
+        reinterpret_cast<float *>(result->allocate(size_t(width) * height * 4 * sizeof(float)));
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            auto *p = data + (size_t(y) * width + x) * 4;
+            std::fill(p, p + 3, float(x) / float(width));
+            p[3] = 1.0f;
+        }
+    }
+    result->set_pixel_unpack_func(&float_rgba_unpack);
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+
+    start_logger(spdlog::level::info);
+
+    const int iterations = argc > 1 ? std::max(std::atoi(argv[1]), 1) : 20;
+    const auto image     = make_image(3840, 2160);
+
+    auto run = [&](const ImageScopesSettings &settings, const std::string &name) {
+        size_t samples = 0;
+        spdlog::stopwatch sw;
+        for (int i = 0; i < iterations; ++i)
+            samples = compute_image_scopes(image, settings).samples_;
+        spdlog::info(
+            "4K scopes, {}: {} samples in {:.3f}ms",
+            name,
+            samples,
+            sw.elapsed().count() * 1000.0 / iterations);
+        return samples;
+    };
+
+    const auto sampled = run(ImageScopesSettings(), "default sampling");
+
+    ImageScopesSettings every_pixel;
+    every_pixel.max_samples_ = 0;
+    const auto full = run(every_pixel, "every pixel");
+
+    if (sampled > ImageScopesSettings().max_samples_ or full != size_t(3840) * 2160) {
+        spdlog::error("Unexpected sample counts {} {}", sampled, full);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,380 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+#include "xstudio/media_reader/audio_buffer.hpp"
+#include "xstudio/media_reader/audio_waveform.hpp"
+
+using namespace xstudio;
+using namespace xstudio::media_reader;
+
+namespace {
+
+constexpr char file_magic[4]        = {'X', 'S', 'W', 'F'};
+constexpr uint32_t file_version     = 1;
+constexpr size_t add_samples_chunk  = 4096;
+constexpr uint64_t max_file_samples = uint64_t(1) << 40;
+constexpr int32_t max_file_channels = 1024;
+constexpr uint64_t file_peak_size   = sizeof(int16_t) * 2 + sizeof(uint16_t);
+constexpr double peaks_per_column   = 4.0;
+
+inline int16_t to_peak_value(const float v) {
+    return static_cast<int16_t>(std::lround(std::clamp(v, -1.0f, 1.0f) * 32767.0f));
+}
+
+inline float rms_value(const WaveformPeak &p) { return float(p.rms_) / 65535.0f; }
+
+// Combines peaks, treating each as covering the same number of samples.
+struct PeakAccumulator {
+    void add(const WaveformPeak &p) {
+        if (not count_) {
+            min_ = p.min_;
+            max_ = p.max_;
+        } else {
+            min_ = std::min(min_, p.min_);
+            max_ = std::max(max_, p.max_);
+        }
+        const float r = rms_value(p);
+        sum_squares_ += r * r;
+        count_++;
+    }
+
+    [[nodiscard]] WaveformPeak peak() const {
+        WaveformPeak result;
+        if (count_) {
+            result.min_ = min_;
+            result.max_ = max_;
+            result.rms_ = static_cast<uint16_t>(
+                std::lround(std::min(std::sqrt(sum_squares_ / count_), 1.0) * 65535.0));
+        }
+        return result;
+    }
+
+    int16_t min_{0};
+    int16_t max_{0};
+    double sum_squares_{0.0};
+    int count_{0};
+};
+
+template <typename T> void write_value(std::ofstream &out, const T &v) {
+    out.write(reinterpret_cast<const char *>(&v), sizeof(T));
+}
+
+template <typename T> bool read_value(std::ifstream &in, T &v) {
+    return bool(in.read(reinterpret_cast<char *>(&v), sizeof(T)));
+}
+
+template <typename T>
+void add_typed_samples(
+    AudioWaveformSummary &summary,
+    const AudioBuffer &buffer,
+    const float scale,
+    const T offset) {
+
+    const auto channels = static_cast<size_t>(buffer.num_channels());
+    const auto *in      = reinterpret_cast<const T *>(buffer.buffer());
+    std::vector<float> chunk(add_samples_chunk * channels);
+
+    size_t done = 0;
+    while (done < size_t(buffer.num_samples())) {
+        const size_t n = std::min(add_samples_chunk, size_t(buffer.num_samples()) - done);
+        for (size_t i = 0; i < n * channels; ++i)
+            chunk[i] = float(in[done * channels + i] - offset) * scale;
+        summary.add_samples(chunk.data(), n);
+        done += n;
+    }
+}
+
+} // namespace
+
+AudioWaveformSummary::AudioWaveformSummary(
+    const uint64_t sample_rate, const int num_channels, const int samples_per_peak)
+    : sample_rate_(sample_rate),
+      num_channels_(std::max(num_channels, 1)),
+      samples_per_peak_(std::max(samples_per_peak, 1)),
+      min_(num_channels_, 0.0f),
+      max_(num_channels_, 0.0f),
+      sum_squares_(num_channels_, 0.0),
+      levels_(1) {}
+
+void AudioWaveformSummary::start_frame() { frame_starts_.push_back(num_samples_); }
+
+void AudioWaveformSummary::add_samples(const float *samples, const size_t count) {
+
+    const auto channels = static_cast<size_t>(num_channels_);
+    size_t i            = 0;
+    while (i < count) {
+        // up to the end of the current peak
+        const size_t n = std::min(count - i, size_t(samples_per_peak_ - count_));
+        for (size_t c = 0; c < channels; ++c) {
+            float mn   = count_ ? min_[c] : samples[i * channels + c];
+            float mx   = count_ ? max_[c] : samples[i * channels + c];
+            double sum = 0.0;
+            for (size_t s = 0; s < n; ++s) {
+                const float v = samples[(i + s) * channels + c];
+                mn            = std::min(mn, v);
+                mx            = std::max(mx, v);
+                sum += double(v) * v;
+            }
+            min_[c] = mn;
+            max_[c] = mx;
+            sum_squares_[c] += sum;
+        }
+        count_ += static_cast<int>(n);
+        num_samples_ += n;
+        i += n;
+
+        if (count_ == samples_per_peak_)
+            end_peak();
+    }
+}
+
+void AudioWaveformSummary::add_samples(const AudioBuffer &buffer) {
+
+    if (buffer.num_channels() != num_channels_ or not buffer.num_samples() or
+        buffer.size() < buffer.actual_sample_data_size())
+        return;
+
+    switch (buffer.sample_format()) {
+    case audio::SampleFormat::UINT8:
+        add_typed_samples<uint8_t>(*this, buffer, 1.0f / 128.0f, 128);
+        break;
+    case audio::SampleFormat::INT16:
+        add_typed_samples<int16_t>(*this, buffer, 1.0f / 32768.0f, 0);
+        break;
+    case audio::SampleFormat::SFINT32:
+        add_typed_samples<int32_t>(*this, buffer, 1.0f / 2147483648.0f, 0);
+        break;
+    case audio::SampleFormat::FLOAT32:
+        add_typed_samples<float>(*this, buffer, 1.0f, 0.0f);
+        break;
+    case audio::SampleFormat::INT64:
+        add_typed_samples<int64_t>(*this, buffer, 1.0f / 9223372036854775808.0f, 0);
+        break;
+    case audio::SampleFormat::DOUBLE64:
+        add_typed_samples<double>(*this, buffer, 1.0f, 0.0);
+        break;
+    default:
+        break;
+    }
+}
+
+void AudioWaveformSummary::end_peak() {
+    if (not count_)
+        return;
+
+    for (int c = 0; c < num_channels_; ++c) {
+        WaveformPeak p;
+        p.min_ = to_peak_value(min_[c]);
+        p.max_ = to_peak_value(max_[c]);
+        p.rms_ = static_cast<uint16_t>(
+            std::lround(std::min(std::sqrt(sum_squares_[c] / count_), 1.0) * 65535.0));
+        levels_[0].push_back(p);
+        sum_squares_[c] = 0.0;
+    }
+    count_ = 0;
+}
+
+void AudioWaveformSummary::finish() {
+    end_peak();
+    build_levels();
+}
+
+void AudioWaveformSummary::build_levels() {
+    levels_.resize(1);
+
+    const auto channels = static_cast<size_t>(num_channels_);
+    while (levels_.back().size() > channels) {
+        const auto &fine   = levels_.back();
+        const size_t count = fine.size() / channels;
+
+        std::vector<WaveformPeak> coarse;
+        coarse.reserve(((count + 1) / 2) * channels);
+        for (size_t i = 0; i < count; i += 2) {
+            for (size_t c = 0; c < channels; ++c) {
+                PeakAccumulator acc;
+                acc.add(fine[i * channels + c]);
+                if (i + 1 < count)
+                    acc.add(fine[(i + 1) * channels + c]);
+                coarse.push_back(acc.peak());
+            }
+        }
+        levels_.push_back(std::move(coarse));
+    }
+}
+
+std::vector<WaveformPeak> AudioWaveformSummary::peaks(
+    const int channel, const uint64_t start, const uint64_t end, const int columns) const {
+
+    std::vector<WaveformPeak> result(std::max(columns, 0));
+    if (columns <= 0 or end <= start or levels_.empty() or channel >= num_channels_)
+        return result;
+
+    const double samples_per_column = double(end - start) / columns;
+
+    // The coarsest level with at least a few peaks per column. Each peak
+    // goes in the column its middle falls in, so column edges are out by at
+    // most half a peak.
+    size_t level = 0;
+    while (level + 1 < levels_.size() and
+           double(uint64_t(samples_per_peak_) << (level + 1)) * peaks_per_column <=
+               samples_per_column)
+        level++;
+
+    const auto &peaks     = levels_[level];
+    const auto channels   = static_cast<size_t>(num_channels_);
+    const size_t count    = peaks.size() / channels;
+    const double peak_len = double(uint64_t(samples_per_peak_) << level);
+
+    for (int col = 0; col < columns; ++col) {
+        const double s0 = double(start) + col * samples_per_column;
+        const double s1 = s0 + samples_per_column;
+        const auto p0   = static_cast<size_t>(std::llround(s0 / peak_len));
+        const auto p1   = std::max(p0 + 1, static_cast<size_t>(std::llround(s1 / peak_len)));
+
+        PeakAccumulator acc;
+        for (size_t p = p0; p < std::min(p1, count); ++p) {
+            if (channel >= 0) {
+                acc.add(peaks[p * channels + channel]);
+            } else {
+                for (size_t c = 0; c < channels; ++c)
+                    acc.add(peaks[p * channels + c]);
+            }
+        }
+        result[col] = acc.peak();
+    }
+    return result;
+}
+
+uint64_t AudioWaveformSummary::frame_to_sample(const double frame) const {
+    if (frame_starts_.empty() or frame <= 0.0)
+        return frame_starts_.empty() ? 0 : frame_starts_.front();
+
+    const auto f = static_cast<size_t>(frame);
+    if (f + 1 < frame_starts_.size()) {
+        const double frac = frame - double(f);
+        return frame_starts_[f] +
+               static_cast<uint64_t>(frac * double(frame_starts_[f + 1] - frame_starts_[f]));
+    }
+
+    // the last frame, or past the end
+    const double frame_len = double(num_samples_) / double(frame_starts_.size());
+    return frame_starts_.back() +
+           static_cast<uint64_t>((frame - double(frame_starts_.size() - 1)) * frame_len);
+}
+
+size_t AudioWaveformSummary::size_bytes() const {
+    size_t result = frame_starts_.size() * sizeof(uint64_t);
+    for (const auto &level : levels_)
+        result += level.size() * sizeof(WaveformPeak);
+    return result;
+}
+
+bool AudioWaveformSummary::save(const std::string &path, const std::string &key) const {
+
+    // written to a temporary file and renamed, so a reader never sees a
+    // partly written one
+    const auto tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (not out)
+            return false;
+
+        out.write(file_magic, sizeof(file_magic));
+        write_value(out, file_version);
+        write_value(out, uint32_t(key.size()));
+        out.write(key.data(), key.size());
+        write_value(out, sample_rate_);
+        write_value(out, int32_t(num_channels_));
+        write_value(out, int32_t(samples_per_peak_));
+        write_value(out, num_samples_);
+        write_value(out, uint64_t(frame_starts_.size()));
+        out.write(
+            reinterpret_cast<const char *>(frame_starts_.data()),
+            frame_starts_.size() * sizeof(uint64_t));
+
+        // only the finest level, the rest are quick to rebuild
+        const auto &peaks = levels_.empty() ? std::vector<WaveformPeak>() : levels_[0];
+        write_value(out, uint64_t(peaks.size()));
+        for (const auto &p : peaks) {
+            write_value(out, p.min_);
+            write_value(out, p.max_);
+            write_value(out, p.rms_);
+        }
+        if (not out)
+            return false;
+    }
+
+    if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        return false;
+    }
+    return true;
+}
+
+std::shared_ptr<AudioWaveformSummary>
+AudioWaveformSummary::load(const std::string &path, const std::string &key) {
+
+    std::ifstream in(path, std::ios::binary);
+    if (not in)
+        return {};
+
+    char magic[sizeof(file_magic)];
+    uint32_t version  = 0;
+    uint32_t key_size = 0;
+    if (not in.read(magic, sizeof(magic)) or std::memcmp(magic, file_magic, sizeof(magic)) or
+        not read_value(in, version) or version != file_version or
+        not read_value(in, key_size) or key_size != key.size())
+        return {};
+
+    std::string file_key(key_size, '\0');
+    if (not in.read(file_key.data(), key_size) or file_key != key)
+        return {};
+
+    uint64_t sample_rate = 0;
+    int32_t channels     = 0;
+    int32_t spp          = 0;
+    uint64_t samples     = 0;
+    uint64_t frames      = 0;
+    if (not read_value(in, sample_rate) or not read_value(in, channels) or
+        not read_value(in, spp) or not read_value(in, samples) or
+        not read_value(in, frames) or channels < 1 or channels > max_file_channels or
+        spp < 1 or samples > max_file_samples or frames > samples + 1)
+        return {};
+
+    // the rest of the file must be what the header says, before anything is
+    // allocated for it
+    const uint64_t count = ((samples + spp - 1) / spp) * uint64_t(channels);
+    const auto data_start = in.tellg();
+    in.seekg(0, std::ios::end);
+    const auto file_end = in.tellg();
+    in.seekg(data_start);
+    if (data_start < 0 or file_end < data_start or
+        uint64_t(file_end - data_start) !=
+            frames * sizeof(uint64_t) + sizeof(uint64_t) + count * file_peak_size)
+        return {};
+
+    auto result          = std::make_shared<AudioWaveformSummary>(sample_rate, channels, spp);
+    result->num_samples_ = samples;
+    result->frame_starts_.resize(frames);
+    if (not in.read(
+            reinterpret_cast<char *>(result->frame_starts_.data()), frames * sizeof(uint64_t)))
+        return {};
+
+    uint64_t file_count = 0;
+    if (not read_value(in, file_count) or file_count != count)
+        return {};
+
+    auto &peaks = result->levels_[0];
+    peaks.resize(count);
+    for (auto &p : peaks) {
+        if (not read_value(in, p.min_) or not read_value(in, p.max_) or
+            not read_value(in, p.rms_))
+            return {};
+    }
+
+    result->build_levels();
+    return result;
+}
@@ -0,0 +1,306 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <filesystem>
+
+#include <fmt/format.h>
+
+#include "xstudio/atoms.hpp"
+#include "xstudio/global_store/global_store.hpp"
+#include "xstudio/media_reader/audio_buffer.hpp"
+#include "xstudio/media_reader/audio_waveform_actor.hpp"
+#include "xstudio/media_reader/image_diff.hpp"
+#include "xstudio/utility/helpers.hpp"
+#include "xstudio/utility/logging.hpp"
+
+namespace fs = std::filesystem;
+
+using namespace caf;
+
+using namespace xstudio;
+using namespace xstudio::global_store;
+using namespace xstudio::media;
+using namespace xstudio::utility;
+using namespace xstudio::media_reader;
+
+namespace {
+
+// audio frames being decoded at once for one source
+constexpr size_t max_in_flight = 4;
+
+// a file's size and modification time are looked at again after this, so
+// the requests made while drawing a waveform don't each stat the file
+constexpr auto key_lifetime = std::chrono::seconds(2);
+constexpr size_t max_keys   = 4096;
+
+JsonStore peaks_to_json(
+    const AudioWaveformSummary &summary,
+    const double start_frame,
+    const double end_frame,
+    const int columns,
+    const int channel) {
+
+    const auto start = summary.frame_to_sample(start_frame);
+    const auto end   = summary.frame_to_sample(end_frame);
+    const auto peaks = summary.peaks(channel, start, end, columns);
+
+    std::vector<float> mins, maxs, rms;
+    mins.reserve(peaks.size());
+    maxs.reserve(peaks.size());
+    rms.reserve(peaks.size());
+    for (const auto &p : peaks) {
+        mins.push_back(float(p.min_) / 32767.0f);
+        maxs.push_back(float(p.max_) / 32767.0f);
+        rms.push_back(float(p.rms_) / 65535.0f);
+    }
+
+    JsonStore result;
+    result["sample_rate"]  = summary.sample_rate();
+    result["num_channels"] = summary.num_channels();
+    result["num_frames"]   = summary.num_frames();
+    result["num_samples"]  = summary.num_samples();
+    result["start_sample"] = start;
+    result["end_sample"]   = end;
+    result["min"]          = mins;
+    result["max"]          = maxs;
+    result["rms"]          = rms;
+    return result;
+}
+
+} // namespace
+
+struct AudioWaveformActor::Build {
+    std::string key_;
+    std::vector<media::AVFrameID> frames_;
+    caf::actor reader_;
+
+    size_t next_{0};
+    size_t in_flight_{0};
+    // decoded frames waiting for the ones before them
+    std::map<size_t, AudioBufPtr> decoded_;
+    size_t added_{0};
+    size_t failed_{0};
+
+    std::shared_ptr<AudioWaveformSummary> summary_;
+};
+
+AudioWaveformActor::AudioWaveformActor(caf::actor_config &cfg, caf::actor reader_pool)
+    : caf::event_based_actor(cfg), reader_pool_(std::move(reader_pool)) {
+    print_on_exit(this, "AudioWaveformActor");
+
+    behavior_.assign(
+        [=](json_store::update_atom, const JsonStore &prefs) {
+            try {
+                enabled_ = preference_value<bool>(
+                    prefs, "/core/media_reader/audio_waveform_cache/enabled");
+                directory_ = expand_envvars(preference_value<std::string>(
+                    prefs, "/core/media_reader/audio_waveform_cache/path"));
+            } catch (const std::exception &e) {
+                spdlog::warn("{} {}", __PRETTY_FUNCTION__, e.what());
+            }
+        },
+
+        [=](audio_waveform_atom,
+            const caf::actor &media,
+            const double start_frame,
+            const double end_frame,
+            const int columns,
+            const int channel) -> result<JsonStore> {
+            auto rp = make_response_promise<JsonStore>();
+            get_summary(
+                media,
+                [=](const AudioWaveformSummaryPtr &summary, const caf::error &err) mutable {
+                    if (err)
+                        rp.deliver(err);
+                    else
+                        rp.deliver(
+                            peaks_to_json(*summary, start_frame, end_frame, columns, channel));
+                });
+            return rp;
+        });
+}
+
+void AudioWaveformActor::get_summary(const caf::actor &media, Waiter waiter) {
+
+    mail(get_media_pointer_atom_v, media::MT_AUDIO)
+        .request(media, infinite)
+        .then(
+            [=](const std::vector<media::AVFrameID> &frames) mutable {
+                if (frames.empty() or frames.front().is_nil()) {
+                    waiter({}, make_error(xstudio_error::error, "No audio"));
+                    return;
+                }
+
+                const auto key = summary_key(frames.front());
+                auto p         = summaries_.find(key);
+                if (p != summaries_.end()) {
+                    p->second.second = ++usage_counter_;
+                    waiter(p->second.first, caf::error());
+                    return;
+                }
+
+                // already being built, wait for it
+                auto &waiting = waiting_[key];
+                waiting.push_back(waiter);
+                if (waiting.size() > 1)
+                    return;
+
+                if (enabled_ and not directory_.empty()) {
+                    if (auto summary = AudioWaveformSummary::load(summary_path(key), key)) {
+                        finish_build(key, summary, caf::error());
+                        return;
+                    }
+                }
+
+                build_summary(key, frames);
+            },
+            [=](const caf::error &err) mutable { waiter({}, err); });
+}
+
+void AudioWaveformActor::build_summary(
+    const std::string &key, const std::vector<media::AVFrameID> &frames) {
+
+    auto build     = std::make_shared<Build>();
+    build->key_    = key;
+    build->frames_ = frames;
+
+    // a reader of our own, reading through the global reader would fill the
+    // audio cache with the whole source
+    mail(get_reader_atom_v, frames.front().uri(), frames.front().reader())
+        .request(reader_pool_, infinite)
+        .then(
+            [=](const caf::actor &reader) {
+                build->reader_ = reader;
+                continue_build(build);
+            },
+            [=](const caf::error &err) { finish_build(key, {}, err); });
+}
+
+void AudioWaveformActor::continue_build(const std::shared_ptr<Build> &build) {
+
+    // add decoded frames, in order
+    for (auto p = build->decoded_.find(build->added_); p != build->decoded_.end();
+         p      = build->decoded_.find(build->added_)) {
+        const auto &buf = p->second;
+        if (buf and not build->summary_)
+            build->summary_ =
+                std::make_shared<AudioWaveformSummary>(buf->sample_rate(), buf->num_channels());
+
+        if (build->summary_) {
+            // frames that didn't decode are empty, later frames keep their
+            // positions
+            while (build->summary_->num_frames() < build->added_)
+                build->summary_->start_frame();
+            build->summary_->start_frame();
+            if (buf)
+                build->summary_->add_samples(*buf);
+        }
+        build->decoded_.erase(p);
+        build->added_++;
+    }
+
+    if (build->added_ == build->frames_.size()) {
+        send_exit(build->reader_, caf::exit_reason::user_shutdown);
+
+        if (not build->summary_) {
+            finish_build(build->key_, {}, make_error(xstudio_error::error, "No audio decoded"));
+            return;
+        }
+        if (build->failed_)
+            spdlog::warn(
+                "{} {} of {} audio frames failed to decode for {}",
+                __PRETTY_FUNCTION__,
+                build->failed_,
+                build->frames_.size(),
+                build->key_);
+
+        build->summary_->finish();
+        if (enabled_ and not directory_.empty()) {
+            try {
+                fs::create_directories(directory_);
+                if (not build->summary_->save(summary_path(build->key_), build->key_))
+                    spdlog::warn("{} failed to write waveform summary", __PRETTY_FUNCTION__);
+            } catch (const std::exception &e) {
+                spdlog::warn("{} {}", __PRETTY_FUNCTION__, e.what());
+            }
+        }
+        finish_build(build->key_, build->summary_, caf::error());
+        return;
+    }
+
+    while (build->in_flight_ < max_in_flight and build->next_ < build->frames_.size()) {
+        const auto i = build->next_++;
+        build->in_flight_++;
+
+        mail(read_precache_audio_atom_v, build->frames_[i])
+            .request(build->reader_, infinite)
+            .then(
+                [=](const AudioBufPtr &buf) {
+                    build->in_flight_--;
+                    build->decoded_[i] = buf;
+                    continue_build(build);
+                },
+                [=](const caf::error &) {
+                    build->in_flight_--;
+                    build->failed_++;
+                    build->decoded_[i] = AudioBufPtr();
+                    continue_build(build);
+                });
+    }
+}
+
+void AudioWaveformActor::finish_build(
+    const std::string &key, AudioWaveformSummaryPtr summary, caf::error err) {
+
+    if (summary)
+        remember(key, summary);
+
+    auto waiting = std::move(waiting_[key]);
+    waiting_.erase(key);
+    for (auto &waiter : waiting)
+        waiter(summary, err);
+}
+
+std::string AudioWaveformActor::summary_key(const media::AVFrameID &frame) {
+    const auto source = fmt::format("{}#{}", to_string(frame.uri()), frame.stream_id());
+    const auto now    = utility::clock::now();
+
+    auto p = keys_.find(source);
+    if (p != keys_.end() and now - p->second.second < key_lifetime)
+        return p->second.first;
+
+    // the file's size and modification time, so a changed file is read again
+    std::string identity;
+    try {
+        const auto path = uri_to_posix_path(frame.uri());
+        identity        = fmt::format(
+            "{}:{}",
+            fs::file_size(path),
+            fs::last_write_time(path).time_since_epoch().count());
+    } catch (...) {
+    }
+
+    if (keys_.size() >= max_keys)
+        keys_.clear();
+
+    auto key      = fmt::format("{}#{}", source, identity);
+    keys_[source] = std::make_pair(key, now);
+    return key;
+}
+
+std::string AudioWaveformActor::summary_path(const std::string &key) const {
+    const auto name = fmt::format("{:016x}.xswf", hash_bytes(key.data(), key.size()));
+    return (fs::path(directory_) / name).string();
+}
+
+void AudioWaveformActor::remember(
+    const std::string &key, const AudioWaveformSummaryPtr &summary) {
+    summaries_[key] = std::make_pair(summary, ++usage_counter_);
+
+    while (summaries_.size() > max_in_memory_) {
+        auto oldest = summaries_.begin();
+        for (auto p = summaries_.begin(); p != summaries_.end(); ++p) {
+            if (p->second.second < oldest->second.second)
+                oldest = p;
+        }
+        summaries_.erase(oldest);
+    }
+}
@@ -1,4 +1,6 @@
 // SPDX-License-Identifier: Apache-2.0
+#include <algorithm>
+
 #include <caf/actor_registry.hpp>
 
 #include "xstudio/media_reader/cacheing_media_reader_actor.hpp"
@@ -114,28 +116,23 @@ CachingMediaReaderActor::CachingMediaReaderActor(
         precache_workers_.push_back(
             request_receive<caf::actor>(
                 *sys, pm, plugin_manager::spawn_plugin_atom_v, media_reader_plugin_uuid, js));
+        precache_worker_reads_.push_back(0);
         link_to(precache_workers_.back());
         // here's a crucial optimisation. For some media readers, like EXR, we
         // can get a big speed increase by spawning multiple reader actors to
         // read different frames in parallel. For others, like ffmpeg, it's much
         // more efficient to use a single reader and request frames sequentially
         // because common motion based video codecs like h264 are designed to
-        // decode frames in a stream, of course.
+        // decode frames in a stream, of course. The extra readers are spawned
+        // as reads start to overlap, so sources that don't benefit from them
+        // never pay for them.
         const bool prefers_sequential_reads =
             request_receive<bool>(*sys, precache_workers_.back(), utility::detail_atom_v);
 
-        if (!prefers_sequential_reads) {
-            for (int i = 1; i < worker_count; ++i) {
-                precache_workers_.push_back(
-                    request_receive<caf::actor>(
-                        *sys,
-                        pm,
-                        plugin_manager::spawn_plugin_atom_v,
-                        media_reader_plugin_uuid,
-                        js));
-                link_to(precache_workers_.back());
-            }
-        }
+        if (!prefers_sequential_reads)
+            max_precache_workers_ = std::max(worker_count, 1);
+        plugin_uuid_  = media_reader_plugin_uuid;
+        plugin_prefs_ = js;
 
         urgent_worker_ = request_receive<caf::actor>(
             *sys, pm, plugin_manager::spawn_plugin_atom_v, media_reader_plugin_uuid, js);
@@ -274,12 +271,18 @@ CachingMediaReaderActor::CachingMediaReaderActor(
         [=](read_precache_image_atom, const media::AVFrameID &mptr) -> result<ImageBufPtr> {
             // note the caller (GlobalMediaReaderActor) handles the cacheing
             // of this image buffer
-            auto rp = make_response_promise<media_reader::ImageBufPtr>();
+            auto rp           = make_response_promise<media_reader::ImageBufPtr>();
+            const auto worker = pick_precache_worker();
+            precache_worker_reads_[worker]++;
             mail(get_image_atom_v, mptr)
-                .request(pick_precache_worker(), infinite)
+                .request(precache_workers_[worker], infinite)
                 .then(
-                    [=](media_reader::ImageBufPtr &buf) mutable { rp.deliver(buf); },
+                    [=](media_reader::ImageBufPtr &buf) mutable {
+                        precache_worker_reads_[worker]--;
+                        rp.deliver(buf);
+                    },
                     [=](const caf::error &err) mutable {
+                        precache_worker_reads_[worker]--;
                         rp.deliver(make_error_buffer(err, mptr));
                     });
 
@@ -289,12 +292,20 @@ CachingMediaReaderActor::CachingMediaReaderActor(
         [=](read_precache_audio_atom, const media::AVFrameID &mptr) -> result<AudioBufPtr> {
             // note the caller (GlobalMediaReaderActor) handles the cacheing
             // of this image buffer
-            auto rp = make_response_promise<media_reader::AudioBufPtr>();
+            auto rp           = make_response_promise<media_reader::AudioBufPtr>();
+            const auto worker = pick_precache_worker();
+            precache_worker_reads_[worker]++;
             mail(get_audio_atom_v, mptr)
-                .request(pick_precache_worker(), infinite)
+                .request(precache_workers_[worker], infinite)
                 .then(
-                    [=](media_reader::AudioBufPtr buf) mutable { rp.deliver(buf); },
-                    [=](const caf::error &err) mutable { rp.deliver(err); });
+                    [=](media_reader::AudioBufPtr buf) mutable {
+                        precache_worker_reads_[worker]--;
+                        rp.deliver(buf);
+                    },
+                    [=](const caf::error &err) mutable {
+                        precache_worker_reads_[worker]--;
+                        rp.deliver(err);
+                    });
             return rp;
         },
 
@@ -305,6 +316,39 @@ CachingMediaReaderActor::CachingMediaReaderActor(
     );
 }
 
+size_t CachingMediaReaderActor::pick_precache_worker() {
+    const auto least =
+        std::min_element(precache_worker_reads_.begin(), precache_worker_reads_.end());
+
+    // all busy, so the next read would queue behind another
+    if (*least and not adding_precache_worker_ and
+        precache_workers_.size() < max_precache_workers_)
+        add_precache_worker();
+
+    return std::distance(precache_worker_reads_.begin(), least);
+}
+
+void CachingMediaReaderActor::add_precache_worker() {
+    adding_precache_worker_ = true;
+    auto pm = system().registry().template get<caf::actor>(plugin_manager_registry);
+
+    mail(plugin_manager::spawn_plugin_atom_v, plugin_uuid_, plugin_prefs_)
+        .request(pm, infinite)
+        .then(
+            [=](caf::actor worker) {
+                link_to(worker);
+                precache_workers_.push_back(worker);
+                precache_worker_reads_.push_back(0);
+                adding_precache_worker_ = false;
+            },
+            [=](const caf::error &err) {
+                // carry on with the workers we have
+                spdlog::warn("Failed to add precache worker {}", to_string(err));
+                max_precache_workers_   = precache_workers_.size();
+                adding_precache_worker_ = false;
+            });
+}
+
 void CachingMediaReaderActor::do_urgent_get_image() {
 
     auto p                      = pending_get_image_requests_.begin();
@@ -313,8 +357,10 @@ void CachingMediaReaderActor::do_urgent_get_image() {
     auto playhead_uuid          = p->first;
     pending_get_image_requests_.erase(p);
 
+    // the playhead will be pushed the full image after a draft (see
+    // GlobalMediaReaderActor), so a draft is fine here
     urgent_worker_busy_ = true;
-    mail(get_image_atom_v, mptr)
+    mail(get_image_atom_v, mptr, true)
         .request(urgent_worker_, infinite)
         .then(
             [=](media_reader::ImageBufPtr &buf) mutable {
@@ -322,14 +368,16 @@ void CachingMediaReaderActor::do_urgent_get_image() {
                 rp.deliver(buf);
 
                 // store the image in our cache
-                anon_mail(
-                    media_cache::store_atom_v,
-                    mptr.key(),
-                    buf,
-                    utility::clock::now(),
-                    playhead_uuid)
-                    .urgent()
-                    .send(image_cache_);
+                if (!buf || !buf->is_draft()) {
+                    anon_mail(
+                        media_cache::store_atom_v,
+                        mptr.key(),
+                        buf,
+                        utility::clock::now(),
+                        playhead_uuid)
+                        .urgent()
+                        .send(image_cache_);
+                }
 
                 // perhaps more urgent requests are now pending
                 urgent_worker_busy_ = false;
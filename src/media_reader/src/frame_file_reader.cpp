@@ -0,0 +1,849 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef XSTUDIO_HAVE_LIBURING
+#include <liburing.h>
+#endif
+
+#include "xstudio/media_reader/frame_file_reader.hpp"
+#include "xstudio/utility/logging.hpp"
+
+using namespace xstudio::media_reader;
+using namespace xstudio::utility;
+
+namespace {
+// what direct IO wants of offsets, lengths and memory, on the filesystems
+// we see it is the logical block size or less
+constexpr size_t alignment = 4096;
+// large buffers are sized to this so frames of a sequence share them
+constexpr size_t bucket = 1024 * 1024;
+// freed buffers kept for reuse
+constexpr size_t max_pooled_bytes = 256 * 1024 * 1024;
+// claimed files not taken by then aren't going to be, nor are any files
+// once playback has stopped for a while
+constexpr auto max_claimed_age = std::chrono::seconds(10);
+constexpr auto max_age         = std::chrono::seconds(60);
+// files read ahead, before we know how big they are and after
+constexpr size_t default_lookahead = 32;
+constexpr size_t min_lookahead     = 8;
+constexpr size_t max_lookahead     = 256;
+// reads in the ring at once, a file is opened as a place comes free
+constexpr size_t uring_depth = 32;
+
+#ifdef _WIN32
+constexpr bool supported = false;
+#else
+constexpr bool supported = true;
+#endif
+
+size_t round_up(const size_t size, const size_t to) { return ((size + to - 1) / to) * to; }
+
+size_t capacity_for(const size_t size) {
+    return size > bucket ? round_up(size, bucket) : round_up(size, alignment);
+}
+
+#ifndef _WIN32
+// Opens path for reading, directly if asked and the filesystem lets us.
+// Returns the descriptor, or -1, and the size of the file.
+int open_file(const std::string &path, const bool try_direct, bool &direct, size_t &size) {
+    int fd = -1;
+    direct = false;
+#ifdef O_DIRECT
+    if (try_direct) {
+        fd     = ::open(path.c_str(), O_RDONLY | O_DIRECT | O_CLOEXEC);
+        direct = fd >= 0;
+    }
+#endif
+    if (fd < 0)
+        fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return -1;
+
+#ifdef F_NOCACHE
+    if (try_direct and fcntl(fd, F_NOCACHE, 1) == 0)
+        direct = true;
+#endif
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 or not S_ISREG(st.st_mode) or st.st_size <= 0) {
+        ::close(fd);
+        return -1;
+    }
+    size = static_cast<size_t>(st.st_size);
+    return fd;
+}
+
+// Reads size bytes into data, which has room for size rounded up to the
+// alignment, as direct reads are whole blocks.
+bool read_fd(const int fd, char *data, const size_t size, const bool direct) {
+    const auto length = direct ? round_up(size, alignment) : size;
+    size_t done       = 0;
+    while (done < size) {
+        const auto result = ::pread(fd, data + done, length - done, off_t(done));
+        if (result < 0 and errno == EINTR)
+            continue;
+        if (result <= 0)
+            return false;
+        done += size_t(result);
+    }
+    return true;
+}
+
+// Closes fd, first dropping what a buffered read left in the page cache.
+void close_file(const int fd, const bool direct) {
+#ifdef POSIX_FADV_DONTNEED
+    if (not direct)
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+#endif
+    ::close(fd);
+}
+#endif
+} // namespace
+
+namespace xstudio::media_reader {
+
+/**
+ *  @brief Aligned buffers, kept for reuse as the frames of a sequence are
+ *  much the same size.
+ */
+class FileBufferPool {
+  public:
+    ~FileBufferPool() {
+        for (const auto &i : free_)
+            operator delete[](i.second, std::align_val_t(alignment));
+    }
+
+    char *acquire(const size_t capacity) {
+        {
+            std::scoped_lock lock(mutex_);
+            auto it = free_.find(capacity);
+            if (it != free_.end()) {
+                auto data = it->second;
+                free_.erase(it);
+                free_bytes_ -= capacity;
+                return data;
+            }
+        }
+        return static_cast<char *>(operator new[](capacity, std::align_val_t(alignment)));
+    }
+
+    void release(char *data, const size_t capacity) {
+        {
+            std::scoped_lock lock(mutex_);
+            if (free_bytes_ + capacity <= max_pooled_bytes) {
+                free_.emplace(capacity, data);
+                free_bytes_ += capacity;
+                return;
+            }
+        }
+        operator delete[](data, std::align_val_t(alignment));
+    }
+
+  private:
+    std::mutex mutex_;
+    std::multimap<size_t, char *> free_;
+    size_t free_bytes_{0};
+};
+
+#ifdef XSTUDIO_HAVE_LIBURING
+/**
+ *  @brief The io_uring that files are read through, kept full. Opener
+ *  threads open files and submit their reads while there is room, one
+ *  thread reaps the completions and hands the files over.
+ */
+struct FrameFileReader::Ring {
+    // a file being read through the ring
+    struct Read {
+        Next next_;
+        int fd_{-1};
+        bool direct_{false};
+        size_t size_{0};
+        size_t done_{0};
+        std::shared_ptr<FileBytes> bytes_;
+        time_point start_;
+    };
+
+    ~Ring() {
+        if (live_)
+            io_uring_queue_exit(&ring_);
+    }
+
+    static std::unique_ptr<Ring> create() {
+        auto result = std::make_unique<Ring>();
+        if (const auto error = io_uring_queue_init(uring_depth, &result->ring_, 0);
+            error < 0) {
+            spdlog::warn("{} io_uring unavailable {}", __PRETTY_FUNCTION__, strerror(-error));
+            return {};
+        }
+        result->live_ = true;
+        return result;
+    }
+
+    // Submits the rest of read, from openers and the reaping thread alike.
+    // False if the ring has failed, read is then still the caller's.
+    bool submit(FrameFileReader &reader, Read *read) {
+        {
+            std::scoped_lock lock(submit_mutex_);
+            if (not live_)
+                return false;
+
+            auto sqe = io_uring_get_sqe(&ring_);
+            const auto length =
+                (read->direct_ ? round_up(read->size_, alignment) : read->size_) - read->done_;
+            io_uring_prep_read(
+                sqe, read->fd_, read->bytes_->data_ + read->done_, length, read->done_);
+            io_uring_sqe_set_data(sqe, read);
+            io_uring_submit(&ring_);
+            in_flight_.insert(read);
+        }
+
+        std::scoped_lock lock(reader.mutex_);
+        submitted_++;
+        reader.cv_.notify_all();
+        return true;
+    }
+
+    // Reads what the ring couldn't, off the reaping thread.
+    void read_here(FrameFileReader &reader, std::unique_ptr<Read> read) {
+        if (read_fd(read->fd_, read->bytes_->data_, read->size_, read->direct_))
+            complete(reader, std::move(read), true);
+        else if (read->direct_)
+            read_buffered(reader, std::move(read));
+        else
+            complete(reader, std::move(read), false);
+    }
+
+    // Some filesystems accept a direct open but not the reads, those are
+    // opened again and read through the page cache.
+    void read_buffered(FrameFileReader &reader, std::unique_ptr<Read> read) {
+        ::close(read->fd_);
+        const auto capacity = read->bytes_->capacity();
+        read->fd_ = open_file(read->next_.first, false, read->direct_, read->size_);
+        const auto ok = read->fd_ >= 0 and read->size_ <= capacity and
+                        read_fd(read->fd_, read->bytes_->data_, read->size_, false);
+        complete(reader, std::move(read), ok);
+    }
+
+    // hands over each file as soon as it's done with, and frees its place
+    void complete(FrameFileReader &reader, std::unique_ptr<Read> read, const bool ok) {
+        FileBytesPtr bytes;
+        if (ok) {
+            read->bytes_->size_ = read->size_;
+            bytes               = read->bytes_;
+        }
+        if (read->fd_ >= 0)
+            close_file(read->fd_, read->direct_);
+
+        {
+            std::scoped_lock lock(reader.mutex_);
+            reserved_--;
+        }
+        reader.finish(
+            read->next_,
+            bytes,
+            read->direct_,
+            clock::now() - read->start_,
+            read->bytes_ ? read->bytes_->capacity() : 0);
+    }
+
+    // the ring can't be waited on, fail what's in it, openers read the rest
+    void fail(FrameFileReader &reader) {
+        std::set<Read *> reads;
+        {
+            std::scoped_lock lock(submit_mutex_);
+            // the kernel is done with the buffers once the ring is gone
+            io_uring_queue_exit(&ring_);
+            live_ = false;
+            reads = std::move(in_flight_);
+        }
+        for (auto read : reads)
+            complete(reader, std::unique_ptr<Read>(read), false);
+    }
+
+    io_uring ring_;
+    // guards submission and the fields after it
+    std::mutex submit_mutex_;
+    bool live_{false};
+    std::set<Read *> in_flight_;
+
+    // guarded by the reader's mutex: reads taken by openers and not yet
+    // complete, those of them in the ring, and direct reads the ring failed
+    // for openers to read again
+    size_t reserved_{0};
+    size_t submitted_{0};
+    std::deque<std::unique_ptr<Read>> retry_;
+};
+#else
+struct FrameFileReader::Ring {};
+#endif
+
+} // namespace xstudio::media_reader
+
+FileBytes::FileBytes(std::shared_ptr<FileBufferPool> pool, const size_t capacity)
+    : pool_(std::move(pool)), capacity_(capacity) {
+    data_ = pool_->acquire(capacity_);
+}
+
+FileBytes::~FileBytes() { pool_->release(data_, capacity_); }
+
+FrameFileReader::FrameFileReader()
+    : pool_(std::make_shared<FileBufferPool>()), enabled_(supported) {}
+
+FrameFileReader::~FrameFileReader() { stop(); }
+
+FrameFileReader &FrameFileReader::instance() {
+    static FrameFileReader s_reader;
+    return s_reader;
+}
+
+void FrameFileReader::set_enabled(const bool enabled) {
+    {
+        std::scoped_lock lock(mutex_);
+        enabled_ = enabled and supported;
+    }
+    if (not enabled)
+        clear();
+}
+
+void FrameFileReader::set_budget(const size_t bytes) {
+    std::scoped_lock lock(mutex_);
+    budget_ = bytes;
+    cv_.notify_all();
+}
+
+void FrameFileReader::set_direct_io(const bool direct) {
+    std::scoped_lock lock(mutex_);
+    direct_io_ = direct;
+}
+
+void FrameFileReader::set_threads(const size_t threads) {
+    std::scoped_lock lock(mutex_);
+    threads_count_ = std::max<size_t>(1, threads);
+}
+
+bool FrameFileReader::enabled() const {
+    std::scoped_lock lock(mutex_);
+    return enabled_;
+}
+
+void FrameFileReader::add_reader(const std::string &reader) {
+    std::scoped_lock lock(mutex_);
+    readers_.insert(reader);
+}
+
+bool FrameFileReader::reads_for(const std::string &reader) const {
+    std::scoped_lock lock(mutex_);
+    return enabled_ and readers_.count(reader);
+}
+
+void FrameFileReader::prefetch(const std::vector<std::string> &paths) {
+    std::scoped_lock lock(mutex_);
+    if (not enabled_ or stopping_)
+        return;
+
+    start();
+
+    // the layers of a file are separate frames
+    std::map<std::string, size_t> ranks;
+    for (const auto &path : paths)
+        ranks.emplace(path, ranks.size() + 1);
+
+    // the playhead has moved on from files on neither list
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        const auto &entry = it->second;
+        if (entry->claimed_ or entry->state_ == Entry::State::Reading or
+            ranks.count(it->first)) {
+            it++;
+        } else {
+            if (entry->state_ == Entry::State::Done)
+                dropped_++;
+            it = drop(it);
+        }
+    }
+
+    // claimed files still waiting first, then the list in order
+    std::deque<std::string> queue;
+    for (const auto &path : queue_) {
+        auto it = entries_.find(path);
+        if (it != entries_.end() and it->second->claimed_ and
+            it->second->state_ == Entry::State::Queued)
+            queue.push_back(path);
+    }
+
+    for (const auto &[path, rank] : ranks) {
+        auto it = entries_.find(path);
+        if (it == entries_.end())
+            it = entries_.emplace(path, std::make_shared<Entry>()).first;
+        else if (it->second->claimed_)
+            continue;
+        it->second->rank_ = rank;
+    }
+
+    std::set<const Entry *> queued;
+    for (const auto &path : paths) {
+        const auto &entry = entries_[path];
+        if (not entry->claimed_ and entry->state_ == Entry::State::Queued and
+            queued.insert(entry.get()).second)
+            queue.push_back(path);
+    }
+    queue_ = std::move(queue);
+
+    evict(clock::now());
+    cv_.notify_all();
+}
+
+void FrameFileReader::claim(const std::string &path) {
+    std::scoped_lock lock(mutex_);
+    if (not enabled_ or stopping_)
+        return;
+
+    start();
+
+    auto it = entries_.find(path);
+    if (it == entries_.end())
+        it = entries_.emplace(path, std::make_shared<Entry>()).first;
+    else if (it->second->state_ == Entry::State::Queued)
+        queue_.erase(std::remove(queue_.begin(), queue_.end(), path), queue_.end());
+
+    auto &entry     = it->second;
+    entry->claimed_ = true;
+    entry->rank_    = 0;
+
+    // after those claimed before it
+    if (entry->state_ == Entry::State::Queued) {
+        auto pos = queue_.begin();
+        while (pos != queue_.end()) {
+            auto other = entries_.find(*pos);
+            if (other == entries_.end() or not other->second->claimed_)
+                break;
+            pos++;
+        }
+        queue_.insert(pos, path);
+        cv_.notify_all();
+    }
+}
+
+void FrameFileReader::discard(const std::string &path) {
+    std::scoped_lock lock(mutex_);
+    auto it = entries_.find(path);
+    if (it != entries_.end() and it->second->state_ != Entry::State::Reading)
+        drop(it);
+}
+
+size_t FrameFileReader::lookahead() const {
+    std::scoped_lock lock(mutex_);
+    if (not reads_)
+        return default_lookahead;
+    const auto mean = std::max<size_t>(1, bytes_read_ / reads_);
+    return std::clamp(budget_ / mean, min_lookahead, max_lookahead);
+}
+
+FileBytesPtr FrameFileReader::take(const std::string &path) {
+    std::unique_lock lock(mutex_);
+    auto it = entries_.find(path);
+    if (it == entries_.end())
+        return {};
+
+    auto entry = it->second;
+    if (entry->state_ == Entry::State::Queued) {
+        // not started, rather than wait behind the others read it here
+        entries_.erase(it);
+        lock.unlock();
+        const auto start = clock::now();
+        bool direct      = false;
+        auto bytes       = read(path, &direct);
+        lock.lock();
+        count(bytes, direct, clock::now() - start);
+        if (bytes)
+            taken_++;
+        return bytes;
+    }
+
+    // under way, rather than wait the caller reads it and the read in
+    // progress finishes into an entry that is no longer held
+    drop(it);
+    if (entry->state_ == Entry::State::Reading) {
+        missed_++;
+        return {};
+    }
+
+    if (entry->bytes_)
+        taken_++;
+    return entry->bytes_;
+}
+
+bool FrameFileReader::reading(const std::string &path) const {
+    std::scoped_lock lock(mutex_);
+    auto it = entries_.find(path);
+    return it != entries_.end() and it->second->state_ == Entry::State::Reading;
+}
+
+void FrameFileReader::clear() {
+    std::scoped_lock lock(mutex_);
+    // reads under way finish into entries that are no longer held
+    entries_.clear();
+    queue_.clear();
+    held_ = 0;
+}
+
+JsonStore FrameFileReader::stats() const {
+    std::scoped_lock lock(mutex_);
+    JsonStore result;
+    result["backend"]      = ring_ ? "io_uring" : "threads";
+    result["enabled"]      = enabled_;
+    result["direct_io"]    = direct_io_;
+    result["budget"]       = budget_;
+    result["held"]         = held_;
+    result["queued"]       = queue_.size();
+    result["entries"]      = entries_.size();
+    result["reads"]        = reads_;
+    result["direct_reads"] = direct_reads_;
+    result["failed"]       = failed_;
+    result["taken"]        = taken_;
+    result["missed"]       = missed_;
+    result["evicted"]      = evicted_;
+    result["dropped"]      = dropped_;
+    result["bytes_read"]   = bytes_read_;
+    result["read_seconds"] = read_seconds_;
+    return result;
+}
+
+FileBytesPtr FrameFileReader::read(const std::string &path, bool *direct) const {
+#ifdef _WIN32
+    return {};
+#else
+    bool try_direct = true;
+    size_t budget   = 0;
+    {
+        std::scoped_lock lock(mutex_);
+        try_direct = direct_io_;
+        budget     = budget_;
+    }
+
+    bool is_direct = false;
+    size_t size    = 0;
+    auto fd        = open_file(path, try_direct, is_direct, size);
+    // more than we'd hold, the reader streams it as before
+    if (fd < 0 or size > budget) {
+        if (fd >= 0)
+            ::close(fd);
+        return {};
+    }
+
+    auto bytes = std::make_shared<FileBytes>(pool_, capacity_for(size));
+    auto ok    = read_fd(fd, bytes->data_, size, is_direct);
+
+    // some filesystems accept a direct open but not the reads
+    if (not ok and is_direct) {
+        ::close(fd);
+        fd = open_file(path, false, is_direct, size);
+        if (fd < 0 or size > bytes->capacity()) {
+            if (fd >= 0)
+                ::close(fd);
+            return {};
+        }
+        ok = read_fd(fd, bytes->data_, size, false);
+    }
+    close_file(fd, is_direct);
+
+    if (not ok)
+        return {};
+
+    bytes->size_ = size;
+    if (direct)
+        *direct = is_direct;
+    return bytes;
+#endif
+}
+
+void FrameFileReader::start() {
+    if (not threads_.empty())
+        return;
+
+#ifdef XSTUDIO_HAVE_LIBURING
+    ring_ = Ring::create();
+    if (ring_) {
+        threads_.emplace_back(&FrameFileReader::uring_worker, this);
+        for (size_t i = 0; i < threads_count_; i++)
+            threads_.emplace_back(&FrameFileReader::uring_opener, this);
+        return;
+    }
+#endif
+    for (size_t i = 0; i < threads_count_; i++)
+        threads_.emplace_back(&FrameFileReader::worker, this);
+}
+
+void FrameFileReader::stop() {
+    {
+        std::scoped_lock lock(mutex_);
+        stopping_ = true;
+        cv_.notify_all();
+    }
+    for (auto &i : threads_)
+        i.join();
+    threads_.clear();
+    ring_.reset();
+}
+
+FrameFileReader::Next
+FrameFileReader::next(std::unique_lock<std::mutex> &lock, const bool wait) {
+    while (not stopping_) {
+        // past those taken or dropped since they were queued
+        auto it = entries_.end();
+        while (not queue_.empty()) {
+            it = entries_.find(queue_.front());
+            if (it != entries_.end() and it->second->state_ == Entry::State::Queued)
+                break;
+            queue_.pop_front();
+            it = entries_.end();
+        }
+
+        if (it != entries_.end()) {
+            // a file wanted sooner than one held takes its place
+            while (held_ + reading_ >= budget_ and make_room(it->second->rank_)) {
+            }
+
+            if (held_ + reading_ < budget_) {
+                queue_.pop_front();
+                it->second->state_ = Entry::State::Reading;
+                return Next(it->first, it->second);
+            }
+        }
+
+        if (not wait)
+            break;
+
+        // waking now and then, so files not taken don't hold the budget
+        cv_.wait_for(lock, std::chrono::seconds(1));
+        evict(clock::now());
+    }
+    return Next();
+}
+
+void FrameFileReader::finish(
+    const Next &read,
+    FileBytesPtr bytes,
+    const bool direct,
+    const clock::duration &duration,
+    const size_t reserved) {
+    std::scoped_lock lock(mutex_);
+    count(bytes, direct, duration);
+    reading_ -= reserved;
+
+    auto it = entries_.find(read.first);
+    if (bytes and it != entries_.end() and it->second == read.second)
+        held_ += bytes->capacity();
+
+    read.second->bytes_ = std::move(bytes);
+    read.second->done_  = clock::now();
+    read.second->state_ = Entry::State::Done;
+    cv_.notify_all();
+}
+
+void FrameFileReader::count(
+    const FileBytesPtr &bytes, const bool direct, const clock::duration &duration) {
+    if (bytes) {
+        reads_++;
+        bytes_read_ += bytes->size();
+        read_seconds_ += std::chrono::duration<double>(duration).count();
+        if (direct)
+            direct_reads_++;
+    } else {
+        failed_++;
+    }
+}
+
+void FrameFileReader::evict(const time_point &now) {
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        const auto &entry = it->second;
+        const auto age    = now - entry->done_;
+        if (entry->state_ == Entry::State::Done and
+            (age > max_age or (entry->claimed_ and age > max_claimed_age))) {
+            evicted_++;
+            it = drop(it);
+        } else {
+            it++;
+        }
+    }
+}
+
+bool FrameFileReader::make_room(const size_t rank) {
+    auto last = entries_.end();
+    for (auto it = entries_.begin(); it != entries_.end(); it++) {
+        const auto &entry = it->second;
+        if (entry->state_ == Entry::State::Done and not entry->claimed_ and
+            entry->rank_ > rank and
+            (last == entries_.end() or entry->rank_ > last->second->rank_))
+            last = it;
+    }
+
+    if (last == entries_.end())
+        return false;
+    dropped_++;
+    drop(last);
+    return true;
+}
+
+FrameFileReader::Entries::iterator FrameFileReader::drop(Entries::iterator it) {
+    if (it->second->bytes_ and it->second->state_ == Entry::State::Done)
+        held_ -= it->second->bytes_->capacity();
+    return entries_.erase(it);
+}
+
+void FrameFileReader::worker() {
+    while (true) {
+        Next read;
+        {
+            std::unique_lock lock(mutex_);
+            read = next(lock, true);
+        }
+        if (not read.second)
+            break;
+
+        const auto start = clock::now();
+        bool direct      = false;
+        auto bytes       = this->read(read.first, &direct);
+        finish(read, bytes, direct, clock::now() - start);
+    }
+}
+
+void FrameFileReader::uring_worker() {
+#ifdef XSTUDIO_HAVE_LIBURING
+    using Read = Ring::Read;
+    auto &ring = *ring_;
+
+    while (true) {
+        {
+            // nothing more goes in once we are stopping and openers hold none
+            std::unique_lock lock(mutex_);
+            cv_.wait(lock, [&]() {
+                return ring.submitted_ or (stopping_ and not ring.reserved_);
+            });
+            if (not ring.submitted_)
+                break;
+        }
+
+        io_uring_cqe *cqe = nullptr;
+        if (const auto error = io_uring_wait_cqe(&ring.ring_, &cqe); error < 0) {
+            if (error == -EINTR)
+                continue;
+            spdlog::warn("{} {}", __PRETTY_FUNCTION__, strerror(-error));
+            ring.fail(*this);
+            break;
+        }
+
+        auto read         = static_cast<Read *>(io_uring_cqe_get_data(cqe));
+        const auto result = cqe->res;
+        io_uring_cqe_seen(&ring.ring_, cqe);
+        {
+            std::scoped_lock lock(ring.submit_mutex_);
+            ring.in_flight_.erase(read);
+        }
+
+        bool retry = false;
+        {
+            std::scoped_lock lock(mutex_);
+            ring.submitted_--;
+            // direct reads that failed are read again buffered, unless we
+            // are stopping and the openers may be gone
+            retry = result <= 0 and result != -EINTR and result != -EAGAIN and
+                    read->direct_ and not stopping_;
+            if (retry) {
+                ring.retry_.emplace_back(read);
+                cv_.notify_all();
+            }
+        }
+        if (retry)
+            continue;
+
+        if (result == -EINTR or result == -EAGAIN or
+            (result > 0 and read->done_ + size_t(result) < read->size_)) {
+            // interrupted or short, carry on from where it got to
+            if (result > 0)
+                read->done_ += size_t(result);
+            if (not ring.submit(*this, read))
+                ring.complete(*this, std::unique_ptr<Read>(read), false);
+        } else {
+            read->done_ += size_t(std::max(0, result));
+            ring.complete(*this, std::unique_ptr<Read>(read), result > 0);
+        }
+    }
+#endif
+}
+
+void FrameFileReader::uring_opener() {
+#ifdef XSTUDIO_HAVE_LIBURING
+    using Read = Ring::Read;
+    auto &ring = *ring_;
+
+    while (true) {
+        std::unique_ptr<Read> read;
+        bool retry      = false;
+        bool try_direct = true;
+        size_t budget   = 0;
+        {
+            std::unique_lock lock(mutex_);
+            while (not read) {
+                if (not ring.retry_.empty()) {
+                    read = std::move(ring.retry_.front());
+                    ring.retry_.pop_front();
+                    retry = true;
+                    break;
+                }
+                if (stopping_)
+                    return;
+
+                // a place in the ring is taken before the file, so it's
+                // always open for as short a time as it can be
+                if (ring.reserved_ < uring_depth) {
+                    auto next = this->next(lock, false);
+                    if (next.second) {
+                        ring.reserved_++;
+                        read = std::make_unique<Read>(Read{std::move(next)});
+                        break;
+                    }
+                }
+
+                // waking now and then, so files not taken don't hold the budget
+                cv_.wait_for(lock, std::chrono::seconds(1));
+                evict(clock::now());
+            }
+            try_direct = direct_io_;
+            budget     = budget_;
+        }
+
+        if (retry) {
+            ring.read_buffered(*this, std::move(read));
+            continue;
+        }
+
+        read->start_ = clock::now();
+        read->fd_    = open_file(read->next_.first, try_direct, read->direct_, read->size_);
+        // more than we'd hold, the reader streams it as before
+        if (read->fd_ < 0 or read->size_ > budget) {
+            ring.complete(*this, std::move(read), false);
+            continue;
+        }
+
+        read->bytes_ = std::make_shared<FileBytes>(pool_, capacity_for(read->size_));
+        {
+            std::scoped_lock lock(mutex_);
+            reading_ += read->bytes_->capacity();
+        }
+
+        if (ring.submit(*this, read.get()))
+            read.release();
+        else
+            ring.read_here(*this, std::move(read));
+    }
+#endif
+}
@@ -63,6 +63,16 @@ std::optional<FrameRequest>
 FrameRequestQueue::pop_request(
     const std::map<utility::Uuid, int> &in_flight_frame_requests_per_playhead,
     const size_t max_num_inflight_requests) {
+    return pop_request(
+        in_flight_frame_requests_per_playhead,
+        [max_num_inflight_requests](const FrameRequest &, const int in_flight) {
+            return size_t(in_flight) < max_num_inflight_requests;
+        });
+}
+
+std::optional<FrameRequest> FrameRequestQueue::pop_request(
+    const std::map<utility::Uuid, int> &in_flight_frame_requests_per_playhead,
+    const std::function<bool(const FrameRequest &, const int in_flight)> &admit) {
     std::optional<FrameRequest> rt = {};
 
     for (auto p = queue_.begin(); p != queue_.end(); p++) {
@@ -74,7 +84,7 @@ FrameRequestQueue::pop_request(
         // the frames will ultimately be read out-of-order. This can kill performance for readers like mp4 which have
         // motion encoding with I fra
         if (q == in_flight_frame_requests_per_playhead.end() || 
-            ((*p)->requested_frame_ && !(*p)->requested_frame_->is_containerised_encoding() && size_t(q->second) < max_num_inflight_requests)
+            ((*p)->requested_frame_ && !(*p)->requested_frame_->is_containerised_encoding() && admit(*(*p), q->second))
         ) {
             rt = *(*p);
             queue_.erase(p);
@@ -84,6 +94,18 @@ FrameRequestQueue::pop_request(
     return rt;
 }
 
+std::vector<std::shared_ptr<const media::AVFrameID>>
+FrameRequestQueue::upcoming(const size_t count) const {
+    std::vector<std::shared_ptr<const media::AVFrameID>> result;
+    for (const auto &p : queue_) {
+        if (result.size() == count)
+            break;
+        if (p->requested_frame_)
+            result.push_back(p->requested_frame_);
+    }
+    return result;
+}
+
 void FrameRequestQueue::prune_stale_frame_requests() {
 
     auto now = utility::clock::now();
@@ -99,6 +121,38 @@ void FrameRequestQueue::prune_stale_frame_requests() {
     }
 }
 
+void FrameRequestQueue::retain_frame_requests(
+    const media::AVFrameIDsAndTimePoints &window, const utility::Uuid &playhead_uuid) {
+
+    std::map<media::MediaKey, utility::time_point> required_by;
+    for (const auto &p : window) {
+        if (p.second)
+            required_by.emplace(p.second->key(), p.first);
+    }
+
+    queue_.erase(
+        std::remove_if(
+            queue_.begin(),
+            queue_.end(),
+            [&](const std::shared_ptr<FrameRequest> &x) {
+                if (x->requesting_playhead_uuid_ != playhead_uuid)
+                    return false;
+                auto p = x->requested_frame_ ? required_by.find(x->requested_frame_->key())
+                                             : required_by.end();
+                if (p == required_by.end())
+                    return true;
+                x->required_by_ = p->second;
+                return false;
+            }),
+        queue_.end());
+
+    std::sort(
+        queue_.begin(),
+        queue_.end(),
+        [](const std::shared_ptr<FrameRequest> &a, const std::shared_ptr<FrameRequest> &b)
+            -> bool { return a->required_by_ < b->required_by_; });
+}
+
 void FrameRequestQueue::clear_pending_requests(const utility::Uuid &playhead_uuid) {
 
     queue_.erase(
@@ -0,0 +1,196 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "xstudio/media_reader/image_diff.hpp"
+
+using namespace xstudio;
+using namespace xstudio::media_reader;
+
+namespace {
+
+// Running totals for the compared pixels, kept per row in float and added
+// to the double totals so long rows don't lose precision.
+struct RowTotals {
+    std::array<float, 4> sum_{0.0f, 0.0f, 0.0f, 0.0f};
+    std::array<float, 4> max_{0.0f, 0.0f, 0.0f, 0.0f};
+    float sq_sum_{0.0f};
+    size_t differing_{0};
+};
+
+// The loops are kept simple so the compiler can vectorise them.
+void compare_row(
+    const float *a,
+    const float *b,
+    float *diff,
+    const int count,
+    const float tolerance,
+    RowTotals &totals) {
+
+    const int n = count * 4;
+    for (int i = 0; i < n; ++i)
+        diff[i] = std::fabs(a[i] - b[i]);
+
+    for (int i = 0; i < count; ++i) {
+        const float *d  = diff + i * 4;
+        float pixel_max = 0.0f;
+        for (int c = 0; c < 4; ++c) {
+            totals.sum_[c] += d[c];
+            totals.max_[c] = std::max(totals.max_[c], d[c]);
+            pixel_max      = std::max(pixel_max, d[c]);
+        }
+        totals.sq_sum_ += d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+        totals.differing_ += pixel_max > tolerance ? 1 : 0;
+    }
+}
+
+// The bytes holding the data window's pixels. Buffers are padded for upload
+// and the padding of a recycled buffer holds whatever was there before, so
+// only rows of the data window are hashed and compared, where the reader
+// says how many bytes a pixel takes, else what it allocated.
+size_t pixel_data_size(const ImageBuffer &image) {
+    auto size = std::min(image.data_size(), image.size());
+
+    const auto &params = image.shader_params();
+    if (params.is_object() and params.contains("bytes_per_pixel") and
+        params.at("bytes_per_pixel").is_number_integer()) {
+        const auto box  = image.image_pixels_bounding_box();
+        const auto rows = static_cast<size_t>(std::max(0, box.max.y - box.min.y));
+        const auto row  = static_cast<size_t>(std::max(0, box.max.x - box.min.x)) *
+                         params.at("bytes_per_pixel").get<size_t>();
+        size = std::min(size, rows * row);
+    }
+
+    return size;
+}
+
+} // namespace
+
+uint64_t xstudio::media_reader::image_content_hash(const ImageBufPtr &image) {
+    if (not image or not image->buffer())
+        return 0;
+
+    // the same bytes mean a different image if they're laid out differently
+    const auto layout = fmt::format(
+        "{} {} {} {} {} {} {}",
+        image->image_size_in_pixels().x,
+        image->image_size_in_pixels().y,
+        image->image_pixels_bounding_box().min.x,
+        image->image_pixels_bounding_box().min.y,
+        image->image_pixels_bounding_box().max.x,
+        image->image_pixels_bounding_box().max.y,
+        image->shader_params().dump());
+
+    return hash_bytes(
+        image->buffer(), pixel_data_size(*image), hash_bytes(layout.data(), layout.size()));
+}
+
+utility::JsonStore ImageDiffStats::to_json() const {
+    utility::JsonStore result;
+
+    result["identical"]        = identical_;
+    result["max_abs_diff"]     = max_abs_diff_;
+    result["mean_abs_diff"]    = mean_abs_diff_;
+    result["differing_pixels"] = differing_pixels_;
+    result["pixel_count"]      = pixel_count_;
+    result["hash_a"]           = fmt::format("{:016x}", hash_a_);
+    result["hash_b"]           = fmt::format("{:016x}", hash_b_);
+    result["error"]            = error_;
+
+    // json has no infinity, identical images have a null psnr
+    result["psnr"] = std::isfinite(psnr_) ? nlohmann::json(psnr_) : nlohmann::json();
+
+    return result;
+}
+
+ImageDiffStats xstudio::media_reader::compare_images(
+    const ImageBufPtr &a, const ImageBufPtr &b, const float tolerance) {
+    ImageDiffStats result;
+
+    if (not a or not b) {
+        result.error_ = "Missing image";
+        return result;
+    }
+
+    if (a->error_state() == HAS_ERROR or b->error_state() == HAS_ERROR) {
+        result.error_ =
+            a->error_state() == HAS_ERROR ? a->error_message() : b->error_message();
+        return result;
+    }
+
+    result.hash_a_ = image_content_hash(a);
+    result.hash_b_ = image_content_hash(b);
+
+    if (a->image_size_in_pixels() != b->image_size_in_pixels()) {
+        result.error_ = fmt::format(
+            "Image sizes differ {}x{} {}x{}",
+            a->image_size_in_pixels().x,
+            a->image_size_in_pixels().y,
+            b->image_size_in_pixels().x,
+            b->image_size_in_pixels().y);
+        return result;
+    }
+
+    auto box = a->image_pixels_bounding_box();
+    box.extendBy(b->image_pixels_bounding_box());
+    const int width  = std::max(0, box.max.x - box.min.x);
+    const int height = std::max(0, box.max.y - box.min.y);
+
+    result.pixel_count_ = static_cast<size_t>(width) * height;
+
+    // same bytes, same layout, nothing to decode
+    const auto size = pixel_data_size(*a);
+    if (result.hash_a_ == result.hash_b_ and size == pixel_data_size(*b) and
+        std::memcmp(a->buffer(), b->buffer(), size) == 0) {
+        result.identical_ = true;
+        result.psnr_      = std::numeric_limits<double>::infinity();
+        return result;
+    }
+
+    if (not a->can_unpack_pixels() or not b->can_unpack_pixels()) {
+        result.error_ = "Images can't be decoded for comparison";
+        return result;
+    }
+
+    std::vector<float> row_a(static_cast<size_t>(width) * 4);
+    std::vector<float> row_b(row_a.size());
+    std::vector<float> diff(row_a.size());
+
+    std::array<double, 4> sum{0.0, 0.0, 0.0, 0.0};
+    double sq_sum = 0.0;
+
+    for (int y = box.min.y; y < box.max.y; ++y) {
+        a->unpack_pixels(box.min.x, y, width, a->shader_params(), row_a.data());
+        b->unpack_pixels(box.min.x, y, width, b->shader_params(), row_b.data());
+
+        RowTotals totals;
+        compare_row(row_a.data(), row_b.data(), diff.data(), width, tolerance, totals);
+
+        for (int c = 0; c < 4; ++c) {
+            sum[c] += totals.sum_[c];
+            result.max_abs_diff_[c] = std::max(result.max_abs_diff_[c], double(totals.max_[c]));
+        }
+        sq_sum += totals.sq_sum_;
+        result.differing_pixels_ += totals.differing_;
+    }
+
+    if (result.pixel_count_) {
+        for (int c = 0; c < 4; ++c)
+            result.mean_abs_diff_[c] = sum[c] / result.pixel_count_;
+    }
+
+    const double mse = result.pixel_count_ ? sq_sum / (3.0 * result.pixel_count_) : 0.0;
+    result.psnr_ =
+        mse > 0.0 ? 10.0 * std::log10(1.0 / mse) : std::numeric_limits<double>::infinity();
+    result.identical_ = std::all_of(
+        result.max_abs_diff_.begin(), result.max_abs_diff_.end(), [](const double v) {
+            return v == 0.0;
+        });
+
+    return result;
+}
@@ -0,0 +1,309 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <caf/actor_registry.hpp>
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <optional>
+
+#include "xstudio/atoms.hpp"
+#include "xstudio/media_reader/image_diff_actor.hpp"
+#include "xstudio/utility/helpers.hpp"
+#include "xstudio/utility/logging.hpp"
+
+using namespace caf;
+
+using namespace xstudio;
+using namespace xstudio::media;
+using namespace xstudio::utility;
+using namespace xstudio::media_reader;
+
+namespace {
+
+JsonStore diff_error(const std::string &message) {
+    ImageDiffStats stats;
+    stats.error_ = message;
+    return stats.to_json();
+}
+
+JsonStore diff_summary(
+    const size_t frame_count_a, const size_t frame_count_b, std::vector<JsonStore> &frames) {
+    JsonStore result;
+    size_t identical = 0;
+    size_t errors    = 0;
+    std::optional<double> min_psnr;
+    std::array<double, 4> max_abs_diff{0.0, 0.0, 0.0, 0.0};
+
+    for (size_t i = 0; i < frames.size(); ++i) {
+        auto &frame    = frames[i];
+        frame["frame"] = i;
+
+        if (not frame.value("error", std::string()).empty()) {
+            errors++;
+            continue;
+        }
+        if (frame.value("identical", false))
+            identical++;
+        if (frame["psnr"].is_number()) {
+            const auto psnr = frame["psnr"].get<double>();
+            min_psnr        = min_psnr ? std::min(*min_psnr, psnr) : psnr;
+        }
+        for (size_t c = 0; c < 4; ++c)
+            max_abs_diff[c] = std::max(max_abs_diff[c], frame["max_abs_diff"][c].get<double>());
+    }
+
+    result["frame_count_a"]           = frame_count_a;
+    result["frame_count_b"]           = frame_count_b;
+    result["frames"]                  = frames;
+    result["summary"]["compared"]     = frames.size();
+    result["summary"]["identical"]    = identical;
+    result["summary"]["differing"]    = frames.size() - identical - errors;
+    result["summary"]["errors"]       = errors;
+    result["summary"]["max_abs_diff"] = max_abs_diff;
+    result["summary"]["min_psnr"]     = min_psnr ? nlohmann::json(*min_psnr) : nlohmann::json();
+    return result;
+}
+
+} // namespace
+
+ImageDiffWorkerActor::ImageDiffWorkerActor(caf::actor_config &cfg)
+    : caf::event_based_actor(cfg) {
+
+    behavior_.assign(
+        [=](image_diff_atom,
+            const media::AVFrameID &frame_a,
+            const media::AVFrameID &frame_b,
+            const double tolerance) -> result<JsonStore> {
+            auto reader = system().registry().template get<caf::actor>(media_reader_registry);
+            if (not reader)
+                return make_error(xstudio_error::error, "No media reader");
+
+            auto rp      = make_response_promise<JsonStore>();
+            auto images  = std::make_shared<std::array<ImageBufPtr, 2>>();
+            auto pending = std::make_shared<int>(2);
+
+            for (size_t i = 0; i < 2; ++i) {
+                mail(
+                    get_image_atom_v,
+                    i ? frame_b : frame_a,
+                    false,
+                    utility::Uuid(),
+                    timebase::flicks(0))
+                    .request(reader, infinite)
+                    .then(
+                        [=](const ImageBufPtr &buf) mutable {
+                            if (*pending <= 0)
+                                return;
+                            (*images)[i] = buf;
+                            if (--(*pending) == 0)
+                                rp.deliver(
+                                    compare_images((*images)[0], (*images)[1], tolerance)
+                                        .to_json());
+                        },
+                        [=](const caf::error &err) mutable {
+                            // a frame that won't read is a result, not a failure
+                            if (*pending <= 0)
+                                return;
+                            *pending = 0;
+                            rp.deliver(diff_error(to_string(err)));
+                        });
+            }
+
+            return rp;
+        },
+
+        [=](pixel_sample_atom,
+            const media::AVFrameID &frame,
+            const JsonStore &request) -> result<JsonStore> {
+            auto reader = system().registry().template get<caf::actor>(media_reader_registry);
+            if (not reader)
+                return make_error(xstudio_error::error, "No media reader");
+
+            PixelSampleRequest sample_request;
+            try {
+                sample_request = PixelSampleRequest(request);
+            } catch (const std::exception &err) {
+                return make_error(xstudio_error::error, err.what());
+            }
+
+            auto rp = make_response_promise<JsonStore>();
+            mail(get_image_atom_v, frame, false, utility::Uuid(), timebase::flicks(0))
+                .request(reader, infinite)
+                .then(
+                    [=](const ImageBufPtr &buf) mutable {
+                        rp.deliver(sample_pixels(buf, sample_request).to_json());
+                    },
+                    [=](const caf::error &err) mutable {
+                        PixelSamples samples;
+                        samples.error_ = to_string(err);
+                        rp.deliver(samples.to_json());
+                    });
+            return rp;
+        });
+}
+
+// A job over many frames, results_[i] is filled by sending request_(i, done)
+// to the pool and finish_ turns them into the response.
+struct ImageDiffActor::SequenceJob {
+    size_t count_{0};
+    size_t next_{0};
+    size_t in_flight_{0};
+    size_t done_{0};
+
+    typedef std::function<void(const JsonStore &)> Done;
+
+    std::vector<JsonStore> results_;
+    std::function<void(const size_t, Done)> request_;
+    std::function<JsonStore(std::vector<JsonStore> &)> finish_;
+    caf::typed_response_promise<JsonStore> rp_;
+};
+
+ImageDiffActor::ImageDiffActor(caf::actor_config &cfg, const size_t worker_count)
+    : caf::event_based_actor(cfg) {
+    print_on_exit(this, "ImageDiffActor");
+
+    // keep a few requests queued per worker so they never wait on the readers
+    max_in_flight_ = std::max<size_t>(worker_count, 1) * 2;
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+
+    pool_ = caf::actor_pool::make(
+        system(),
+        std::max<size_t>(worker_count, 1),
+        [&] { return system().spawn<ImageDiffWorkerActor>(); },
+        caf::actor_pool::round_robin());
+    link_to(pool_);
+
+#pragma GCC diagnostic pop
+
+    behavior_.assign(
+        [=](image_diff_atom atom,
+            const media::AVFrameID &frame_a,
+            const media::AVFrameID &frame_b,
+            const double tolerance) {
+            return mail(atom, frame_a, frame_b, tolerance).delegate(pool_);
+        },
+
+        [=](image_diff_atom,
+            const caf::actor &media_a,
+            const caf::actor &media_b,
+            const double tolerance) -> result<JsonStore> {
+            auto job = std::make_shared<SequenceJob>();
+            job->rp_ = make_response_promise<JsonStore>();
+
+            mail(get_media_pointer_atom_v, media::MT_IMAGE)
+                .request(media_a, infinite)
+                .then(
+                    [=](const std::vector<media::AVFrameID> &frames_a) mutable {
+                        mail(get_media_pointer_atom_v, media::MT_IMAGE)
+                            .request(media_b, infinite)
+                            .then(
+                                [=](const std::vector<media::AVFrameID> &frames_b) mutable {
+                                    job->count_ = std::min(frames_a.size(), frames_b.size());
+                                    job->results_.resize(job->count_);
+                                    job->request_ = [=](const size_t i,
+                                                        SequenceJob::Done done) {
+                                        mail(
+                                            image_diff_atom_v,
+                                            frames_a[i],
+                                            frames_b[i],
+                                            tolerance)
+                                            .request(pool_, infinite)
+                                            .then(
+                                                [=](const JsonStore &stats) { done(stats); },
+                                                [=](const caf::error &err) {
+                                                    done(diff_error(to_string(err)));
+                                                });
+                                    };
+                                    job->finish_ = [=](std::vector<JsonStore> &results) {
+                                        return diff_summary(
+                                            frames_a.size(), frames_b.size(), results);
+                                    };
+                                    continue_sequence(job);
+                                },
+                                [=](const caf::error &err) mutable { job->rp_.deliver(err); });
+                    },
+                    [=](const caf::error &err) mutable { job->rp_.deliver(err); });
+
+            return job->rp_;
+        },
+
+        [=](pixel_sample_atom atom, const media::AVFrameID &frame, const JsonStore &request) {
+            return mail(atom, frame, request).delegate(pool_);
+        },
+
+        [=](pixel_sample_atom,
+            const caf::actor &media,
+            const JsonStore &request) -> result<JsonStore> {
+            auto job = std::make_shared<SequenceJob>();
+            job->rp_ = make_response_promise<JsonStore>();
+
+            mail(get_media_pointer_atom_v, media::MT_IMAGE)
+                .request(media, infinite)
+                .then(
+                    [=](const std::vector<media::AVFrameID> &frames) mutable {
+                        // all frames unless some are asked for
+                        std::vector<size_t> indexes;
+                        if (request.count("frames")) {
+                            for (const auto &f : request.at("frames")) {
+                                if (f.is_number_integer() and f.get<int64_t>() >= 0 and
+                                    f.get<size_t>() < frames.size())
+                                    indexes.push_back(f.get<size_t>());
+                            }
+                        } else {
+                            indexes.resize(frames.size());
+                            std::iota(indexes.begin(), indexes.end(), 0);
+                        }
+
+                        job->count_ = indexes.size();
+                        job->results_.resize(job->count_);
+                        job->request_ = [=](const size_t i, SequenceJob::Done done) {
+                            mail(pixel_sample_atom_v, frames[indexes[i]], request)
+                                .request(pool_, infinite)
+                                .then(
+                                    [=](const JsonStore &samples) {
+                                        auto result     = samples;
+                                        result["frame"] = indexes[i];
+                                        done(result);
+                                    },
+                                    [=](const caf::error &err) {
+                                        JsonStore result;
+                                        result["frame"] = indexes[i];
+                                        result["error"] = to_string(err);
+                                        done(result);
+                                    });
+                        };
+                        job->finish_ = [=](std::vector<JsonStore> &results) {
+                            JsonStore result;
+                            result["frame_count"] = frames.size();
+                            result["frames"]      = results;
+                            return result;
+                        };
+                        continue_sequence(job);
+                    },
+                    [=](const caf::error &err) mutable { job->rp_.deliver(err); });
+
+            return job->rp_;
+        });
+}
+
+void ImageDiffActor::continue_sequence(const std::shared_ptr<SequenceJob> &job) {
+
+    if (job->done_ == job->count_) {
+        job->rp_.deliver(job->finish_(job->results_));
+        return;
+    }
+
+    while (job->in_flight_ < max_in_flight_ and job->next_ < job->count_) {
+        const auto i = job->next_++;
+        job->in_flight_++;
+
+        job->request_(i, [=](const JsonStore &result) {
+            job->results_[i] = result;
+            job->in_flight_--;
+            job->done_++;
+            continue_sequence(job);
+        });
+    }
+}
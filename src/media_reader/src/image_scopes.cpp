@@ -0,0 +1,319 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <thread>
+
+#include "xstudio/media_reader/image_scopes.hpp"
+
+using namespace xstudio;
+using namespace xstudio::media_reader;
+
+namespace {
+
+// Rec.709
+constexpr float luma_r = 0.2126f;
+constexpr float luma_g = 0.7152f;
+constexpr float luma_b = 0.0722f;
+
+// a thread isn't worth starting for fewer samples than this
+constexpr size_t min_samples_per_thread = 1 << 15;
+
+inline int bin_index(const float v, const float min, const float scale, const int bins) {
+    // NaNs go in the first bin with everything below the range
+    const float f = (v - min) * scale;
+    return f > 0.0f ? std::min(static_cast<int>(f), bins - 1) : 0;
+}
+
+struct Counts {
+    Counts(const ImageScopesSettings &s) {
+        for (auto &h : histograms_)
+            h.assign(s.histogram_bins_, 0);
+        luma_waveform_.assign(size_t(s.waveform_columns_) * s.waveform_rows_, 0);
+        for (auto &p : rgb_parade_)
+            p.assign(luma_waveform_.size(), 0);
+    }
+
+    void add(const Counts &o) {
+        for (size_t c = 0; c < histograms_.size(); ++c)
+            std::transform(
+                histograms_[c].begin(),
+                histograms_[c].end(),
+                o.histograms_[c].begin(),
+                histograms_[c].begin(),
+                std::plus<uint32_t>());
+        std::transform(
+            luma_waveform_.begin(),
+            luma_waveform_.end(),
+            o.luma_waveform_.begin(),
+            luma_waveform_.begin(),
+            std::plus<uint32_t>());
+        for (size_t c = 0; c < rgb_parade_.size(); ++c)
+            std::transform(
+                rgb_parade_[c].begin(),
+                rgb_parade_[c].end(),
+                o.rgb_parade_[c].begin(),
+                rgb_parade_[c].begin(),
+                std::plus<uint32_t>());
+        samples_ += o.samples_;
+    }
+
+    std::array<std::vector<uint32_t>, 4> histograms_;
+    std::vector<uint32_t> luma_waveform_;
+    std::array<std::vector<uint32_t>, 3> rgb_parade_;
+    size_t samples_{0};
+};
+
+// Sample rows first_row, first_row + step_y ... up to end_row.
+void measure_rows(
+    const ImageBuffer &image,
+    const utility::JsonStore &uniforms,
+    const ImageScopesSettings &settings,
+    const Imath::Box2i &box,
+    const int first_row,
+    const int end_row,
+    const int step_x,
+    const int step_y,
+    Counts &counts) {
+
+    const int width        = box.max.x - box.min.x;
+    const int hbins        = settings.histogram_bins_;
+    const int wcols        = settings.waveform_columns_;
+    const int wrows        = settings.waveform_rows_;
+    const float range      = std::max(settings.range_max_ - settings.range_min_, 1e-6f);
+    const float hist_scale = hbins / range;
+    const float wave_scale = wrows / range;
+    const float min        = settings.range_min_;
+
+    // waveform column of each sampled pixel, the same for every row
+    std::vector<int> columns;
+    columns.reserve(width / step_x + 1);
+    for (int x = 0; x < width; x += step_x)
+        columns.push_back(static_cast<int>(int64_t(x) * wcols / width));
+
+    std::vector<float> row(size_t(width) * 4);
+    std::array<std::vector<int>, 4> hist_bins;
+    std::array<std::vector<int>, 4> wave_bins;
+    for (size_t c = 0; c < 4; ++c) {
+        hist_bins[c].resize(columns.size());
+        wave_bins[c].resize(columns.size());
+    }
+
+    const int n = static_cast<int>(columns.size());
+
+    for (int y = first_row; y < end_row; y += step_y) {
+        image.unpack_pixels(box.min.x, y, width, uniforms, row.data());
+
+        // bin indexes first, in simple loops that vectorise, then scatter
+        // the counts
+        for (int i = 0; i < n; ++i) {
+            const float *p = row.data() + size_t(i) * step_x * 4;
+            const float l  = luma_r * p[0] + luma_g * p[1] + luma_b * p[2];
+            for (int c = 0; c < 3; ++c) {
+                hist_bins[c][i] = bin_index(p[c], min, hist_scale, hbins);
+                wave_bins[c][i] = bin_index(p[c], min, wave_scale, wrows);
+            }
+            hist_bins[3][i] = bin_index(l, min, hist_scale, hbins);
+            wave_bins[3][i] = bin_index(l, min, wave_scale, wrows);
+        }
+
+        for (int i = 0; i < n; ++i) {
+            for (int c = 0; c < 4; ++c)
+                counts.histograms_[c][hist_bins[c][i]]++;
+            for (int c = 0; c < 3; ++c)
+                counts.rgb_parade_[c][size_t(wave_bins[c][i]) * wcols + columns[i]]++;
+            counts.luma_waveform_[size_t(wave_bins[3][i]) * wcols + columns[i]]++;
+        }
+        counts.samples_ += n;
+    }
+}
+
+} // namespace
+
+ImageScopesSettings::ImageScopesSettings(const utility::JsonStore &js) {
+    histogram_bins_   = std::clamp(js.value("histogram_bins", histogram_bins_), 1, 4096);
+    waveform_columns_ = std::clamp(js.value("waveform_columns", waveform_columns_), 1, 4096);
+    waveform_rows_    = std::clamp(js.value("waveform_rows", waveform_rows_), 1, 4096);
+    range_min_        = js.value("range_min", range_min_);
+    range_max_        = js.value("range_max", range_max_);
+    max_samples_      = js.value("max_samples", max_samples_);
+    max_threads_      = js.value("max_threads", max_threads_);
+}
+
+utility::JsonStore ImageScopesSettings::to_json() const {
+    utility::JsonStore result;
+    result["histogram_bins"]   = histogram_bins_;
+    result["waveform_columns"] = waveform_columns_;
+    result["waveform_rows"]    = waveform_rows_;
+    result["range_min"]        = range_min_;
+    result["range_max"]        = range_max_;
+    result["max_samples"]      = max_samples_;
+    result["max_threads"]      = max_threads_;
+    return result;
+}
+
+utility::JsonStore ImageScopes::to_json() const {
+    utility::JsonStore result;
+    result["settings"]            = settings_.to_json();
+    result["histograms"]["red"]   = histograms_[RED];
+    result["histograms"]["green"] = histograms_[GREEN];
+    result["histograms"]["blue"]  = histograms_[BLUE];
+    result["histograms"]["luma"]  = histograms_[LUMA];
+    result["luma_waveform"]       = luma_waveform_;
+    result["rgb_parade"]["red"]   = rgb_parade_[RED];
+    result["rgb_parade"]["green"] = rgb_parade_[GREEN];
+    result["rgb_parade"]["blue"]  = rgb_parade_[BLUE];
+    result["samples"]             = samples_;
+    result["step"]                = {step_x_, step_y_};
+    result["error"]               = error_;
+    return result;
+}
+
+ImageScopes xstudio::media_reader::compute_image_scopes(
+    const ImageBufPtr &image, const ImageScopesSettings &settings) {
+    ImageScopes result;
+    result.settings_ = settings;
+
+    auto s              = settings;
+    s.histogram_bins_   = std::max(s.histogram_bins_, 1);
+    s.waveform_columns_ = std::max(s.waveform_columns_, 1);
+    s.waveform_rows_    = std::max(s.waveform_rows_, 1);
+
+    if (not image) {
+        result.error_ = "No image";
+        return result;
+    }
+    if (image->error_state() == HAS_ERROR) {
+        result.error_ = image->error_message();
+        return result;
+    }
+    if (not image->can_unpack_pixels()) {
+        result.error_ = "Image can't be decoded for scopes";
+        return result;
+    }
+
+    const auto box    = image->image_pixels_bounding_box();
+    const int width   = box.max.x - box.min.x;
+    const int height  = box.max.y - box.min.y;
+    const auto pixels = size_t(std::max(width, 0)) * std::max(height, 0);
+
+    if (not pixels) {
+        Counts empty(s);
+        result.histograms_    = std::move(empty.histograms_);
+        result.luma_waveform_ = std::move(empty.luma_waveform_);
+        result.rgb_parade_    = std::move(empty.rgb_parade_);
+        return result;
+    }
+
+    // same step both ways, so the sampling grid is square
+    if (s.max_samples_ and pixels > s.max_samples_) {
+        const auto step = static_cast<int>(
+            std::ceil(std::sqrt(double(pixels) / double(s.max_samples_))));
+        result.step_x_ = std::min(step, width);
+        result.step_y_ = std::min(step, height);
+    }
+
+    const size_t rows    = (height + result.step_y_ - 1) / result.step_y_;
+    const size_t samples = rows * ((width + result.step_x_ - 1) / result.step_x_);
+
+    size_t threads =
+        s.max_threads_ > 0 ? size_t(s.max_threads_) : std::thread::hardware_concurrency();
+    threads = std::clamp<size_t>(
+        std::min(threads, samples / min_samples_per_thread), 1, std::max<size_t>(rows, 1));
+
+    const auto &uniforms = image->shader_params();
+
+    // whole sampled rows per thread
+    const size_t rows_per_thread = (rows + threads - 1) / threads;
+    const auto first_row         = [&](const size_t t) {
+        const auto row = static_cast<int>(std::min(t * rows_per_thread, rows));
+        return box.min.y + row * result.step_y_;
+    };
+
+    std::vector<Counts> counts(threads, Counts(s));
+    std::vector<std::future<void>> workers;
+    for (size_t t = 1; t < threads; ++t) {
+        workers.emplace_back(std::async(std::launch::async, [&, t]() {
+            measure_rows(
+                *image,
+                uniforms,
+                s,
+                box,
+                first_row(t),
+                std::min(first_row(t + 1), box.max.y),
+                result.step_x_,
+                result.step_y_,
+                counts[t]);
+        }));
+    }
+    measure_rows(
+        *image,
+        uniforms,
+        s,
+        box,
+        first_row(0),
+        std::min(first_row(1), box.max.y),
+        result.step_x_,
+        result.step_y_,
+        counts[0]);
+
+    for (size_t t = 1; t < threads; ++t) {
+        workers[t - 1].get();
+        counts[0].add(counts[t]);
+    }
+
+    result.histograms_    = std::move(counts[0].histograms_);
+    result.luma_waveform_ = std::move(counts[0].luma_waveform_);
+    result.rgb_parade_    = std::move(counts[0].rgb_parade_);
+    result.samples_       = counts[0].samples_;
+
+    return result;
+}
+
+ImageScopesPtr
+ImageScopesCache::get(const ImageBufPtr &image, const ImageScopesSettings &settings) {
+    const auto key = image ? image->media_key() : media::MediaKey();
+
+    if (not key.is_null()) {
+        std::lock_guard<std::mutex> l(mutex_);
+        auto p = index_.find(key);
+        if (p != index_.end() and p->second->second->settings_ == settings) {
+            entries_.splice(entries_.begin(), entries_, p->second);
+            hits_++;
+            return p->second->second;
+        }
+    }
+
+    // not under the lock, another thread asking for something else
+    // shouldn't have to wait for this
+    auto result = std::make_shared<const ImageScopes>(compute_image_scopes(image, settings));
+
+    if (not key.is_null() and result->error_.empty()) {
+        std::lock_guard<std::mutex> l(mutex_);
+        auto p = index_.find(key);
+        if (p != index_.end()) {
+            entries_.erase(p->second);
+            index_.erase(p);
+        }
+        entries_.emplace_front(key, result);
+        index_[key] = entries_.begin();
+
+        while (entries_.size() > capacity_) {
+            index_.erase(entries_.back().first);
+            entries_.pop_back();
+        }
+    }
+
+    return result;
+}
+
+void ImageScopesCache::clear() {
+    std::lock_guard<std::mutex> l(mutex_);
+    entries_.clear();
+    index_.clear();
+}
+
+size_t ImageScopesCache::size() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return entries_.size();
+}
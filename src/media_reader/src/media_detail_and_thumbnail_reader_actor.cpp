@@ -29,8 +29,10 @@ using namespace xstudio::media_reader;
 using namespace xstudio::media_cache;
 
 MediaDetailAndThumbnailReaderActor::MediaDetailAndThumbnailReaderActor(
-    caf::actor_config &cfg, const utility::Uuid &uuid)
-    : caf::event_based_actor(cfg), uuid_(uuid) {
+    caf::actor_config &cfg,
+    const utility::Uuid &uuid,
+    std::shared_ptr<utility::FileProbeCache> probe_cache)
+    : caf::event_based_actor(cfg), uuid_(uuid), probe_cache_(std::move(probe_cache)) {
     print_on_exit(this, NAME);
     spdlog::debug("Created {}.", NAME);
 
@@ -60,6 +62,16 @@ MediaDetailAndThumbnailReaderActor::MediaDetailAndThumbnailReaderActor(
                 plugins_map_[i.uuid_] = actor;
             }
         }
+
+        nlohmann::json probe_prefs;
+        try {
+            probe_prefs["plugin"] = js.get("/plugin/media_reader");
+            probe_prefs["timecode_from_frame"] =
+                js.get("/core/media_reader/timecode_from_frame/value");
+        } catch (...) {
+        }
+        probe_fingerprint_ = plugin_manager::plugin_fingerprint(
+            details, plugin_manager::PluginFlags::PF_MEDIA_READER, probe_prefs);
     }
 
     behavior_.assign(
@@ -94,6 +106,21 @@ MediaDetailAndThumbnailReaderActor::MediaDetailAndThumbnailReaderActor(
                 return media_detail_cache_[_uri];
             }
 
+            // try the persistent cache before touching any reader
+            if (probe_cache_) {
+                if (auto cached =
+                        probe_cache_->find(uri_to_posix_path(_uri), probe_fingerprint_)) {
+                    try {
+                        auto md                       = cached->get<MediaDetail>();
+                        media_detail_cache_age_[_uri] = utility::clock::now();
+                        media_detail_cache_[_uri]     = md;
+                        return md;
+                    } catch (const std::exception &e) {
+                        spdlog::debug("{} {}", __PRETTY_FUNCTION__, e.what());
+                    }
+                }
+            }
+
             // Add the request to a queue - if the queues aren't empty at this
             // point the loop to process the queues is already underway so we
             // don't want to send ourselves another message to start the
@@ -275,6 +302,9 @@ void MediaDetailAndThumbnailReaderActor::process_get_media_detail_queue() {
                                 [=](const MediaDetail &md) mutable {
                                     media_detail_cache_age_[_uri] = utility::clock::now();
                                     media_detail_cache_[_uri]     = md;
+                                    if (probe_cache_)
+                                        probe_cache_->store(
+                                            uri_to_posix_path(_uri), probe_fingerprint_, md);
                                     rp.deliver(md);
                                     continue_processing_queue();
                                 },
@@ -5,6 +5,7 @@
 #endif
 #include <filesystem>
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 
@@ -248,9 +249,113 @@ xstudio::media_reader::byte *ImageBuffer::allocate(const size_t _size) {
     const size_t padded_size =
         (_size & (gl_line_size - 1)) ? ((_size / gl_line_size) + 1) * gl_line_size : _size;
 
+    data_size_ = _size;
     return Buffer::allocate(padded_size);
 }
 
+namespace {
+utility::InternedJson intern(
+    utility::JsonSourceInterner *source, const std::string &slot, nlohmann::json value) {
+    return source ? source->intern(slot, std::move(value))
+                  : utility::JsonInterner::instance().intern(std::move(value));
+}
+} // namespace
+
+void ImageBuffer::set_shader_params(
+    const utility::JsonStore &params, utility::JsonSourceInterner *source) {
+    shader_params_ = intern(source, "shader_params", params);
+}
+
+const utility::JsonStore &ImageBuffer::shader_params() const {
+    static const utility::JsonStore s_null;
+    return shader_params_.value ? *shader_params_.value : s_null;
+}
+
+void ImageBuffer::set_metadata(
+    const utility::JsonStore &metadata, utility::JsonSourceInterner *source) {
+    metadata_keys_ = utility::InternedJson();
+    metadata_values_.clear();
+
+    if (not metadata.is_object()) {
+        metadata_values_.push_back(intern(source, "metadata", metadata));
+        return;
+    }
+
+    nlohmann::json keys = nlohmann::json::array();
+    metadata_values_.reserve(metadata.size());
+    for (auto it = metadata.begin(); it != metadata.end(); ++it) {
+        keys.push_back(it.key());
+        metadata_values_.push_back(intern(source, "metadata/" + it.key(), it.value()));
+    }
+    metadata_keys_ = intern(source, "metadata keys", std::move(keys));
+}
+
+utility::JsonStore ImageBuffer::metadata() const {
+    if (not metadata_keys_.value)
+        return metadata_values_.empty() ? utility::JsonStore()
+                                        : *metadata_values_.front().value;
+
+    utility::JsonStore result(nlohmann::json::object());
+    for (size_t i = 0; i < metadata_values_.size(); ++i)
+        result[metadata_keys_.value->at(i).get_ref<const std::string &>()] =
+            *metadata_values_[i].value;
+    return result;
+}
+
+size_t ImageBuffer::metadata_size_bytes() const {
+    return metadata_values_.capacity() * sizeof(utility::InternedJson) +
+           utility::json_size_bytes(params());
+}
+
+std::vector<utility::InternedJson> ImageBuffer::shared_values() const {
+    std::vector<utility::InternedJson> result;
+    result.reserve(metadata_values_.size() + 2);
+    if (shader_params_.value)
+        result.push_back(shader_params_);
+    if (metadata_keys_.value)
+        result.push_back(metadata_keys_);
+    result.insert(result.end(), metadata_values_.begin(), metadata_values_.end());
+    return result;
+}
+
+void ImageBuffer::unpack_pixels(
+    const int x,
+    const int y,
+    const int count,
+    const utility::JsonStore &pixel_unpack_uniforms,
+    float *rgba) const {
+
+    if (count <= 0)
+        return;
+
+    if (pixel_unpack_) {
+        pixel_unpack_(*this, pixel_unpack_uniforms, x, y, count, rgba);
+        return;
+    }
+
+    std::fill(rgba, rgba + 4 * count, 0.0f);
+    if (not pixel_picker_)
+        return;
+
+    // The pixel picker gives us raw RGBA for its 'extra' pixels, so ask for
+    // the whole span that way. Pickers may give up early if the main location
+    // is outside the data window, so give them one that isn't.
+    std::vector<Imath::V2i> locations;
+    locations.reserve(count);
+    for (int i = 0; i < count; ++i)
+        locations.emplace_back(x + i, y);
+
+    const auto info = pixel_picker_(
+        *this, pixel_unpack_uniforms, image_pixels_bounding_box().min, locations);
+    const auto &values = info.extra_pixel_raw_rgba_values();
+    for (size_t i = 0; i < std::min(values.size(), size_t(count)); ++i) {
+        rgba[i * 4]     = values[i].x;
+        rgba[i * 4 + 1] = values[i].y;
+        rgba[i * 4 + 2] = values[i].z;
+        rgba[i * 4 + 3] = values[i].w;
+    }
+}
+
 utility::JsonStore ImageBufPtr::metadata() const {
     // the idea here is we add in a few useful metadata fields ontop of the
     // metadata that is carried by the underlying pointer (the ImageBuffer).
@@ -3,12 +3,18 @@
 #include <caf/policy/select_all.hpp>
 #include <caf/actor_registry.hpp>
 
+#include <algorithm>
 #include <limits>
+#include <set>
+#include <thread>
 
 #include "xstudio/atoms.hpp"
 #include "xstudio/global_store/global_store.hpp"
 #include "xstudio/media/caf_media_error.hpp"
+#include "xstudio/media_reader/audio_waveform_actor.hpp"
 #include "xstudio/media_reader/cacheing_media_reader_actor.hpp"
+#include "xstudio/media_reader/frame_file_reader.hpp"
+#include "xstudio/media_reader/image_diff_actor.hpp"
 #include "xstudio/media_reader/media_detail_and_thumbnail_reader_actor.hpp"
 #include "xstudio/media_reader/media_reader_actor.hpp"
 #include "xstudio/plugin_manager/plugin_manager.hpp"
@@ -33,6 +39,15 @@ using namespace xstudio::media_cache;
 namespace {
 using map_addr_timepoint = std::map<std::string, utility::time_point>;
 using workers_t          = std::list<std::shared_ptr<std::pair<caf::actor, int>>>;
+
+// where the file of frame is, if it's one FrameFileReader reads ahead
+std::string frame_file_path(const FrameFileReader &reader, const media::AVFrameID &frame) {
+    if (frame.media_type() != media::MediaType::MT_IMAGE or
+        frame.is_containerised_encoding() or frame.uri().scheme() != "file" or
+        not reader.reads_for(frame.reader()))
+        return {};
+    return uri_to_posix_path(frame.uri());
+}
 } // namespace
 
 
@@ -146,6 +161,15 @@ GlobalMediaReaderActor::GlobalMediaReaderActor(
     if (uuid_.is_null())
         uuid_.generate_in_place();
 
+    probe_cache_ = std::make_shared<FileProbeCache>("media_detail");
+
+    // media detail requests are mostly waiting on filesystem IO, so by default
+    // we have at least 4 workers, more on bigger machines
+    size_t media_detail_worker_count =
+        std::clamp<size_t>(std::thread::hardware_concurrency(), 4, 16);
+
+    JsonStore initial_prefs;
+
     // get plugins
     {
         JsonStore js;
@@ -155,11 +179,23 @@ GlobalMediaReaderActor::GlobalMediaReaderActor(
             max_source_count_ =
                 preference_value<size_t>(js, "/core/media_reader/max_source_count");
             max_source_age_ = preference_value<size_t>(js, "/core/media_reader/max_source_age");
-            max_num_inflight_requests_ =
-                preference_value<size_t>(js, "/core/media_reader/read_threads_per_source");
+            read_concurrency_.set_max_in_flight(
+                preference_value<size_t>(js, "/core/media_reader/read_threads_per_source"));
+            read_concurrency_.set_adaptive(
+                preference_value<bool>(js, "/core/media_reader/adaptive_read_concurrency"));
         } catch (...) {
         }
 
+        try {
+            if (auto count = preference_value<size_t>(
+                    js, "/core/media_reader/media_detail_worker_count"))
+                media_detail_worker_count = count;
+        } catch (...) {
+        }
+        update_probe_cache_preferences(js);
+        update_frame_file_preferences(js);
+        initial_prefs = js;
+
         auto pm = system().registry().template get<caf::actor>(plugin_manager_registry);
         scoped_actor sys{system()};
         auto details = request_receive<std::vector<plugin_manager::PluginDetail>>(
@@ -198,8 +234,11 @@ GlobalMediaReaderActor::GlobalMediaReaderActor(
 
     auto media_detail_reader_pool = caf::actor_pool::make(
         system(),
-        4, // hardcoding to 4 media detail fetchers
-        [&] { return system().spawn<MediaDetailAndThumbnailReaderActor>(); },
+        media_detail_worker_count,
+        [&] {
+            return system().spawn<MediaDetailAndThumbnailReaderActor>(
+                Uuid::generate(), probe_cache_);
+        },
         caf::actor_pool::round_robin());
     link_to(media_detail_reader_pool);
 
@@ -214,12 +253,25 @@ GlobalMediaReaderActor::GlobalMediaReaderActor(
 
 #pragma GCC diagnostic pop
 
+    // QC image comparisons, CPU bound once the frames are read so leave some
+    // cores for playback
+    auto image_diff = system().spawn<ImageDiffActor>(
+        std::clamp<size_t>(std::thread::hardware_concurrency() / 2, 2, 8));
+    link_to(image_diff);
+
+    // waveform summaries, with readers of their own from the pool
+    audio_waveform_ = system().spawn<AudioWaveformActor>(pool_);
+    link_to(audio_waveform_);
+    anon_mail(json_store::update_atom_v, initial_prefs).send(audio_waveform_);
+
     behavior_.assign(
         [=](xstudio::broadcast::broadcast_down_atom, const caf::actor_addr &) {},
 
         [=](clear_precache_queue_atom, const Uuid &playhead_uuid) -> bool {
             playback_precache_request_queue_.clear_pending_requests(playhead_uuid);
             background_precache_request_queue_.clear_pending_requests(playhead_uuid);
+            playback_precache_windows_.erase(std::make_pair(playhead_uuid, MT_IMAGE));
+            playback_precache_windows_.erase(std::make_pair(playhead_uuid, MT_AUDIO));
 
             // this marks all cache entries for this playhead as 'stale' by
             // moving their timestamps to 1 hour in the past - hence they
@@ -237,6 +289,8 @@ GlobalMediaReaderActor::GlobalMediaReaderActor(
 
                 playback_precache_request_queue_.clear_pending_requests(playhead_uuid);
                 background_precache_request_queue_.clear_pending_requests(playhead_uuid);
+                playback_precache_windows_.erase(std::make_pair(playhead_uuid, MT_IMAGE));
+                playback_precache_windows_.erase(std::make_pair(playhead_uuid, MT_AUDIO));
                 // this marks all cache entries for this playhead as 'stale' by
                 // moving their timestamps to 1 hour in the past - hence they
                 // will be dropped if the cache fills up
@@ -246,6 +300,38 @@ GlobalMediaReaderActor::GlobalMediaReaderActor(
             return true;
         },
 
+        [=](image_diff_atom atom,
+            const media::AVFrameID &frame_a,
+            const media::AVFrameID &frame_b,
+            const double tolerance) {
+            return mail(atom, frame_a, frame_b, tolerance).delegate(image_diff);
+        },
+
+        [=](image_diff_atom atom,
+            const caf::actor &media_a,
+            const caf::actor &media_b,
+            const double tolerance) {
+            return mail(atom, media_a, media_b, tolerance).delegate(image_diff);
+        },
+
+        [=](pixel_sample_atom atom, const media::AVFrameID &frame, const JsonStore &request) {
+            return mail(atom, frame, request).delegate(image_diff);
+        },
+
+        [=](pixel_sample_atom atom, const caf::actor &media, const JsonStore &request) {
+            return mail(atom, media, request).delegate(image_diff);
+        },
+
+        [=](audio_waveform_atom atom,
+            const caf::actor &media,
+            const double start_frame,
+            const double end_frame,
+            const int columns,
+            const int channel) {
+            return mail(atom, media, start_frame, end_frame, columns, channel)
+                .delegate(audio_waveform_);
+        },
+
         [=](retire_readers_atom, const media::AVFrameID &mptr) -> bool {
             return prune_reader(reader_key(mptr.uri(), mptr.media_source_addr()));
         },
@@ -435,13 +521,14 @@ GlobalMediaReaderActor::GlobalMediaReaderActor(
                                     .request(*reader, infinite)
                                     .then(
                                         [=](const media_reader::ImageBufPtr &buf) mutable {
-                                            mail(
-                                                push_image_atom_v,
+                                            push_image(
+                                                *reader,
+                                                playhead,
                                                 buf,
                                                 mptr,
+                                                playhead_uuid,
                                                 tp,
-                                                playhead_position)
-                                                .send(playhead);
+                                                playhead_position);
                                         },
                                         [=](caf::error &err) {});
                             } else {
@@ -485,13 +572,14 @@ GlobalMediaReaderActor::GlobalMediaReaderActor(
                                                     .then(
                                                         [=](const media_reader::ImageBufPtr
                                                                 &buf) mutable {
-                                                            mail(
-                                                                push_image_atom_v,
+                                                            push_image(
+                                                                new_reader,
+                                                                r->playhead,
                                                                 buf,
                                                                 r->mptr,
+                                                                r->playhead_uuid,
                                                                 r->tp,
-                                                                r->playhead_position)
-                                                                .send(r->playhead);
+                                                                r->playhead_position);
                                                         },
                                                         [=](caf::error &err) {});
                                             }
@@ -543,7 +631,16 @@ GlobalMediaReaderActor::GlobalMediaReaderActor(
             max_source_age_ =
                 preference_value<size_t>(json, "/core/media_reader/max_source_age");
             // mmm_->update_preferences(json);
+            try {
+                read_concurrency_.set_adaptive(preference_value<bool>(
+                    json, "/core/media_reader/adaptive_read_concurrency"));
+            } catch (const std::exception &e) {
+                spdlog::warn("{} {}", __PRETTY_FUNCTION__, e.what());
+            }
             prune_readers();
+            update_probe_cache_preferences(json);
+            update_frame_file_preferences(json);
+            anon_mail(json_store::update_atom_v, json).send(audio_waveform_);
         },
 
         [=](playback_precache_atom,
@@ -554,6 +651,79 @@ GlobalMediaReaderActor::GlobalMediaReaderActor(
             return true;
         },
 
+        [=](playback_precache_atom,
+            const media::AVFrameIDsAndTimePointsDelta &delta,
+            const Uuid &playhead_uuid,
+            const media::MediaType mt) -> result<bool> {
+            // lookahead update from a playhead during playback, as a change
+            // to the window of frames that it sent last time. Returning false
+            // tells the playhead that we are out of step and need the full
+            // window
+            auto &window = playback_precache_windows_[std::make_pair(playhead_uuid, mt)];
+            if (!window.apply_delta(delta))
+                return false;
+
+            // if the window is new or its timing has shifted by more than a
+            // frame or so then all of the pending requests need re-doing
+            if (delta.reset_ ||
+                std::chrono::abs(delta.time_offset_) > std::chrono::milliseconds(50)) {
+                auto rp = make_response_promise<bool>();
+                rp.delegate(
+                    actor_cast<caf::actor>(this),
+                    playback_precache_atom_v,
+                    window.frames(),
+                    playhead_uuid,
+                    mt);
+                return rp;
+            }
+
+            // otherwise the pending requests for frames still in the window
+            // are kept, less those for frames that have left it, and re-timed
+            // to match the window
+            playback_precache_request_queue_.retain_frame_requests(
+                window.frames(), playhead_uuid);
+            if (not window.frames().empty())
+                background_cached_ref_timepoint_[playhead_uuid] =
+                    window.frames().front().first;
+
+            // the cache only needs asking about frames that have entered the
+            // window - unless the retained frames have moved in time, when
+            // the cache must preserve them until their new time
+            const bool retimed = delta.time_offset_ != std::chrono::microseconds(0);
+            if (not retimed and delta.appended_.empty())
+                return true;
+
+            std::set<const media::AVFrameID *> appended;
+            for (const auto &p : delta.appended_)
+                appended.insert(p.second.get());
+
+            auto rp = make_response_promise<bool>();
+            mail(
+                media_cache::preserve_atom_v,
+                retimed ? window.frames() : delta.appended_,
+                playhead_uuid)
+                .request(mt == MT_IMAGE ? image_cache_ : audio_cache_, std::chrono::seconds(1))
+                .await(
+                    [=](const media::AVFrameIDsAndTimePoints &not_in_cache) mutable {
+                        // retained frames not in the cache are already queued
+                        // or being read (the periodic full window catches any
+                        // that were evicted)
+                        media::AVFrameIDsAndTimePoints requests;
+                        for (const auto &p : not_in_cache) {
+                            if (appended.count(p.second.get()))
+                                requests.push_back(p);
+                        }
+                        if (not requests.empty()) {
+                            playback_precache_request_queue_.add_frame_requests(
+                                requests, playhead_uuid);
+                            continue_precacheing();
+                        }
+                        rp.deliver(true);
+                    },
+                    [=](const caf::error &err) mutable { rp.deliver(err); });
+            return rp;
+        },
+
         [=](playback_precache_atom,
             const media::AVFrameIDsAndTimePoints media_ptrs,
             const Uuid &playhead_uuid,
@@ -652,6 +822,8 @@ GlobalMediaReaderActor::GlobalMediaReaderActor(
             return rp;
         },
 
+        [=](read_concurrency_atom) -> JsonStore { return read_concurrency_.stats(); },
+
         [=](retire_readers_atom) {
             prune_readers();
             anon_mail(retire_readers_atom_v)
@@ -735,6 +907,7 @@ bool GlobalMediaReaderActor::prune_reader(const std::string &key) {
         result = true;
         unlink_from(it->second);
         send_exit(it->second, caf::exit_reason::user_shutdown);
+        read_concurrency_.forget(it->first);
         reader_access_.erase(it->first);
         readers_.erase(it->first);
     }
@@ -754,6 +927,7 @@ void GlobalMediaReaderActor::prune_readers() {
                 auto a = readers_[it->first];
                 unlink_from(a);
                 send_exit(a, caf::exit_reason::user_shutdown);
+                read_concurrency_.forget(it->first);
                 readers_.erase(it->first);
                 spdlog::debug("{}", readers_.count(it->first));
                 reaped = true;
@@ -777,6 +951,7 @@ void GlobalMediaReaderActor::prune_readers() {
             auto a = readers_[rit->first];
             unlink_from(a);
             send_exit(a, caf::exit_reason::user_shutdown);
+            read_concurrency_.forget(rit->first);
             readers_.erase(rit->first);
             reader_access_.erase(rit);
         } else {
@@ -785,7 +960,58 @@ void GlobalMediaReaderActor::prune_readers() {
     }
 }
 
-void GlobalMediaReaderActor::on_exit() { system().registry().erase(media_reader_registry); }
+void GlobalMediaReaderActor::on_exit() {
+    probe_cache_->flush();
+    system().registry().erase(media_reader_registry);
+}
+
+void GlobalMediaReaderActor::update_probe_cache_preferences(const utility::JsonStore &prefs) {
+    try {
+        probe_cache_->set_enabled(
+            preference_value<bool>(prefs, "/core/media_reader/probe_cache/enabled"));
+        probe_cache_->set_max_count(
+            preference_value<size_t>(prefs, "/core/media_reader/probe_cache/max_count"));
+        probe_cache_->set_directory(expand_envvars(
+            preference_value<std::string>(prefs, "/core/media_reader/probe_cache/path")));
+    } catch (const std::exception &e) {
+        spdlog::warn("{} {}", __PRETTY_FUNCTION__, e.what());
+    }
+}
+
+void GlobalMediaReaderActor::update_frame_file_preferences(const utility::JsonStore &prefs) {
+    try {
+        auto &reader = FrameFileReader::instance();
+        reader.set_enabled(
+            preference_value<bool>(prefs, "/core/media_reader/frame_file_io/enabled"));
+        reader.set_budget(
+            preference_value<size_t>(prefs, "/core/media_reader/frame_file_io/budget_mb") *
+            1024 * 1024);
+        reader.set_direct_io(
+            preference_value<bool>(prefs, "/core/media_reader/frame_file_io/direct_io"));
+        reader.set_threads(
+            preference_value<size_t>(prefs, "/core/media_reader/frame_file_io/threads"));
+    } catch (const std::exception &e) {
+        spdlog::warn("{} {}", __PRETTY_FUNCTION__, e.what());
+    }
+}
+
+void GlobalMediaReaderActor::prefetch_frame_files(
+    const FrameRequest &fr, const FrameRequestQueue &queue) {
+    auto &file_reader = FrameFileReader::instance();
+
+    // the decode stage has this one, the IO stage runs on down the queue
+    const auto claimed = frame_file_path(file_reader, *fr.requested_frame_);
+    if (claimed.empty())
+        return;
+    file_reader.claim(claimed);
+
+    std::vector<std::string> paths;
+    for (const auto &frame : queue.upcoming(file_reader.lookahead())) {
+        if (auto path = frame_file_path(file_reader, *frame); not path.empty())
+            paths.emplace_back(std::move(path));
+    }
+    file_reader.prefetch(paths);
+}
 
 bool GlobalMediaReaderActor::do_precache() {
 
@@ -794,9 +1020,18 @@ bool GlobalMediaReaderActor::do_precache() {
     // we could send 100s of requests to precache frames (sending messages is
     // fast) before frames can actually be read, decoded and cached (because
     // reading frames is slow) - we would then be in a situation where the CAF
-    // mailbox is full of requests to precache frames
+    // mailbox is full of requests to precache frames.
+    // A playhead may have as many in flight as a source is ever allowed, and
+    // how many reads each source may have in flight is up to
+    // read_concurrency_, which learns what the storage and reader can take.
+    // The playhead is checked first, so its refusals don't count as the
+    // source wanting more slots.
+    auto admit = [this](const FrameRequest &fr, const int in_flight) {
+        return size_t(in_flight) < read_concurrency_.max_in_flight() and
+               admit_precache_request(fr);
+    };
     std::optional<FrameRequest> fr = playback_precache_request_queue_.pop_request(
-        playheads_with_precache_requests_in_flight_, max_num_inflight_requests_);
+        playheads_with_precache_requests_in_flight_, admit);
 
     // when putting new images in the cache, images older than this timepoint can
     // be discarded
@@ -804,7 +1039,7 @@ bool GlobalMediaReaderActor::do_precache() {
     if (not fr) {
 
         fr = background_precache_request_queue_.pop_request(
-            playheads_with_precache_requests_in_flight_, max_num_inflight_requests_);
+            playheads_with_precache_requests_in_flight_, admit);
 
         if (not fr) {
             return false; // global reader is saying pre-cache queue for this reader is empty
@@ -816,6 +1051,7 @@ bool GlobalMediaReaderActor::do_precache() {
 
     const time_point &predicted_time   = fr->required_by_;
     const utility::Uuid &playhead_uuid = fr->requesting_playhead_uuid_;
+    const auto source                  = reader_key(mptr->uri(), mptr->media_source_addr());
     time_point cache_out_of_date_threshold =
         utility::clock::now() - std::chrono::milliseconds(10);
 
@@ -835,7 +1071,7 @@ bool GlobalMediaReaderActor::do_precache() {
 
     caf::actor cache_actor =
         mptr->media_type() == media::MediaType::MT_IMAGE ? image_cache_ : audio_cache_;
-    mark_playhead_waiting_for_precache_result(playhead_uuid);
+    mark_playhead_waiting_for_precache_result(playhead_uuid, source);
 
     mail(media_cache::preserve_atom_v, mptr->key(), predicted_time, playhead_uuid)
         .request(cache_actor, std::chrono::milliseconds(500))
@@ -844,12 +1080,20 @@ bool GlobalMediaReaderActor::do_precache() {
             [=](const bool exists) mutable {
                 if (exists) {
                     // already have in the cache, but might still have work to do
-                    mark_playhead_received_precache_result(playhead_uuid);
+                    mark_playhead_received_precache_result(playhead_uuid, source);
+                    if (const auto path = frame_file_path(FrameFileReader::instance(), *mptr);
+                        not path.empty())
+                        FrameFileReader::instance().discard(path);
                     // if (is_background_cache) {
                     // keep_cache_hot(mptr.key(), predicted_time, playhead_uuid);
                     // }
                     continue_precacheing();
                 } else {
+                    // not cached, nor likely are the frames queued after it
+                    prefetch_frame_files(
+                        *fr,
+                        is_background_cache ? background_precache_request_queue_
+                                            : playback_precache_request_queue_);
                     try {
                         auto reader =
                             get_reader(mptr->uri(), mptr->media_source_addr(), mptr->reader());
@@ -859,9 +1103,7 @@ bool GlobalMediaReaderActor::do_precache() {
                                 .request(pool_, infinite)
                                 .then(
                                     [=](caf::actor new_reader) mutable {
-                                        auto key =
-                                            reader_key(mptr->uri(), mptr->media_source_addr());
-                                        new_reader = add_reader(new_reader, key);
+                                        new_reader = add_reader(new_reader, source);
                                         if (cache_actor == image_cache_) {
                                             read_and_cache_image(
                                                 new_reader,
@@ -877,7 +1119,8 @@ bool GlobalMediaReaderActor::do_precache() {
                                         }
                                     },
                                     [=](caf::error &err) {
-                                        mark_playhead_received_precache_result(playhead_uuid);
+                                        mark_playhead_received_precache_result(
+                                            playhead_uuid, source);
                                         continue_precacheing();
                                     });
                         } else {
@@ -908,17 +1151,32 @@ bool GlobalMediaReaderActor::do_precache() {
                         // shouldn't it continue... ?
                         // mark_playhead_received_precache_result(playhead_uuid);
                         // continue_precacheing();
+
+                        // the read isn't in flight though
+                        read_concurrency_.finished(source);
                     }
                 }
             },
             [=](const caf::error &err) {
-                mark_playhead_received_precache_result(playhead_uuid);
+                mark_playhead_received_precache_result(playhead_uuid, source);
                 spdlog::warn(
                     "Failed preserve buffer {} {}", to_string(mptr->key()), to_string(err));
             });
     return true;
 }
 
+bool GlobalMediaReaderActor::admit_precache_request(const FrameRequest &fr) {
+    // consecutive requests in the queue are mostly for the same source
+    const auto &mptr = fr.requested_frame_;
+    if (mptr->media_source_addr() != last_admitted_addr_ or
+        mptr->uri() != last_admitted_uri_) {
+        last_admitted_addr_   = mptr->media_source_addr();
+        last_admitted_uri_    = mptr->uri();
+        last_admitted_source_ = reader_key(last_admitted_uri_, last_admitted_addr_);
+    }
+    return read_concurrency_.admit(last_admitted_source_);
+}
+
 void GlobalMediaReaderActor::keep_cache_hot(
     const media::MediaKey &new_entry,
     const utility::time_point &tp,
@@ -939,10 +1197,16 @@ void GlobalMediaReaderActor::read_and_cache_image(
     const time_point predicted_time                    = fr.required_by_;
     const utility::Uuid playhead_uuid                  = fr.requesting_playhead_uuid_;
 
+    const auto source  = reader_key(mptr->uri(), mptr->media_source_addr());
+    const auto started = utility::clock::now();
+
     mail(read_precache_image_atom_v, *mptr)
         .request(reader, std::chrono::seconds(60))
         .then(
             [=](media_reader::ImageBufPtr buf) mutable {
+                read_concurrency_.sample(
+                    source, started, utility::clock::now(), predicted_time);
+
                 // store the image in our cache. We use a different store message
                 // if background cacheing
                 if (is_background_cache) {
@@ -956,7 +1220,7 @@ void GlobalMediaReaderActor::read_and_cache_image(
                         .request(image_cache_, std::chrono::milliseconds(500))
                         .then(
                             [=](const bool stored) {
-                                mark_playhead_received_precache_result(playhead_uuid);
+                                mark_playhead_received_precache_result(playhead_uuid, source);
 
                                 if (!stored) {
                                     // cache is full ... stop background cacheing
@@ -968,7 +1232,7 @@ void GlobalMediaReaderActor::read_and_cache_image(
                                 }
                             },
                             [=](const caf::error &err) mutable {
-                                mark_playhead_received_precache_result(playhead_uuid);
+                                mark_playhead_received_precache_result(playhead_uuid, source);
                                 spdlog::warn("Cache store error {}", to_string(err));
                             });
                 } else {
@@ -988,25 +1252,51 @@ void GlobalMediaReaderActor::read_and_cache_image(
                                     background_precache_request_queue_.clear_pending_requests(
                                         playhead_uuid);
                                 }
-                                mark_playhead_received_precache_result(playhead_uuid);
+                                mark_playhead_received_precache_result(playhead_uuid, source);
 
                                 // still might have work to do
                                 continue_precacheing();
                             },
                             [=](const caf::error &err) mutable {
-                                mark_playhead_received_precache_result(playhead_uuid);
+                                mark_playhead_received_precache_result(playhead_uuid, source);
                                 spdlog::warn("Cache store error {}", to_string(err));
                             });
                 }
             },
             [=](const caf::error &err) mutable {
-                mark_playhead_received_precache_result(playhead_uuid);
+                mark_playhead_received_precache_result(playhead_uuid, source);
                 send_error_to_source(mptr->media_source_addr(), err);
                 // we might still have more work to do so keep going
                 continue_precacheing();
             });
 }
 
+void GlobalMediaReaderActor::push_image(
+    caf::actor reader,
+    caf::actor playhead,
+    const media_reader::ImageBufPtr &buf,
+    const media::AVFrameID &mptr,
+    const utility::Uuid &playhead_uuid,
+    const utility::time_point &tp,
+    const timebase::flicks playhead_position) {
+
+    mail(push_image_atom_v, buf, mptr, tp, playhead_position).send(playhead);
+
+    if (!buf || !buf->is_draft())
+        return;
+
+    // this read gives the full image, and caches it
+    mail(get_image_atom_v, mptr, false, playhead_uuid, playhead_position)
+        .request(reader, infinite)
+        .then(
+            [=](const media_reader::ImageBufPtr &full) mutable {
+                mail(push_image_atom_v, full, mptr, tp, playhead_position).send(playhead);
+            },
+            [=](const caf::error &err) {
+                spdlog::warn("{} {}", __PRETTY_FUNCTION__, to_string(err));
+            });
+}
+
 void GlobalMediaReaderActor::read_and_cache_audio(
     caf::actor reader,
     const FrameRequest fr,
@@ -1017,10 +1307,16 @@ void GlobalMediaReaderActor::read_and_cache_audio(
     const time_point predicted_time                    = fr.required_by_;
     const utility::Uuid playhead_uuid                  = fr.requesting_playhead_uuid_;
 
+    const auto source  = reader_key(mptr->uri(), mptr->media_source_addr());
+    const auto started = utility::clock::now();
+
     mail(read_precache_audio_atom_v, *mptr)
         .request(reader, std::chrono::seconds(60))
         .then(
             [=](media_reader::AudioBufPtr buf) mutable {
+                read_concurrency_.sample(
+                    source, started, utility::clock::now(), predicted_time);
+
                 // store the image in our cache
                 mail(
                     media_cache::store_atom_v,
@@ -1032,7 +1328,7 @@ void GlobalMediaReaderActor::read_and_cache_audio(
                     .request(audio_cache_, std::chrono::milliseconds(500))
                     .then(
                         [=](const bool stored) {
-                            mark_playhead_received_precache_result(playhead_uuid);
+                            mark_playhead_received_precache_result(playhead_uuid, source);
 
                             if (!stored && is_background_cache) {
                                 // cache is full ... stop background cacheing
@@ -1047,12 +1343,12 @@ void GlobalMediaReaderActor::read_and_cache_audio(
                             }
                         },
                         [=](const caf::error &err) mutable {
-                            mark_playhead_received_precache_result(playhead_uuid);
+                            mark_playhead_received_precache_result(playhead_uuid, source);
                             spdlog::warn("Audio cache store error {}", to_string(err));
                         });
             },
             [=](const caf::error &err) mutable {
-                mark_playhead_received_precache_result(playhead_uuid);
+                mark_playhead_received_precache_result(playhead_uuid, source);
                 send_error_to_source(mptr->media_source_addr(), err);
                 // we might still have more work to do so keep going
                 continue_precacheing();
@@ -1072,7 +1368,9 @@ void GlobalMediaReaderActor::continue_precacheing() {
 }
 
 void GlobalMediaReaderActor::mark_playhead_waiting_for_precache_result(
-    const utility::Uuid &playhead_uuid) {
+    const utility::Uuid &playhead_uuid, const std::string &source) {
+
+    read_concurrency_.started(source);
 
     auto p = playheads_with_precache_requests_in_flight_.find(playhead_uuid);
     if (p == playheads_with_precache_requests_in_flight_.end()) {
@@ -1083,7 +1381,9 @@ void GlobalMediaReaderActor::mark_playhead_waiting_for_precache_result(
 }
 
 void GlobalMediaReaderActor::mark_playhead_received_precache_result(
-    const utility::Uuid &playhead_uuid) {
+    const utility::Uuid &playhead_uuid, const std::string &source) {
+
+    read_concurrency_.finished(source);
     auto p = playheads_with_precache_requests_in_flight_.find(playhead_uuid);
     if (p != playheads_with_precache_requests_in_flight_.end()) {
         if (p->second <= 1) {
@@ -0,0 +1,260 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <algorithm>
+#include <future>
+#include <limits>
+#include <numeric>
+#include <thread>
+
+#include "xstudio/media_reader/pixel_sampler.hpp"
+
+using namespace xstudio;
+using namespace xstudio::media_reader;
+
+namespace {
+
+// a thread isn't worth starting for fewer pixels than this
+constexpr size_t min_pixels_per_thread = 1 << 16;
+
+// Points on a row are decoded in one span if it's no more than this many
+// times the number of points (plus a little), otherwise one at a time.
+constexpr int max_span_per_point = 8;
+
+nlohmann::json box_to_json(const Imath::Box2i &box) {
+    return nlohmann::json{box.min.x, box.min.y, box.max.x, box.max.y};
+}
+
+// the part of a region inside the data window, which may be empty
+Imath::Box2i clip_to(const Imath::Box2i &region, const Imath::Box2i &window) {
+    return Imath::Box2i(
+        Imath::V2i(std::max(region.min.x, window.min.x), std::max(region.min.y, window.min.y)),
+        Imath::V2i(std::min(region.max.x, window.max.x), std::min(region.max.y, window.max.y)));
+}
+
+// Totals over some rows of a region, kept in float per row and added to
+// double so that long rows don't lose precision.
+struct RegionTotals {
+    RegionTotals() {
+        min_.fill(std::numeric_limits<float>::max());
+        max_.fill(std::numeric_limits<float>::lowest());
+    }
+
+    void add(const RegionTotals &o) {
+        for (size_t c = 0; c < 4; ++c) {
+            sum_[c] += o.sum_[c];
+            min_[c] = std::min(min_[c], o.min_[c]);
+            max_[c] = std::max(max_[c], o.max_[c]);
+        }
+        count_ += o.count_;
+    }
+
+    std::array<double, 4> sum_{0.0, 0.0, 0.0, 0.0};
+    std::array<float, 4> min_;
+    std::array<float, 4> max_;
+    size_t count_{0};
+};
+
+void measure_region_rows(
+    const ImageBuffer &image,
+    const utility::JsonStore &uniforms,
+    const Imath::Box2i &region,
+    const int first_row,
+    const int end_row,
+    RegionTotals &totals) {
+
+    const int width = region.max.x - region.min.x;
+    std::vector<float> row(size_t(width) * 4);
+
+    for (int y = first_row; y < end_row; ++y) {
+        image.unpack_pixels(region.min.x, y, width, uniforms, row.data());
+
+        // channel-interleaved, the compiler vectorises these four wide
+        std::array<float, 4> sum{0.0f, 0.0f, 0.0f, 0.0f};
+        std::array<float, 4> mn = totals.min_;
+        std::array<float, 4> mx = totals.max_;
+        for (int i = 0; i < width; ++i) {
+            const float *p = row.data() + size_t(i) * 4;
+            for (int c = 0; c < 4; ++c) {
+                sum[c] += p[c];
+                mn[c] = std::min(mn[c], p[c]);
+                mx[c] = std::max(mx[c], p[c]);
+            }
+        }
+        for (size_t c = 0; c < 4; ++c)
+            totals.sum_[c] += sum[c];
+        totals.min_ = mn;
+        totals.max_ = mx;
+        totals.count_ += width;
+    }
+}
+
+PixelRegionStats measure_region(
+    const ImageBuffer &image, const utility::JsonStore &uniforms, const Imath::Box2i &region) {
+
+    PixelRegionStats result;
+    result.region_ = region;
+
+    const int width  = region.max.x - region.min.x;
+    const int height = region.max.y - region.min.y;
+    if (width <= 0 or height <= 0)
+        return result;
+
+    const size_t pixels = size_t(width) * height;
+    const size_t threads =
+        std::clamp<size_t>(
+            std::min<size_t>(
+                std::thread::hardware_concurrency(), pixels / min_pixels_per_thread),
+            1,
+            height);
+    const int rows_per_thread = static_cast<int>((height + threads - 1) / threads);
+    const auto first_row      = [&](const size_t t) {
+        return region.min.y + std::min(static_cast<int>(t) * rows_per_thread, height);
+    };
+
+    std::vector<RegionTotals> totals(threads);
+    std::vector<std::future<void>> workers;
+    for (size_t t = 1; t < threads; ++t) {
+        workers.emplace_back(std::async(std::launch::async, [&, t]() {
+            measure_region_rows(
+                image, uniforms, region, first_row(t), first_row(t + 1), totals[t]);
+        }));
+    }
+    measure_region_rows(image, uniforms, region, first_row(0), first_row(1), totals[0]);
+    for (size_t t = 1; t < threads; ++t) {
+        workers[t - 1].get();
+        totals[0].add(totals[t]);
+    }
+
+    result.pixel_count_ = totals[0].count_;
+    for (size_t c = 0; c < 4; ++c) {
+        result.mean_[c] = totals[0].sum_[c] / double(result.pixel_count_);
+        result.min_[c]  = totals[0].min_[c];
+        result.max_[c]  = totals[0].max_[c];
+    }
+    return result;
+}
+
+void sample_points(
+    const ImageBuffer &image,
+    const utility::JsonStore &uniforms,
+    const std::vector<Imath::V2i> &points,
+    std::vector<std::array<float, 4>> &result) {
+
+    result.resize(points.size());
+
+    // visit the points row by row, left to right
+    std::vector<size_t> order(points.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](const size_t a, const size_t b) {
+        return points[a].y < points[b].y or
+               (points[a].y == points[b].y and points[a].x < points[b].x);
+    });
+
+    std::vector<float> span;
+    size_t i = 0;
+    while (i < order.size()) {
+        const int y = points[order[i]].y;
+        size_t end  = i;
+        while (end < order.size() and points[order[end]].y == y)
+            end++;
+
+        const int x0         = points[order[i]].x;
+        const int x1         = points[order[end - 1]].x + 1;
+        const auto row_count = static_cast<int>(end - i);
+
+        if (x1 - x0 <= row_count * max_span_per_point + 64) {
+            span.resize(size_t(x1 - x0) * 4);
+            image.unpack_pixels(x0, y, x1 - x0, uniforms, span.data());
+            for (size_t j = i; j < end; ++j) {
+                const float *p = span.data() + size_t(points[order[j]].x - x0) * 4;
+                std::copy(p, p + 4, result[order[j]].begin());
+            }
+        } else {
+            for (size_t j = i; j < end; ++j)
+                image.unpack_pixels(
+                    points[order[j]].x, y, 1, uniforms, result[order[j]].data());
+        }
+        i = end;
+    }
+}
+
+} // namespace
+
+PixelSampleRequest::PixelSampleRequest(const utility::JsonStore &js) {
+    if (js.count("points")) {
+        for (const auto &p : js.at("points"))
+            points_.emplace_back(p.at(0).get<int>(), p.at(1).get<int>());
+    }
+    if (js.count("regions")) {
+        for (const auto &r : js.at("regions"))
+            regions_.emplace_back(
+                Imath::V2i(r.at(0).get<int>(), r.at(1).get<int>()),
+                Imath::V2i(r.at(2).get<int>(), r.at(3).get<int>()));
+    }
+    data_window_ = js.value("data_window", false);
+}
+
+utility::JsonStore PixelSampleRequest::to_json() const {
+    utility::JsonStore result;
+    result["points"]  = nlohmann::json::array();
+    result["regions"] = nlohmann::json::array();
+    for (const auto &p : points_)
+        result["points"].push_back({p.x, p.y});
+    for (const auto &r : regions_)
+        result["regions"].push_back(box_to_json(r));
+    result["data_window"] = data_window_;
+    return result;
+}
+
+utility::JsonStore PixelRegionStats::to_json() const {
+    utility::JsonStore result;
+    result["region"]      = box_to_json(region_);
+    result["pixel_count"] = pixel_count_;
+    result["mean"]        = mean_;
+    result["min"]         = min_;
+    result["max"]         = max_;
+    return result;
+}
+
+utility::JsonStore PixelSamples::to_json() const {
+    utility::JsonStore result;
+    result["points"]  = points_;
+    result["regions"] = nlohmann::json::array();
+    for (const auto &r : regions_)
+        result["regions"].push_back(r.to_json());
+    if (data_window_.pixel_count_)
+        result["data_window"] = data_window_.to_json();
+    result["error"] = error_;
+    return result;
+}
+
+PixelSamples xstudio::media_reader::sample_pixels(
+    const ImageBufPtr &image, const PixelSampleRequest &request) {
+    PixelSamples result;
+
+    if (not image) {
+        result.error_ = "No image";
+        return result;
+    }
+    if (image->error_state() == HAS_ERROR) {
+        result.error_ = image->error_message();
+        return result;
+    }
+    if (not image->can_unpack_pixels()) {
+        result.error_ = "Image can't be decoded for sampling";
+        return result;
+    }
+
+    const auto &uniforms = image->shader_params();
+
+    sample_points(*image, uniforms, request.points_, result.points_);
+
+    // pixels outside the data window aren't in the buffer, they'd count as zero
+    const auto window = image->image_pixels_bounding_box();
+    for (const auto &region : request.regions_)
+        result.regions_.push_back(measure_region(*image, uniforms, clip_to(region, window)));
+
+    if (request.data_window_)
+        result.data_window_ = measure_region(*image, uniforms, window);
+
+    return result;
+}
@@ -0,0 +1,232 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <algorithm>
+
+#include "xstudio/media_reader/read_concurrency.hpp"
+
+using namespace xstudio::media_reader;
+using namespace xstudio::utility;
+
+namespace {
+// a window is this many reads per slot, and no fewer than min_window_reads,
+// else it says little about throughput
+constexpr size_t window_reads_per_slot = 3;
+constexpr size_t min_window_reads      = 8;
+// an extra slot has to give this much more throughput to be kept
+constexpr double min_gain = 1.05;
+// windows to hold below a limit that didn't help before trying it again,
+// doubling each time it still doesn't
+constexpr size_t min_hold_windows = 16;
+constexpr size_t max_hold_windows = 512;
+// needed no sooner than this many read times away, there's no hurry
+constexpr double ahead_latencies = 4.0;
+constexpr size_t max_decisions = 32;
+
+double milliseconds(const clock::duration &d) {
+    return std::chrono::duration<double, std::milli>(d).count();
+}
+} // namespace
+
+ReadConcurrency::ReadConcurrency(const size_t max_in_flight, const bool adaptive)
+    : max_in_flight_(std::max<size_t>(1, max_in_flight)), adaptive_(adaptive) {}
+
+void ReadConcurrency::set_max_in_flight(const size_t max_in_flight) {
+    max_in_flight_ = std::max<size_t>(1, max_in_flight);
+    for (auto &i : sources_)
+        i.second.limit_ =
+            adaptive_ ? std::min(i.second.limit_, max_in_flight_) : max_in_flight_;
+}
+
+void ReadConcurrency::set_adaptive(const bool adaptive) {
+    if (adaptive == adaptive_)
+        return;
+    adaptive_ = adaptive;
+    // start again from what we measure
+    sources_.clear();
+}
+
+ReadConcurrency::Source &ReadConcurrency::source(const std::string &name) {
+    auto it = sources_.find(name);
+    if (it == sources_.end()) {
+        it                = sources_.emplace(name, Source()).first;
+        it->second.limit_ = adaptive_ ? 1 : max_in_flight_;
+        it->second.hold_  = min_hold_windows;
+    }
+    return it->second;
+}
+
+bool ReadConcurrency::admit(const std::string &name) {
+    auto &s = source(name);
+    if (s.in_flight_ < s.limit_)
+        return true;
+    s.refused_ = true;
+    return false;
+}
+
+void ReadConcurrency::started(const std::string &name) { source(name).in_flight_++; }
+
+void ReadConcurrency::finished(const std::string &name) {
+    auto it = sources_.find(name);
+    if (it != sources_.end() and it->second.in_flight_)
+        it->second.in_flight_--;
+}
+
+void ReadConcurrency::sample(
+    const std::string &name,
+    const time_point &started,
+    const time_point &finished,
+    const time_point &required_by) {
+    auto &s = source(name);
+
+    // a window starts with its first read if the source was idle before it
+    if (not s.reads_ and started > s.window_start_)
+        s.window_start_ = started;
+
+    const auto slack = milliseconds(required_by - finished);
+    s.reads_++;
+    s.total_reads_++;
+    s.latency_sum_ += milliseconds(finished - started);
+    s.min_slack_ = std::min(s.min_slack_, slack);
+    if (slack < 0.0) {
+        s.late_++;
+        s.total_late_++;
+    }
+    s.last_finish_ = std::max(s.last_finish_, finished);
+
+    if (s.reads_ >= std::max(min_window_reads, s.limit_ * window_reads_per_slot))
+        end_window(name, s);
+}
+
+void ReadConcurrency::end_window(const std::string &name, Source &s) {
+    const auto seconds =
+        std::chrono::duration<double>(s.last_finish_ - s.window_start_).count();
+    const auto throughput = seconds > 0.0 ? double(s.reads_) / seconds : 0.0;
+    const auto late       = s.late_;
+    const auto refused    = s.refused_;
+    s.latency_            = s.latency_sum_ / double(s.reads_);
+    const auto ahead      = not late and s.min_slack_ > ahead_latencies * s.latency_;
+
+    s.windows_++;
+    s.window_start_ = s.last_finish_;
+    s.reads_        = 0;
+    s.late_         = 0;
+    s.refused_      = false;
+    s.latency_sum_  = 0.0;
+    s.min_slack_    = std::numeric_limits<double>::max();
+
+    // reads started under the old limit finish in the window after a change
+    if (throughput <= 0.0 or s.windows_ <= s.changed_at_ + 1)
+        return;
+
+    auto &smoothed = s.throughput_[s.limit_];
+    smoothed       = smoothed > 0.0 ? (smoothed + throughput) / 2.0 : throughput;
+
+    if (not adaptive_)
+        return;
+
+    // an increase is judged once the extra slots were all in use
+    if (s.probing_ and refused) {
+        s.probing_        = false;
+        const auto before = s.throughput_.find(s.previous_);
+        if (before != s.throughput_.end() and throughput < before->second * min_gain) {
+            s.slow_start_ = false;
+            s.ceiling_    = s.limit_ - 1;
+            if (s.ceiling_ == s.previous_) {
+                s.probe_after_ = s.windows_ + s.hold_;
+                s.hold_        = std::min(s.hold_ * 2, max_hold_windows);
+            }
+            change(name, s, s.previous_, "no gain", throughput);
+            return;
+        }
+        s.hold_ = min_hold_windows;
+    }
+
+    // the storage or the sources around it may have changed
+    if (s.probe_after_ and s.windows_ >= s.probe_after_) {
+        s.ceiling_     = 0;
+        s.probe_after_ = 0;
+    }
+
+    // no more work than slots, or nowhere near the playhead
+    if (not refused or ahead)
+        return;
+
+    const auto top = s.ceiling_ ? std::min(s.ceiling_, max_in_flight_) : max_in_flight_;
+    if (s.limit_ < top) {
+        s.previous_ = s.limit_;
+        s.probing_  = true;
+        change(
+            name,
+            s,
+            s.slow_start_ ? std::min(top, s.limit_ * 2) : s.limit_ + 1,
+            late ? "late" : "close to deadline",
+            throughput);
+    }
+}
+
+void ReadConcurrency::change(
+    const std::string &name,
+    Source &s,
+    const size_t limit,
+    const std::string &reason,
+    const double throughput) {
+    spdlog::debug(
+        "Read concurrency {} {} -> {}, {} at {:.1f} fps {:.1f} ms",
+        name,
+        s.limit_,
+        limit,
+        reason,
+        throughput,
+        s.latency_);
+
+    decisions_.push_back(Decision{name, s.limit_, limit, reason, throughput, s.latency_});
+    if (decisions_.size() > max_decisions)
+        decisions_.pop_front();
+
+    s.limit_      = limit;
+    s.changed_at_ = s.windows_;
+}
+
+void ReadConcurrency::forget(const std::string &name) { sources_.erase(name); }
+
+size_t ReadConcurrency::limit(const std::string &name) const {
+    auto it = sources_.find(name);
+    if (it == sources_.end())
+        return adaptive_ ? 1 : max_in_flight_;
+    return it->second.limit_;
+}
+
+size_t ReadConcurrency::in_flight(const std::string &name) const {
+    auto it = sources_.find(name);
+    return it == sources_.end() ? 0 : it->second.in_flight_;
+}
+
+JsonStore ReadConcurrency::stats() const {
+    JsonStore result;
+    result["adaptive"]      = adaptive_;
+    result["max_in_flight"] = max_in_flight_;
+    result["sources"]       = nlohmann::json::object();
+    result["decisions"]     = nlohmann::json::array();
+
+    for (const auto &[name, s] : sources_) {
+        const auto throughput = s.throughput_.find(s.limit_);
+        result["sources"][name] = {
+            {"limit", s.limit_},
+            {"in_flight", s.in_flight_},
+            {"ceiling", s.ceiling_},
+            {"latency_ms", s.latency_},
+            {"throughput_fps", throughput == s.throughput_.end() ? 0.0 : throughput->second},
+            {"reads", s.total_reads_},
+            {"late", s.total_late_}};
+    }
+
+    for (const auto &i : decisions_)
+        result["decisions"].push_back(
+            {{"source", i.source_},
+             {"from", i.from_},
+             {"to", i.to_},
+             {"reason", i.reason_},
+             {"throughput_fps", i.throughput_},
+             {"latency_ms", i.latency_}});
+
+    return result;
+}
@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+#include "xstudio/media_reader/audio_buffer.hpp"
+#include "xstudio/media_reader/audio_waveform.hpp"
+#include "xstudio/utility/caf_helpers.hpp"
+
+using namespace xstudio;
+using namespace xstudio::media_reader;
+
+ACTOR_TEST_MINIMAL()
+
+namespace {
+
+// 10 frames of 1000 stereo samples, left is a square wave of amplitude
+// 0.5, right is silent apart from frame 7 which is full scale
+AudioWaveformSummary make_summary(const int samples_per_peak = 100) {
+    AudioWaveformSummary result(48000, 2, samples_per_peak);
+    std::vector<float> frame(2000);
+    for (int f = 0; f < 10; ++f) {
+        for (int i = 0; i < 1000; ++i) {
+            frame[i * 2]     = i % 2 ? 0.5f : -0.5f;
+            frame[i * 2 + 1] = f == 7 ? 1.0f : 0.0f;
+        }
+        result.start_frame();
+        // in two uneven parts, peaks span the calls
+        result.add_samples(frame.data(), 333);
+        result.add_samples(frame.data() + 666, 667);
+    }
+    result.finish();
+    return result;
+}
+
+} // namespace
+
+TEST(AudioWaveformSummary, Test) {
+    const auto summary = make_summary();
+
+    EXPECT_EQ(summary.num_samples(), uint64_t(10000));
+    EXPECT_EQ(summary.num_frames(), size_t(10));
+    // 100 peaks, halving down to 1
+    EXPECT_EQ(summary.num_levels(), size_t(8));
+
+    EXPECT_EQ(summary.frame_to_sample(0), uint64_t(0));
+    EXPECT_EQ(summary.frame_to_sample(7), uint64_t(7000));
+    EXPECT_EQ(summary.frame_to_sample(7.5), uint64_t(7500));
+    EXPECT_EQ(summary.frame_to_sample(12), uint64_t(12000));
+
+    // whole source in 10 columns, one per frame
+    auto peaks = summary.peaks(0, 0, 10000, 10);
+    ASSERT_EQ(peaks.size(), size_t(10));
+    for (const auto &p : peaks) {
+        EXPECT_EQ(p.min_, -16384);
+        EXPECT_EQ(p.max_, 16384);
+        EXPECT_NEAR(p.rms_ / 65535.0, 0.5, 1e-3);
+    }
+
+    peaks = summary.peaks(1, 0, 10000, 10);
+    EXPECT_EQ(peaks[6].max_, 0);
+    EXPECT_EQ(peaks[7].max_, 32767);
+    EXPECT_NEAR(peaks[7].rms_ / 65535.0, 1.0, 1e-3);
+    EXPECT_EQ(peaks[8].max_, 0);
+
+    // frame 7 alone, at finer resolution
+    peaks = summary.peaks(1, summary.frame_to_sample(7), summary.frame_to_sample(8), 5);
+    for (const auto &p : peaks)
+        EXPECT_EQ(p.max_, 32767);
+
+    // mixed channels
+    peaks = summary.peaks(-1, 0, 10000, 1);
+    EXPECT_EQ(peaks[0].min_, -16384);
+    EXPECT_EQ(peaks[0].max_, 32767);
+
+    // past the end, and bad requests
+    peaks = summary.peaks(0, 20000, 30000, 4);
+    EXPECT_EQ(peaks[3].max_, 0);
+    EXPECT_TRUE(summary.peaks(0, 0, 10000, 0).empty());
+    EXPECT_EQ(summary.peaks(2, 0, 10000, 3)[0].max_, 0);
+}
+
+TEST(AudioWaveformSummary, AudioBuffer) {
+    AudioBuffer buffer;
+    buffer.allocate(48000, 1, 512, audio::SampleFormat::INT16);
+    auto *samples = reinterpret_cast<int16_t *>(buffer.buffer());
+    for (int i = 0; i < 512; ++i)
+        samples[i] = i == 100 ? -32768 : 8192;
+
+    AudioWaveformSummary summary(48000, 1, 256);
+    summary.start_frame();
+    summary.add_samples(buffer);
+    summary.finish();
+
+    const auto peaks = summary.peaks(0, 0, 512, 2);
+    EXPECT_EQ(peaks[0].min_, -32767);
+    EXPECT_EQ(peaks[0].max_, 8192);
+    EXPECT_EQ(peaks[1].min_, 8192);
+
+    // wrong channel count, ignored
+    AudioWaveformSummary stereo(48000, 2, 256);
+    stereo.add_samples(buffer);
+    EXPECT_EQ(stereo.num_samples(), uint64_t(0));
+}
+
+TEST(AudioWaveformSummary, SaveLoad) {
+    const auto path =
+        (std::filesystem::temp_directory_path() / "xstudio_audio_waveform_test.xswf").string();
+
+    const auto summary = make_summary();
+    ASSERT_TRUE(summary.save(path, "source key"));
+
+    EXPECT_FALSE(AudioWaveformSummary::load(path, "other key"));
+    EXPECT_FALSE(AudioWaveformSummary::load(path + ".missing", "source key"));
+
+    const auto loaded = AudioWaveformSummary::load(path, "source key");
+    ASSERT_TRUE(loaded);
+    EXPECT_EQ(loaded->num_samples(), summary.num_samples());
+    EXPECT_EQ(loaded->num_frames(), summary.num_frames());
+    EXPECT_EQ(loaded->num_levels(), summary.num_levels());
+    EXPECT_EQ(loaded->frame_to_sample(7), uint64_t(7000));
+    EXPECT_EQ(loaded->peaks(1, 0, 10000, 10)[7].max_, 32767);
+    EXPECT_EQ(loaded->size_bytes(), summary.size_bytes());
+
+    // counts that don't match the file's size aren't trusted
+    const auto size = std::filesystem::file_size(path);
+    std::filesystem::resize_file(path, size - 1);
+    EXPECT_FALSE(AudioWaveformSummary::load(path, "source key"));
+    std::filesystem::resize_file(path, size + 6);
+    EXPECT_FALSE(AudioWaveformSummary::load(path, "source key"));
+
+    ASSERT_TRUE(summary.save(path, "source key"));
+    {
+        // a huge frame count
+        std::fstream f(path, std::ios::binary | std::ios::in | std::ios::out);
+        f.seekp(4 + 4 + 4 + 10 + 8 + 4 + 4 + 8);
+        const uint64_t frames = uint64_t(1) << 39;
+        f.write(reinterpret_cast<const char *>(&frames), sizeof(frames));
+    }
+    EXPECT_FALSE(AudioWaveformSummary::load(path, "source key"));
+
+    std::remove(path.c_str());
+}
@@ -0,0 +1,257 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <thread>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "xstudio/media_reader/frame_file_reader.hpp"
+#include "xstudio/utility/caf_helpers.hpp"
+
+using namespace xstudio;
+using namespace xstudio::utility;
+using namespace xstudio::media_reader;
+
+namespace fs = std::filesystem;
+
+ACTOR_TEST_MINIMAL()
+
+#ifndef _WIN32
+
+namespace {
+
+// A sequence of count files of size bytes, each filled with its index.
+class Sequence {
+  public:
+    Sequence(const std::string &name, const size_t count, const size_t size) {
+        directory_ = fs::temp_directory_path() / (name + "_" + std::to_string(::getpid()));
+        fs::create_directories(directory_);
+        std::vector<char> data(size);
+        for (size_t i = 0; i < count; i++) {
+            std::memset(data.data(), int('a' + i % 26), size);
+            paths_.push_back((directory_ / (std::to_string(i) + ".exr")).string());
+            std::ofstream(paths_.back(), std::ios::binary).write(data.data(), size);
+        }
+    }
+    ~Sequence() { fs::remove_all(directory_); }
+
+    // out of the page cache, as frames not read before would be
+    void drop_cache() const {
+        for (const auto &i : paths_) {
+            auto fd = ::open(i.c_str(), O_RDONLY);
+            fdatasync(fd);
+#ifdef POSIX_FADV_DONTNEED
+            posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+#endif
+            ::close(fd);
+        }
+    }
+
+    fs::path directory_;
+    std::vector<std::string> paths_;
+};
+
+bool filled_with(const FileBytesPtr &bytes, const size_t size, const char c) {
+    if (not bytes or bytes->size() != size)
+        return false;
+    for (size_t i = 0; i < size; i++)
+        if (bytes->data()[i] != c)
+            return false;
+    return true;
+}
+
+// until condition holds of the reader's stats, false if it takes too long
+bool wait_for(
+    const FrameFileReader &reader, const std::function<bool(const JsonStore &)> &condition) {
+    const auto until = clock::now() + std::chrono::seconds(10);
+    while (not condition(reader.stats())) {
+        if (clock::now() > until)
+            return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+// take doesn't wait for a read under way, so wait for it here
+FileBytesPtr take_when_read(FrameFileReader &reader, const std::string &path) {
+    const auto until = clock::now() + std::chrono::seconds(10);
+    while (reader.reading(path) and clock::now() < until)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    return reader.take(path);
+}
+
+} // namespace
+
+TEST(FrameFileReaderTest, Test) {
+    // sizes that aren't whole blocks, as most frames aren't
+    Sequence seq("frame_file_reader_test", 8, 100000 + 17);
+    FrameFileReader reader;
+
+    bool direct = false;
+    EXPECT_TRUE(filled_with(reader.read(seq.paths_[0], &direct), 100017, 'a'));
+    EXPECT_FALSE(reader.read((seq.directory_ / "missing.exr").string()));
+    EXPECT_FALSE(reader.read(seq.directory_.string()));
+
+    // the same again without direct IO
+    reader.set_direct_io(false);
+    EXPECT_TRUE(filled_with(reader.read(seq.paths_[1], &direct), 100017, 'b'));
+    EXPECT_FALSE(direct);
+    reader.set_direct_io(true);
+
+    // only what was prefetched is handed over, and once
+    EXPECT_FALSE(reader.take(seq.paths_[0]));
+    reader.prefetch(seq.paths_);
+    for (size_t i = 0; i < seq.paths_.size(); i++)
+        EXPECT_TRUE(filled_with(take_when_read(reader, seq.paths_[i]), 100017, char('a' + i)));
+    EXPECT_FALSE(reader.take(seq.paths_[0]));
+
+    // a file that can't be read is for the caller to fail on
+    const auto missing = (seq.directory_ / "missing.exr").string();
+    reader.prefetch({missing});
+    EXPECT_FALSE(take_when_read(reader, missing));
+
+    auto stats = reader.stats();
+    EXPECT_EQ(stats.at("reads").get<size_t>(), size_t(8));
+    EXPECT_EQ(stats.at("taken").get<size_t>(), size_t(8));
+    EXPECT_EQ(stats.at("held").get<size_t>(), size_t(0));
+    EXPECT_EQ(stats.at("missed").get<size_t>(), size_t(0));
+
+    // not enabled, nothing is prefetched
+    reader.set_enabled(false);
+    reader.prefetch(seq.paths_);
+    EXPECT_FALSE(reader.take(seq.paths_[0]));
+    reader.set_enabled(true);
+}
+
+TEST(FrameFileReaderTest, Budget) {
+    Sequence seq("frame_file_reader_budget_test", 8, 1024 * 1024);
+    FrameFileReader reader;
+
+    // room for about two files, reading stops there until they're taken
+    reader.set_budget(2 * 1024 * 1024);
+    reader.prefetch(seq.paths_);
+    EXPECT_TRUE(filled_with(take_when_read(reader, seq.paths_[0]), 1024 * 1024, 'a'));
+    EXPECT_TRUE(wait_for(reader, [](const JsonStore &stats) {
+        return stats.at("held").get<size_t>() >= size_t(2 * 1024 * 1024);
+    }));
+
+    auto stats = reader.stats();
+    EXPECT_LE(stats.at("held").get<size_t>(), size_t(2 * 1024 * 1024) + 4 * 1024 * 1024);
+    EXPECT_GT(stats.at("queued").get<size_t>(), size_t(0));
+
+    // and carries on as they are
+    for (size_t i = 1; i < seq.paths_.size(); i++)
+        EXPECT_TRUE(
+            filled_with(take_when_read(reader, seq.paths_[i]), 1024 * 1024, char('a' + i)));
+
+    // a new list replaces what was waiting
+    reader.clear();
+    reader.set_budget(0);
+    reader.prefetch({seq.paths_[0], seq.paths_[1]});
+    reader.prefetch({seq.paths_[2]});
+    EXPECT_EQ(reader.stats().at("queued").get<size_t>(), size_t(1));
+    EXPECT_FALSE(reader.take(seq.paths_[0]));
+}
+
+TEST(FrameFileReaderTest, OverBudget) {
+    const size_t size = 1024 * 1024;
+    Sequence seq("frame_file_reader_over_budget_test", 4, size);
+    FrameFileReader reader;
+    reader.set_budget(size / 2);
+
+    // files bigger than the budget are left for their reader to stream, with
+    // and without direct IO
+    EXPECT_FALSE(reader.read(seq.paths_[0]));
+    for (const auto direct : {true, false}) {
+        reader.clear();
+        reader.set_direct_io(direct);
+        const auto failed = reader.stats().at("failed").get<size_t>();
+        reader.prefetch(seq.paths_);
+        EXPECT_TRUE(wait_for(reader, [&](const JsonStore &stats) {
+            return stats.at("failed").get<size_t>() == failed + seq.paths_.size();
+        }));
+        for (const auto &i : seq.paths_)
+            EXPECT_FALSE(reader.take(i));
+        EXPECT_EQ(reader.stats().at("held").get<size_t>(), size_t(0));
+        EXPECT_EQ(reader.stats().at("reads").get<size_t>(), size_t(0));
+    }
+}
+
+TEST(FrameFileReaderTest, Pipeline) {
+    const size_t size = 1024 * 1024;
+    Sequence seq("frame_file_reader_pipeline_test", 8, size);
+    FrameFileReader reader;
+    reader.set_budget(2 * size);
+    reader.set_threads(1);
+
+    // read ahead until the budget is used up
+    reader.prefetch(seq.paths_);
+    EXPECT_TRUE(wait_for(reader, [&](const JsonStore &stats) {
+        return stats.at("held").get<size_t>() >= 2 * size;
+    }));
+    EXPECT_EQ(reader.lookahead(), size_t(8));
+
+    // the frame being decoded is read next, in place of the furthest held
+    reader.claim(seq.paths_[7]);
+    EXPECT_TRUE(wait_for(reader, [](const JsonStore &stats) {
+        return stats.at("dropped").get<size_t>() > 0;
+    }));
+    EXPECT_TRUE(filled_with(take_when_read(reader, seq.paths_[7]), size, 'h'));
+
+    // the playhead moved on, what it left behind is dropped
+    reader.prefetch({seq.paths_[5], seq.paths_[6]});
+    EXPECT_TRUE(wait_for(reader, [&](const JsonStore &stats) {
+        return stats.at("entries").get<size_t>() == 2 and
+               stats.at("held").get<size_t>() == 2 * size;
+    }));
+    EXPECT_FALSE(reader.take(seq.paths_[0]));
+
+    // frames found cached aren't held for
+    reader.discard(seq.paths_[5]);
+    EXPECT_FALSE(reader.take(seq.paths_[5]));
+    EXPECT_TRUE(filled_with(reader.take(seq.paths_[6]), size, 'g'));
+    EXPECT_EQ(reader.stats().at("held").get<size_t>(), size_t(0));
+}
+
+TEST(FrameFileReaderTest, Missed) {
+    const size_t size = 8 * 1024 * 1024;
+    Sequence seq("frame_file_reader_missed_test", 4, size);
+    FrameFileReader reader;
+
+    // a file being read is missed rather than waited for, and not held
+    // once its read is done
+    reader.prefetch(seq.paths_);
+    std::string path;
+    EXPECT_TRUE(wait_for(reader, [&](const JsonStore &) {
+        for (const auto &i : seq.paths_)
+            if (reader.reading(i))
+                path = i;
+        return not path.empty();
+    }));
+    if (not path.empty()) {
+        const auto missed = reader.stats().at("missed").get<size_t>();
+        const auto bytes  = reader.take(path);
+        // unless it finished just now
+        if (not bytes)
+            EXPECT_EQ(reader.stats().at("missed").get<size_t>(), missed + 1);
+        EXPECT_FALSE(reader.reading(path));
+    }
+
+    for (const auto &i : seq.paths_)
+        static_cast<void>(take_when_read(reader, i));
+    EXPECT_TRUE(wait_for(reader, [&](const JsonStore &stats) {
+        return stats.at("reads").get<size_t>() + stats.at("failed").get<size_t>() ==
+               seq.paths_.size();
+    }));
+    EXPECT_EQ(reader.stats().at("held").get<size_t>(), size_t(0));
+}
+
+#endif
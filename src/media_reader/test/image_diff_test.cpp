@@ -0,0 +1,141 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstring>
+
+#include "xstudio/media_reader/image_diff.hpp"
+#include "xstudio/utility/caf_helpers.hpp"
+
+using namespace xstudio;
+using namespace xstudio::utility;
+using namespace xstudio::media_reader;
+
+ACTOR_TEST_MINIMAL()
+
+namespace {
+
+// float RGBA, tightly packed over the data window
+void float_rgba_unpack(
+    const ImageBuffer &buf,
+    const JsonStore &,
+    const int x,
+    const int y,
+    const int count,
+    float *rgba) {
+    const auto box   = buf.image_pixels_bounding_box();
+    const auto width = box.max.x - box.min.x;
+    const auto *data = reinterpret_cast<const float *>(buf.buffer());
+    for (int i = 0; i < count; ++i) {
+        const int px = x + i;
+        if (px < box.min.x or px >= box.max.x or y < box.min.y or y >= box.max.y) {
+            std::fill(rgba + i * 4, rgba + i * 4 + 4, 0.0f);
+        } else {
+            std::memcpy(
+                rgba + i * 4,
+                data + ((y - box.min.y) * width + (px - box.min.x)) * 4,
+                4 * sizeof(float));
+        }
+    }
+}
+
+ImageBufPtr make_image(const int width, const int height, const float value) {
+    ImageBufPtr result(new ImageBuffer());
+    result->set_image_dimensions(Imath::V2i(width, height));
+    auto *data =
+        reinterpret_cast<float *>(result->allocate(width * height * 4 * sizeof(float)));
+    std::fill(data, data + width * height * 4, value);
+    result->set_pixel_unpack_func(&float_rgba_unpack);
+    return result;
+}
+
+float *pixels(ImageBufPtr &image) { return reinterpret_cast<float *>(image->buffer()); }
+
+} // namespace
+
+TEST(ImageContentHash, Test) {
+    const std::string a = "the quick brown fox jumps over the lazy dog, twice over";
+    std::string b       = a;
+
+    EXPECT_EQ(hash_bytes(a.data(), a.size()), hash_bytes(b.data(), b.size()));
+    EXPECT_NE(hash_bytes(a.data(), a.size()), hash_bytes(a.data(), a.size(), 1));
+    EXPECT_NE(hash_bytes(a.data(), a.size()), hash_bytes(a.data(), a.size() - 1));
+    b[40] = 'X';
+    EXPECT_NE(hash_bytes(a.data(), a.size()), hash_bytes(b.data(), b.size()));
+
+    auto im_a = make_image(16, 8, 0.5f);
+    auto im_b = make_image(16, 8, 0.5f);
+    EXPECT_EQ(image_content_hash(im_a), image_content_hash(im_b));
+
+    // same bytes, different layout
+    auto im_c = make_image(8, 16, 0.5f);
+    EXPECT_NE(image_content_hash(im_a), image_content_hash(im_c));
+
+    // what's left in the padding after the pixels isn't part of the image
+    ASSERT_GT(im_b->size(), size_t(16 * 8 * 4 * sizeof(float)));
+    im_b->buffer()[im_b->size() - 1] = 1;
+    EXPECT_EQ(image_content_hash(im_a), image_content_hash(im_b));
+    EXPECT_TRUE(compare_images(im_a, im_b).identical_);
+
+    // nor is what's after the data window, for readers giving a pixel size
+    auto im_d = make_image(16, 8, 0.5f);
+    im_a->set_shader_params(JsonStore(R"({"bytes_per_pixel": 16})"_json));
+    im_d->set_shader_params(JsonStore(R"({"bytes_per_pixel": 16})"_json));
+    im_d->set_image_dimensions(Imath::V2i(16, 8), Imath::Box2i({0, 0}, {16, 7}));
+    im_a->set_image_dimensions(Imath::V2i(16, 8), Imath::Box2i({0, 0}, {16, 7}));
+    pixels(im_d)[16 * 7 * 4] = 0.25f;
+    EXPECT_EQ(image_content_hash(im_a), image_content_hash(im_d));
+    im_a->set_shader_params(JsonStore());
+    im_a->set_image_dimensions(Imath::V2i(16, 8));
+
+    pixels(im_b)[7] = 0.25f;
+    EXPECT_NE(image_content_hash(im_a), image_content_hash(im_b));
+    EXPECT_EQ(image_content_hash(ImageBufPtr()), uint64_t(0));
+}
+
+TEST(CompareImages, Test) {
+    auto a = make_image(10, 10, 0.5f);
+    auto b = make_image(10, 10, 0.5f);
+
+    auto stats = compare_images(a, b);
+    EXPECT_TRUE(stats.identical_);
+    EXPECT_TRUE(stats.error_.empty());
+    EXPECT_EQ(stats.pixel_count_, size_t(100));
+    EXPECT_TRUE(std::isinf(stats.psnr_));
+    EXPECT_TRUE(stats.to_json()["psnr"].is_null());
+
+    // one pixel's green is off by 0.1, another's alpha by 0.01
+    pixels(b)[(3 * 10 + 4) * 4 + 1] = 0.6f;
+    pixels(b)[(7 * 10 + 2) * 4 + 3] = 0.51f;
+
+    stats = compare_images(a, b);
+    EXPECT_FALSE(stats.identical_);
+    EXPECT_EQ(stats.differing_pixels_, size_t(2));
+    EXPECT_NEAR(stats.max_abs_diff_[0], 0.0, 1e-6);
+    EXPECT_NEAR(stats.max_abs_diff_[1], 0.1, 1e-6);
+    EXPECT_NEAR(stats.max_abs_diff_[3], 0.01, 1e-6);
+    EXPECT_NEAR(stats.mean_abs_diff_[1], 0.001, 1e-6);
+    // mse over rgb of 100 pixels
+    EXPECT_NEAR(stats.psnr_, 10.0 * std::log10(300.0 / 0.01), 1e-3);
+    EXPECT_NE(stats.hash_a_, stats.hash_b_);
+
+    stats = compare_images(a, b, 0.05f);
+    EXPECT_EQ(stats.differing_pixels_, size_t(1));
+
+    // data windows are compared over their union, pixels outside are zero
+    ImageBufPtr c(new ImageBuffer());
+    c->set_image_dimensions(
+        Imath::V2i(10, 10), Imath::Box2i(Imath::V2i(0, 0), Imath::V2i(10, 5)));
+    auto *data = reinterpret_cast<float *>(c->allocate(10 * 5 * 4 * sizeof(float)));
+    std::fill(data, data + 10 * 5 * 4, 0.5f);
+    c->set_pixel_unpack_func(&float_rgba_unpack);
+
+    stats = compare_images(a, c);
+    EXPECT_EQ(stats.differing_pixels_, size_t(50));
+    EXPECT_NEAR(stats.max_abs_diff_[2], 0.5, 1e-6);
+
+    // can't compare
+    EXPECT_FALSE(compare_images(a, make_image(5, 5, 0.5f)).error_.empty());
+    EXPECT_FALSE(compare_images(a, ImageBufPtr()).error_.empty());
+    EXPECT_FALSE(compare_images(a, ImageBufPtr(new ImageBuffer("bad frame"))).error_.empty());
+}
@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include <numeric>
+
+#include "xstudio/media_reader/image_scopes.hpp"
+#include "xstudio/utility/caf_helpers.hpp"
+
+using namespace xstudio;
+using namespace xstudio::utility;
+using namespace xstudio::media_reader;
+
+ACTOR_TEST_MINIMAL()
+
+namespace {
+
+// float RGBA, tightly packed over the data window
+void float_rgba_unpack(
+    const ImageBuffer &buf,
+    const JsonStore &,
+    const int x,
+    const int y,
+    const int count,
+    float *rgba) {
+    const auto box   = buf.image_pixels_bounding_box();
+    const auto width = box.max.x - box.min.x;
+    const auto *data = reinterpret_cast<const float *>(buf.buffer());
+    std::copy(
+        data + (size_t(y - box.min.y) * width + (x - box.min.x)) * 4,
+        data + (size_t(y - box.min.y) * width + (x - box.min.x) + count) * 4,
+        rgba);
+}
+
+// left half black, right half white
+ImageBufPtr make_image(const int width, const int height) {
+    ImageBufPtr result(new ImageBuffer());
+    result->set_image_dimensions(Imath::V2i(width, height));
+    auto *data =
+        reinterpret_cast<float *>(result->allocate(size_t(width) * height * 4 * sizeof(float)));
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            auto *p = data + (size_t(y) * width + x) * 4;
+            std::fill(p, p + 3, x < width / 2 ? 0.0f : 1.0f);
+            p[3] = 1.0f;
+        }
+    }
+    result->set_pixel_unpack_func(&float_rgba_unpack);
+    return result;
+}
+
+size_t total(const std::vector<uint32_t> &v) {
+    return std::accumulate(v.begin(), v.end(), size_t(0));
+}
+
+} // namespace
+
+TEST(ImageScopes, Test) {
+    auto image = make_image(64, 32);
+
+    ImageScopesSettings settings;
+    settings.histogram_bins_   = 16;
+    settings.waveform_columns_ = 8;
+    settings.waveform_rows_    = 4;
+
+    auto scopes = compute_image_scopes(image, settings);
+    EXPECT_TRUE(scopes.error_.empty());
+    EXPECT_EQ(scopes.samples_, size_t(64 * 32));
+    EXPECT_EQ(scopes.step_x_, 1);
+
+    for (const auto &h : scopes.histograms_) {
+        ASSERT_EQ(h.size(), size_t(16));
+        EXPECT_EQ(h.front(), uint32_t(32 * 32));
+        EXPECT_EQ(h.back(), uint32_t(32 * 32));
+    }
+
+    // left half of the waveform in the bottom row, right half in the top
+    ASSERT_EQ(scopes.luma_waveform_.size(), size_t(8 * 4));
+    EXPECT_EQ(scopes.luma_waveform_[0], uint32_t(8 * 32));
+    EXPECT_EQ(scopes.luma_waveform_[3 * 8 + 7], uint32_t(8 * 32));
+    EXPECT_EQ(scopes.luma_waveform_[7], uint32_t(0));
+    EXPECT_EQ(total(scopes.rgb_parade_[ImageScopes::GREEN]), size_t(64 * 32));
+
+    // subsampled, and split across threads, gives the same shape
+    settings.max_samples_ = 64 * 32 / 4;
+    settings.max_threads_ = 4;
+    scopes                = compute_image_scopes(image, settings);
+    EXPECT_EQ(scopes.step_x_, 2);
+    EXPECT_EQ(scopes.step_y_, 2);
+    EXPECT_EQ(scopes.samples_, size_t(32 * 16));
+    EXPECT_EQ(scopes.histograms_[ImageScopes::LUMA].front(), uint32_t(16 * 16));
+    EXPECT_EQ(total(scopes.luma_waveform_), scopes.samples_);
+
+    EXPECT_FALSE(compute_image_scopes(ImageBufPtr()).error_.empty());
+    EXPECT_EQ(scopes.to_json()["histograms"]["red"].size(), size_t(16));
+}
+
+TEST(ImageScopesCache, Test) {
+    ImageScopesCache cache(2);
+
+    auto a = make_image(16, 16);
+    auto b = make_image(16, 16);
+    auto c = make_image(16, 16);
+    a->set_media_key(media::MediaKey("a"));
+    b->set_media_key(media::MediaKey("b"));
+    c->set_media_key(media::MediaKey("c"));
+
+    auto scopes = cache.get(a);
+    EXPECT_EQ(cache.get(a), scopes);
+    EXPECT_EQ(cache.hits(), size_t(1));
+
+    // different settings, recomputed
+    ImageScopesSettings settings;
+    settings.histogram_bins_ = 8;
+    EXPECT_NE(cache.get(a, settings), scopes);
+    EXPECT_EQ(cache.size(), size_t(1));
+
+    cache.get(b, settings);
+    cache.get(c, settings);
+    EXPECT_EQ(cache.size(), size_t(2));
+    // a was the least recently used
+    const auto hits = cache.hits();
+    cache.get(a, settings);
+    EXPECT_EQ(cache.hits(), hits);
+
+    // no key, not cached
+    cache.clear();
+    cache.get(make_image(4, 4));
+    EXPECT_EQ(cache.size(), size_t(0));
+}
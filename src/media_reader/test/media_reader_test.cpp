@@ -2,9 +2,11 @@
 #include <gtest/gtest.h>
 
 #include "xstudio/media/media.hpp"
+#include "xstudio/media_reader/frame_request_queue.hpp"
 #include "xstudio/media_reader/media_reader.hpp"
 #include "xstudio/utility/helpers.hpp"
 #include "xstudio/utility/caf_helpers.hpp"
+#include "xstudio/utility/time_cache.hpp"
 
 using namespace xstudio;
 using namespace xstudio::utility;
@@ -44,3 +46,116 @@ TEST(MediaReaderManager, Test) {
     // EXPECT_TRUE(mrm.image(media::AVFrameID(path, 0)));
     // EXPECT_THROW(auto i = mrm.image(media::AVFrameID(badpath, 0)), std::runtime_error);
 }
+
+TEST(ImageBuffer, Metadata) {
+    // frames of a sequence, the same but for their timecode
+    auto make_metadata = [](const int frame) {
+        JsonStore result;
+        result["channels"]    = {"R", "G", "B", "A"};
+        result["compression"] = "zip";
+        result["owner"]       = std::string(100, 'x');
+        result["timecode"]    = "01:00:00:" + std::to_string(frame);
+        return result;
+    };
+
+    JsonStore shader_params;
+    shader_params["num_channels"] = 4;
+    shader_params["pix_type_r"]   = 1;
+
+    // half the frames come through a stream's source interner
+    JsonSourceInterner source;
+    std::vector<ImageBufPtr> frames;
+    for (int i = 0; i < 10; i++) {
+        frames.emplace_back(new ImageBuffer());
+        frames.back()->set_shader_params(shader_params, i % 2 ? &source : nullptr);
+        frames.back()->set_metadata(make_metadata(i), i % 2 ? &source : nullptr);
+        EXPECT_EQ(frames.back()->metadata(), make_metadata(i));
+    }
+
+    EXPECT_EQ(frames[3]->shader_params(), shader_params);
+    EXPECT_EQ(&frames[3]->shader_params(), &frames[6]->shader_params());
+
+    // frames only pay for what they don't share
+    EXPECT_EQ(frames[0]->metadata_size_bytes(), frames[9]->metadata_size_bytes());
+    EXPECT_EQ(
+        cache_entry_size(frames[1]), frames[1]->size() + frames[1]->metadata_size_bytes());
+
+    // the cache counts shared values once, while any frame holding them is cached
+    auto shared_size = [](const std::vector<ImageBufPtr> &frames) {
+        std::map<const void *, size_t> shared;
+        for (const auto &i : frames)
+            for (const auto &j : cache_entry_shared(i))
+                shared[j.first] = j.second;
+        size_t result = 0;
+        for (const auto &i : shared)
+            result += i.second;
+        return result;
+    };
+
+    TimeCache<int, ImageBufPtr> cache;
+    size_t own = 0;
+    for (int i = 0; i < 10; i++) {
+        cache.store(i, frames[i]);
+        own += cache_entry_size(frames[i]);
+    }
+    EXPECT_EQ(cache.size(), own + shared_size(frames));
+    EXPECT_LT(shared_size(frames), 2 * shared_size({frames[0]}));
+
+    for (int i = 0; i < 9; i++)
+        cache.erase(i);
+    EXPECT_EQ(cache.size(), cache_entry_size(frames[9]) + shared_size({frames[9]}));
+    cache.erase(9);
+    EXPECT_EQ(cache.size(), size_t(0));
+
+    // not objects
+    frames[0]->set_metadata(JsonStore(nlohmann::json::array({1, 2})));
+    EXPECT_EQ(frames[0]->metadata(), JsonStore(nlohmann::json::array({1, 2})));
+    frames[0]->set_metadata(JsonStore());
+    EXPECT_TRUE(frames[0]->metadata().is_null());
+
+    ImageBuffer error("error");
+    EXPECT_TRUE(error.shader_params().is_null());
+    EXPECT_TRUE(error.metadata().is_null());
+}
+
+TEST(FrameRequestQueue, Retain) {
+
+    std::vector<std::shared_ptr<const media::AVFrameID>> ids;
+    for (int i = 0; i < 8; ++i)
+        ids.push_back(std::make_shared<const media::AVFrameID>(
+            posix_path_to_uri("/tmp/test/test.{:04d}.exr"), i, 0));
+
+    const auto t0       = utility::clock::now();
+    const auto playhead = Uuid::generate();
+    const auto other    = Uuid::generate();
+
+    auto window = [&](const int start, const int count, const int offset_ms) {
+        media::AVFrameIDsAndTimePoints result;
+        for (int i = start; i < start + count; ++i)
+            result.emplace_back(t0 + std::chrono::milliseconds(40 * i + offset_ms), ids[i]);
+        return result;
+    };
+
+    FrameRequestQueue queue;
+    queue.add_frame_requests(window(0, 4, 0), playhead);
+    queue.add_frame_requests(window(0, 1, 1000), other);
+
+    // frames 0 and 1 have left the window, the rest moved along 10ms
+    queue.retain_frame_requests(window(2, 6, 10), playhead);
+
+    std::map<Uuid, int> in_flight;
+    auto r = queue.pop_request(in_flight, 1);
+    ASSERT_TRUE(r);
+    EXPECT_EQ(r->requested_frame_->frame(), 2);
+    EXPECT_EQ(r->required_by_, t0 + std::chrono::milliseconds(90));
+
+    r = queue.pop_request(in_flight, 1);
+    ASSERT_TRUE(r);
+    EXPECT_EQ(r->requested_frame_->frame(), 3);
+
+    // other playheads' requests are left alone
+    r = queue.pop_request(in_flight, 1);
+    ASSERT_TRUE(r);
+    EXPECT_EQ(r->requesting_playhead_uuid_, other);
+    EXPECT_FALSE(queue.pop_request(in_flight, 1));
+}
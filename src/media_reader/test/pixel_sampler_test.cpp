@@ -0,0 +1,153 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "xstudio/media_reader/pixel_sampler.hpp"
+#include "xstudio/utility/caf_helpers.hpp"
+
+using namespace xstudio;
+using namespace xstudio::utility;
+using namespace xstudio::media_reader;
+
+ACTOR_TEST_MINIMAL()
+
+namespace {
+
+// float RGBA, tightly packed over the data window
+void float_rgba_unpack(
+    const ImageBuffer &buf,
+    const JsonStore &,
+    const int x,
+    const int y,
+    const int count,
+    float *rgba) {
+    const auto box   = buf.image_pixels_bounding_box();
+    const auto width = box.max.x - box.min.x;
+    const auto *data = reinterpret_cast<const float *>(buf.buffer());
+    for (int i = 0; i < count; ++i) {
+        const int px = x + i;
+        if (px < box.min.x or px >= box.max.x or y < box.min.y or y >= box.max.y) {
+            std::fill(rgba + i * 4, rgba + i * 4 + 4, 0.0f);
+        } else {
+            std::memcpy(
+                rgba + i * 4,
+                data + (size_t(y - box.min.y) * width + (px - box.min.x)) * 4,
+                4 * sizeof(float));
+        }
+    }
+}
+
+// red is x / width, green is y / height, blue is 0.5 and alpha 1
+ImageBufPtr make_image(const int width, const int height) {
+    ImageBufPtr result(new ImageBuffer());
+    result->set_image_dimensions(Imath::V2i(width, height));
+    auto *data =
+        reinterpret_cast<float *>(result->allocate(size_t(width) * height * 4 * sizeof(float)));
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            auto *p = data + (size_t(y) * width + x) * 4;
+            p[0]    = float(x) / width;
+            p[1]    = float(y) / height;
+            p[2]    = 0.5f;
+            p[3]    = 1.0f;
+        }
+    }
+    result->set_pixel_unpack_func(&float_rgba_unpack);
+    return result;
+}
+
+} // namespace
+
+TEST(PixelSampleRequest, Test) {
+    PixelSampleRequest request;
+    request.points_      = {Imath::V2i(1, 2), Imath::V2i(3, 4)};
+    request.regions_     = {Imath::Box2i(Imath::V2i(0, 0), Imath::V2i(8, 8))};
+    request.data_window_ = true;
+
+    const PixelSampleRequest copy(request.to_json());
+    EXPECT_EQ(copy.points_, request.points_);
+    ASSERT_EQ(copy.regions_.size(), size_t(1));
+    EXPECT_EQ(copy.regions_[0].max, Imath::V2i(8, 8));
+    EXPECT_TRUE(copy.data_window_);
+
+    EXPECT_TRUE(PixelSampleRequest(JsonStore(nlohmann::json::object())).points_.empty());
+}
+
+TEST(SamplePixels, Test) {
+    auto image = make_image(100, 50);
+
+    PixelSampleRequest request;
+    // out of order, repeated, spread along a row, and outside the image
+    request.points_ = {
+        Imath::V2i(10, 20),
+        Imath::V2i(50, 5),
+        Imath::V2i(10, 20),
+        Imath::V2i(0, 5),
+        Imath::V2i(99, 5),
+        Imath::V2i(200, 5)};
+    request.regions_ = {
+        Imath::Box2i(Imath::V2i(0, 0), Imath::V2i(10, 10)),
+        Imath::Box2i(Imath::V2i(5, 5), Imath::V2i(5, 20)),
+        Imath::Box2i(Imath::V2i(90, 40), Imath::V2i(200, 200)),
+        Imath::Box2i(Imath::V2i(-20, -20), Imath::V2i(-10, -10))};
+    request.data_window_ = true;
+
+    const auto samples = sample_pixels(image, request);
+    EXPECT_TRUE(samples.error_.empty());
+
+    ASSERT_EQ(samples.points_.size(), size_t(6));
+    EXPECT_FLOAT_EQ(samples.points_[0][0], 0.1f);
+    EXPECT_FLOAT_EQ(samples.points_[0][1], 0.4f);
+    EXPECT_EQ(samples.points_[2], samples.points_[0]);
+    EXPECT_FLOAT_EQ(samples.points_[1][0], 0.5f);
+    EXPECT_FLOAT_EQ(samples.points_[3][0], 0.0f);
+    EXPECT_FLOAT_EQ(samples.points_[4][0], 0.99f);
+    EXPECT_FLOAT_EQ(samples.points_[4][3], 1.0f);
+    EXPECT_FLOAT_EQ(samples.points_[5][3], 0.0f);
+
+    ASSERT_EQ(samples.regions_.size(), size_t(4));
+    const auto &r = samples.regions_[0];
+    EXPECT_EQ(r.pixel_count_, size_t(100));
+    EXPECT_NEAR(r.mean_[0], 0.045, 1e-6);
+    EXPECT_NEAR(r.mean_[1], 0.09, 1e-6);
+    EXPECT_FLOAT_EQ(r.min_[0], 0.0f);
+    EXPECT_FLOAT_EQ(r.max_[0], 0.09f);
+    EXPECT_FLOAT_EQ(r.max_[1], 0.18f);
+    EXPECT_FLOAT_EQ(r.min_[2], 0.5f);
+
+    // empty
+    EXPECT_EQ(samples.regions_[1].pixel_count_, size_t(0));
+
+    // clipped to the data window
+    EXPECT_EQ(samples.regions_[2].region_.max, Imath::V2i(100, 50));
+    EXPECT_EQ(samples.regions_[2].pixel_count_, size_t(100));
+    EXPECT_FLOAT_EQ(samples.regions_[2].min_[3], 1.0f);
+    EXPECT_EQ(samples.regions_[3].pixel_count_, size_t(0));
+
+    EXPECT_EQ(samples.data_window_.pixel_count_, size_t(5000));
+    EXPECT_NEAR(samples.data_window_.mean_[0], 0.495, 1e-6);
+    EXPECT_NEAR(samples.data_window_.mean_[3], 1.0, 1e-6);
+
+    const auto js = samples.to_json();
+    EXPECT_EQ(js["points"].size(), size_t(6));
+    EXPECT_EQ(js["regions"][0]["pixel_count"], 100);
+    EXPECT_EQ(js["data_window"]["region"][2], 100);
+
+    EXPECT_FALSE(sample_pixels(ImageBufPtr(), request).error_.empty());
+    EXPECT_FALSE(sample_pixels(ImageBufPtr(new ImageBuffer("bad")), request).error_.empty());
+}
+
+TEST(SamplePixels, LargeRegion) {
+    // split across threads, same answer
+    auto image = make_image(1024, 512);
+
+    PixelSampleRequest request;
+    request.data_window_ = true;
+    const auto samples   = sample_pixels(image, request);
+
+    EXPECT_EQ(samples.data_window_.pixel_count_, size_t(1024 * 512));
+    EXPECT_NEAR(samples.data_window_.mean_[0], 1023.0 / 2048.0, 1e-5);
+    EXPECT_NEAR(samples.data_window_.mean_[1], 511.0 / 1024.0, 1e-5);
+    EXPECT_FLOAT_EQ(samples.data_window_.max_[1], 511.0f / 512.0f);
+}
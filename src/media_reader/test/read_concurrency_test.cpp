@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+#include "xstudio/media_reader/read_concurrency.hpp"
+#include "xstudio/utility/caf_helpers.hpp"
+
+using namespace xstudio;
+using namespace xstudio::utility;
+using namespace xstudio::media_reader;
+
+ACTOR_TEST_MINIMAL()
+
+namespace {
+
+const std::string source = "source";
+
+// Reads count frames, always with more queued than allowed, from storage
+// that takes latency_ms(reads in flight) per read. Each frame is needed
+// lead_ms after its read starts. Returns the limit at the end.
+size_t simulate(
+    ReadConcurrency &rc,
+    const std::function<double(size_t)> &latency_ms,
+    const int count        = 3000,
+    const double lead_ms   = 0.0,
+    const std::string &key = source) {
+
+    // when each read in flight finishes, and when it started
+    using Read = std::pair<time_point, time_point>;
+    std::priority_queue<Read, std::vector<Read>, std::greater<>> in_flight;
+    auto now = time_point() + std::chrono::seconds(1);
+
+    auto ms = [](const double value) {
+        return std::chrono::duration_cast<clock::duration>(
+            std::chrono::duration<double, std::milli>(value));
+    };
+
+    for (int done = 0; done < count; done++) {
+        while (rc.admit(key)) {
+            rc.started(key);
+            in_flight.emplace(now + ms(latency_ms(rc.in_flight(key))), now);
+        }
+
+        const auto read = in_flight.top();
+        in_flight.pop();
+        now = read.first;
+        rc.finished(key);
+        rc.sample(key, read.second, now, read.second + ms(lead_ms));
+    }
+
+    return rc.limit(key);
+}
+
+} // namespace
+
+TEST(ReadConcurrencyTest, Test) {
+    ReadConcurrency rc(8);
+
+    // sources start at one read
+    EXPECT_EQ(rc.limit(source), size_t(1));
+    EXPECT_TRUE(rc.admit(source));
+    rc.started(source);
+    EXPECT_EQ(rc.in_flight(source), size_t(1));
+    EXPECT_FALSE(rc.admit(source));
+    rc.finished(source);
+    EXPECT_TRUE(rc.admit(source));
+
+    // finishing more than started, or for a source we don't know, is harmless
+    rc.finished(source);
+    rc.finished("other");
+    EXPECT_EQ(rc.in_flight(source), size_t(0));
+
+    // readers that scale take all they're allowed
+    EXPECT_EQ(simulate(rc, [](size_t) { return 40.0; }), size_t(8));
+
+    rc.set_max_in_flight(4);
+    EXPECT_EQ(rc.max_in_flight(), size_t(4));
+    EXPECT_EQ(rc.limit(source), size_t(4));
+
+    // and start again when their reader is retired
+    rc.forget(source);
+    EXPECT_EQ(rc.limit(source), size_t(1));
+
+    const auto stats = rc.stats();
+    EXPECT_TRUE(stats.at("adaptive").get<bool>());
+    EXPECT_EQ(stats.at("max_in_flight").get<size_t>(), size_t(4));
+    EXPECT_FALSE(stats.at("decisions").empty());
+    EXPECT_EQ(stats.at("decisions").back().at("to").get<size_t>(), size_t(8));
+}
+
+TEST(ReadConcurrencyTest, Storage) {
+    // parallel up to four reads, then they queue
+    {
+        ReadConcurrency rc(8);
+        EXPECT_EQ(
+            simulate(rc, [](size_t n) { return 40.0 * std::max(1.0, n / 4.0); }), size_t(4));
+    }
+
+    // one read at a time whatever we ask, as a single reader would
+    {
+        ReadConcurrency rc(8);
+        EXPECT_LE(simulate(rc, [](size_t n) { return 40.0 * n; }), size_t(2));
+    }
+
+    // more than three reads thrash, as a disk seeking between files
+    {
+        ReadConcurrency rc(8);
+        const auto limit = simulate(rc, [](size_t n) { return n > 3 ? 20.0 * n : 40.0; });
+        EXPECT_GE(limit, size_t(2));
+        EXPECT_LE(limit, size_t(4));
+
+        const auto stats = rc.stats();
+        EXPECT_EQ(stats.at("sources").at(source).at("limit").get<size_t>(), limit);
+        EXPECT_GT(stats.at("sources").at(source).at("throughput_fps").get<double>(), 40.0);
+    }
+}
+
+TEST(ReadConcurrencyTest, Deadline) {
+    // frames needed well after they are read don't need more reads in flight
+    ReadConcurrency rc(8);
+    EXPECT_EQ(simulate(rc, [](size_t) { return 40.0; }, 1000, 1000.0), size_t(1));
+    EXPECT_EQ(rc.stats().at("sources").at(source).at("late").get<size_t>(), size_t(0));
+
+    // but do once they are needed sooner
+    EXPECT_EQ(simulate(rc, [](size_t) { return 40.0; }, 3000, 50.0), size_t(8));
+}
+
+TEST(ReadConcurrencyTest, Fixed) {
+    // not adaptive, every source may use the most
+    ReadConcurrency rc(8, false);
+    EXPECT_EQ(rc.limit(source), size_t(8));
+    EXPECT_EQ(simulate(rc, [](size_t n) { return 40.0 * n; }), size_t(8));
+    EXPECT_TRUE(rc.stats().at("decisions").empty());
+
+    rc.set_adaptive(true);
+    EXPECT_EQ(rc.limit(source), size_t(1));
+}
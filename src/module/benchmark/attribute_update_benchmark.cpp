@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: Apache-2.0
+
+// Throughput of setting module attribute values, for comparing changes to
+// how attribute role data is stored. Not run as part of the tests.
+//
+//   attribute_update_benchmark [count]
+
+#include <cstdlib>
+
+#include "xstudio/module/module.hpp"
+#include "xstudio/utility/logging.hpp"
+
+using namespace xstudio;
+using namespace xstudio::module;
+using namespace xstudio::utility;
+
+int main(int argc, char **argv) {
+
+    start_logger(spdlog::level::info);
+
+    const int count = argc > 1 ? std::atoi(argv[1]) : 1000000;
+
+    Module m("AttributeUpdateBenchmark");
+
+    auto fattr = m.add_float_attribute("Float", "Flt", 0.0f, 0.0f, 1e9f);
+    auto battr = m.add_boolean_attribute("Bool", "Bool", false);
+    auto cattr = m.add_colour_attribute("Colour", "Col", ColourTriplet(0.0f, 0.0f, 0.0f));
+    auto vattr = m.add_vec4f_attribute("Vec4", "V4", Imath::V4f(0.0f, 0.0f, 0.0f, 0.0f));
+
+    spdlog::stopwatch sw;
+    for (int i = 0; i < count; ++i) {
+        fattr->set_value(float(i));
+        battr->set_value(i & 1);
+        cattr->set_value(ColourTriplet(float(i), 0.5f, 0.5f));
+        vattr->set_value(Imath::V4f(float(i), 0.5f, 0.5f, 1.0f));
+    }
+    const double secs = std::chrono::duration<double>(sw.elapsed()).count();
+    spdlog::info(
+        "Module attribute updates {:.0f}/sec ({} updates in {:.3})",
+        double(count) * 4.0 / secs,
+        count * 4,
+        sw);
+
+    if (count and fattr->value() != float(count - 1)) {
+        spdlog::error("Unexpected attribute value {}", fattr->value());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
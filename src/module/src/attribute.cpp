@@ -46,8 +46,7 @@ void Attribute::update_role_data_from_json(
         set_role_data(role, data, notify);
 }
 
-void Attribute::notify_change(
-    const int role, const nlohmann::json &data, const bool self_notify) {
+void Attribute::notify_change(const int role, const bool self_notify) {
     if (owner_) {
         owner_->notify_change(
             uuid(), role, role_data_as_json(role), redraw_viewport_on_change_, self_notify);
@@ -57,7 +56,7 @@ void Attribute::notify_change(
 nlohmann::json Attribute::as_json() const {
 
     nlohmann::json result;
-    for (auto p : role_data_) {
+    for (const auto &p : role_data_) {
         result[role_name(p.first)] = p.second.to_json();
     }
 
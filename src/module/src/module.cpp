@@ -1186,19 +1186,21 @@ void Module::notify_change(
 
     Attribute *attr = get_attribute(attr_uuid);
 
-    if (attribute_events_group_) {
+    if (attribute_events_group_ && attr) {
 
         anon_mail(change_attribute_event_atom_v, module_uuid_, attr_uuid, role, value)
             .send(attribute_events_group_);
 
-        if (attr->has_role_data(Attribute::UIDataModels)) {
+        const auto groups =
+            attr->has_role_data(Attribute::UIDataModels)
+                ? attr->get_role_data<std::vector<std::string>>(Attribute::UIDataModels)
+                : std::vector<std::string>();
+        if (not groups.empty()) {
 
             auto central_models_data_actor =
                 self()->home_system().registry().template get<caf::actor>(
                     global_ui_model_data_registry);
 
-            auto groups =
-                attr->get_role_data<std::vector<std::string>>(Attribute::UIDataModels);
             for (const auto &group_name : groups) {
                 anon_mail(
                     ui::model_data::set_node_data_atom_v,
@@ -1283,7 +1285,8 @@ void Module::attribute_changed(const utility::Uuid &attr_uuid, const int role_id
         auto p     = attribute_watchers_.find(attr_uuid);
         auto _self = caf::actor_cast<caf::event_based_actor *>(self());
 
-        if (p != attribute_watchers_.end()) {
+        if (p != attribute_watchers_.end() && attr) {
+            const utility::JsonStore value(attr->role_data_as_json(role_id));
             for (auto &watcher : p->second) {
                 caf::actor a = caf::actor_cast<caf::actor>(watcher);
                 if (a) {
@@ -1293,7 +1296,7 @@ void Module::attribute_changed(const utility::Uuid &attr_uuid, const int role_id
                             module::attribute_value_atom_v,
                             attr_uuid,
                             role_id,
-                            utility::JsonStore(attr->role_data_as_json(role_id)))
+                            value)
                         .send(a);
                 }
             }
@@ -40,3 +40,63 @@ TEST(ModuleTest, Test) {
 
     f.self->send_exit(gsa, caf::exit_reason::user_shutdown);
 }
+
+TEST(ModuleTest, AttributeDataTest) {
+
+    AttributeData f(1.5f);
+    EXPECT_EQ(f.get<float>(), 1.5f);
+    EXPECT_FALSE(f.set(1.5f));
+    EXPECT_TRUE(f.set(2.5f));
+    EXPECT_EQ(f.to_json(), nlohmann::json(2.5f));
+
+    // ints and floats can set each other
+    EXPECT_TRUE(f.set(3));
+    EXPECT_EQ(f.get<float>(), 3.0f);
+
+    AttributeData v(Imath::V4f(1.0f, 2.0f, 3.0f, 4.0f));
+    const auto vj          = v.to_json();
+    const auto expected_vj = nlohmann::json{"vec4", 1, 1.0f, 2.0f, 3.0f, 4.0f};
+    EXPECT_EQ(vj, expected_vj);
+    EXPECT_FALSE(v.set(vj));
+    EXPECT_TRUE(v.set(Imath::V4f(0.0f, 2.0f, 3.0f, 4.0f)));
+    EXPECT_EQ(v.get<Imath::V4f>(), Imath::V4f(0.0f, 2.0f, 3.0f, 4.0f));
+
+    AttributeData u(Uuid::generate());
+    const auto uuid = Uuid::generate();
+    EXPECT_TRUE(u.set(to_string(uuid)));
+    EXPECT_EQ(u.get<Uuid>(), uuid);
+
+    AttributeData s(std::vector<std::string>({"a", "b"}));
+    EXPECT_TRUE(s.set(nlohmann::json({"a", "b", "c"})));
+    EXPECT_EQ(s.get<std::vector<std::string>>().size(), size_t(3));
+
+    // json can be read back as any type it converts to
+    AttributeData j(nlohmann::json{{"a", 1}});
+    EXPECT_EQ(j.get<nlohmann::json>()["a"], 1);
+
+    EXPECT_THROW((void)f.get<std::string>(), std::bad_variant_access);
+
+    AttributeRoleTable t;
+    t[Attribute::Value] = 1.0f;
+    t[Attribute::Title] = std::string("title");
+    t[Attribute::Enabled].set(true);
+    EXPECT_EQ(t.size(), size_t(3));
+    EXPECT_EQ(t.find(Attribute::Title)->second.get<std::string>(), "title");
+    EXPECT_EQ(t.find(Attribute::ToolTip), t.end());
+    t.erase(t.find(Attribute::Title));
+    EXPECT_EQ(t.size(), size_t(2));
+    EXPECT_EQ(t.find(Attribute::Title), t.end());
+
+    // roles past the index table, and what moves when one is erased
+    for (int role = 0; role < Attribute::Value + 64; ++role)
+        if (t.find(role) == t.end())
+            t[role].set(role);
+    t.erase(t.find(Attribute::Enabled));
+    t.erase(t.find(Attribute::Value + 10));
+    EXPECT_EQ(t.size(), size_t(Attribute::Value + 62));
+    EXPECT_EQ(t.find(Attribute::Enabled), t.end());
+    EXPECT_EQ(t.find(Attribute::Value + 10), t.end());
+    for (const auto role : {0, Attribute::Value + 11, Attribute::Value + 63})
+        EXPECT_EQ(t.find(role)->second.get<int64_t>(), int64_t(role));
+    EXPECT_EQ(t.find(Attribute::Value)->second.get<float>(), 1.0f);
+}
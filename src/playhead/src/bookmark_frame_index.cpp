@@ -0,0 +1,142 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <algorithm>
+#include <limits>
+
+#include "xstudio/playhead/bookmark_frame_index.hpp"
+
+using namespace xstudio::playhead;
+using namespace xstudio;
+
+void MediaSegments::add_frame(const int logical_frame, const media::AVFrameID *frame) {
+
+    if (!frame)
+        return;
+
+    const int media_frame = frame->frame() - frame->first_frame();
+
+    // carry on the current segment if this is the next frame of the same
+    // media, otherwise (cut, gap, retime hold etc) start a new one
+    if (!segments_.empty()) {
+        auto &s = segments_.back();
+        if (s.media_uuid_ == frame->media_uuid() &&
+            s.logical_start_ + s.length_ == logical_frame &&
+            s.media_start_ + s.length_ == media_frame) {
+            s.length_++;
+            return;
+        }
+    }
+
+    segments_.push_back(Segment{frame->media_uuid(), logical_frame, media_frame, 1});
+}
+
+BookmarkRanges MediaSegments::bookmark_ranges(
+    const std::map<utility::Uuid, std::vector<bookmark::BookmarkDetail>> &bookmarks) const {
+
+    BookmarkRanges result;
+
+    // index into result of the last range added for each bookmark, so a
+    // range can be extended where a bookmark spans adjacent segments
+    std::map<utility::Uuid, size_t> last_range;
+
+    for (const auto &s : segments_) {
+
+        auto p = bookmarks.find(s.media_uuid_);
+        if (p == bookmarks.end())
+            continue;
+
+        const int media_end = s.media_start_ + s.length_ - 1;
+
+        for (const auto &bookmark : p->second) {
+
+            const int first = std::max(bookmark.start_frame(), s.media_start_);
+            const int last  = std::min(bookmark.end_frame(), media_end);
+            if (first > last)
+                continue;
+
+            const int logical_first = s.logical_start_ + first - s.media_start_;
+            const int logical_last  = s.logical_start_ + last - s.media_start_;
+
+            auto r = last_range.find(bookmark.uuid_);
+            if (r != last_range.end() && std::get<3>(result[r->second]) == logical_first - 1) {
+                std::get<3>(result[r->second]) = logical_last;
+            } else {
+                last_range[bookmark.uuid_] = result.size();
+                result.emplace_back(
+                    bookmark.uuid_, bookmark.colour(), logical_first, logical_last);
+            }
+        }
+    }
+
+    // ranges in timeline order, as if we had walked the timeline frame by frame
+    std::stable_sort(result.begin(), result.end(), [](const auto &a, const auto &b) {
+        return std::get<2>(a) < std::get<2>(b);
+    });
+
+    return result;
+}
+
+void BookmarkFrameIndex::build(const bookmark::BookmarkAndAnnotations &bookmarks) {
+
+    bookmarks_ = bookmarks;
+    std::stable_sort(
+        bookmarks_.begin(),
+        bookmarks_.end(),
+        [](const bookmark::BookmarkAndAnnotationPtr &a,
+           const bookmark::BookmarkAndAnnotationPtr &b) {
+            return a->start_frame_ < b->start_frame_;
+        });
+
+    max_end_frame_.resize(bookmarks_.size());
+    build_node(0, bookmarks_.size());
+}
+
+void BookmarkFrameIndex::clear() {
+    bookmarks_.clear();
+    max_end_frame_.clear();
+}
+
+bookmark::BookmarkAndAnnotations BookmarkFrameIndex::at_frame(const int frame) const {
+    bookmark::BookmarkAndAnnotations result;
+    collect(0, bookmarks_.size(), frame, result);
+    return result;
+}
+
+int BookmarkFrameIndex::build_node(const size_t begin, const size_t end) {
+
+    // the node for [begin, end) is the element at the middle, its children
+    // are the nodes for the halves either side of it
+    if (begin >= end)
+        return std::numeric_limits<int>::lowest();
+
+    const size_t mid = begin + (end - begin) / 2;
+    max_end_frame_[mid] = std::max(
+        {bookmarks_[mid]->end_frame_, build_node(begin, mid), build_node(mid + 1, end)});
+    return max_end_frame_[mid];
+}
+
+void BookmarkFrameIndex::collect(
+    const size_t begin,
+    const size_t end,
+    const int frame,
+    bookmark::BookmarkAndAnnotations &result) const {
+
+    if (begin >= end)
+        return;
+
+    const size_t mid = begin + (end - begin) / 2;
+
+    // nothing in this subtree reaches frame
+    if (max_end_frame_[mid] < frame)
+        return;
+
+    collect(begin, mid, frame, result);
+
+    // this node and everything to its right starts after frame
+    if (bookmarks_[mid]->start_frame_ > frame)
+        return;
+
+    if (bookmarks_[mid]->end_frame_ >= frame)
+        result.push_back(bookmarks_[mid]);
+
+    collect(mid + 1, end, frame, result);
+}
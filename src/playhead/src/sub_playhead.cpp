@@ -1490,13 +1490,7 @@ std::vector<timebase::flicks> SubPlayhead::get_lookahead_frame_pointers(
         return tps;
     }
 
-    timebase::flicks look_ahead_start_point =
-        playing_forwards_ ? position_flicks_ - headroom : position_flicks_ + headroom;
-
-    look_ahead_start_point =
-        std::min(out_frame_->first, std::max(in_frame_->first, look_ahead_start_point));
-
-    auto frame = current_frame_iterator(look_ahead_start_point);
+    auto frame = lookahead_start_frame(headroom);
 
     const auto start_point = frame;
 
@@ -1560,13 +1554,7 @@ std::vector<timebase::flicks> SubPlayhead::get_lookahead_frame_pointers(
     const timebase::flicks headroom =
         use_headroom ? timebase::to_flicks(0.5) : timebase::k_flicks_zero_seconds;
 
-    timebase::flicks look_ahead_start_point =
-        playing_forwards_ ? position_flicks_ - headroom : position_flicks_ + headroom;
-
-    look_ahead_start_point =
-        std::min(out_frame_->first, std::max(in_frame_->first, look_ahead_start_point));
-
-    auto frame = current_frame_iterator(look_ahead_start_point);
+    auto frame = lookahead_start_frame(headroom);
 
     const auto start_point = frame;
 
@@ -1648,19 +1636,192 @@ void SubPlayhead::request_future_frames() {
             });
 }
 
-void SubPlayhead::update_playback_precache_requests(caf::typed_response_promise<bool> &rp) {
+media::FrameTimeMap::iterator
+SubPlayhead::lookahead_start_frame(const timebase::flicks headroom) {
 
-    // get the AVFrameID iterator for the current frame
-    media::AVFrameIDsAndTimePoints requests;
-    get_lookahead_frame_pointers(requests, pre_cache_read_ahead_frames_, true);
+    timebase::flicks look_ahead_start_point =
+        playing_forwards_ ? position_flicks_ - headroom : position_flicks_ + headroom;
+
+    look_ahead_start_point =
+        std::min(out_frame_->first, std::max(in_frame_->first, look_ahead_start_point));
+
+    return current_frame_iterator(look_ahead_start_point);
+}
+
+media::AVFrameIDsAndTimePointsDelta SubPlayhead::move_precache_window() {
+
+    if (num_retimed_frames_ < 2) {
+        precache_steps_valid_ = false;
+        return precache_window_.make_delta(media::AVFrameIDsAndTimePoints());
+    }
+
+    // same window as get_lookahead_frame_pointers(requests, max_num_frames, true)
+    // builds, starting half a second behind the playhead
+    const timebase::flicks headroom = timebase::to_flicks(0.5);
+    const auto start                = lookahead_start_frame(headroom);
+    const auto start_time =
+        utility::clock::now() - std::chrono::duration_cast<std::chrono::milliseconds>(headroom);
+    const auto max_num_frames = size_t(std::max(pre_cache_read_ahead_frames_, 0));
+
+    // The window can be moved on if the playhead has moved into it, playing
+    // the same way at the same speed. Otherwise (a seek, the timeline or loop
+    // range changed) we build it again.
+    bool moved = precache_steps_valid_ && precache_forwards_ == playing_forwards_ &&
+                 precache_velocity_ == playback_velocity_ &&
+                 precache_steps_.size() <= max_num_frames;
+
+    const auto previous_origin = precache_origin_;
+    size_t drop_front          = 0;
+
+    if (moved && start != precache_start_) {
+        auto p = std::find_if(
+            precache_steps_.begin(), precache_steps_.end(), [&start](const auto &step) {
+                return step.frame_ == start;
+            });
+        if (p == precache_steps_.end()) {
+            moved = false;
+        } else {
+            // drop the frames the playhead has passed, the start frame itself
+            // isn't part of the window. A held frame at the new front stays
+            // unrequested, it's the same frame as the one we requested for the
+            // step before it.
+            ++p;
+            for (auto q = precache_steps_.begin(); q != p; ++q) {
+                if (q->requested_)
+                    drop_front++;
+            }
+            precache_origin_ = std::prev(p)->offset_;
+            precache_steps_.erase(precache_steps_.begin(), p);
+            precache_num_requested_ -= drop_front;
+            if (!precache_num_requested_)
+                precache_last_requested_.reset();
+        }
+    }
+
+    if (!moved) {
+        precache_steps_.clear();
+        precache_origin_        = std::chrono::microseconds(0);
+        precache_num_requested_ = 0;
+        precache_last_requested_.reset();
+        precache_forwards_    = playing_forwards_;
+        precache_velocity_    = playback_velocity_;
+        precache_steps_valid_ = true;
+        precache_window_.reset();
+    }
+
+    // the retained frames are due earlier by however far the window start
+    // has moved along, and later by however much time has passed
+    const auto time_offset = std::chrono::duration_cast<std::chrono::microseconds>(
+                                 start_time - precache_start_time_) -
+                             (precache_origin_ - previous_origin);
+
+    precache_start_      = start;
+    precache_start_time_ = start_time;
+
+    // step on from the leading edge of the window, with the same rules as
+    // get_lookahead_frame_pointers, until it's full or has looped around
+    // the whole in/out range back to the start frame
+    media::AVFrameIDsAndTimePoints appended;
+    auto frame  = precache_steps_.empty() ? start : precache_steps_.back().frame_;
+    auto offset = precache_steps_.empty() ? precache_origin_ : precache_steps_.back().offset_;
+
+    while (precache_steps_.size() < max_num_frames &&
+           (precache_steps_.empty() || precache_steps_.back().frame_ != start)) {
+        if (playing_forwards_) {
+            if (frame != out_frame_)
+                frame++;
+            else
+                frame = in_frame_;
+        } else {
+            if (frame != in_frame_)
+                frame--;
+            else
+                frame = out_frame_;
+        }
 
+        auto frame_plus = frame;
+        frame_plus++;
+        timebase::flicks frame_duration = frame_plus->first - frame->first;
+        offset += std::chrono::duration_cast<std::chrono::microseconds>(
+            frame_duration / playback_velocity_);
+
+        // we don't send pre-read requests for 'blank' frames where
+        // source_uuid is null, or for repeated frames
+        const bool requested = frame->second && !frame->second->source_uuid().is_null() &&
+                               frame->second != precache_last_requested_;
+
+        if (requested) {
+            appended.emplace_back(start_time + (offset - precache_origin_), frame->second);
+            precache_last_requested_ = frame->second;
+            precache_num_requested_++;
+        }
+        precache_steps_.push_back(PrecacheStep{frame, offset, requested});
+    }
+
+    if (moved) {
+        auto delta = precache_window_.make_delta(drop_front, time_offset, appended);
+        if (delta) {
+            // sources in the rest of the window have already been sent
+            if (!appended.empty())
+                make_prefetch_requests_for_colour_pipeline(appended);
+            return std::move(*delta);
+        }
+    }
+
+    // a new window, or a periodic full refresh of the one we have
+    const auto requests = precache_window_requests();
     make_prefetch_requests_for_colour_pipeline(requests);
+    return precache_window_.make_delta(requests);
+}
+
+media::AVFrameIDsAndTimePoints SubPlayhead::precache_window_requests() const {
+
+    media::AVFrameIDsAndTimePoints requests;
+    requests.reserve(precache_num_requested_);
+    for (const auto &step : precache_steps_) {
+        if (step.requested_)
+            requests.emplace_back(
+                precache_start_time_ + (step.offset_ - precache_origin_), step.frame_->second);
+    }
+    return requests;
+}
+
+void SubPlayhead::update_playback_precache_requests(caf::typed_response_promise<bool> &rp) {
 
-    mail(media_reader::playback_precache_atom_v, requests, uuid_, media_type_)
+    // During playback the lookahead window moves along with the playhead, so
+    // we drop the frames it has passed, add frames at its leading edge and
+    // only send the pre-reader that change
+    auto delta = move_precache_window();
+
+    mail(media_reader::playback_precache_atom_v, delta, uuid_, media_type_)
         .request(pre_reader_, infinite)
         .then(
-            [=](const bool requests_processed) mutable { rp.deliver(requests_processed); },
-            [=](const error &err) mutable { rp.deliver(err); });
+            [=](const bool in_step) mutable {
+                // the pre-reader has lost track of our window (maybe it
+                // cleared our requests). If we've sent another update since
+                // this one, that will be refused too and it's for the reply
+                // to the latest update to send the whole window again
+                if (in_step || precache_window_.sequence() != delta.sequence_) {
+                    rp.deliver(true);
+                    return;
+                }
+                precache_window_.reset();
+                mail(
+                    media_reader::playback_precache_atom_v,
+                    precache_window_.make_delta(precache_window_requests()),
+                    uuid_,
+                    media_type_)
+                    .request(pre_reader_, infinite)
+                    .then(
+                        [=](const bool requests_processed) mutable {
+                            rp.deliver(requests_processed);
+                        },
+                        [=](const error &err) mutable { rp.deliver(err); });
+            },
+            [=](const error &err) mutable {
+                precache_window_.reset();
+                rp.deliver(err);
+            });
 }
 
 void SubPlayhead::make_static_precache_request(
@@ -2194,6 +2355,7 @@ void SubPlayhead::store_media_frame_ranges() {
 
     all_media_uuids_.clear();
     media_ranges_.clear();
+    media_segments_.clear();
     logical_frames_.clear();
 
     utility::Uuid media_uuid;
@@ -2216,6 +2378,7 @@ void SubPlayhead::store_media_frame_ranges() {
             }
         } else if (!f.second)
             clip_uuid = utility::Uuid();
+        media_segments_.add_frame(logical_frame, f.second.get());
         logical_frames_[f.first] = logical_frame++;
     }
 
@@ -2224,6 +2387,10 @@ void SubPlayhead::store_media_frame_ranges() {
 
 void SubPlayhead::set_in_and_out_frames() {
 
+    // the playback precache window is stepped between in_frame_ and
+    // out_frame_ and holds iterators into retimed_frames_
+    precache_steps_valid_ = false;
+
     if (num_retimed_frames_ < 2) {
         out_frame_   = retimed_frames_.begin();
         in_frame_    = retimed_frames_.begin();
@@ -2309,46 +2476,9 @@ void SubPlayhead::full_bookmarks_update(caf::typed_response_promise<bool> done)
                                 }
                             }
 
-                            utility::Uuid curr_media_uuid;
-                            std::vector<bookmark::BookmarkDetail> *curr_media_bookmarks =
-                                nullptr;
-
-                            // WARNING!! This is potentially expensive for very long timelines
-                            // ... Need to look for an optimisation
-
-                            // loop over the timeline frames, kkep track of current
-                            // media (for efficiency) and check against the bookmarks
-                            int logical_playhead_frame = 0;
-                            for (const auto &f : retimed_frames_) {
-
-                                // check if media changed and if so are there bookmarks?
-                                if (f.second && f.second->media_uuid() != curr_media_uuid) {
-                                    curr_media_uuid = f.second->media_uuid();
-                                    if (bookmarks.count(curr_media_uuid)) {
-                                        curr_media_bookmarks = &(bookmarks[curr_media_uuid]);
-                                    } else {
-                                        curr_media_bookmarks = nullptr;
-                                    }
-
-                                } else if (!f.second) {
-                                    curr_media_uuid      = utility::Uuid();
-                                    curr_media_bookmarks = nullptr;
-                                }
-
-                                if (curr_media_bookmarks) {
-
-                                    auto media_frame =
-                                        f.second->frame() - f.second->first_frame();
-                                    for (const auto &bookmark : *curr_media_bookmarks) {
-                                        if (bookmark.start_frame() <= media_frame &&
-                                            bookmark.end_frame() >= media_frame) {
-                                            extend_bookmark_frame(
-                                                bookmark, logical_playhead_frame, result);
-                                        }
-                                    }
-                                }
-                                logical_playhead_frame++;
-                            }
+                            // map the bookmarks' media frame ranges onto the
+                            // timeline one media segment (clip) at a time
+                            result = media_segments_.bookmark_ranges(bookmarks);
 
                             fetch_bookmark_annotations(result, done);
                         },
@@ -2363,27 +2493,6 @@ void SubPlayhead::full_bookmarks_update(caf::typed_response_promise<bool> done)
             });
 }
 
-void SubPlayhead::extend_bookmark_frame(
-    const bookmark::BookmarkDetail &detail,
-    const int logical_playhead_frame,
-    BookmarkRanges &bookmark_ranges) {
-    bool existing_entry_extended = false;
-    for (auto &bm_frame_range : bookmark_ranges) {
-        if (detail.uuid_ == std::get<0>(bm_frame_range)) {
-            if (std::get<3>(bm_frame_range) == (logical_playhead_frame - 1)) {
-                std::get<3>(bm_frame_range)++;
-                existing_entry_extended = true;
-                break;
-            }
-        }
-    }
-    if (!existing_entry_extended) {
-        bookmark_ranges.emplace_back(
-            std::make_tuple(
-                detail.uuid_, detail.colour(), logical_playhead_frame, logical_playhead_frame));
-    }
-}
-
 void SubPlayhead::fetch_bookmark_annotations(
     BookmarkRanges bookmark_ranges, caf::typed_response_promise<bool> rp) {
 
@@ -2392,6 +2501,7 @@ void SubPlayhead::fetch_bookmark_annotations(
     if (!bookmark_ranges.size()) {
         bookmark_ranges_.clear();
         bookmarks_.clear();
+        bookmark_index_.clear();
         mail(utility::event_atom_v, bookmark::get_bookmarks_atom_v, bookmark_ranges_)
             .send(parent_);
         rp.deliver(true);
@@ -2460,6 +2570,7 @@ void SubPlayhead::fetch_bookmark_annotations(
                                                     });
 
                                                 bookmarks_ = *result;
+                                                bookmark_index_.build(bookmarks_);
 
                                                 // now ditch non-visible bookmarks
                                                 // (e.g. grades) from our ranges
@@ -2518,17 +2629,8 @@ void SubPlayhead::fetch_bookmark_annotations(
 
 void SubPlayhead::add_annotations_data_to_frame(ImageBufPtr &frame) {
 
-    xstudio::bookmark::BookmarkAndAnnotations bookmarks;
     int logical_frame = logical_frame_from_pts(frame.timeline_timestamp());
-    for (auto &p : bookmarks_) {
-        if (p->start_frame_ <= logical_frame && p->end_frame_ >= logical_frame) {
-            bookmarks.push_back(p);
-        } else if (p->start_frame_ > logical_frame)
-            break;
-        // bookmarks_ sorted by start frame so if this bookmark starts after
-        // logical_frame we can leave the loop
-    }
-    frame.set_bookmarks(bookmarks);
+    frame.set_bookmarks(bookmark_index_.at_frame(logical_frame));
 }
 
 void SubPlayhead::bookmark_deleted(const utility::Uuid &bookmark_uuid) {
@@ -2553,6 +2655,9 @@ void SubPlayhead::bookmark_deleted(const utility::Uuid &bookmark_uuid) {
         }
     }
 
+    if (b != bookmarks_.size())
+        bookmark_index_.build(bookmarks_);
+
     if (n != bookmark_ranges_.size() || b != bookmarks_.size()) {
         mail(utility::event_atom_v, bookmark::get_bookmarks_atom_v, bookmark_ranges_)
             .send(parent_);
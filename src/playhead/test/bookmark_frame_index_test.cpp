@@ -0,0 +1,173 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include <random>
+#include <set>
+
+#include "xstudio/playhead/bookmark_frame_index.hpp"
+#include "xstudio/utility/helpers.hpp"
+#include "xstudio/utility/uuid.hpp"
+
+using namespace xstudio;
+using namespace xstudio::utility;
+using namespace xstudio::playhead;
+
+namespace {
+
+std::shared_ptr<const media::AVFrameID> make_frame(const Uuid &media_uuid, const int frame) {
+    return std::make_shared<const media::AVFrameID>(
+        caf::uri(),
+        frame,
+        0,
+        media::FS_ON_DISK,
+        0,
+        1.0f,
+        FrameRate(timebase::k_flicks_24fps),
+        "",
+        "{0}@{1}/{2},{3}",
+        "",
+        caf::actor_addr(),
+        caf::actor_addr(),
+        JsonStore(),
+        Uuid(),
+        media_uuid);
+}
+
+bookmark::BookmarkDetail make_bookmark(const int start_frame, const int duration_frames) {
+    bookmark::BookmarkDetail detail;
+    detail.uuid_            = Uuid::generate();
+    detail.colour_          = "red";
+    detail.media_reference_ = MediaReference(caf::uri(), "1-1000");
+    detail.start_           = timebase::k_flicks_24fps * start_frame;
+    detail.duration_        = timebase::k_flicks_24fps * duration_frames;
+    return detail;
+}
+
+} // namespace
+
+TEST(MediaSegmentsTest, Test) {
+
+    const auto media_a = Uuid::generate();
+    const auto media_b = Uuid::generate();
+
+    MediaSegments segments;
+    int logical_frame = 0;
+    std::vector<std::shared_ptr<const media::AVFrameID>> frames;
+    auto add = [&](const Uuid &media, const int first, const int last) {
+        for (int f = first; f <= last; ++f) {
+            frames.push_back(make_frame(media, f));
+            segments.add_frame(logical_frame++, frames.back().get());
+        }
+    };
+
+    add(media_a, 0, 99); // logical 0-99
+    add(media_b, 0, 49); // logical 100-149
+    segments.add_frame(logical_frame++, nullptr);
+    add(media_a, 50, 59); // logical 151-160
+
+    EXPECT_EQ(segments.segments().size(), size_t(3));
+    EXPECT_EQ(segments.segments()[2].logical_start_, 151);
+    EXPECT_EQ(segments.segments()[2].media_start_, 50);
+    EXPECT_EQ(segments.segments()[2].length_, 10);
+
+    const auto bm1 = make_bookmark(10, 20); // media frames 10-30
+    const auto bm2 = make_bookmark(40, 15); // media frames 40-55
+    const auto bm3 = make_bookmark(20, 80); // media frames 20-100
+
+    std::map<Uuid, std::vector<bookmark::BookmarkDetail>> bookmarks;
+    bookmarks[media_a] = {bm1, bm2};
+    bookmarks[media_b] = {bm3};
+
+    const auto ranges = segments.bookmark_ranges(bookmarks);
+    ASSERT_EQ(ranges.size(), size_t(4));
+
+    EXPECT_EQ(std::get<0>(ranges[0]), bm1.uuid_);
+    EXPECT_EQ(std::get<1>(ranges[0]), "red");
+    EXPECT_EQ(std::get<2>(ranges[0]), 10);
+    EXPECT_EQ(std::get<3>(ranges[0]), 30);
+
+    EXPECT_EQ(std::get<0>(ranges[1]), bm2.uuid_);
+    EXPECT_EQ(std::get<2>(ranges[1]), 40);
+    EXPECT_EQ(std::get<3>(ranges[1]), 55);
+
+    // clipped to the end of media b
+    EXPECT_EQ(std::get<0>(ranges[2]), bm3.uuid_);
+    EXPECT_EQ(std::get<2>(ranges[2]), 120);
+    EXPECT_EQ(std::get<3>(ranges[2]), 149);
+
+    // second appearance of media a
+    EXPECT_EQ(std::get<0>(ranges[3]), bm2.uuid_);
+    EXPECT_EQ(std::get<2>(ranges[3]), 151);
+    EXPECT_EQ(std::get<3>(ranges[3]), 156);
+}
+
+TEST(MediaSegmentsTest, AdjacentSegmentsTest) {
+
+    // a retime that jumps forward in the media gives two segments that
+    // touch on the timeline, a bookmark spanning both is one range
+    const auto media_a = Uuid::generate();
+
+    MediaSegments segments;
+    std::vector<std::shared_ptr<const media::AVFrameID>> frames;
+    int logical_frame = 0;
+    for (int f = 0; f < 10; ++f) {
+        frames.push_back(make_frame(media_a, f));
+        segments.add_frame(logical_frame++, frames.back().get());
+    }
+    for (int f = 20; f < 30; ++f) {
+        frames.push_back(make_frame(media_a, f));
+        segments.add_frame(logical_frame++, frames.back().get());
+    }
+    EXPECT_EQ(segments.segments().size(), size_t(2));
+
+    std::map<Uuid, std::vector<bookmark::BookmarkDetail>> bookmarks;
+    bookmarks[media_a] = {make_bookmark(5, 20)}; // media frames 5-25
+
+    const auto ranges = segments.bookmark_ranges(bookmarks);
+    ASSERT_EQ(ranges.size(), size_t(1));
+    EXPECT_EQ(std::get<2>(ranges[0]), 5);
+    EXPECT_EQ(std::get<3>(ranges[0]), 15);
+}
+
+TEST(BookmarkFrameIndexTest, Test) {
+
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<int> start_dist(0, 10000);
+    std::uniform_int_distribution<int> length_dist(0, 500);
+
+    bookmark::BookmarkAndAnnotations bookmarks;
+    for (int i = 0; i < 1000; ++i) {
+        auto b          = std::make_shared<bookmark::BookmarkAndAnnotation>();
+        b->start_frame_ = start_dist(rng);
+        b->end_frame_   = b->start_frame_ + length_dist(rng);
+        bookmarks.push_back(b);
+    }
+
+    BookmarkFrameIndex index;
+    EXPECT_TRUE(index.empty());
+    EXPECT_TRUE(index.at_frame(0).empty());
+
+    index.build(bookmarks);
+    EXPECT_FALSE(index.empty());
+
+    for (int frame = -10; frame < 10600; frame += 7) {
+        std::set<const bookmark::BookmarkAndAnnotation *> expected;
+        for (const auto &b : bookmarks) {
+            if (b->start_frame_ <= frame && b->end_frame_ >= frame)
+                expected.insert(b.get());
+        }
+
+        const auto found = index.at_frame(frame);
+        std::set<const bookmark::BookmarkAndAnnotation *> found_set;
+        for (size_t i = 0; i < found.size(); ++i) {
+            found_set.insert(found[i].get());
+            if (i)
+                EXPECT_LE(found[i - 1]->start_frame_, found[i]->start_frame_);
+        }
+        EXPECT_EQ(found.size(), expected.size());
+        EXPECT_EQ(found_set, expected);
+    }
+
+    index.clear();
+    EXPECT_TRUE(index.at_frame(100).empty());
+}
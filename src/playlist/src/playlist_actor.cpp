@@ -254,71 +254,84 @@ PlaylistActor::PlaylistActor(
 
     link_to(json_store_);
     join_event_group(this, json_store_);
-    // media needs to exist before we can deserialise containers.
+    // media needs to exist before we can deserialise containers. Neither
+    // media nor containers depend on each other, so each are built
+    // concurrently.
     spdlog::stopwatch sw;
+    const auto playlist = caf::actor_cast<caf::actor>(this);
 
+    std::vector<std::pair<utility::Uuid, const nlohmann::json *>> media_jsn;
+    std::vector<std::pair<utility::Uuid, const nlohmann::json *>> container_jsn;
     for (const auto &[key, value] : jsn.at("actors").items()) {
-        if (value.at("base").at("container").at("type") == "Media") {
+        const auto &type = value.at("base").at("container").at("type");
+        if (type == "Media")
+            media_jsn.emplace_back(key, &value);
+        else if (type == "Subset" or type == "ContactSheet" or type == "Timeline")
+            container_jsn.emplace_back(key, &value);
+        else if (type == "PlayheadSelection") {
             try {
-                auto actor =
-                    spawn<media::MediaActor>(static_cast<utility::JsonStore>(value), true);
-                media_[key] = actor;
-                link_to(actor);
-                join_event_group(this, actor);
+                selection_actor_ = system().spawn<playhead::PlayheadSelectionActor>(
+                    static_cast<utility::JsonStore>(value), playlist);
+                link_to(selection_actor_);
             } catch (const std::exception &e) {
                 spdlog::error("{}", e.what());
             }
         }
     }
-    spdlog::debug("media loaded in {:.3} seconds.", sw);
-    // deserialise containers
-    for (const auto &[key, value] : jsn.at("actors").items()) {
-        if (value.at("base").at("container").at("type") == "Subset") {
-            try {
-                auto actor = system().spawn<subset::SubsetActor>(
-                    this, static_cast<utility::JsonStore>(value));
-                container_[key] = actor;
-                link_to(actor);
-                join_event_group(this, actor);
-            } catch (const std::exception &e) {
-                spdlog::error("{}", e.what());
-            }
-        } else if (value.at("base").at("container").at("type") == "ContactSheet") {
-            try {
-                auto actor = system().spawn<contact_sheet::ContactSheetActor>(
-                    this, static_cast<utility::JsonStore>(value));
-                container_[key] = actor;
-                link_to(actor);
-                join_event_group(this, actor);
-            } catch (const std::exception &e) {
-                spdlog::error("{}", e.what());
-            }
-        } else if (value.at("base").at("container").at("type") == "Timeline") {
-            try {
-                auto actor = system().spawn<timeline::TimelineActor>(
-                    static_cast<utility::JsonStore>(value), caf::actor_cast<caf::actor>(this));
 
-                container_[key] = actor;
-                link_to(actor);
-                join_event_group(this, actor);
-                // link media to clips.
-                anon_mail(timeline::link_media_atom_v, media_, false).send(actor);
-            } catch (const std::exception &e) {
-                spdlog::error("{}", e.what());
-            }
-        } else if (value.at("base").at("container").at("type") == "PlayheadSelection") {
-
-            try {
+    std::vector<caf::actor> media_actors(media_jsn.size());
+    parallel_for(media_jsn.size(), [&](const size_t i) {
+        try {
+            media_actors[i] = system().spawn<media::MediaActor>(
+                static_cast<utility::JsonStore>(*media_jsn[i].second), true);
+        } catch (const std::exception &e) {
+            spdlog::error("{}", e.what());
+        }
+    });
 
-                selection_actor_ = system().spawn<playhead::PlayheadSelectionActor>(
-                    static_cast<utility::JsonStore>(value), caf::actor_cast<caf::actor>(this));
-                link_to(selection_actor_);
+    for (size_t i = 0; i < media_actors.size(); i++) {
+        if (media_actors[i]) {
+            media_[media_jsn[i].first] = media_actors[i];
+            link_to(media_actors[i]);
+            join_event_group(this, media_actors[i]);
+        }
+    }
+    spdlog::debug("{} media loaded in {:.3} seconds.", media_.size(), sw);
 
-            } catch (const std::exception &e) {
-                spdlog::error("{}", e.what());
-            }
+    // deserialise containers
+    sw.reset();
+    std::vector<caf::actor> containers(container_jsn.size());
+    parallel_for(container_jsn.size(), [&](const size_t i) {
+        const auto &value = *container_jsn[i].second;
+        const auto &type  = value.at("base").at("container").at("type");
+        try {
+            if (type == "Subset")
+                containers[i] = system().spawn<subset::SubsetActor>(
+                    playlist, static_cast<utility::JsonStore>(value));
+            else if (type == "ContactSheet")
+                containers[i] = system().spawn<contact_sheet::ContactSheetActor>(
+                    playlist, static_cast<utility::JsonStore>(value));
+            else
+                containers[i] = system().spawn<timeline::TimelineActor>(
+                    static_cast<utility::JsonStore>(value), playlist);
+        } catch (const std::exception &e) {
+            spdlog::error("{}", e.what());
         }
+    });
+
+    for (size_t i = 0; i < containers.size(); i++) {
+        if (not containers[i])
+            continue;
+        container_[container_jsn[i].first] = containers[i];
+        link_to(containers[i]);
+        join_event_group(this, containers[i]);
+
+        // link media to clips.
+        if (container_jsn[i].second->at("base").at("container").at("type") == "Timeline")
+            anon_mail(timeline::link_media_atom_v, media_, false).send(containers[i]);
     }
+    spdlog::debug("{} containers loaded in {:.3} seconds.", container_.size(), sw);
+
     init();
 }
 
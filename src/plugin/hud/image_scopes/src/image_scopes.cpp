@@ -0,0 +1,193 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <algorithm>
+#include <cmath>
+
+#include "image_scopes.hpp"
+#include "xstudio/atoms.hpp"
+#include "xstudio/media_reader/image_buffer_set.hpp"
+#include "xstudio/utility/helpers.hpp"
+
+using namespace xstudio;
+using namespace xstudio::ui::viewport;
+using namespace xstudio::media_reader;
+
+namespace {
+
+// histogram counts as heights 0-255, relative to the tallest bin of the
+// channels given
+std::vector<std::vector<int>>
+histogram_heights(const ImageScopes &scopes, const std::vector<int> &channels) {
+    uint32_t peak = 1;
+    for (const auto c : channels)
+        for (const auto v : scopes.histograms_[c])
+            peak = std::max(peak, v);
+
+    std::vector<std::vector<int>> result;
+    for (const auto c : channels) {
+        std::vector<int> heights;
+        heights.reserve(scopes.histograms_[c].size());
+        for (const auto v : scopes.histograms_[c])
+            heights.push_back(static_cast<int>(255.0 * v / peak));
+        result.push_back(std::move(heights));
+    }
+    return result;
+}
+
+// waveform counts as intensities 0-255, on a log scale so that sparse
+// traces are still visible
+std::vector<int> waveform_intensities(const std::vector<uint32_t> &counts) {
+    uint32_t peak = 1;
+    for (const auto v : counts)
+        peak = std::max(peak, v);
+
+    const double scale = 255.0 / std::log1p(double(peak));
+    std::vector<int> result;
+    result.reserve(counts.size());
+    for (const auto v : counts)
+        result.push_back(static_cast<int>(std::log1p(double(v)) * scale));
+    return result;
+}
+
+} // namespace
+
+ImageScopesHUD::ImageScopesHUD(caf::actor_config &cfg, const utility::JsonStore &init_settings)
+    : plugin::HUDPluginBase(cfg, "Image Scopes", init_settings, 4.0f), cache_(8) {
+
+    // the overlay is small, there's no point measuring more finely than it
+    // can draw
+    display_settings_.histogram_bins_   = 128;
+    display_settings_.waveform_columns_ = 192;
+    display_settings_.waveform_rows_    = 96;
+
+    scope_type_ = add_string_choice_attribute(
+        "Scope", "Scope", "Histogram", {"Histogram", "Luma Waveform", "RGB Parade"});
+    scope_type_->set_tool_tip("Selects the scope shown over the viewport.");
+    add_hud_settings_attribute(scope_type_);
+
+    scope_data_ = add_string_attribute("Scope Data", "Scope Data", "");
+    scope_data_->expose_in_ui_attrs_group("image_scopes_attributes");
+
+    current_viewport_ = add_string_attribute("Current Viewport", "Current Viewport", "");
+    current_viewport_->expose_in_ui_attrs_group("image_scopes_attributes");
+
+    auto bg_opacity = add_float_attribute("Bg Opacity", "Bg Opacity", 0.6f, 0.0f, 1.0f, 0.05f);
+    bg_opacity->expose_in_ui_attrs_group("image_scopes_attributes");
+    bg_opacity->set_tool_tip("Sets the opactity for dark backdrop behind the scope.");
+    add_hud_settings_attribute(bg_opacity);
+
+    update_during_playback_ =
+        add_boolean_attribute("Update During Playback", "Update Playing", false);
+    update_during_playback_->set_tool_tip(
+        "Toggles whether the scope is recomputed for every frame during playback.");
+    add_hud_settings_attribute(update_during_playback_);
+
+    scope_type_->set_preference_path("/plugin/image_scopes/scope");
+    bg_opacity->set_preference_path("/plugin/image_scopes/bg_opacity");
+    update_during_playback_->set_preference_path("/plugin/image_scopes/update_during_playback");
+
+    hud_element_qml(
+        R"(
+            import ImageScopes 1.0
+            ImageScopesOverlay {
+            }
+        )",
+        plugin::BottomRight);
+}
+
+caf::message_handler ImageScopesHUD::message_handler_extensions() {
+    return caf::message_handler(
+               {[=](media_reader::image_scopes_atom,
+                    const std::string &viewport_name) -> caf::result<utility::JsonStore> {
+                    auto image = onscreen_image(viewport_name);
+                    if (not image)
+                        return make_error(xstudio_error::error, "No image on screen");
+                    return cache_.get(image)->to_json();
+                },
+
+                [=](media_reader::image_scopes_atom,
+                    const std::string &viewport_name,
+                    const utility::JsonStore &settings) -> caf::result<utility::JsonStore> {
+                    auto image = onscreen_image(viewport_name);
+                    if (not image)
+                        return make_error(xstudio_error::error, "No image on screen");
+                    return cache_.get(image, ImageScopesSettings(settings))->to_json();
+                }})
+        .or_else(plugin::HUDPluginBase::message_handler_extensions());
+}
+
+ImageBufPtr ImageScopesHUD::onscreen_image(const std::string &viewport_name) const {
+    auto p = current_onscreen_images_.find(viewport_name);
+    if (p == current_onscreen_images_.end() or not p->second)
+        return ImageBufPtr();
+    return p->second->hero_image();
+}
+
+void ImageScopesHUD::attribute_changed(const utility::Uuid &attribute_uuid, const int role) {
+
+    if (attribute_uuid == scope_type_->uuid()) {
+        displayed_scopes_.reset();
+        update_display(current_viewport_->value());
+    }
+    plugin::HUDPluginBase::attribute_changed(attribute_uuid, role);
+}
+
+void ImageScopesHUD::images_going_on_screen(
+    const media_reader::ImageBufDisplaySetPtr &images,
+    const std::string viewport_name,
+    const bool playhead_playing) {
+
+    if (images)
+        current_onscreen_images_[viewport_name] = images;
+    else
+        current_onscreen_images_[viewport_name].reset();
+
+    if (visible() and (not playhead_playing or update_during_playback_->value()))
+        update_display(viewport_name);
+}
+
+void ImageScopesHUD::update_display(const std::string &viewport_name) {
+
+    auto image = onscreen_image(viewport_name);
+    if (not image or not visible())
+        return;
+
+    auto scopes = cache_.get(image, display_settings_);
+    if (scopes == displayed_scopes_)
+        return;
+    displayed_scopes_ = scopes;
+
+    nlohmann::json data;
+    const auto &type = scope_type_->value();
+    data["type"]     = type;
+    data["error"]    = scopes->error_;
+    data["columns"]  = display_settings_.waveform_columns_;
+    data["rows"]     = display_settings_.waveform_rows_;
+
+    if (type == "Luma Waveform") {
+        data["waveform"] = waveform_intensities(scopes->luma_waveform_);
+    } else if (type == "RGB Parade") {
+        for (const auto &channel : scopes->rgb_parade_)
+            data["parade"].push_back(waveform_intensities(channel));
+    } else {
+        data["histograms"] = histogram_heights(
+            *scopes, {ImageScopes::RED, ImageScopes::GREEN, ImageScopes::BLUE});
+        data["histograms"].push_back(histogram_heights(*scopes, {ImageScopes::LUMA})[0]);
+    }
+
+    current_viewport_->set_value(viewport_name);
+    scope_data_->set_value(data.dump());
+}
+
+extern "C" {
+plugin_manager::PluginFactoryCollection *plugin_factory_collection_ptr() {
+    return new plugin_manager::PluginFactoryCollection(
+        std::vector<std::shared_ptr<plugin_manager::PluginFactory>>(
+            {std::make_shared<plugin_manager::PluginFactoryTemplate<ImageScopesHUD>>(
+                utility::Uuid("3c1d8e52-7a4f-4b0e-9d61-2f85c0a7e914"),
+                "ImageScopesHUD",
+                plugin_manager::PluginFlags::PF_HEAD_UP_DISPLAY,
+                true,
+                "xStudio",
+                "Histogram and waveform scopes HUD Plugin")}));
+}
+}
@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "xstudio/plugin_manager/plugin_base.hpp"
+#include "xstudio/plugin_manager/hud_plugin.hpp"
+#include "xstudio/media_reader/image_scopes.hpp"
+
+namespace xstudio::ui::viewport {
+
+/**
+ *  @brief HUD showing a histogram, luma waveform or RGB parade of the image
+ *  on screen.
+ *
+ *  @details Scopes are computed on the plugin's own thread from the decoded
+ *  image buffer and sent to the QML overlay as a compact JSON string. They
+ *  can also be requested directly with (image_scopes_atom, viewport_name)
+ *  or (image_scopes_atom, viewport_name, settings), which return the
+ *  ImageScopes json. Like the overlay's, these sample the image on a grid
+ *  of at most max_samples points (64K by default), set max_samples to 0 to
+ *  measure every pixel.
+ */
+class ImageScopesHUD : public plugin::HUDPluginBase {
+  public:
+    ImageScopesHUD(caf::actor_config &cfg, const utility::JsonStore &init_settings);
+
+    ~ImageScopesHUD() override = default;
+
+    void attribute_changed(const utility::Uuid &attribute_uuid, const int role) override;
+
+    void images_going_on_screen(
+        const media_reader::ImageBufDisplaySetPtr &images,
+        const std::string viewport_name,
+        const bool playhead_playing) override;
+
+  protected:
+    caf::message_handler message_handler_extensions() override;
+
+  private:
+    void update_display(const std::string &viewport_name);
+    media_reader::ImageBufPtr onscreen_image(const std::string &viewport_name) const;
+
+    std::map<std::string, media_reader::ImageBufDisplaySetPtr> current_onscreen_images_;
+    media_reader::ImageScopesCache cache_;
+    media_reader::ImageScopesSettings display_settings_;
+    media_reader::ImageScopesPtr displayed_scopes_;
+
+    module::StringChoiceAttribute *scope_type_;
+    module::StringAttribute *scope_data_;
+    module::StringAttribute *current_viewport_;
+    module::BooleanAttribute *update_during_playback_;
+};
+
+} // namespace xstudio::ui::viewport
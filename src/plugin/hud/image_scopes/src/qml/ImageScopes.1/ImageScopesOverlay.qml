@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: Apache-2.0
+
+import QtQuick
+import xStudio 1.0
+import xstudio.qml.models 1.0
+
+Rectangle {
+
+    width: 300
+    height: 160
+    color: "transparent"
+
+    id: control
+    visible: scope_data_string != "" && scope_viewport == view.name
+
+    XsModuleData {
+        id: scopes_model_data
+        modelDataName: "image_scopes_attributes"
+    }
+
+    XsAttributeValue {
+        id: __scope_data_string
+        attributeTitle: "Scope Data"
+        model: scopes_model_data
+    }
+    property alias scope_data_string: __scope_data_string.value
+
+    XsAttributeValue {
+        id: __scope_viewport
+        attributeTitle: "Current Viewport"
+        model: scopes_model_data
+    }
+    property alias scope_viewport: __scope_viewport.value
+
+    XsAttributeValue {
+        id: __bg_opacity
+        attributeTitle: "Bg Opacity"
+        model: scopes_model_data
+    }
+    property alias bg_opacity: __bg_opacity.value
+
+    property var scope_data: scope_data_string ? JSON.parse(scope_data_string) : undefined
+
+    onScope_dataChanged: canvas.requestPaint()
+
+    Rectangle {
+        anchors.fill: parent
+        radius: 5
+        color: "black"
+        opacity: bg_opacity
+        border.color: "white"
+        border.width: 2
+    }
+
+    Canvas {
+
+        id: canvas
+        anchors.fill: parent
+        anchors.margins: 6
+
+        // draw an intensity image of cols x rows into the given rect,
+        // intensities are stored bottom row first
+        function drawWaveform(ctx, values, cols, rows, x0, w, r, g, b) {
+            var img = ctx.createImageData(cols, rows)
+            for (var row = 0; row < rows; ++row) {
+                for (var col = 0; col < cols; ++col) {
+                    var v = values[row * cols + col]
+                    var i = ((rows - 1 - row) * cols + col) * 4
+                    img.data[i] = r * v
+                    img.data[i + 1] = g * v
+                    img.data[i + 2] = b * v
+                    img.data[i + 3] = v
+                }
+            }
+            ctx.save()
+            ctx.translate(x0, 0)
+            ctx.scale(w / cols, height / rows)
+            ctx.drawImage(img, 0, 0)
+            ctx.restore()
+        }
+
+        function drawHistogram(ctx, values, colour) {
+            ctx.strokeStyle = colour
+            ctx.lineWidth = 1
+            ctx.beginPath()
+            for (var i = 0; i < values.length; ++i) {
+                var x = (i + 0.5) * width / values.length
+                var y = height - values[i] * height / 255.0
+                if (i == 0)
+                    ctx.moveTo(x, y)
+                else
+                    ctx.lineTo(x, y)
+            }
+            ctx.stroke()
+        }
+
+        onPaint: {
+            var ctx = getContext("2d")
+            ctx.clearRect(0, 0, width, height)
+            var d = scope_data
+            if (!d || d.error != "")
+                return
+
+            if (d.histograms) {
+                var colours = ["#ff4040", "#40ff40", "#4080ff", "#e0e0e0"]
+                for (var c = 0; c < d.histograms.length; ++c)
+                    drawHistogram(ctx, d.histograms[c], colours[c])
+            } else if (d.waveform) {
+                drawWaveform(ctx, d.waveform, d.columns, d.rows, 0, width, 1, 1, 1)
+            } else if (d.parade) {
+                var w = width / 3
+                drawWaveform(ctx, d.parade[0], d.columns, d.rows, 0, w, 1, 0.25, 0.25)
+                drawWaveform(ctx, d.parade[1], d.columns, d.rows, w, w, 0.25, 1, 0.25)
+                drawWaveform(ctx, d.parade[2], d.columns, d.rows, 2 * w, w, 0.25, 0.5, 1)
+            }
+        }
+    }
+
+}
@@ -1,4 +1,6 @@
 // SPDX-License-Identifier: Apache-2.0
+#include <algorithm>
+#include <cstring>
 #include <filesystem>
 
 #include <iostream>
@@ -883,11 +885,9 @@ PixelInfo FFMpegMediaReader::ffmpeg_buffer_pixel_picker(
 
         for (const auto &p : extra_pixel_locations) {
 
-            if (pixel_location.x < 0 || pixel_location.x >= width || pixel_location.y < 0 ||
-                pixel_location.y >= height) {
+            if (p.x < 0 || p.x >= width || p.y < 0 || p.y >= height) {
                 r.add_extra_pixel_raw_rgba(Imath::V4f(0.0f, 0.0f, 0.0f, 0.0f));
             } else {
-                Imath::V4f rgba_pix = fetch_rgba_pixel(pixel_location);
                 r.add_extra_pixel_raw_rgba(fetch_rgba_pixel(p));
             }
         }
@@ -900,3 +900,149 @@ PixelInfo FFMpegMediaReader::ffmpeg_buffer_pixel_picker(
     }
     return {};
 }
+
+/*
+ * Row at a time version of the above for CPU side image analysis, without
+ * the code value bookkeeping. Pixels without alpha get 1.
+ */
+void FFMpegMediaReader::ffmpeg_buffer_pixel_unpack(
+    const ImageBuffer &buf,
+    const utility::JsonStore &pixel_unpack_uniforms,
+    const int x,
+    const int y,
+    const int count,
+    float *rgba) {
+
+    std::fill(rgba, rgba + 4 * count, 0.0f);
+
+    const int width  = buf.image_size_in_pixels().x;
+    const int height = buf.image_size_in_pixels().y;
+    if (pixel_unpack_uniforms.is_null() or y < 0 or y >= height)
+        return;
+
+    const int x0 = std::max(x, 0);
+    const int x1 = std::min(x + count, width);
+    if (x1 <= x0)
+        return;
+
+    const int pix_fmt              = pixel_unpack_uniforms.value("pix_fmt", 0);
+    const int y_linesize           = pixel_unpack_uniforms.value("y_linesize", 0);
+    const int u_linesize           = pixel_unpack_uniforms.value("u_linesize", 0);
+    const int v_linesize           = pixel_unpack_uniforms.value("v_linesize", 0);
+    const int a_linesize           = pixel_unpack_uniforms.value("a_linesize", 0);
+    const int y_plane_bytes_offset = pixel_unpack_uniforms.value("y_plane_bytes_offset", 0);
+    const int u_plane_bytes_offset = pixel_unpack_uniforms.value("u_plane_bytes_offset", 0);
+    const int v_plane_bytes_offset = pixel_unpack_uniforms.value("v_plane_bytes_offset", 0);
+    const int a_plane_bytes_offset = pixel_unpack_uniforms.value("a_plane_bytes_offset", 0);
+    const int half_scale_uvy       = pixel_unpack_uniforms.value("half_scale_uvy", 0);
+    const int half_scale_uvx       = pixel_unpack_uniforms.value("half_scale_uvx", 0);
+    const int bits_per_channel     = pixel_unpack_uniforms.value("bits_per_channel", 0);
+    const Imath::M33f yuv_conv     = pixel_unpack_uniforms.value("yuv_conv", Imath::M33f());
+    const Imath::V3i yuv_offsets   = pixel_unpack_uniforms.value("yuv_offsets", Imath::V3i());
+    const float norm_coeff         = pixel_unpack_uniforms.value("norm_coeff", 1.0f);
+
+    const auto *data  = reinterpret_cast<const uint8_t *>(buf.buffer());
+    const size_t size = buf.size();
+
+    auto byte1 = [&](const int address) -> int {
+        return address >= 0 and size_t(address) < size ? data[address] : 0;
+    };
+    auto byte2 = [&](const int address) -> int {
+        if (address < 0 or size_t(address) + 2 > size)
+            return 0;
+        uint16_t v;
+        std::memcpy(&v, data + address, sizeof(v));
+        return v;
+    };
+
+    const bool wide = bits_per_channel == 10 or bits_per_channel == 12;
+    auto yuv_lookup = [&](const int px, const int py, const int offset, const int linesize) {
+        return wide ? byte2(offset + px * 2 + py * linesize)
+                    : byte1(offset + px + py * linesize);
+    };
+
+    float *dst = rgba + 4 * (x0 - x);
+    for (int px = x0; px < x1; ++px, dst += 4) {
+        Imath::V4f p(0.0f, 0.0f, 0.0f, 1.0f);
+
+        if (pix_fmt == 0) {
+            const int ux = half_scale_uvx ? px >> 1 : px;
+            const int uy = half_scale_uvy ? y >> 1 : y;
+            Imath::V3i yuv(
+                yuv_lookup(px, y, y_plane_bytes_offset, y_linesize),
+                yuv_lookup(ux, uy, u_plane_bytes_offset, u_linesize),
+                yuv_lookup(ux, uy, v_plane_bytes_offset, v_linesize));
+
+            if (wide) {
+                if (half_scale_uvx and (px & 1) == 1) {
+                    const Imath::V3i yuv2(
+                        yuv.x,
+                        yuv_lookup(ux + 1, uy, u_plane_bytes_offset, u_linesize),
+                        yuv_lookup(ux + 1, uy, v_plane_bytes_offset, v_linesize));
+                    yuv = (yuv + yuv2) / 2;
+                }
+                if (a_linesize != 0)
+                    p.w = float(yuv_lookup(px, y, a_plane_bytes_offset, a_linesize)) *
+                          norm_coeff;
+            }
+
+            yuv -= yuv_offsets;
+            Imath::V3f yuvf(yuv.x, yuv.y, yuv.z);
+            yuvf *= yuv_conv;
+            yuvf *= norm_coeff;
+            p.x = yuvf.x;
+            p.y = yuvf.y;
+            p.z = yuvf.z;
+
+        } else if (pix_fmt == 9) {
+            const int address = px * 8 + y * y_linesize;
+            p = Imath::V4f(
+                    byte2(address),
+                    byte2(address + 2),
+                    byte2(address + 4),
+                    byte2(address + 6)) *
+                norm_coeff;
+
+        } else if (pix_fmt == 8) {
+            const int address = px * 6 + y * y_linesize;
+            p.x               = byte2(address) * norm_coeff;
+            p.y               = byte2(address + 2) * norm_coeff;
+            p.z               = byte2(address + 4) * norm_coeff;
+
+        } else if (pix_fmt == 7) {
+            const int address = px * 2 + y * y_linesize;
+            p.x               = byte2(address + v_plane_bytes_offset) * norm_coeff;
+            p.y               = byte2(address + y_plane_bytes_offset) * norm_coeff;
+            p.z               = byte2(address + u_plane_bytes_offset) * norm_coeff;
+            if (a_linesize != 0)
+                p.w = byte2(address + a_plane_bytes_offset) * norm_coeff;
+
+        } else if (pix_fmt > 2) {
+            const int address = px * 4 + y * y_linesize;
+            const Imath::V4f b(
+                byte1(address), byte1(address + 1), byte1(address + 2), byte1(address + 3));
+            if (pix_fmt == 3) { // AV_PIX_FMT_ARGB
+                p = Imath::V4f(b[1], b[2], b[3], b[0]);
+            } else if (pix_fmt == 4) { // AV_PIX_FMT_RGBA
+                p = b;
+            } else if (pix_fmt == 5) { // AV_PIX_FMT_ABGR
+                p = Imath::V4f(b[3], b[2], b[1], b[0]);
+            } else { // AV_PIX_FMT_BGRA
+                p = Imath::V4f(b[2], b[1], b[0], b[3]);
+            }
+            p *= norm_coeff;
+
+        } else {
+            const int address = px * 3 + y * y_linesize;
+            const bool bgr    = pix_fmt == 2;
+            p.x               = byte1(address + (bgr ? 2 : 0)) * norm_coeff;
+            p.y               = byte1(address + 1) * norm_coeff;
+            p.z               = byte1(address + (bgr ? 0 : 2)) * norm_coeff;
+        }
+
+        dst[0] = p.x;
+        dst[1] = p.y;
+        dst[2] = p.z;
+        dst[3] = p.w;
+    }
+}
@@ -40,6 +40,9 @@ class FFMpegMediaReader : public MediaReader {
     [[nodiscard]] ImageBuffer::PixelPickerFunc pixel_picker_func() const override {
         return &FFMpegMediaReader::ffmpeg_buffer_pixel_picker;
     }
+    [[nodiscard]] ImageBuffer::PixelUnpackFunc pixel_unpack_func() const override {
+        return &FFMpegMediaReader::ffmpeg_buffer_pixel_unpack;
+    }
 
   private:
     static PixelInfo ffmpeg_buffer_pixel_picker(
@@ -48,6 +51,14 @@ class FFMpegMediaReader : public MediaReader {
         const Imath::V2i &pixel_location,
         const std::vector<Imath::V2i> &extra_pixel_locationss);
 
+    static void ffmpeg_buffer_pixel_unpack(
+        const ImageBuffer &buf,
+        const utility::JsonStore &pixel_unpack_uniforms,
+        const int x,
+        const int y,
+        const int count,
+        float *rgba);
+
     std::shared_ptr<ffmpeg::FFMpegDecoder> decoder;
     std::shared_ptr<ffmpeg::FFMpegDecoder> audio_decoder;
     std::shared_ptr<ffmpeg::FFMpegDecoder> thumbnail_decoder;
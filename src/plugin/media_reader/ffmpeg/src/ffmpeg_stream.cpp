@@ -427,7 +427,7 @@ ImageBufPtr FFMpegStream::get_ffmpeg_frame_as_xstudio_image() {
         color_range,
         ffmpeg_frame_->colorspace);
 
-    image_buffer->set_shader_params(jsn);
+    image_buffer->set_shader_params(jsn, &shader_params_interner_);
 
     image_buffer->set_display_timestamp_seconds(
         double(ffmpeg_frame_->pts) * double(avc_stream_->time_base.num) /
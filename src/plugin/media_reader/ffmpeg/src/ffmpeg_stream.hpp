@@ -180,5 +180,8 @@ class FFMpegStream {
 
     utility::FrameRate frame_rate_;
     ImageBufPtr attached_pic_;
+
+    // shader parameters of the frames decoded, which rarely change
+    utility::JsonSourceInterner shader_params_interner_;
 };
 } // namespace xstudio::media_reader::ffmpeg
@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <cstring>
+
+#include <Iex.h>
+#include <ImfIO.h>
+
+#include "xstudio/media_reader/frame_file_reader.hpp"
+
+namespace xstudio::media_reader {
+
+/**
+ *  @brief An EXR read from the bytes of the whole file in memory.
+ *
+ *  @details Memory mapped as far as OpenEXR is concerned, so chunks are
+ *  decompressed straight from our buffer without a copy.
+ */
+class ExrMemoryStream : public Imf::IStream {
+  public:
+    ExrMemoryStream(const std::string &path, FileBytesPtr bytes)
+        : Imf::IStream(path.c_str()), bytes_(std::move(bytes)) {}
+
+    bool isMemoryMapped() const override { return true; }
+
+    bool read(char c[], int n) override {
+        std::memcpy(c, advance(n), n);
+        return pos_ < bytes_->size();
+    }
+
+    char *readMemoryMapped(int n) override { return const_cast<char *>(advance(n)); }
+
+    uint64_t tellg() override { return pos_; }
+
+    void seekg(uint64_t pos) override { pos_ = pos; }
+
+  private:
+    const char *advance(const int n) {
+        if (n < 0 or pos_ + n > bytes_->size())
+            throw Iex::InputExc("Unexpected end of file.");
+        auto data = bytes_->data() + pos_;
+        pos_ += n;
+        return data;
+    }
+
+    FileBytesPtr bytes_;
+    uint64_t pos_{0};
+};
+
+} // namespace xstudio::media_reader
@@ -2,6 +2,7 @@
 #include <filesystem>
 #include <algorithm>
 #include <cctype>
+#include <cstring>
 
 #include <Iex.h>
 #include <IexErrnoExc.h>
@@ -21,12 +22,14 @@
 #include <ImfVecAttribute.h>
 
 #include "xstudio/media/media_error.hpp"
+#include "xstudio/media_reader/frame_file_reader.hpp"
 #include "xstudio/media_reader/media_reader.hpp"
 #include "xstudio/utility/helpers.hpp"
 #include "xstudio/utility/logging.hpp"
 #include <chrono>
 #include "xstudio/ui/opengl/shader_program_base.hpp"
 
+#include "exr_memory_stream.hpp"
 #include "openexr.hpp"
 #include "simple_exr_sampler.hpp"
 
@@ -186,6 +189,8 @@ OpenEXRMediaReader::OpenEXRMediaReader(const utility::JsonStore &prefs)
     max_exr_overscan_percent_ = 5.0f;
     readers_per_source_       = 1;
 
+    FrameFileReader::instance().add_reader(name());
+
     update_preferences(prefs);
 }
 
@@ -219,7 +224,16 @@ ImageBufPtr OpenEXRMediaReader::image(const media::AVFrameID &mptr) {
 
     // DebugTimer dd(path);
 
-    Imf::MultiPartInputFile input(path.c_str());
+    // decode from the file read ahead by the precache pipeline if it was
+    std::unique_ptr<ExrMemoryStream> stream;
+    std::unique_ptr<Imf::MultiPartInputFile> input_file;
+    if (auto bytes = FrameFileReader::instance().take(path)) {
+        stream     = std::make_unique<ExrMemoryStream>(path, std::move(bytes));
+        input_file = std::make_unique<Imf::MultiPartInputFile>(*stream);
+    } else {
+        input_file = std::make_unique<Imf::MultiPartInputFile>(path.c_str());
+    }
+    Imf::MultiPartInputFile &input = *input_file;
     int parts    = input.parts();
     int part_idx = -1;
     std::array<Imf::PixelType, 4> pix_type;
@@ -323,7 +337,9 @@ ImageBufPtr OpenEXRMediaReader::image(const media::AVFrameID &mptr) {
     jsn["bytes_per_pixel"] = int(bytes_per_pixel);
     // jsn["path"] = to_string(mptr.uri());
 
-    ImageBufPtr buf(new ImageBuffer(openexr_shader_uuid, jsn));
+    auto &interner = source_interner(mptr.stream_id());
+    ImageBufPtr buf(new ImageBuffer(openexr_shader_uuid));
+    buf->set_shader_params(jsn, &interner);
 
     auto b = buf->allocate(buf_size);
 
@@ -332,7 +348,7 @@ ImageBufPtr OpenEXRMediaReader::image(const media::AVFrameID &mptr) {
         memset(b, 0, buf_size);
     }
 
-    buf->set_metadata(part_metadata);
+    buf->set_metadata(part_metadata, &interner);
 
     // 4th channel is always put into 'alpha' channel as per shader code
     // above
@@ -530,6 +546,15 @@ void OpenEXRMediaReader::get_channel_names_by_layer(
     }
 }
 
+utility::JsonSourceInterner &
+OpenEXRMediaReader::source_interner(const std::string &stream_id) {
+    // the last values of every layer read are kept, start again if a lot of
+    // differently named ones have been
+    if (source_interners_.size() > 64 and not source_interners_.count(stream_id))
+        source_interners_.clear();
+    return source_interners_[stream_id];
+}
+
 void OpenEXRMediaReader::stream_ids_from_exr_part(
     const Imf::Header &header, std::vector<std::string> &stream_ids) const {
 
@@ -953,4 +978,90 @@ PixelInfo OpenEXRMediaReader::exr_buffer_pixel_picker(
     }
 
     return r;
-}
\ No newline at end of file
+}
+
+/*
+ * Row at a time version of the above for CPU side image analysis, as fast as
+ * we can make it for the common all half RGBA layout.
+ */
+void OpenEXRMediaReader::exr_buffer_pixel_unpack(
+    const ImageBuffer &buf,
+    const utility::JsonStore &pixel_unpack_uniforms,
+    const int x,
+    const int y,
+    const int count,
+    float *rgba) {
+
+    std::fill(rgba, rgba + 4 * count, 0.0f);
+
+    const int num_channels    = pixel_unpack_uniforms.value("num_channels", 0);
+    const int bytes_per_pixel = pixel_unpack_uniforms.value("bytes_per_pixel", 0);
+    const std::array<int, 4> pix_types{
+        pixel_unpack_uniforms.value("pix_type_r", 0),
+        pixel_unpack_uniforms.value("pix_type_g", 0),
+        pixel_unpack_uniforms.value("pix_type_b", 0),
+        pixel_unpack_uniforms.value("pix_type_a", 0)};
+    const Imath::V2i image_bounds_min = buf.image_pixels_bounding_box().min;
+    const Imath::V2i image_bounds_max = buf.image_pixels_bounding_box().max;
+
+    if (num_channels < 1 || num_channels > 4 || bytes_per_pixel <= 0)
+        return;
+    if (y < image_bounds_min.y || y >= image_bounds_max.y)
+        return;
+
+    const int x0 = std::max(x, image_bounds_min.x);
+    const int x1 = std::min(x + count, image_bounds_max.x);
+    if (x1 <= x0)
+        return;
+
+    const size_t row_start =
+        ((size_t)(y - image_bounds_min.y) * (image_bounds_max.x - image_bounds_min.x) +
+         (x0 - image_bounds_min.x)) *
+        bytes_per_pixel;
+    if (row_start + (size_t)(x1 - x0) * bytes_per_pixel > buf.size())
+        return;
+
+    const auto *src = reinterpret_cast<const uint8_t *>(buf.buffer()) + row_start;
+    float *dst      = rgba + 4 * (x0 - x);
+    const int n     = x1 - x0;
+
+    if (num_channels == 4 && bytes_per_pixel == 8 && pix_types[0] == 1 && pix_types[1] == 1 &&
+        pix_types[2] == 1 && pix_types[3] == 1) {
+        const half *h = reinterpret_cast<const half *>(src);
+        for (int i = 0; i < n * 4; ++i)
+            dst[i] = h[i];
+        return;
+    }
+
+    // byte offset of each channel within the pixel
+    std::array<int, 4> offsets{0, 0, 0, 0};
+    for (int c = 1; c < num_channels; ++c)
+        offsets[c] = offsets[c - 1] + (pix_types[c - 1] == 1 ? 2 : 4);
+
+    auto channel = [&](const uint8_t *pix, const int c) -> float {
+        if (pix_types[c] == 1)
+            return *reinterpret_cast<const half *>(pix + offsets[c]);
+        float v;
+        std::memcpy(&v, pix + offsets[c], sizeof(float));
+        return v;
+    };
+
+    for (int i = 0; i < n; ++i, src += bytes_per_pixel, dst += 4) {
+        switch (num_channels) {
+        case 1:
+            dst[0] = channel(src, 0);
+            break;
+        case 2:
+            // Luminance/Alpha layout, as the picker
+            dst[0] = dst[1] = dst[2] = channel(src, 0);
+            dst[3]                   = channel(src, 1);
+            break;
+        default:
+            dst[0] = channel(src, 0);
+            dst[1] = channel(src, 1);
+            dst[2] = channel(src, 2);
+            if (num_channels == 4)
+                dst[3] = channel(src, 3);
+        }
+    }
+}
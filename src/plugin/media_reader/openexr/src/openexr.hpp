@@ -1,11 +1,13 @@
 // SPDX-License-Identifier: Apache-2.0
 #pragma once
 
+#include <map>
 #include <string>
 
 #include "xstudio/media_reader/media_reader.hpp"
 #include "xstudio/thumbnail/thumbnail.hpp"
 #include "xstudio/utility/helpers.hpp"
+#include "xstudio/utility/json_interner.hpp"
 #include <ImfChannelList.h>
 #include <ImfHeader.h> // staticInitialize
 
@@ -36,6 +38,9 @@ class OpenEXRMediaReader : public MediaReader {
     [[nodiscard]] ImageBuffer::PixelPickerFunc pixel_picker_func() const override {
         return &OpenEXRMediaReader::exr_buffer_pixel_picker;
     }
+    [[nodiscard]] ImageBuffer::PixelUnpackFunc pixel_unpack_func() const override {
+        return &OpenEXRMediaReader::exr_buffer_pixel_unpack;
+    }
     [[nodiscard]] std::vector<std::string> supported_extensions() const override;
 
   private:
@@ -45,6 +50,14 @@ class OpenEXRMediaReader : public MediaReader {
         const Imath::V2i &pixel_location,
         const std::vector<Imath::V2i> &extra_pixel_locationss);
 
+    static void exr_buffer_pixel_unpack(
+        const ImageBuffer &buf,
+        const utility::JsonStore &pixel_unpack_uniforms,
+        const int x,
+        const int y,
+        const int count,
+        float *rgba);
+
     void get_channel_names_by_layer(
         const Imf::Header &header,
         std::map<std::string, std::vector<std::string>> &channel_names_by_layer) const;
@@ -57,8 +70,13 @@ class OpenEXRMediaReader : public MediaReader {
         const std::string &stream_id,
         std::vector<std::string> &exr_channels_to_load) const;
 
+    // interns the shader parameters and metadata of the frames read, per
+    // stream, so consecutive frames reuse unchanged values cheaply
+    utility::JsonSourceInterner &source_interner(const std::string &stream_id);
+
     float max_exr_overscan_percent_;
     int readers_per_source_;
+    std::map<std::string, utility::JsonSourceInterner> source_interners_;
 
     utility::JsonStore supported_;
 };
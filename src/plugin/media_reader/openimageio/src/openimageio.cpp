@@ -1,18 +1,25 @@
 #include <OpenImageIO/typedesc.h>
+#include <array>
 #include <cstddef>
+#include <cstring>
 #include <exception>
 #include <filesystem>
+#include <mutex>
 #include <spdlog/spdlog.h>
 #include <string>
 
 #include "openimageio.hpp"
+#include "xstudio/media_reader/frame_file_reader.hpp"
 #include "xstudio/media_reader/media_reader.hpp"
 #include "xstudio/utility/helpers.hpp"
 #include "xstudio/ui/opengl/shader_program_base.hpp"
 
+#include <OpenImageIO/filesystem.h>
 #include <OpenImageIO/imageio.h>
 #include <OpenImageIO/imagebuf.h>
 #include <OpenImageIO/imagebufalgo.h>
+#include <OpenImageIO/imagecache.h>
+#include <Imath/half.h>
 
 namespace fs = std::filesystem;
 
@@ -138,9 +145,18 @@ vec4 fetch_rgba_pixel(ivec2 image_coord)
 static ui::viewport::GPUShaderPtr
     oiio_shader(new ui::opengl::OpenGLShader(myshader_uuid, oiio_shader_code));
 
+// The modification times of the files read through the image cache. The cache
+// is shared by all reader instances so this must be too, or a file re-written
+// after one reader saw it would stay stale in the cache for the others.
+std::mutex s_file_mod_times_mutex;
+std::map<std::string, fs::file_time_type> s_file_mod_times;
+
 } // namespace
 
 OIIOMediaReader::OIIOMediaReader(const utility::JsonStore &prefs) : MediaReader("OIIO", prefs) {
+#if OIIO_VERSION >= 20200
+    FrameFileReader::instance().add_reader(name());
+#endif
     update_preferences(prefs);
 }
 
@@ -175,6 +191,27 @@ void OIIOMediaReader::update_preferences(const utility::JsonStore &prefs) {
     } catch (const std::exception &e) {
     }
 
+    try {
+        // Reduced resolution reads of big stills via the OIIO ImageCache
+        tiled_mode_ =
+            global_store::preference_value<bool>(prefs, "/plugin/media_reader/OIIO/tiled_mode");
+        tiled_mode_max_size_ = global_store::preference_value<int>(
+            prefs, "/plugin/media_reader/OIIO/tiled_mode_max_size");
+        const auto cache_mb = global_store::preference_value<float>(
+            prefs, "/plugin/media_reader/OIIO/tiled_mode_cache_size_mb");
+
+        // the cache is only made once tiled mode is on
+        if (tiled_mode_) {
+            auto cache = image_cache();
+            cache->attribute("max_memory_MB", cache_mb);
+            // scanline images without MIP levels are tiled and MIP mapped as
+            // they are pulled into the cache
+            cache->attribute("autotile", 256);
+            cache->attribute("automip", 1);
+        }
+    } catch (const std::exception &e) {
+    }
+
     try {
         // Set OIIO log times preference
         // When the "log_times" attribute is nonzero, ImageBufAlgo functions are instrumented to
@@ -189,6 +226,82 @@ void OIIOMediaReader::update_preferences(const utility::JsonStore &prefs) {
 
 utility::Uuid OIIOMediaReader::plugin_uuid() const { return s_plugin_uuid; }
 
+/*
+ * Row at a time decode for CPU side image analysis, the same as the shader:
+ * a plane per channel, with grey images' R, G and B all reading plane 0.
+ */
+void OIIOMediaReader::oiio_buffer_pixel_unpack(
+    const ImageBuffer &buf,
+    const utility::JsonStore &pixel_unpack_uniforms,
+    const int x,
+    const int y,
+    const int count,
+    float *rgba) {
+
+    std::fill(rgba, rgba + 4 * count, 0.0f);
+
+    const int width             = pixel_unpack_uniforms.value("width", 0);
+    const int height            = pixel_unpack_uniforms.value("height", 0);
+    const int bytes_per_channel = pixel_unpack_uniforms.value("bytes_per_channel", 0);
+    const bool is_half_float    = pixel_unpack_uniforms.value("is_half_float", 0) != 0;
+    const bool has_alpha        = pixel_unpack_uniforms.value("has_alpha", false);
+    const std::array<size_t, 4> starts{
+        pixel_unpack_uniforms.value("channel_r_start", size_t(0)),
+        pixel_unpack_uniforms.value("channel_g_start", size_t(0)),
+        pixel_unpack_uniforms.value("channel_b_start", size_t(0)),
+        pixel_unpack_uniforms.value("channel_a_start", size_t(0))};
+
+    if (bytes_per_channel != 1 and bytes_per_channel != 2 and bytes_per_channel != 4)
+        return;
+    if (y < 0 or y >= height)
+        return;
+
+    const int x0 = std::max(x, 0);
+    const int x1 = std::min(x + count, width);
+    if (x1 <= x0)
+        return;
+
+    const int n           = x1 - x0;
+    const int channels    = has_alpha ? 4 : 3;
+    const size_t offset   = (size_t(y) * width + x0) * bytes_per_channel;
+    const size_t row_size = size_t(n) * bytes_per_channel;
+    for (int c = 0; c < channels; ++c) {
+        if (starts[c] + offset + row_size > buf.size())
+            return;
+    }
+
+    float *dst = rgba + 4 * (x0 - x);
+    for (int c = 0; c < 4; ++c) {
+        float *d = dst + c;
+        if (c == 3 and not has_alpha) {
+            for (int i = 0; i < n; ++i)
+                d[i * 4] = 1.0f;
+            continue;
+        }
+
+        const auto *src = reinterpret_cast<const uint8_t *>(buf.buffer()) + starts[c] + offset;
+        if (bytes_per_channel == 1) {
+            for (int i = 0; i < n; ++i)
+                d[i * 4] = float(src[i]) / 255.0f;
+        } else if (bytes_per_channel == 2 and is_half_float) {
+            for (int i = 0; i < n; ++i) {
+                half v;
+                std::memcpy(&v, src + i * 2, sizeof(v));
+                d[i * 4] = v;
+            }
+        } else if (bytes_per_channel == 2) {
+            for (int i = 0; i < n; ++i) {
+                uint16_t v;
+                std::memcpy(&v, src + i * 2, sizeof(v));
+                d[i * 4] = float(v) / 65535.0f;
+            }
+        } else {
+            for (int i = 0; i < n; ++i)
+                std::memcpy(d + i * 4, src + i * 4, sizeof(float));
+        }
+    }
+}
+
 /**
  * @brief Detects the image type (grayscale, RGB, etc.) from the given OIIO::ImageSpec.
  *
@@ -705,20 +818,123 @@ void fill_rendered_image(
     }
 }
 
+/**
+ * @brief Allocates an ImageBuffer for planar image data and sets up the shader parameters.
+ *
+ * @param spec              The OpenImageIO ImageSpec describing the source image.
+ * @param width             Width of the image data that will be put in the buffer.
+ * @param height            Height of the image data that will be put in the buffer.
+ * @param image_type        The detected type of the image (RGBA, RGB, GRAYSCALE, etc).
+ * @return                  The allocated image buffer, ready to be filled.
+ */
+ImageBufPtr make_rendered_image_buffer(
+    const OIIO::ImageSpec &spec,
+    const size_t width,
+    const size_t height,
+    const ImageType image_type) {
+
+    // Determine channel and pixel information for buffer allocation
+    size_t num_channels            = get_rendered_image_channel_count(image_type);
+    OIIO::TypeDesc rendered_format = get_rendered_image_format(spec.format);
+    int bytes_per_channel          = get_rendered_image_bytes_per_channel(rendered_format);
+    int is_half_float              = get_is_half_float(spec.format);
+
+    // Compute the channel offsets for the shader
+    size_t channel_r_start =
+        get_rendered_image_channel_red_start(width, height, bytes_per_channel, image_type);
+    size_t channel_g_start =
+        get_rendered_image_channel_green_start(width, height, bytes_per_channel, image_type);
+    size_t channel_b_start =
+        get_rendered_image_channel_blue_start(width, height, bytes_per_channel, image_type);
+    size_t channel_a_start =
+        get_rendered_image_channel_alpha_start(width, height, bytes_per_channel, image_type);
+
+    // Calculate total number of pixels and bytes per pixel
+    size_t pixel_count  = width * height;
+    int bytes_per_pixel = bytes_per_channel * num_channels;
+
+    // Prepare JSON input parameters for the shader program
+    JsonStore jsn;
+    jsn["width"]             = width;
+    jsn["height"]            = height;
+    jsn["bytes_per_channel"] = bytes_per_channel;
+    jsn["is_half_float"]     = is_half_float;
+    jsn["has_alpha"]       = image_type == IMAGE_RGBA || image_type == IMAGE_GRAYSCALE_ALPHA;
+    jsn["channel_r_start"] = channel_r_start;
+    jsn["channel_g_start"] = channel_g_start;
+    jsn["channel_b_start"] = channel_b_start;
+    jsn["channel_a_start"] = channel_a_start;
+
+    // Allocate and configure the image buffer
+    ImageBufPtr buf(new ImageBuffer(myshader_uuid, jsn));
+    buf->allocate(pixel_count * bytes_per_pixel);
+    buf->set_shader(oiio_shader);
+    buf->set_image_dimensions(Imath::V2i(width, height));
+    return buf;
+}
+
+/**
+ * @brief Picks the MIP level to decode so that the image is no bigger than needed.
+ *
+ * Returns the smallest level whose longest edge is still at least max_size pixels, so that
+ * the image is never decoded at a lower resolution than it will be displayed.
+ *
+ * @param width       Width of MIP level 0.
+ * @param height      Height of MIP level 0.
+ * @param num_levels  Number of MIP levels available.
+ * @param max_size    Longest edge, in pixels, that we need to display.
+ * @return            The MIP level to read.
+ */
+int pick_mip_level(
+    const int width, const int height, const int num_levels, const int max_size) {
+    int level = 0;
+    int size  = std::max(width, height);
+    while (level + 1 < num_levels && (size / 2) >= max_size) {
+        size /= 2;
+        level++;
+    }
+    return level;
+}
+
 ImageBufPtr OIIOMediaReader::image(const media::AVFrameID &mptr) {
     ImageBufPtr buf;
 
     try {
         // Step 1: Convert the URI to a POSIX path
         std::string path = uri_to_posix_path(mptr.uri());
+        auto stream_id   = mptr.stream_id();
+
+        // If a specific subimage/mipmap stream hasn't been asked for, big
+        // images are read at reduced resolution via the image cache
+        if (tiled_mode_ && stream_id == "image") {
+            buf = cached_image(path);
+            if (buf)
+                return buf;
+        }
 
-        // Step 2: Open the image using OpenImageIO
-        auto image = OIIO::ImageInput::open(path);
+        // Step 2: Open the image using OpenImageIO, from the file read ahead
+        // by the precache pipeline if it was and the format reads from memory
+        const auto bytes = FrameFileReader::instance().take(path);
+#if OIIO_VERSION >= 20200
+        std::unique_ptr<OIIO::Filesystem::IOMemReader> proxy;
+#endif
+        std::unique_ptr<OIIO::ImageInput> image;
+#if OIIO_VERSION >= 20200
+        if (bytes) {
+            proxy = std::make_unique<OIIO::Filesystem::IOMemReader>(
+                const_cast<char *>(bytes->data()), bytes->size());
+            image = OIIO::ImageInput::open(path, nullptr, proxy.get());
+            // a format that can't, read the file as before
+            if (!image)
+                OIIO::geterror();
+        }
+#endif
+        if (!image)
+            image = OIIO::ImageInput::open(path);
         if (!image) {
             throw media_corrupt_error("OIIO error: " + OIIO::geterror());
         }
 
-        auto stream_id = mptr.stream_id();
         // determine if mip/subimage..
         int subimage = 0;
         int mipmap   = 0;
@@ -741,44 +957,13 @@ ImageBufPtr OIIOMediaReader::image(const media::AVFrameID &mptr) {
         std::map<char, int> channel_indices = get_channel_indices(spec, image_type);
 
         // Step 7: Determine channel and pixel information for buffer allocation
-        size_t num_channels            = get_rendered_image_channel_count(image_type);
         OIIO::TypeDesc rendered_format = get_rendered_image_format(spec.format);
         int bytes_per_channel          = get_rendered_image_bytes_per_channel(rendered_format);
-        int is_half_float              = get_is_half_float(spec.format);
-
-        // Step 8: Compute the channel offsets for the shader
-        size_t channel_r_start =
-            get_rendered_image_channel_red_start(width, height, bytes_per_channel, image_type);
-        size_t channel_g_start = get_rendered_image_channel_green_start(
-            width, height, bytes_per_channel, image_type);
-        size_t channel_b_start =
-            get_rendered_image_channel_blue_start(width, height, bytes_per_channel, image_type);
-        size_t channel_a_start = get_rendered_image_channel_alpha_start(
-            width, height, bytes_per_channel, image_type);
-
-        // Step 9: Calculate total number of pixels and bytes per pixel
-        size_t pixel_count  = spec.width * spec.height;
-        int bytes_per_pixel = bytes_per_channel * num_channels;
-
-        // Step 10: Prepare JSON input parameters for the shader program
-        JsonStore jsn;
-        jsn["width"]             = width;
-        jsn["height"]            = height;
-        jsn["bytes_per_channel"] = bytes_per_channel;
-        jsn["is_half_float"]     = is_half_float;
-        jsn["has_alpha"] = image_type == IMAGE_RGBA || image_type == IMAGE_GRAYSCALE_ALPHA;
-        jsn["channel_r_start"] = channel_r_start;
-        jsn["channel_g_start"] = channel_g_start;
-        jsn["channel_b_start"] = channel_b_start;
-        jsn["channel_a_start"] = channel_a_start;
-
-        // Step 11: Allocate and configure the image buffer
-        buf.reset(new ImageBuffer(myshader_uuid, jsn));
-        buf->allocate(pixel_count * bytes_per_pixel);
-        buf->set_shader(oiio_shader);
-        buf->set_image_dimensions(Imath::V2i(width, height));
-
-        // Step 12: Read the image and fill the buffer in planar format
+
+        // Step 8: Allocate and configure the image buffer
+        buf = make_rendered_image_buffer(spec, width, height, image_type);
+
+        // Step 9: Read the image and fill the buffer in planar format
         fill_rendered_image(
             image.get(),
             image_type,
@@ -791,7 +976,7 @@ ImageBufPtr OIIOMediaReader::image(const media::AVFrameID &mptr) {
             subimage,
             mipmap);
 
-        // Step 13: Close the image file
+        // Step 10: Close the image file
         image->close();
 
     } catch (const std::exception &e) {
@@ -803,6 +988,104 @@ ImageBufPtr OIIOMediaReader::image(const media::AVFrameID &mptr) {
     return buf;
 }
 
+ImageBufPtr OIIOMediaReader::cached_image(const std::string &path) {
+
+    ImageBufPtr buf;
+    auto cache = image_cache();
+    const OIIO::ustring filename(path);
+
+    // if the file has been re-written since any reader last read it, the
+    // tiles in the cache are stale
+    {
+        const auto mtime = fs::last_write_time(fs::path(path));
+        std::lock_guard<std::mutex> l(s_file_mod_times_mutex);
+        auto p = s_file_mod_times.find(path);
+        if (p != s_file_mod_times.end() && p->second != mtime)
+            cache->invalidate(filename, true);
+        s_file_mod_times[path] = mtime;
+    }
+
+    OIIO::ImageSpec spec;
+    if (!cache->get_imagespec(filename, spec, 0)) {
+        throw media_corrupt_error("OIIO error: " + cache->geterror());
+    }
+
+    // small images are read in one go as normal
+    if (std::max(spec.width, spec.height) <= tiled_mode_max_size_)
+        return buf;
+
+    int num_levels = 1;
+    cache->get_image_info(
+        filename, 0, 0, OIIO::ustring("miplevels"), OIIO::TypeInt, &num_levels);
+    const int level = pick_mip_level(spec.width, spec.height, num_levels, tiled_mode_max_size_);
+
+    // data window of the chosen level, as the cache (or the file) has it -
+    // it isn't always the full size one halved
+    OIIO::ImageSpec level_spec;
+#if OIIO_VERSION >= 20500
+    const bool have_level_spec = cache->get_cache_dimensions(filename, level_spec, 0, level);
+#else
+    const bool have_level_spec = cache->get_imagespec(filename, level_spec, 0, level);
+#endif
+    if (!have_level_spec) {
+        throw media_corrupt_error("OIIO error: " + cache->geterror());
+    }
+    const size_t width  = level_spec.width;
+    const size_t height = level_spec.height;
+    const int x0        = level_spec.x;
+    const int y0        = level_spec.y;
+
+    ImageType image_type                = detect_image_type(spec);
+    std::map<char, int> channel_indices = get_channel_indices(spec, image_type);
+    OIIO::TypeDesc rendered_format      = get_rendered_image_format(spec.format);
+    int bytes_per_channel = get_rendered_image_bytes_per_channel(rendered_format);
+
+    buf = make_rendered_image_buffer(spec, width, height, image_type);
+
+    // fill the planes from the cache's tiles, same layout as fill_rendered_image
+    const size_t plane_size = width * height * bytes_per_channel;
+    auto fill_plane         = [&](const char channel, const int plane) {
+        const int ch = channel_indices.at(channel);
+        if (!cache->get_pixels(
+                filename,
+                0,
+                level,
+                x0,
+                x0 + int(width),
+                y0,
+                y0 + int(height),
+                0,
+                1,
+                ch,
+                ch + 1,
+                rendered_format,
+                &(buf->buffer()[plane_size * plane]))) {
+            throw media_unreadable_error("OIIO error: " + cache->geterror());
+        }
+    };
+
+    if (image_type == IMAGE_RGBA || image_type == IMAGE_RGB) {
+        fill_plane('R', 0);
+        fill_plane('G', 1);
+        fill_plane('B', 2);
+        if (image_type == IMAGE_RGBA)
+            fill_plane('A', 3);
+    } else {
+        fill_plane('Y', 0);
+        if (image_type == IMAGE_GRAYSCALE_ALPHA)
+            fill_plane('A', 1);
+    }
+
+    return buf;
+}
+
+std::shared_ptr<OIIO::ImageCache> OIIOMediaReader::image_cache() {
+    // one cache shared by all the OIIO readers, so that tiles read by one
+    // reader worker are available to the others
+    static std::shared_ptr<OIIO::ImageCache> cache = OIIO::ImageCache::create(true);
+    return cache;
+}
+
 thumbnail::ThumbnailBufferPtr
 OIIOMediaReader::thumbnail(const media::AVFrameID &mpr, const size_t thumb_size) {
 
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <map>
+#include <memory>
 #include <string>
 #include <OpenImageIO/imageio.h>
+#include <OpenImageIO/imagecache.h>
 
 #include "xstudio/media_reader/media_reader.hpp"
 #include "xstudio/thumbnail/thumbnail.hpp"
@@ -29,7 +32,28 @@ class OIIOMediaReader : public MediaReader {
 
     [[nodiscard]] utility::Uuid plugin_uuid() const override;
 
+    [[nodiscard]] ImageBuffer::PixelUnpackFunc pixel_unpack_func() const override {
+        return &OIIOMediaReader::oiio_buffer_pixel_unpack;
+    }
+
   private:
+    static void oiio_buffer_pixel_unpack(
+        const ImageBuffer &buf,
+        const utility::JsonStore &pixel_unpack_uniforms,
+        const int x,
+        const int y,
+        const int count,
+        float *rgba);
+
+    // Reads a big image at reduced resolution, via the shared OIIO
+    // ImageCache. Returns an empty ImageBufPtr if the image is small enough
+    // to be read in full as normal.
+    ImageBufPtr cached_image(const std::string &path);
+
+    static std::shared_ptr<OIIO::ImageCache> image_cache();
+
     utility::JsonStore supported_;
+    bool tiled_mode_         = {false};
+    int tiled_mode_max_size_ = {4096};
 };
 } // namespace xstudio::media_reader
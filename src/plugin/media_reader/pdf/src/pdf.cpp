@@ -1,9 +1,11 @@
 // SPDX-License-Identifier: Apache-2.0
+#include <cstring>
 #include <exception>
 #include <filesystem>
 
 #include <fstream>
 #include <iostream>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -11,6 +13,7 @@
 #include <QPdfDocument>
 
 #include "pdf.hpp"
+#include "pdf_render_cache.hpp"
 #include "xstudio/media_reader/media_reader.hpp"
 #include "xstudio/media/media_error.hpp"
 #include "xstudio/utility/helpers.hpp"
@@ -67,6 +70,16 @@ static ui::viewport::GPUShaderPtr
 static ui::viewport::GPUShaderPtr pdf_shader_transparent(
     new ui::opengl::OpenGLShader(myshader_transparent_uuid, myshader_transparent));
 
+// QImage scanlines are padded to 4 bytes
+void copy_pixels(const QImage &image, char *dst, const size_t row_bytes, const size_t rows) {
+    if (size_t(image.bytesPerLine()) == row_bytes) {
+        std::memcpy(dst, image.constBits(), row_bytes * rows);
+    } else {
+        for (size_t y = 0; y < rows; ++y)
+            std::memcpy(dst + y * row_bytes, image.constScanLine(int(y)), row_bytes);
+    }
+}
+
 } // namespace
 
 // QPdfDocument::Error::None   0   No error occurred.
@@ -84,40 +97,36 @@ void PDFMediaReader::update_preferences(const utility::JsonStore &prefs) {
 
         dpi_ = global_store::preference_value<uint32_t>(prefs, "/plugin/media_reader/pdf/dpi");
 
+        draft_dpi_ = global_store::preference_value<uint32_t>(
+            prefs, "/plugin/media_reader/pdf/draft_dpi");
+
+        read_ahead_ =
+            global_store::preference_value<int>(prefs, "/plugin/media_reader/pdf/read_ahead");
+
+        PDFRenderCache::instance().set_limits(
+            global_store::preference_value<size_t>(
+                prefs, "/plugin/media_reader/pdf/document_cache_size"),
+            global_store::preference_value<size_t>(
+                prefs, "/plugin/media_reader/pdf/page_cache_size_mb") *
+                1024 * 1024,
+            global_store::preference_value<int>(
+                prefs, "/plugin/media_reader/pdf/render_threads"));
+
     } catch (const std::exception &e) {
         spdlog::warn("{} {}", __PRETTY_FUNCTION__, e.what());
     }
 }
 
-uint64_t PDFMediaReader::points_to_pixels(const double points) const {
-    uint64_t value = (points / 72.0f) * dpi_;
-
-    return (value / 32) * 32;
-}
-
 media::MediaDetail PDFMediaReader::detail(const caf::uri &uri) const {
 
     std::vector<media::StreamDetail> streams;
-    std::shared_ptr<QPdfDocument> pdf;
-    auto frame_count = 0;
-
-    if (cache_.count(uri))
-        pdf = cache_[uri];
-    else {
-        pdf         = std::make_shared<QPdfDocument>();
-        auto loaded = pdf->load(QStringFromStd(uri_to_posix_path(uri)));
-        if (loaded != QPdfDocument::Error::None) {
-            throw media_unreadable_error("Unable to open " + to_string(uri));
-        }
-
-        if (not cache_.count(uri))
-            cache_[uri] = pdf;
-    }
+    const auto path = uri_to_posix_path(uri);
 
-    frame_count     = pdf->pageCount();
-    auto point_size = pdf->pagePointSize(0);
-    auto width      = points_to_pixels(point_size.width());
-    auto height     = points_to_pixels(point_size.height());
+    auto &cache      = PDFRenderCache::instance();
+    auto frame_count = cache.document(path)->page_count_;
+    auto size        = cache.page_size(path, 0, dpi_);
+    auto width       = size.width();
+    auto height      = size.height();
 
     streams.emplace_back(
         media::StreamDetail(
@@ -148,93 +157,79 @@ media::MediaDetail PDFMediaReader::detail(const caf::uri &uri) const {
 ImageBufPtr PDFMediaReader::image(const media::AVFrameID &mptr) {
     ImageBufPtr buf;
 
-    std::shared_ptr<QPdfDocument> pdf;
-
-    if (cache_.count(mptr.uri()))
-        pdf = cache_[mptr.uri()];
-    else {
-        pdf = std::make_shared<QPdfDocument>();
-        if (auto loaded = pdf->load(QStringFromStd(uri_to_posix_path(mptr.uri())));
-            loaded != QPdfDocument::Error::None) {
-            throw media_unreadable_error("Unable to open " + to_string(mptr.uri()));
-        }
-        if (not cache_.count(mptr.uri()))
-            cache_[mptr.uri()] = pdf;
+    const auto path  = uri_to_posix_path(mptr.uri());
+    const bool alpha = mptr.stream_id() != "Pages RGB";
+
+    auto &cache       = PDFRenderCache::instance();
+    const auto size   = cache.page_size(path, mptr.frame(), dpi_);
+    const auto width  = size.width();
+    const auto height = size.height();
+
+    // If the page isn't rendered yet we return the draft render (made now if
+    // the read ahead hasn't made it) scaled up, and render the page in the
+    // background. Reading the page again waits for that.
+    auto image       = cache.cached_page(path, mptr.frame(), size, alpha);
+    const bool draft = image.isNull() && draft_dpi_ && draft_dpi_ < dpi_ &&
+                       !cache.rendering(path, mptr.frame(), size, alpha);
+    if (draft) {
+        const auto draft_size = cache.page_size(path, mptr.frame(), draft_dpi_);
+        cache.render_soon(path, mptr.frame(), size, alpha);
+        image = cache.page(path, mptr.frame(), draft_size, alpha)
+                    .scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation)
+                    .convertToFormat(alpha ? QImage::Format_RGBA8888 : QImage::Format_RGB888);
+    } else if (image.isNull()) {
+        image = cache.page(path, mptr.frame(), size, alpha);
     }
 
-    const auto stream_id = mptr.stream_id();
-
-    auto point_size = pdf->pagePointSize(mptr.frame());
-    auto width      = points_to_pixels(point_size.width());
-    auto height     = points_to_pixels(point_size.height());
-
-    if (stream_id == "Pages RGB") {
-        auto image =
-            pdf->render(mptr.frame(), QSize(width, height), QPdfDocumentRenderOptions());
-
-        image.convertTo(QImage::Format_RGB888);
-
-        JsonStore jsn;
-        jsn["width"]  = width;
-        jsn["height"] = height;
-
-        buf.reset(new ImageBuffer(myshader_uuid, jsn));
-        buf->allocate(width * height * 3);
-        buf->set_shader(pdf_shader);
-        buf->set_image_dimensions(Imath::V2i(width, height));
-
-        byte *buffer = buf->buffer();
+    // get the pages either side rendering while this one is viewed
+    cache.read_ahead(path, mptr.frame(), read_ahead_, dpi_, draft_dpi_, alpha);
 
-        std::memcpy((char *)buffer, image.constBits(), width * height * 3);
-    } else {
-        auto image =
-            pdf->render(mptr.frame(), QSize(width, height), QPdfDocumentRenderOptions());
+    JsonStore jsn;
+    jsn["width"]  = width;
+    jsn["height"] = height;
 
-        image.convertTo(QImage::Format_RGBA8888);
-
-        JsonStore jsn;
-        jsn["width"]  = width;
-        jsn["height"] = height;
+    const size_t bytes_per_pixel = alpha ? 4 : 3;
 
+    if (alpha) {
         buf.reset(new ImageBuffer(myshader_transparent_uuid, jsn));
-        buf->allocate(width * height * 4);
         buf->set_shader(pdf_shader_transparent);
-        buf->set_image_dimensions(Imath::V2i(width, height));
-
-        byte *buffer = buf->buffer();
-
-        std::memcpy((char *)buffer, image.constBits(), width * height * 4);
+    } else {
+        buf.reset(new ImageBuffer(myshader_uuid, jsn));
+        buf->set_shader(pdf_shader);
     }
+    buf->allocate(width * height * bytes_per_pixel);
+    buf->set_image_dimensions(Imath::V2i(width, height));
+    buf->set_draft(draft);
+
+    copy_pixels(image, (char *)buf->buffer(), width * bytes_per_pixel, height);
 
     return buf;
 }
 
 std::shared_ptr<thumbnail::ThumbnailBuffer>
 PDFMediaReader::thumbnail(const media::AVFrameID &mptr, const size_t thumb_size) {
-    try {
-        auto pdf = std::make_shared<QPdfDocument>();
-
-        if (auto loaded = pdf->load(QStringFromStd(uri_to_posix_path(mptr.uri())));
-            loaded != QPdfDocument::Error::None) {
-            throw media_unreadable_error("Unable to open " + to_string(mptr.uri()));
-        }
-
-        auto point_size = pdf->pagePointSize(mptr.frame());
-        auto ratio      = point_size.width() / point_size.height();
-        auto height     = (static_cast<uint32_t>(thumb_size / ratio) / 32) * 32;
-
-        auto image =
-            pdf->render(mptr.frame(), QSize(thumb_size, height), QPdfDocumentRenderOptions());
-        auto thumb = std::make_shared<thumbnail::ThumbnailBuffer>(
-            thumb_size, height, thumbnail::TF_RGB24);
-
-        image.convertTo(QImage::Format_RGB888);
-        std::memcpy((char *)(thumb->data().data()), image.constBits(), thumb_size * height * 3);
-
-        return thumb;
-    } catch ([[maybe_unused]] std::exception &e) {
-        throw;
-    }
+    const auto path = uri_to_posix_path(mptr.uri());
+    auto &cache     = PDFRenderCache::instance();
+
+    const auto point_size = cache.document(path)->page_points_.at(mptr.frame());
+    auto ratio            = point_size.width() / point_size.height();
+    auto height = (static_cast<uint32_t>(thumb_size / ratio) / 32) * 32;
+
+    // scale down a draft (or full) render if we have one already, they are
+    // made by the read ahead
+    auto image = cache.cached_page(path, mptr.frame(), thumb_size, false);
+    if (image.isNull())
+        image = cache.page(path, mptr.frame(), QSize(thumb_size, height), false);
+    else
+        image =
+            image.scaled(thumb_size, height, Qt::IgnoreAspectRatio, Qt::SmoothTransformation)
+                .convertToFormat(QImage::Format_RGB888);
+
+    auto thumb =
+        std::make_shared<thumbnail::ThumbnailBuffer>(thumb_size, height, thumbnail::TF_RGB24);
+    copy_pixels(image, (char *)(thumb->data().data()), thumb_size * 3, height);
+
+    return thumb;
 }
 
 std::vector<std::string> PDFMediaReader::supported_extensions() const {
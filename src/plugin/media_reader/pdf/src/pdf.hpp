@@ -2,7 +2,6 @@
 #pragma once
 
 #include <string>
-#include <QPdfDocument>
 
 #include "xstudio/media_reader/media_reader.hpp"
 #include "xstudio/utility/helpers.hpp"
@@ -30,10 +29,9 @@ class PDFMediaReader : public MediaReader {
     thumbnail(const media::AVFrameID &mptr, const size_t thumb_size) override;
 
   private:
-    [[nodiscard]] uint64_t points_to_pixels(const double points) const;
     uint32_t dpi_{100};
+    uint32_t draft_dpi_{36};
+    int read_ahead_{4};
     utility::JsonStore supported_;
-
-    mutable std::map<caf::uri, std::shared_ptr<QPdfDocument>> cache_;
 };
 } // namespace xstudio::media_reader
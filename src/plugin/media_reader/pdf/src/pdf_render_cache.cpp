@@ -0,0 +1,358 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+#include <fmt/format.h>
+
+#include "pdf_render_cache.hpp"
+#include "xstudio/media/media_error.hpp"
+#include "xstudio/utility/logging.hpp"
+
+namespace fs = std::filesystem;
+
+using namespace xstudio::media_reader;
+using namespace xstudio;
+
+namespace {
+
+int points_to_pixels(const double points, const uint32_t dpi) {
+    const auto value = static_cast<uint64_t>((points / 72.0) * dpi);
+    return std::max(32, static_cast<int>((value / 32) * 32));
+}
+
+std::unique_ptr<QPdfDocument> open_pdf(const std::string &path) {
+    auto pdf = std::make_unique<QPdfDocument>();
+    if (pdf->load(QString::fromStdString(path)) != QPdfDocument::Error::None)
+        throw media_unreadable_error("Unable to open " + path);
+    return pdf;
+}
+
+} // namespace
+
+PDFRenderCache::PDFRenderCache() { pool_.setMaxThreadCount(4); }
+
+PDFRenderCache &PDFRenderCache::instance() {
+    // never destroyed, background renders may still be running at exit
+    static auto *cache = new PDFRenderCache();
+    return *cache;
+}
+
+std::shared_ptr<PDFRenderCache::Document> PDFRenderCache::document(const std::string &path) {
+
+    std::error_code ec;
+    const auto mtime = fs::last_write_time(path, ec);
+
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        auto p = documents_.find(path);
+        if (p != documents_.end()) {
+            if (p->second->mtime_ == mtime) {
+                p->second->last_used_ = ++usage_counter_;
+                return p->second;
+            }
+            // changed on disk, forget it and everything rendered from it
+            documents_.erase(p);
+            drop_pages(path);
+        }
+    }
+
+    // parse outside the lock, this is the slow bit for big documents
+    auto doc         = std::make_shared<Document>();
+    auto pdf         = open_pdf(path);
+    doc->mtime_      = mtime;
+    doc->page_count_ = pdf->pageCount();
+    doc->page_points_.reserve(doc->page_count_);
+    for (int page = 0; page < doc->page_count_; ++page)
+        doc->page_points_.push_back(pdf->pagePointSize(page));
+    doc->idle_.push_back(std::move(pdf));
+    doc->instances_ = 1;
+
+    std::lock_guard<std::mutex> l(mutex_);
+
+    // another reader may have beaten us to it
+    auto p = documents_.try_emplace(path, doc).first;
+    p->second->last_used_ = ++usage_counter_;
+
+    while (documents_.size() > max_documents_) {
+        auto oldest = std::min_element(
+            documents_.begin(), documents_.end(), [](const auto &a, const auto &b) {
+                return a.second->last_used_ < b.second->last_used_;
+            });
+        drop_pages(oldest->first);
+        documents_.erase(oldest);
+    }
+
+    return p->second;
+}
+
+QSize PDFRenderCache::page_size(const std::string &path, const int page, const uint32_t dpi) {
+    auto doc = document(path);
+    if (page < 0 || page >= doc->page_count_)
+        throw media_corrupt_error(fmt::format("No page {} in {}", page, path));
+
+    const auto &points = doc->page_points_[page];
+    return QSize(points_to_pixels(points.width(), dpi), points_to_pixels(points.height(), dpi));
+}
+
+QImage PDFRenderCache::page(
+    const std::string &path, const int page, const QSize &size, const bool alpha) {
+
+    const PageKey key(path, page, alpha, size.width(), size.height());
+    std::shared_future<QImage> pending;
+    std::promise<QImage> promise;
+
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        auto p = pages_.find(key);
+        if (p != pages_.end()) {
+            p->second.last_used_ = ++usage_counter_;
+            return p->second.image_;
+        }
+        auto r = rendering_.find(key);
+        if (r != rendering_.end())
+            pending = r->second;
+        else
+            rendering_[key] = promise.get_future().share();
+    }
+
+    // rethrows if the other render failed
+    if (pending.valid())
+        return pending.get();
+
+    try {
+        auto doc   = document(path);
+        auto image = render(key, doc);
+        promise.set_value(image);
+        store(key, image, doc);
+        return image;
+    } catch (...) {
+        promise.set_exception(std::current_exception());
+        std::lock_guard<std::mutex> l(mutex_);
+        rendering_.erase(key);
+        throw;
+    }
+}
+
+QImage PDFRenderCache::cached_page(
+    const std::string &path, const int page, const QSize &size, const bool alpha) {
+
+    std::lock_guard<std::mutex> l(mutex_);
+    auto p = pages_.find(PageKey(path, page, alpha, size.width(), size.height()));
+    if (p == pages_.end())
+        return QImage();
+
+    p->second.last_used_ = ++usage_counter_;
+    return p->second.image_;
+}
+
+bool PDFRenderCache::rendering(
+    const std::string &path, const int page, const QSize &size, const bool alpha) {
+
+    const PageKey key(path, page, alpha, size.width(), size.height());
+    std::lock_guard<std::mutex> l(mutex_);
+    return rendering_.count(key) || queued_.count(key);
+}
+
+void PDFRenderCache::render_soon(
+    const std::string &path, const int page, const QSize &size, const bool alpha) {
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        current_page_[path] = page;
+    }
+    queue_render(
+        PageKey(path, page, alpha, size.width(), size.height()),
+        std::numeric_limits<int>::max(),
+        2);
+}
+
+QImage PDFRenderCache::cached_page(
+    const std::string &path, const int page, const int min_width, const bool alpha) {
+
+    std::lock_guard<std::mutex> l(mutex_);
+    auto p = pages_.lower_bound(PageKey(path, page, alpha, min_width, 0));
+    if (p == pages_.end() || std::get<0>(p->first) != path || std::get<1>(p->first) != page ||
+        std::get<2>(p->first) != alpha)
+        return QImage();
+
+    p->second.last_used_ = ++usage_counter_;
+    return p->second.image_;
+}
+
+void PDFRenderCache::read_ahead(
+    const std::string &path,
+    const int page,
+    const int count,
+    const uint32_t dpi,
+    const uint32_t draft_dpi,
+    const bool alpha) {
+
+    if (count <= 0)
+        return;
+
+    auto doc = document(path);
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        current_page_[path] = page;
+    }
+
+    // nearest pages first, alternating either side of the current page
+    std::vector<int> pages;
+    for (int offset = 1; offset <= count; ++offset) {
+        if (page + offset < doc->page_count_)
+            pages.push_back(page + offset);
+        if (page - offset >= 0)
+            pages.push_back(page - offset);
+    }
+
+    // draft pass runs first, it's cheap and gives us thumbnails
+    if (draft_dpi && draft_dpi < dpi) {
+        for (const auto p : pages) {
+            const auto size = page_size(path, p, draft_dpi);
+            queue_render(PageKey(path, p, alpha, size.width(), size.height()), count, 1);
+        }
+    }
+
+    for (const auto p : pages) {
+        const auto size = page_size(path, p, dpi);
+        queue_render(PageKey(path, p, alpha, size.width(), size.height()), count, 0);
+    }
+}
+
+void PDFRenderCache::set_limits(
+    const size_t max_documents, const size_t max_bytes, const int threads) {
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        max_documents_ = std::max(size_t(1), max_documents);
+        max_bytes_     = max_bytes;
+    }
+    pool_.setMaxThreadCount(std::max(1, threads));
+    max_instances_ = std::max(1, threads) + 1;
+}
+
+QImage PDFRenderCache::render(const PageKey &key, const std::shared_ptr<Document> &doc) {
+
+    const auto &[path, page, alpha, width, height] = key;
+
+    auto pdf   = acquire(*doc, path);
+    auto image = pdf->render(page, QSize(width, height), QPdfDocumentRenderOptions());
+    release(*doc, std::move(pdf));
+
+    if (image.isNull())
+        throw media_corrupt_error(fmt::format("Unable to render page {} of {}", page, path));
+
+    image.convertTo(alpha ? QImage::Format_RGBA8888 : QImage::Format_RGB888);
+    return image;
+}
+
+std::unique_ptr<QPdfDocument> PDFRenderCache::acquire(Document &doc, const std::string &path) {
+
+    std::unique_lock<std::mutex> l(doc.mutex_);
+    doc.released_.wait(
+        l, [&]() { return !doc.idle_.empty() || doc.instances_ < max_instances_; });
+
+    if (!doc.idle_.empty()) {
+        auto pdf = std::move(doc.idle_.back());
+        doc.idle_.pop_back();
+        return pdf;
+    }
+
+    // open another instance, outside the lock so others can be released
+    doc.instances_++;
+    l.unlock();
+    try {
+        return open_pdf(path);
+    } catch (...) {
+        l.lock();
+        doc.instances_--;
+        doc.released_.notify_one();
+        throw;
+    }
+}
+
+void PDFRenderCache::release(Document &doc, std::unique_ptr<QPdfDocument> pdf) {
+    {
+        std::lock_guard<std::mutex> l(doc.mutex_);
+        doc.idle_.push_back(std::move(pdf));
+    }
+    doc.released_.notify_one();
+}
+
+void PDFRenderCache::store(
+    const PageKey &key, const QImage &image, const std::shared_ptr<Document> &doc) {
+
+    std::lock_guard<std::mutex> l(mutex_);
+    rendering_.erase(key);
+
+    // document was dropped, or the file changed and was re-loaded, while we
+    // were rendering
+    auto d = documents_.find(std::get<0>(key));
+    if (d == documents_.end() || d->second != doc)
+        return;
+
+    auto &entry = pages_[key];
+    bytes_ -= entry.image_.sizeInBytes();
+    entry.image_     = image;
+    entry.last_used_ = ++usage_counter_;
+    bytes_ += image.sizeInBytes();
+
+    while (bytes_ > max_bytes_ && pages_.size() > 1) {
+        auto oldest = std::min_element(
+            pages_.begin(), pages_.end(), [](const auto &a, const auto &b) {
+                return a.second.last_used_ < b.second.last_used_;
+            });
+        bytes_ -= oldest->second.image_.sizeInBytes();
+        pages_.erase(oldest);
+    }
+}
+
+void PDFRenderCache::drop_pages(const std::string &path) {
+    // caller holds mutex_
+    for (auto p = pages_.begin(); p != pages_.end();) {
+        if (std::get<0>(p->first) == path) {
+            bytes_ -= p->second.image_.sizeInBytes();
+            p = pages_.erase(p);
+        } else
+            ++p;
+    }
+    current_page_.erase(path);
+}
+
+void PDFRenderCache::queue_render(const PageKey &key, const int count, const int priority) {
+
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        if (pages_.count(key) || rendering_.count(key) || queued_.count(key))
+            return;
+        queued_.insert(key);
+    }
+
+    pool_.start(
+        [this, key, count]() {
+            const auto &path = std::get<0>(key);
+            const auto page  = std::get<1>(key);
+            {
+                std::lock_guard<std::mutex> l(mutex_);
+                // skip it if the document was dropped or the viewer has moved
+                // away from this part of it since it was queued
+                auto c = current_page_.find(path);
+                if (c == current_page_.end() || std::abs(page - c->second) > count) {
+                    queued_.erase(key);
+                    return;
+                }
+            }
+            try {
+                this->page(
+                    path,
+                    page,
+                    QSize(std::get<3>(key), std::get<4>(key)),
+                    std::get<2>(key));
+            } catch (const std::exception &e) {
+                spdlog::debug("{} {}", __PRETTY_FUNCTION__, e.what());
+            }
+            // only now, so that rendering() is true until it's stored
+            std::lock_guard<std::mutex> l(mutex_);
+            queued_.erase(key);
+        },
+        priority);
+}
@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <QImage>
+#include <QPdfDocument>
+#include <QSize>
+#include <QSizeF>
+#include <QThreadPool>
+
+namespace xstudio::media_reader {
+
+/**
+ *  @brief Process wide cache of open PDF documents and rendered pages, shared
+ *  by every PDFMediaReader instance (there is one per reader actor).
+ *
+ *  @details Documents are parsed once and reused until the file changes on
+ *  disk. QPdfDocument isn't thread safe, so each document keeps a small pool
+ *  of instances and a render takes one to itself, letting pages of the same
+ *  document render in parallel. Rendered pages are kept up to a memory
+ *  budget. Around the page being viewed, the pages either side of it are
+ *  rasterised on a thread pool, first at a low 'draft' dpi (a stand in while
+ *  the full render is made, and used for thumbnails) and then at the full
+ *  dpi, so stepping through a document finds the next pages already
+ *  rendered.
+ */
+class PDFRenderCache {
+  public:
+    struct Document {
+        std::filesystem::file_time_type mtime_;
+        int page_count_ = {0};
+        // page sizes in points, read when the document is loaded
+        std::vector<QSizeF> page_points_;
+        uint64_t last_used_ = {0};
+
+        // idle QPdfDocument instances, and how many there are in all
+        std::mutex mutex_;
+        std::condition_variable released_;
+        std::vector<std::unique_ptr<QPdfDocument>> idle_;
+        int instances_ = {0};
+    };
+
+    static PDFRenderCache &instance();
+
+    // The document at path, loaded if it isn't open yet or has changed on
+    // disk. Throws media_unreadable_error if it can't be loaded.
+    std::shared_ptr<Document> document(const std::string &path);
+
+    // Size in pixels of a page at the given dpi, rounded down to a multiple
+    // of 32
+    QSize page_size(const std::string &path, const int page, const uint32_t dpi);
+
+    // Page rendered at size, converted to RGB888 (or RGBA8888 if alpha). If
+    // the page is already rendered the cached image is returned. If it is
+    // being rendered in the background we wait for that. Otherwise it is
+    // rendered in the calling thread.
+    QImage
+    page(const std::string &path, const int page, const QSize &size, const bool alpha);
+
+    // The cached render of the page at size, or a null QImage
+    QImage
+    cached_page(const std::string &path, const int page, const QSize &size, const bool alpha);
+
+    // True if the page is queued or being rendered at size
+    bool
+    rendering(const std::string &path, const int page, const QSize &size, const bool alpha);
+
+    // Queue a background render of the page at size ahead of any read
+    // ahead work
+    void
+    render_soon(const std::string &path, const int page, const QSize &size, const bool alpha);
+
+    // The smallest cached render of the page that is at least min_width
+    // wide, or a null QImage
+    QImage cached_page(
+        const std::string &path, const int page, const int min_width, const bool alpha);
+
+    // Queue background renders of the 'count' pages either side of 'page',
+    // nearest first. All of them at draft_dpi first (skipped if draft_dpi
+    // is 0), then at dpi.
+    void read_ahead(
+        const std::string &path,
+        const int page,
+        const int count,
+        const uint32_t dpi,
+        const uint32_t draft_dpi,
+        const bool alpha);
+
+    void set_limits(const size_t max_documents, const size_t max_bytes, const int threads);
+
+  private:
+    PDFRenderCache();
+
+    // path, page, alpha, width, height
+    typedef std::tuple<std::string, int, bool, int, int> PageKey;
+
+    struct Page {
+        QImage image_;
+        uint64_t last_used_ = {0};
+    };
+
+    QImage render(const PageKey &key, const std::shared_ptr<Document> &doc);
+    // take a QPdfDocument instance for a render, opening another one if they
+    // are all busy and there are fewer than max_instances_
+    std::unique_ptr<QPdfDocument> acquire(Document &doc, const std::string &path);
+    void release(Document &doc, std::unique_ptr<QPdfDocument> pdf);
+    // cache a render, unless doc has since been replaced by a newer version
+    // of the file
+    void
+    store(const PageKey &key, const QImage &image, const std::shared_ptr<Document> &doc);
+    void drop_pages(const std::string &path);
+    // Renders are skipped if the viewer has moved more than 'count' pages
+    // away by the time they run
+    void queue_render(const PageKey &key, const int count, const int priority);
+
+    std::mutex mutex_;
+    std::map<std::string, std::shared_ptr<Document>> documents_;
+    std::map<PageKey, Page> pages_;
+    std::map<PageKey, std::shared_future<QImage>> rendering_;
+    std::set<PageKey> queued_;
+    std::map<std::string, int> current_page_;
+
+    uint64_t usage_counter_ = {0};
+    size_t bytes_           = {0};
+    size_t max_documents_   = {8};
+    size_t max_bytes_       = {size_t(512) * 1024 * 1024};
+    // QPdfDocument instances per document, one per render thread and one
+    // for the readers
+    std::atomic<int> max_instances_ = {5};
+
+    QThreadPool pool_;
+};
+
+} // namespace xstudio::media_reader
@@ -1,10 +1,13 @@
 // SPDX-License-Identifier: Apache-2.0
+#include <algorithm>
 #include <exception>
 #include <filesystem>
 
 #include <fstream>
 #include <iostream>
+#include <optional>
 #include <sstream>
+#include <streambuf>
 #include <string>
 #include <vector>
 
@@ -59,13 +62,36 @@ vec4 fetch_rgba_pixel(ivec2 image_coord)
 static ui::viewport::GPUShaderPtr
     ppm_shader(new ui::opengl::OpenGLShader(myshader_uuid, myshader));
 
+// reads the bytes of a file read ahead, in place
+struct MemoryBuffer : public std::streambuf {
+    MemoryBuffer(const char *data, const size_t size) {
+        auto begin = const_cast<char *>(data);
+        setg(begin, begin, begin + size);
+    }
+};
+
 } // namespace
 
 ImageBufPtr PPMMediaReader::image(const media::AVFrameID &mptr) {
     ImageBufPtr buf;
 
-    std::ifstream inp(uri_to_posix_path(mptr.uri()), std::ios::in | std::ios::binary);
-    if (inp.is_open()) {
+    const auto path = uri_to_posix_path(mptr.uri());
+
+    // from the file read ahead by the precache pipeline if it was
+    std::istream inp(nullptr);
+    std::ifstream file;
+    std::optional<MemoryBuffer> memory;
+    const auto bytes = FrameFileReader::instance().take(path);
+    if (bytes) {
+        memory.emplace(bytes->data(), bytes->size());
+        inp.rdbuf(&(*memory));
+    } else {
+        file.open(path, std::ios::in | std::ios::binary);
+        if (file.is_open())
+            inp.rdbuf(file.rdbuf());
+    }
+
+    if (inp.rdbuf()) {
         size_t width;
         size_t height;
         size_t max_col_val;
@@ -114,7 +140,6 @@ ImageBufPtr PPMMediaReader::image(const media::AVFrameID &mptr) {
 
         byte *buffer = buf->buffer();
         inp.read((char *)buffer, size * bytes_per_pixel);
-        inp.close();
 
     } else {
         throw media_unreadable_error("Unable to open " + to_string(mptr.uri()));
@@ -123,6 +148,51 @@ ImageBufPtr PPMMediaReader::image(const media::AVFrameID &mptr) {
     return buf;
 }
 
+/*
+ * Row at a time decode for CPU side image analysis. Samples are interleaved
+ * RGB, 16 bit ones most significant byte first as in the file.
+ */
+void PPMMediaReader::ppm_buffer_pixel_unpack(
+    const ImageBuffer &buf,
+    const utility::JsonStore &pixel_unpack_uniforms,
+    const int x,
+    const int y,
+    const int count,
+    float *rgba) {
+
+    std::fill(rgba, rgba + 4 * count, 0.0f);
+
+    const int width             = pixel_unpack_uniforms.value("width", 0);
+    const int height            = pixel_unpack_uniforms.value("height", 0);
+    const int bytes_per_channel = pixel_unpack_uniforms.value("bytes_per_channel", 0);
+    const int bytes_per_pixel   = 3 * bytes_per_channel;
+
+    if ((bytes_per_channel != 1 and bytes_per_channel != 2) or y < 0 or y >= height)
+        return;
+
+    const int x0 = std::max(x, 0);
+    const int x1 = std::min(x + count, width);
+    if (x1 <= x0)
+        return;
+
+    const size_t offset = (size_t(y) * width + x0) * bytes_per_pixel;
+    if (offset + size_t(x1 - x0) * bytes_per_pixel > buf.size())
+        return;
+
+    const auto *src = reinterpret_cast<const uint8_t *>(buf.buffer()) + offset;
+    float *dst      = rgba + 4 * (x0 - x);
+    for (int i = x0; i < x1; ++i, dst += 4) {
+        if (bytes_per_channel == 1) {
+            for (int c = 0; c < 3; ++c)
+                dst[c] = float(*src++) / 255.0f;
+        } else {
+            for (int c = 0; c < 3; ++c, src += 2)
+                dst[c] = float((src[0] << 8) | src[1]) / 65535.0f;
+        }
+        dst[3] = 1.0f;
+    }
+}
+
 std::vector<std::string> PPMMediaReader::supported_extensions() const {
     auto result = std::vector<std::string>();
 
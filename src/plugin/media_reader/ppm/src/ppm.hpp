@@ -3,6 +3,7 @@
 
 #include <string>
 
+#include "xstudio/media_reader/frame_file_reader.hpp"
 #include "xstudio/media_reader/media_reader.hpp"
 #include "xstudio/utility/helpers.hpp"
 #include "xstudio/utility/logging.hpp"
@@ -18,6 +19,7 @@ class PPMMediaReader : public MediaReader {
         } catch (const std::exception &e) {
             spdlog::warn("{} {}", __PRETTY_FUNCTION__, e.what());
         }
+        FrameFileReader::instance().add_reader(name());
     }
     virtual ~PPMMediaReader() = default;
 
@@ -29,7 +31,19 @@ class PPMMediaReader : public MediaReader {
     // media::MediaDetail detail(const caf::uri &uri) const override;
     [[nodiscard]] utility::Uuid plugin_uuid() const override;
 
+    [[nodiscard]] ImageBuffer::PixelUnpackFunc pixel_unpack_func() const override {
+        return &PPMMediaReader::ppm_buffer_pixel_unpack;
+    }
+
   private:
+    static void ppm_buffer_pixel_unpack(
+        const ImageBuffer &buf,
+        const utility::JsonStore &pixel_unpack_uniforms,
+        const int x,
+        const int y,
+        const int count,
+        float *rgba);
+
     utility::JsonStore supported_;
 };
 } // namespace xstudio::media_reader
@@ -20,6 +20,11 @@ try:
 except ImportError:
     fileseq = None
 
+try:
+    from xstudio.core import DirectoryScanner
+except ImportError:
+    DirectoryScanner = None
+
 class FileScanner:
     def __init__(self, config=None):
         self.config = config or {}
@@ -29,6 +34,9 @@ class FileScanner:
         self.version_regex = re.compile(self.config.get("version_regex", r"_v(\d+)"))
         self.max_workers = self.config.get("thread_count", 4)
         self.max_depth = self.config.get("max_depth", 6)
+        # use the C++ scanner engine when we're running inside xstudio
+        self.use_native = self.config.get("native", True) and DirectoryScanner is not None
+        self.native_scanner = None
         
         self.cancel_event = threading.Event()
         self.executor = ThreadPoolExecutor(max_workers=self.max_workers)
@@ -61,7 +69,10 @@ class FileScanner:
         callback(results, scanned_dir, progress_info) is called periodically.
         """
         self.cancel_event.clear()
-        
+
+        if self.use_native:
+            return self._scan_native(start_path, callback)
+
         from collections import deque
         from concurrent.futures import wait, FIRST_COMPLETED
 
@@ -155,6 +166,112 @@ class FileScanner:
             
         return all_items
 
+    def _scan_native(self, start_path, callback=None):
+        """
+        As scan(), but the directory tree is read by the native scanner engine,
+        which also collapses the files in each directory into sequences.
+        """
+        self.native_scanner = DirectoryScanner(
+            max_depth=self.max_depth,
+            thread_count=self.max_workers,
+            extensions=list(self.extensions),
+            ignore_directories=list(self.ignore_dirs))
+
+        all_items = []
+        scanned_count = 0
+        recent_scanned_dirs = []
+        last_update = time.time()
+
+        def on_directory(result, progress):
+            nonlocal scanned_count, recent_scanned_dirs, last_update
+
+            items = self._native_items(result, start_path)
+            all_items.extend(items)
+            scanned_count += len(items)
+            recent_scanned_dirs.append(result["path"])
+
+            if not callback:
+                return
+
+            callback(items, result["path"], result["index_path"], {
+                "scanned": scanned_count,
+                "progress": progress["progress"] * 100,
+                "phase": "scanning",
+                "scanned_dirs": []})
+
+            if time.time() - last_update > 0.2:
+                callback([], "", [], {
+                    "scanned": scanned_count,
+                    "progress": min(100, int(progress["progress"] * 100)),
+                    "phase": "scanning",
+                    "scanned_dirs": list(recent_scanned_dirs)})
+                recent_scanned_dirs = []
+                last_update = time.time()
+
+        completed = self.native_scanner.scan(start_path, on_directory)
+
+        if completed and not self.cancel_event.is_set() and callback:
+            callback([], "", [], {"scanned": scanned_count, "progress": 100, "phase": "complete", "scanned_dirs": list(recent_scanned_dirs)})
+
+        return all_items
+
+    def _native_items(self, result, start_path):
+        """Convert a directory result from the native scanner into items."""
+        from types import SimpleNamespace
+
+        depth = result["depth"]
+        items = []
+
+        for p in result["subdirectories"]:
+            try:
+                items.append(self._make_item(p, os.path.basename(p), os.stat(p), start_path, is_directory=True, depth=depth))
+            except OSError:
+                pass
+
+        for seq in result["sequences"]:
+            st = SimpleNamespace(st_size=seq["apparent_size"], st_mtime=seq["mtime"], st_uid=seq["uid"])
+            dirname, basename = os.path.split(seq["name"])
+
+            if not seq["is_sequence"]:
+                items.append(self._make_item(seq["name"], basename, st, start_path, depth=depth))
+                continue
+
+            # names are printf style, shot.%04d.exr, %00d when the padding is unknown
+            m = re.search(r"%0(\d+)d", basename)
+            pad_len = int(m.group(1)) if m else 0
+            prefix, suffix = (basename[:m.start()], basename[m.end():]) if m else (basename, "")
+            name = (prefix + "@" * (pad_len or 4) + suffix).replace("%%", "%")
+            brace_padding = f"{{:0{pad_len}d}}" if pad_len > 0 else "{:d}"
+            ext = os.path.splitext(basename)[1]
+
+            match = self.version_regex.search(name)
+            if match:
+                span = match.span()
+                version_stream_key = name[:span[0]] + name[span[1]:]
+            else:
+                version_stream_key = name
+
+            items.append({
+                "name": name,
+                "path": os.path.join(dirname, (prefix + brace_padding + suffix).replace("%%", "%")) + "=" + seq["frames"],
+                "relpath": os.path.relpath(seq["name"], start_path),
+                "thumbnailFrame": seq["name"] % seq["middle_frame"],
+                "type": "Sequence",
+                "frames": seq["frames"],
+                "size": seq["apparent_size"],
+                "size_str": self.format_size_str(seq["apparent_size"]),
+                "date": seq["mtime"],
+                "date_string": datetime.fromtimestamp(seq["mtime"]).strftime("%Y-%m-%d %H:%M:%S"),
+                "owner": self.get_owner(seq["uid"]),
+                "extension": ext,
+                "is_sequence": True,
+                "is_folder": False,
+                "version_stream_key": version_stream_key,
+                "depth": depth
+            })
+
+        return self._group_versions(items)
+
     def _scan_and_process_worker(self, path, root_path, weight, depth, index_path_in_tree):
         """
         Scans a directory, processes files therein, returns (subdirs, items, weight, depth, path).
@@ -489,6 +606,8 @@ class FileScanner:
 
     def stop(self):
         self.cancel_event.set()
+        if self.native_scanner:
+            self.native_scanner.cancel()
 
     def shutdown(self):
         """Release the ThreadPoolExecutor. Call after stop() when the scanner is no longer needed."""
@@ -1,6 +1,8 @@
 // SPDX-License-Identifier: Apache-2.0
 #include <caf/actor_registry.hpp>
 
+#include <fmt/format.h>
+
 #include "audio_waveform_overlay.hpp"
 #include "xstudio/plugin_manager/plugin_base.hpp"
 #include "xstudio/media_reader/image_buffer.hpp"
@@ -20,6 +22,10 @@ using namespace xstudio;
 using namespace xstudio::ui::viewport;
 
 namespace {
+
+// peaks drawn across the waveform window when drawing from the summaries
+constexpr int peak_columns = 1024;
+constexpr size_t max_cached_peaks = 64;
 const char *vertex_shader = R"(
     #version 330 core
     layout (location = 0) in float ypos;
@@ -303,7 +309,7 @@ utility::BlindDataObjectPtr AudioWaveformOverlay::onscreen_render_data(
 
     auto p = latest_audio_buffers_.find(playhead_uuid);
     if (p == latest_audio_buffers_.end())
-        return r;
+        return peaks_render_data(image);
     const auto &latest_audio_buffers = p->second;
 
     // check our sample buffers to get sample rate & num channels
@@ -320,7 +326,7 @@ utility::BlindDataObjectPtr AudioWaveformOverlay::onscreen_render_data(
     }
 
     if (!sample_rate)
-        return r;
+        return peaks_render_data(image);
 
     // the number of samples we need depends on the audio scurbbing duration and
     // horizontal_scale_
@@ -402,6 +408,134 @@ utility::BlindDataObjectPtr AudioWaveformOverlay::onscreen_render_data(
     return r;
 }
 
+void AudioWaveformOverlay::images_going_on_screen(
+    const media_reader::ImageBufDisplaySetPtr &images,
+    const std::string /*viewport_name*/,
+    const bool /*playhead_playing*/) {
+
+    if (visible() and images and images->hero_image())
+        request_peaks(images->hero_image());
+}
+
+std::string AudioWaveformOverlay::peaks_key(const media::AVFrameID &frame_id) const {
+    return fmt::format(
+        "{}/{}/{}/{}",
+        to_string(frame_id.source_uuid()),
+        frame_id.frame(),
+        horizontal_scale_->value(),
+        separate_channels_->value());
+}
+
+void AudioWaveformOverlay::request_peaks(const media_reader::ImageBufPtr &image) {
+
+    const auto &frame_id = image.frame_id();
+    auto source          = caf::actor_cast<caf::actor>(frame_id.media_source_addr());
+    if (!source)
+        return;
+
+    const auto key = peaks_key(frame_id);
+    if (peaks_.count(key) or peaks_pending_.count(key))
+        return;
+
+    if (!media_reader_)
+        media_reader_ = system().registry().template get<caf::actor>(media_reader_registry);
+    if (!media_reader_)
+        return;
+
+    // the window is centred on the middle of the frame, as when drawing from
+    // the audio buffers
+    const double frame  = double(frame_id.frame() - frame_id.first_frame()) + 0.5;
+    const double start  = frame - horizontal_scale_->value() * 0.5;
+    const double end    = frame + horizontal_scale_->value() * 0.5;
+    const bool separate = separate_channels_->value();
+    peaks_pending_.insert(key);
+
+    mail(media_reader::audio_waveform_atom_v, source, start, end, peak_columns, -1)
+        .request(media_reader_, infinite)
+        .then(
+            [=](const utility::JsonStore &mixed) {
+                const int nc = mixed.value("num_channels", 0);
+                if (!separate or nc < 2) {
+                    store_peaks(key, {mixed});
+                    return;
+                }
+
+                auto channels  = std::make_shared<std::vector<utility::JsonStore>>(nc);
+                auto remaining = std::make_shared<int>(nc);
+                for (int c = 0; c < nc; ++c) {
+                    mail(media_reader::audio_waveform_atom_v,
+                         source,
+                         start,
+                         end,
+                         peak_columns,
+                         c)
+                        .request(media_reader_, infinite)
+                        .then(
+                            [=](const utility::JsonStore &peaks) {
+                                (*channels)[c] = peaks;
+                                if (!--(*remaining))
+                                    store_peaks(key, *channels);
+                            },
+                            [=](const caf::error &) {
+                                if (!--(*remaining))
+                                    store_peaks(key, *channels);
+                            });
+                }
+            },
+            // no audio, remembered so that we don't ask again
+            [=](const caf::error &) { store_peaks(key, {}); });
+}
+
+void AudioWaveformOverlay::store_peaks(
+    const std::string &key, const std::vector<utility::JsonStore> &channels) {
+
+    peaks_pending_.erase(key);
+
+    // min and max of each column in turn, drawn as a line strip this fills
+    // the waveform's envelope
+    std::vector<float> verts;
+    verts.reserve(channels.size() * peak_columns * 2);
+    for (const auto &channel : channels) {
+        std::vector<float> mins(peak_columns, 0.0f);
+        std::vector<float> maxs(peak_columns, 0.0f);
+        if (channel.contains("min") and channel.contains("max")) {
+            mins = channel["min"].get<std::vector<float>>();
+            maxs = channel["max"].get<std::vector<float>>();
+        }
+        for (size_t i = 0; i < mins.size() and i < maxs.size(); ++i) {
+            verts.push_back(mins[i]);
+            verts.push_back(maxs[i]);
+        }
+    }
+
+    peaks_[key] = std::make_pair(int(channels.size()), verts);
+    peaks_order_.push_back(key);
+    while (peaks_order_.size() > max_cached_peaks) {
+        peaks_.erase(peaks_order_.front());
+        peaks_order_.pop_front();
+    }
+
+    redraw_viewport();
+}
+
+utility::BlindDataObjectPtr
+AudioWaveformOverlay::peaks_render_data(const media_reader::ImageBufPtr &image) const {
+
+    auto p = peaks_.find(peaks_key(image.frame_id()));
+    if (p == peaks_.end() or !p->second.first or p->second.second.empty())
+        return utility::BlindDataObjectPtr();
+
+    return utility::BlindDataObjectPtr(new WaveFormData(
+        p->second.second,
+        p->second.first,
+        vertical_scale_->value(),
+        chan_position_spacing_->value(),
+        vertical_position_->value(),
+        in_frame_waveform_colour_->value(),
+        outside_frame_waveform_colour_->value(),
+        horizontal_scale_->value()));
+}
+
 /*void AudioWaveformOverlay::viewport_playhead_changed(const std::string &viewport_name,
 caf::actor playhead) { if (playhead) { request(playhead, infinite, utility::uuid_atom_v).then(
             [=](utility::Uuid &playhead_uuid) {
@@ -1,6 +1,9 @@
 // SPDX-License-Identifier: Apache-2.0
 #pragma once
 
+#include <deque>
+#include <set>
+
 #include "xstudio/audio/audio_output.hpp"
 #include "xstudio/ui/opengl/shader_program_base.hpp"
 #include "xstudio/ui/opengl/opengl_text_rendering.hpp"
@@ -85,7 +88,20 @@ class AudioWaveformOverlay : public plugin::HUDPluginBase {
 
     void attribute_changed(const utility::Uuid &attr_uuid, const int role) override;
 
+    void images_going_on_screen(
+        const media_reader::ImageBufDisplaySetPtr &images,
+        const std::string viewport_name,
+        const bool playhead_playing) override;
+
   private:
+    // Waveform from the global reader's waveform summaries, for when the
+    // audio around a frame isn't in the audio cache
+    void request_peaks(const media_reader::ImageBufPtr &image);
+    void store_peaks(const std::string &key, const std::vector<utility::JsonStore> &channels);
+    [[nodiscard]] std::string peaks_key(const media::AVFrameID &frame_id) const;
+    [[nodiscard]] utility::BlindDataObjectPtr
+    peaks_render_data(const media_reader::ImageBufPtr &image) const;
+
     module::FloatAttribute *vertical_scale_;
     module::FloatAttribute *horizontal_scale_;
     module::FloatAttribute *chan_position_spacing_;
@@ -101,6 +117,12 @@ class AudioWaveformOverlay : public plugin::HUDPluginBase {
 
     std::unordered_map<utility::Uuid, std::vector<media_reader::AudioBufPtr>>
         latest_audio_buffers_;
+
+    caf::actor media_reader_;
+    // number of channels and min/max verts, per frame and display settings
+    std::map<std::string, std::pair<int, std::vector<float>>> peaks_;
+    std::deque<std::string> peaks_order_;
+    std::set<std::string> peaks_pending_;
 };
 
 } // namespace xstudio::ui::viewport
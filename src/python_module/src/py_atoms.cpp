@@ -88,6 +88,8 @@ void py_config::add_atoms() {
     ADD_ATOM(xstudio::timeline, trimmed_range_atom);
     ADD_ATOM(xstudio::timeline, item_selection_atom);
     ADD_ATOM(xstudio::timeline, item_type_atom);
+    ADD_ATOM(xstudio::timeline, item_actor_atom);
+    ADD_ATOM(xstudio::timeline, item_lightweight_atom);
 
     ADD_ATOM(xstudio::thumbnail, cache_path_atom);
     ADD_ATOM(xstudio::thumbnail, cache_stats_atom);
@@ -168,6 +170,10 @@ void py_config::add_atoms() {
     ADD_ATOM(xstudio::media_reader, push_image_atom);
     ADD_ATOM(xstudio::media_reader, retire_readers_atom);
     ADD_ATOM(xstudio::media_reader, supported_atom);
+    ADD_ATOM(xstudio::media_reader, image_diff_atom);
+    ADD_ATOM(xstudio::media_reader, image_scopes_atom);
+    ADD_ATOM(xstudio::media_reader, pixel_sample_atom);
+    ADD_ATOM(xstudio::media_reader, audio_waveform_atom);
     ADD_ATOM(xstudio::media_cache, count_atom);
     ADD_ATOM(xstudio::media_cache, erase_atom);
     ADD_ATOM(xstudio::media_cache, keys_atom);
@@ -378,7 +384,9 @@ void py_config::add_atoms() {
     ADD_ATOM(xstudio::history, undo_atom);
     ADD_ATOM(xstudio::history, redo_atom);
     ADD_ATOM(xstudio::history, log_atom);
+    ADD_ATOM(xstudio::history, budget_atom);
     ADD_ATOM(xstudio::history, history_atom);
+    ADD_ATOM(xstudio::history, stats_atom);
 
     ADD_ATOM(xstudio::ui::viewport, viewport_playhead_atom);
     ADD_ATOM(xstudio::ui::viewport, quickview_media_atom);
@@ -389,6 +397,7 @@ void py_config::add_atoms() {
     ADD_ATOM(xstudio::ui::viewport, active_viewport_atom);
     ADD_ATOM(xstudio::ui::viewport, render_viewport_to_image_atom);
     ADD_ATOM(xstudio::ui::viewport, viewport_mask_atom);
+    ADD_ATOM(xstudio::ui::viewport, frame_pacing_telemetry_atom);
 
     ADD_ATOM(xstudio::ui, show_message_box_atom);
     ADD_ATOM(xstudio::ui, open_quickview_window_atom);
@@ -16,11 +16,65 @@
 #include <pybind11/chrono.h>
 // CAF_POP_WARNINGS
 
+#include "xstudio/utility/directory_scanner.hpp"
 #include "xstudio/utility/enums.hpp"
+#include "xstudio/utility/frame_list.hpp"
 
 using namespace xstudio;
 namespace py = pybind11;
 
+namespace {
+
+py::dict scan_result_to_dict(const utility::DirectoryScanResult &result) {
+    py::list index_path;
+    for (const auto i : result.index_path_)
+        index_path.append(i);
+
+    py::list subdirectories;
+    for (const auto &i : result.subdirectories_)
+        subdirectories.append(i);
+
+    py::list sequences;
+    for (const auto &i : result.sequences_) {
+        py::dict seq;
+        seq["name"]          = i.name_;
+        seq["frames"]        = i.frames_;
+        seq["is_sequence"]   = i.is_sequence();
+        seq["count"]         = i.count_;
+        seq["size"]          = i.size_;
+        seq["apparent_size"] = i.apparent_size_;
+        seq["mtime"]         = i.mtim_;
+        seq["ctime"]         = i.ctim_;
+        seq["uid"]           = i.uid_;
+        seq["gid"]           = i.gid_;
+        if (i.is_sequence()) {
+            // middle frame, for thumbnails
+            const utility::FrameList frames(i.frames_);
+            seq["middle_frame"] = frames.frame(frames.count() / 2);
+        }
+        sequences.append(seq);
+    }
+
+    py::dict d;
+    d["path"]           = result.path_;
+    d["depth"]          = result.depth_;
+    d["index_path"]     = index_path;
+    d["subdirectories"] = subdirectories;
+    d["sequences"]      = sequences;
+    return d;
+}
+
+py::dict scan_progress_to_dict(const utility::DirectoryScanProgress &progress) {
+    py::dict d;
+    d["directories_scanned"] = progress.directories_scanned_;
+    d["directories_pending"] = progress.directories_pending_;
+    d["files_found"]         = progress.files_found_;
+    d["progress"]            = progress.progress_;
+    return d;
+}
+
+} // namespace
+
 void py_utility(py::module_ &m) {
     py::enum_<utility::TimeSourceMode>(m, "TimeSourceMode")
         .value("TSM_FIXED", utility::TimeSourceMode::FIXED)
@@ -36,4 +90,54 @@ void py_utility(py::module_ &m) {
         .value("NT_PROGRESS_RANGE", utility::NotificationType::NT_PROGRESS_RANGE)
         .value("NT_PROGRESS_PERCENTAGE", utility::NotificationType::NT_PROGRESS_PERCENTAGE)
         .export_values();
+
+    py::class_<utility::DirectoryScanner>(m, "DirectoryScanner")
+        .def(
+            py::init([](const int max_depth,
+                        const size_t thread_count,
+                        const py::iterable &extensions,
+                        const py::iterable &ignore_directories,
+                        const bool include_hidden,
+                        const bool stat_files) {
+                utility::DirectoryScanOptions options;
+                options.max_depth       = max_depth;
+                options.thread_count    = thread_count;
+                options.include_hidden  = include_hidden;
+                options.stat_files      = stat_files;
+                for (const auto &i : extensions)
+                    options.extensions.insert(i.cast<std::string>());
+                for (const auto &i : ignore_directories)
+                    options.ignore_directories.insert(i.cast<std::string>());
+                return std::make_unique<utility::DirectoryScanner>(options);
+            }),
+            py::arg("max_depth")          = -1,
+            py::arg("thread_count")       = 4,
+            py::arg("extensions")         = py::list(),
+            py::arg("ignore_directories") = py::list(),
+            py::arg("include_hidden")     = false,
+            py::arg("stat_files")         = true)
+        .def(
+            "scan",
+            [](utility::DirectoryScanner &scanner,
+               const std::string &path,
+               const py::object &callback) {
+                // the scan runs on the scanner's threads, we only need the GIL
+                // to hand each directory to python
+                py::gil_scoped_release release;
+                return scanner.scan(
+                    path,
+                    [&](const utility::DirectoryScanResult &result,
+                        const utility::DirectoryScanProgress &progress) {
+                        py::gil_scoped_acquire acquire;
+                        if (not callback.is_none())
+                            callback(
+                                scan_result_to_dict(result), scan_progress_to_dict(progress));
+                    });
+            },
+            "Scan directory tree, callback(result, progress) is called as each directory "
+            "completes. Returns False if cancelled.",
+            py::arg("path"),
+            py::arg("callback") = py::none())
+        .def("cancel", &utility::DirectoryScanner::cancel)
+        .def("cancelled", &utility::DirectoryScanner::cancelled);
 }
@@ -16,11 +16,14 @@
 #include "xstudio/broadcast/broadcast_actor.hpp"
 #include "xstudio/global_store/global_store.hpp"
 #include "xstudio/json_store/json_store_actor.hpp"
+#include "xstudio/media/media_actor.hpp"
 #include "xstudio/bookmark/bookmarks_actor.hpp"
 #include "xstudio/playlist/playlist_actor.hpp"
 #include "xstudio/session/session_actor.hpp"
+#include "xstudio/timeline/timeline_actor.hpp"
 #include "xstudio/utility/helpers.hpp"
 #include "xstudio/utility/logging.hpp"
+#include "xstudio/utility/undo_redo.hpp"
 #include "xstudio/thumbnail/thumbnail.hpp"
 
 using namespace xstudio;
@@ -545,18 +548,33 @@ SessionActor::SessionActor(
     join_event_group(this, bookmarks_);
     link_to(bookmarks_);
 
+    // playlists don't depend on each other, so build them concurrently
+    spdlog::stopwatch sw;
+    std::vector<std::pair<std::string, const nlohmann::json *>> playlist_jsn;
     for (const auto &[key, value] : jsn["actors"].items()) {
-        if (value["base"]["container"]["type"] == "Playlist") {
-            try {
-                playlists_[key] = spawn<playlist::PlaylistActor>(
-                    static_cast<utility::JsonStore>(value), caf::actor_cast<caf::actor>(this));
-                link_to(playlists_[key]);
-                join_event_group(this, playlists_[key]);
-            } catch (const std::exception &e) {
-                spdlog::error("{}", e.what());
-            }
+        if (value["base"]["container"]["type"] == "Playlist")
+            playlist_jsn.emplace_back(key, &value);
+    }
+
+    const auto session = caf::actor_cast<caf::actor>(this);
+    std::vector<caf::actor> playlists(playlist_jsn.size());
+    parallel_for(playlist_jsn.size(), [&](const size_t i) {
+        try {
+            playlists[i] = system().spawn<playlist::PlaylistActor>(
+                static_cast<utility::JsonStore>(*playlist_jsn[i].second), session);
+        } catch (const std::exception &e) {
+            spdlog::error("{}", e.what());
+        }
+    });
+
+    for (size_t i = 0; i < playlists.size(); i++) {
+        if (playlists[i]) {
+            playlists_[playlist_jsn[i].first] = playlists[i];
+            link_to(playlists[i]);
+            join_event_group(this, playlists[i]);
         }
     }
+    spdlog::info("{} playlists built in {:.3} seconds.", playlists_.size(), sw);
 
     init();
 
@@ -588,6 +606,11 @@ SessionActor::SessionActor(caf::actor_config &cfg, const std::string &name)
             "Push to Current Playlist");
         base_.set_push_playlist_name(
             preference_value<std::string>(j, "/core/session/pushed_media_playlist_name"));
+        timeline::TimelineActor::set_lightweight_items(
+            preference_value<bool>(j, "/core/sequence/lightweight_items"));
+        utility::UndoRedoBudget::set_max_bytes(
+            size_t(preference_value<int>(j, "/core/sequence/history_budget_mb")) * 1024 * 1024);
+        media::MediaActor::set_lazy_load(preference_value<bool>(j, "/core/session/lazy_media"));
 
     } catch (...) {
     }
@@ -1897,6 +1920,13 @@ caf::message_handler SessionActor::message_handler() {
                         change.get<std::string>() == "Push to Current Playlist");
                 } else if (path == "/core/session/pushed_media_playlist_name/value") {
                     base_.set_push_playlist_name(change.get<std::string>());
+                } else if (path == "/core/sequence/lightweight_items/value") {
+                    timeline::TimelineActor::set_lightweight_items(change.get<bool>());
+                } else if (path == "/core/sequence/history_budget_mb/value") {
+                    utility::UndoRedoBudget::set_max_bytes(
+                        size_t(change.get<int>()) * 1024 * 1024);
+                } else if (path == "/core/session/lazy_media/value") {
+                    media::MediaActor::set_lazy_load(change.get<bool>());
                 }
             } catch (std::exception &err) {
                 spdlog::warn("{} {}", __PRETTY_FUNCTION__, err.what());
@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: Apache-2.0
+
+// Memory and edit times of a track of gaps and clips, held as actors and as
+// plain items (/core/sequence/lightweight_items). Not run as part of the
+// tests.
+//
+//   track_lightweight_benchmark [items]
+
+#include <caf/all.hpp>
+#include <cstdlib>
+#include <fstream>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+#include "xstudio/atoms.hpp"
+#include "xstudio/global/xstudio_actor_system.hpp"
+#include "xstudio/timeline/clip.hpp"
+#include "xstudio/timeline/gap.hpp"
+#include "xstudio/timeline/track.hpp"
+#include "xstudio/timeline/track_actor.hpp"
+#include "xstudio/utility/helpers.hpp"
+#include "xstudio/utility/logging.hpp"
+
+using namespace xstudio;
+using namespace xstudio::utility;
+using namespace xstudio::timeline;
+
+using namespace caf;
+
+namespace {
+
+// resident memory, where we can tell
+size_t resident_bytes() {
+#ifdef __linux__
+    size_t pages    = 0;
+    size_t resident = 0;
+    std::ifstream statm("/proc/self/statm");
+    if (statm >> pages >> resident)
+        return resident * size_t(sysconf(_SC_PAGESIZE));
+#endif
+    return 0;
+}
+
+// serialised track of alternating gaps and clips, 10 frames each
+JsonStore track_json(const int count, const bool lightweight) {
+    const auto range = FrameRange(FrameRateDuration(10, timebase::k_flicks_24fps));
+    auto track       = Track("Track", FrameRate(timebase::k_flicks_24fps));
+
+    JsonStore jsn;
+    jsn["actors"] = R"({})"_json;
+    for (int i = 0; i < count; i++) {
+        JsonStore child;
+        auto item = Item();
+        if (i % 2) {
+            auto clip = Clip("Clip", Uuid::generate(), caf::actor(), Uuid::generate());
+            clip.item().set_range(range, range);
+            child["base"] = clip.serialise();
+            item          = clip.item().clone();
+        } else {
+            auto gap      = Gap("Gap", FrameRateDuration(10, timebase::k_flicks_24fps));
+            child["base"] = gap.serialise();
+            item          = gap.item().clone();
+        }
+        jsn["actors"][to_string(item.uuid())] = child;
+        track.item().insert(track.item().end(), item, child);
+    }
+
+    jsn["base"]        = track.serialise();
+    jsn["lightweight"] = lightweight;
+    return jsn;
+}
+
+struct Result {
+    size_t item_actors_{0};
+    long memory_{0};
+    double build_{0.0};
+    double edit_{0.0};
+    double serialise_{0.0};
+};
+
+// a track of count items loaded, some edits and a serialise
+Result build_and_edit(caf::scoped_actor &self, const int count, const bool lightweight) {
+    Result result;
+    const auto jsn = track_json(count, lightweight);
+
+    const auto before = resident_bytes();
+    spdlog::stopwatch sw;
+
+    auto t = self->spawn<TrackActor>(jsn);
+    request_receive<Item>(*self, t, item_atom_v);
+    result.build_ = sw.elapsed().count();
+
+    sw.reset();
+    for (int i = 0; i < count / 10; i++) {
+        request_receive<JsonStore>(*self, t, split_item_at_frame_atom_v, i * 100 + 5);
+        request_receive<std::pair<JsonStore, std::vector<Item>>>(
+            *self, t, remove_item_atom_v, i * 10, true);
+    }
+    request_receive<JsonStore>(*self, t, move_item_atom_v, 0, 10, count / 4);
+    result.edit_ = sw.elapsed().count();
+
+    sw.reset();
+    request_receive<JsonStore>(*self, t, serialise_atom_v);
+    result.serialise_ = sw.elapsed().count();
+
+    // the items the track still holds as actors
+    for (const auto &i : request_receive<Item>(*self, t, item_atom_v).children()) {
+        if (i.actor_addr())
+            result.item_actors_++;
+    }
+    result.memory_ = long(resident_bytes()) - long(before);
+
+    self->send_exit(t, caf::exit_reason::user_shutdown);
+    return result;
+}
+
+void report(const std::string &name, const Result &r) {
+    spdlog::info(
+        "{}: {} item actors, {:.1f}MB more resident, load {:.3f}s edit {:.3f}s serialise "
+        "{:.3f}s",
+        name,
+        r.item_actors_,
+        double(r.memory_) / (1024.0 * 1024.0),
+        r.build_,
+        r.edit_,
+        r.serialise_);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+
+    start_logger(spdlog::level::info);
+    CafActorSystem::instance();
+
+    const int count = argc > 1 ? std::max(std::atoi(argv[1]), 40) : 2000;
+
+    caf::actor_system_config cfg;
+    caf::actor_system system(cfg);
+    caf::scoped_actor self(system);
+
+    // lightweight first, so the actor run can't reuse memory it freed
+    const auto lightweight = build_and_edit(self, count, true);
+    const auto actors      = build_and_edit(self, count, false);
+
+    spdlog::info("{} gaps and clips", count);
+    report("actor items", actors);
+    report("lightweight items", lightweight);
+
+    if (lightweight.item_actors_ or actors.item_actors_ < size_t(count)) {
+        spdlog::error("Unexpected item actor counts");
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -21,13 +21,19 @@ caf::actor StackActor::deserialise(const JsonStore &value, const bool replace_it
     auto item = Item();
 
     if (type == "Track") {
-        actor = spawn<TrackActor>(static_cast<JsonStore>(value), item);
+        auto jsn = static_cast<JsonStore>(value);
+        if (lightweight_)
+            jsn["lightweight"] = true;
+        actor = spawn<TrackActor>(jsn, item);
     } else if (type == "Clip") {
         actor = spawn<ClipActor>(static_cast<JsonStore>(value), item);
     } else if (type == "Gap") {
         actor = spawn<GapActor>(static_cast<JsonStore>(value), item);
     } else if (type == "Stack") {
-        actor = spawn<StackActor>(static_cast<JsonStore>(value), item);
+        auto jsn = static_cast<JsonStore>(value);
+        if (lightweight_)
+            jsn["lightweight"] = true;
+        actor = spawn<StackActor>(jsn, item);
     }
 
     if (actor) {
@@ -77,7 +83,9 @@ void StackActor::deserialise() {
 
 
 StackActor::StackActor(caf::actor_config &cfg, const JsonStore &jsn)
-    : caf::event_based_actor(cfg), base_(static_cast<JsonStore>(jsn.at("base"))) {
+    : caf::event_based_actor(cfg),
+      base_(static_cast<JsonStore>(jsn.at("base"))),
+      lightweight_(jsn.value("lightweight", false)) {
 
     base_.item().set_actor_addr(this);
 
@@ -95,7 +103,9 @@ StackActor::StackActor(caf::actor_config &cfg, const JsonStore &jsn)
 }
 
 StackActor::StackActor(caf::actor_config &cfg, const JsonStore &jsn, Item &pitem)
-    : caf::event_based_actor(cfg), base_(static_cast<JsonStore>(jsn.at("base"))) {
+    : caf::event_based_actor(cfg),
+      base_(static_cast<JsonStore>(jsn.at("base"))),
+      lightweight_(jsn.value("lightweight", false)) {
 
     base_.item().set_actor_addr(this);
 
@@ -262,6 +272,43 @@ caf::message_handler StackActor::message_handler() {
 
         [=](item_type_atom) -> ItemType { return base_.item().item_type(); },
 
+        [=](item_lightweight_atom) -> bool { return lightweight_; },
+
+        [=](item_lightweight_atom, const bool value) -> bool {
+            lightweight_ = value;
+            for (const auto &i : base_.item().children()) {
+                if (i.item_type() != IT_CLIP and i.item_type() != IT_GAP and
+                    actors_.count(i.uuid()))
+                    mail(item_lightweight_atom_v, value).send(actors_.at(i.uuid()));
+            }
+            return true;
+        },
+
+        [=](item_actor_atom) -> result<JsonStore> {
+            // actors for the lightweight clips of our tracks, see TrackActor
+            std::vector<caf::actor> children;
+            for (const auto &i : base_.item().children()) {
+                if (i.item_type() != IT_CLIP and i.item_type() != IT_GAP and
+                    actors_.count(i.uuid()))
+                    children.push_back(actors_.at(i.uuid()));
+            }
+
+            if (children.empty())
+                return JsonStore(R"([])"_json);
+
+            auto rp = make_response_promise<JsonStore>();
+            fan_out_request<policy::select_all>(children, infinite, item_actor_atom_v)
+                .then(
+                    [=](const std::vector<JsonStore> &updates) mutable {
+                        auto changes = JsonStore(R"([])"_json);
+                        for (const auto &u : updates)
+                            changes.insert(changes.end(), u.begin(), u.end());
+                        rp.deliver(changes);
+                    },
+                    [=](const caf::error &err) mutable { rp.deliver(err); });
+            return rp;
+        },
+
         [=](rate_atom) -> FrameRate { return base_.item().rate(); },
 
         [=](rate_atom atom, const media::MediaType media_type) {
@@ -737,6 +784,14 @@ void StackActor::insert_items(
                     for (const auto &ua : uav)
                         add_item(ua);
 
+                    // tracks and stacks follow our mode
+                    if (lightweight_) {
+                        for (const auto &i : items) {
+                            if (i.item_type() != IT_CLIP and i.item_type() != IT_GAP)
+                                mail(item_lightweight_atom_v, true).send(actors_.at(i.uuid()));
+                        }
+                    }
+
                     // find insertion point..
                     auto it = std::next(base_.item().begin(), index);
 
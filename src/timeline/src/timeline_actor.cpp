@@ -51,7 +51,10 @@ caf::actor TimelineActor::deserialise(const JsonStore &value, const bool replace
     if (value.at("base").at("container").at("type") == "Stack") {
         auto key  = Uuid(value.at("base").at("item").at("uuid"));
         auto item = Item();
-        actor     = spawn<StackActor>(static_cast<JsonStore>(value), item);
+        auto jsn  = static_cast<JsonStore>(value);
+        if (lightweight_items_)
+            jsn["lightweight"] = true;
+        actor = spawn<StackActor>(jsn, item);
         add_item(UuidActor(key, actor));
         if (replace_item) {
             auto itemit = find_uuid(base_.item().children(), key);
@@ -1191,6 +1194,8 @@ TimelineActor::TimelineActor(
     }
 
     auto stack = spawn<StackActor>(stack_item, stack_item);
+    if (lightweight_items_)
+        anon_mail(item_lightweight_atom_v, true).send(stack);
 
     base_.item().set_name(name);
 
@@ -2586,8 +2591,34 @@ caf::message_handler TimelineActor::message_handler() {
             const FrameRate &override_rate) -> caf::result<media::FrameTimeMapPtr> {
             // This is required by SubPlayhead actor to make the timeline
             // playable.
-            return base_.item().get_all_frame_IDs(
-                media_type, tsm, override_rate, base_.focus_list());
+            if (not lightweight_items_ or item_actors_.empty())
+                return base_.item().get_all_frame_IDs(
+                    media_type, tsm, override_rate, base_.focus_list());
+
+            // lightweight clips need actors to be asked for frames, the address
+            // updates are applied here as they won't have reached us yet
+            auto rp = make_response_promise<media::FrameTimeMapPtr>();
+            fan_out_request<policy::select_all>(
+                map_value_to_vec(item_actors_), infinite, item_actor_atom_v)
+                .then(
+                    [=](const std::vector<JsonStore> &updates) mutable {
+                        for (const auto &u : updates)
+                            base_.item().update(u);
+                        rp.deliver(base_.item().get_all_frame_IDs(
+                            media_type, tsm, override_rate, base_.focus_list()));
+                    },
+                    [=](const caf::error &err) mutable { rp.deliver(err); });
+            return rp;
+        },
+
+        [=](item_lightweight_atom) -> bool { return lightweight_items_; },
+
+        [=](item_lightweight_atom, const bool value) -> bool {
+            // existing actors are kept, new children and reloads follow it
+            lightweight_items_ = value;
+            for (const auto &i : item_actors_)
+                anon_mail(item_lightweight_atom_v, value).send(i.second);
+            return true;
         },
 
         [=](serialise_atom) -> result<JsonStore> {
@@ -20,16 +20,25 @@ caf::actor TrackActor::deserialise(const JsonStore &value, const bool replace_it
 
     auto item = Item();
 
-    if (type == "Clip") {
+    const auto lightweight = lightweight_ and (type == "Gap" or type == "Clip");
+
+    if (lightweight) {
+        // kept as an item, materialise() makes an actor if one is needed
+        keep_lightweight(item, value);
+    } else if (type == "Clip") {
         actor = spawn<ClipActor>(static_cast<JsonStore>(value), item);
     } else if (type == "Gap") {
         actor = spawn<GapActor>(static_cast<JsonStore>(value), item);
     } else if (type == "Stack") {
-        actor = spawn<StackActor>(static_cast<JsonStore>(value), item);
+        auto jsn = static_cast<JsonStore>(value);
+        if (lightweight_)
+            jsn["lightweight"] = true;
+        actor = spawn<StackActor>(jsn, item);
     }
 
-    if (actor) {
-        add_item(UuidActor(key, actor));
+    if (actor or lightweight) {
+        if (actor)
+            add_item(UuidActor(key, actor));
         if (replace_item) {
             auto itemit = find_uuid(base_.item().children(), key);
             if (itemit != base_.item().end()) {
@@ -86,6 +95,23 @@ void TrackActor::item_event_callback(const JsonStore &event, Item &item) {
 
         if (child_item_it != base_.item().end() and not actors_.count(cuuid) and
             not event.at("blind").is_null()) {
+
+            if (lightweight_ and (child_item_it->item_type() == IT_GAP or
+                                  child_item_it->item_type() == IT_CLIP)) {
+                // stays an item, but drop the address of any actor it had
+                if (child_item_it->item_type() == IT_CLIP)
+                    media_rates_[cuuid] =
+                        Clip(JsonStore(event.at("blind").at("base"))).media_rate();
+
+                if (child_item_it->actor_addr()) {
+                    child_item_it->set_actor_addr(caf::actor_addr());
+                    mail(
+                        event_atom_v, item_atom_v, child_item_it->make_actor_addr_update(), true)
+                        .send(base_.event_group());
+                }
+                break;
+            }
+
             // our child
             // spdlog::warn("RECREATE MATCH");
 
@@ -124,6 +150,7 @@ void TrackActor::item_event_callback(const JsonStore &event, Item &item) {
         // spdlog::warn("TrackActor IT_REMOVE {} {}", base_.item().name(), event.dump(2));
 
         auto cuuid = Uuid(event.at("item_uuid"));
+        media_rates_.erase(cuuid);
         // child destroyed
         if (actors_.count(cuuid)) {
             // spdlog::warn("destroy
@@ -154,7 +181,9 @@ void TrackActor::item_event_callback(const JsonStore &event, Item &item) {
 }
 
 TrackActor::TrackActor(caf::actor_config &cfg, const JsonStore &jsn)
-    : caf::event_based_actor(cfg), base_(static_cast<JsonStore>(jsn.at("base"))) {
+    : caf::event_based_actor(cfg),
+      base_(static_cast<JsonStore>(jsn.at("base"))),
+      lightweight_(jsn.value("lightweight", false)) {
     base_.item().set_actor_addr(this);
 
     for (const auto &[key, value] : jsn.at("actors").items()) {
@@ -173,7 +202,9 @@ TrackActor::TrackActor(caf::actor_config &cfg, const JsonStore &jsn)
 
 
 TrackActor::TrackActor(caf::actor_config &cfg, const JsonStore &jsn, Item &pitem)
-    : caf::event_based_actor(cfg), base_(static_cast<JsonStore>(jsn.at("base"))) {
+    : caf::event_based_actor(cfg),
+      base_(static_cast<JsonStore>(jsn.at("base"))),
+      lightweight_(jsn.value("lightweight", false)) {
     base_.item().set_actor_addr(this);
 
     for (const auto &[key, value] : jsn.at("actors").items()) {
@@ -235,6 +266,10 @@ caf::message_handler TrackActor::message_handler() {
         [=](link_media_atom, const UuidActorMap &media, const bool force) -> result<bool> {
             auto rp = make_response_promise<bool>();
 
+            // for lightweight clips, linked when they get an actor
+            for (const auto &[uuid, actor] : media)
+                media_[uuid] = caf::actor_cast<caf::actor_addr>(actor);
+
             if (actors_.empty()) {
                 rp.deliver(true);
             } else {
@@ -298,6 +333,23 @@ caf::message_handler TrackActor::message_handler() {
             return rp;
         },
 
+        [=](item_actor_atom, const Uuid &uuid) -> result<UuidActor> {
+            auto actor = materialise(uuid);
+            if (not actor)
+                return make_error(xstudio_error::error, "Invalid uuid");
+            return UuidActor(uuid, actor);
+        },
+
+        [=](item_actor_atom) -> JsonStore { return materialise_clips(); },
+
+        [=](item_lightweight_atom) -> bool { return lightweight_; },
+
+        [=](item_lightweight_atom, const bool value) -> bool {
+            // applies to children added from now on
+            lightweight_ = value;
+            return true;
+        },
+
         [=](item_atom, int index) -> result<Item> {
             if (static_cast<size_t>(index) >= base_.item().size()) {
                 return make_error(xstudio_error::error, "Invalid index");
@@ -686,19 +738,25 @@ caf::message_handler TrackActor::message_handler() {
             auto dup = base_.duplicate();
             dup.item().clear();
 
-            jsn["base"]   = dup.serialise();
-            jsn["actors"] = {};
-            auto actor    = spawn<TrackActor>(jsn);
+            jsn["base"]        = dup.serialise();
+            jsn["actors"]      = {};
+            jsn["lightweight"] = lightweight_;
+            auto actor         = spawn<TrackActor>(jsn);
 
-            if (actors_.empty()) {
+            if (base_.item().empty()) {
                 rp.deliver(UuidActor(dup.uuid(), actor));
             } else {
                 // duplicate all children and relink against items.
                 scoped_actor sys{system()};
 
                 for (const auto &i : base_.children()) {
-                    auto ua =
-                        request_receive<UuidActor>(*sys, actors_[i.uuid()], duplicate_atom_v);
+                    auto ua = UuidActor();
+                    if (is_lightweight(i)) {
+                        ua = duplicate_lightweight(i);
+                    } else {
+                        ua = request_receive<UuidActor>(
+                            *sys, actors_[i.uuid()], duplicate_atom_v);
+                    }
                     request_receive<JsonStore>(
                         *sys, actor, insert_item_atom_v, -1, UuidActorVector({ua}));
                 }
@@ -713,6 +771,29 @@ caf::message_handler TrackActor::message_handler() {
             const UuidActorMap &media) -> result<bool> {
             auto rp = make_response_promise<bool>();
 
+            // lightweight clips swap here, as their ClipActor would
+            auto changes = JsonStore(R"([])"_json);
+            for (auto &i : base_.item().children()) {
+                if (i.item_type() != IT_CLIP or not is_lightweight(i))
+                    continue;
+
+                auto prop = i.prop();
+                auto sit  = swap.find(prop.value("media_uuid", Uuid()));
+                if (sit == std::end(swap))
+                    continue;
+
+                if (auto mit = media.find(sit->second); mit != std::end(media))
+                    media_[sit->second] = caf::actor_cast<caf::actor_addr>(mit->second);
+
+                prop["media_uuid"] = sit->second;
+                auto tmp           = i.set_prop(prop);
+                if (not tmp.is_null())
+                    changes.insert(changes.end(), tmp.begin(), tmp.end());
+            }
+
+            if (not changes.empty())
+                mail(event_atom_v, item_atom_v, changes, false).send(base_.event_group());
+
             if (actors_.empty()) {
                 rp.deliver(true);
             } else {
@@ -749,6 +830,11 @@ caf::message_handler TrackActor::message_handler() {
                                 jsn["actors"]
                                    [static_cast<std::string>(j["base"]["container"]["uuid"])] =
                                        j;
+                            for (const auto &i : base_.item().children()) {
+                                if (is_lightweight(i))
+                                    jsn["actors"][to_string(i.uuid())] =
+                                        lightweight_serialise(i);
+                            }
                             rp.deliver(jsn);
                         },
                         [=](error &err) mutable { rp.deliver(std::move(err)); });
@@ -758,6 +844,10 @@ caf::message_handler TrackActor::message_handler() {
             JsonStore jsn;
             jsn["base"]   = base_.serialise();
             jsn["actors"] = {};
+            for (const auto &i : base_.item().children()) {
+                if (is_lightweight(i))
+                    jsn["actors"][to_string(i.uuid())] = lightweight_serialise(i);
+            }
 
             return result<JsonStore>(jsn);
         },
@@ -767,7 +857,8 @@ caf::message_handler TrackActor::message_handler() {
             const TimeSourceMode tsm,
             const FrameRate &override_rate) -> caf::result<media::FrameTimeMapPtr> {
             // This is required by SubPlayhead actor to make the track
-            // playable.
+            // playable, clips need actors for that.
+            materialise_clips();
             return base_.item().get_all_frame_IDs(media_type, tsm, override_rate);
         }
 
@@ -826,6 +917,137 @@ void TrackActor::add_item(const UuidActor &ua) {
     actors_[ua.uuid()] = ua.actor();
 }
 
+caf::actor TrackActor::materialise(const Uuid &uuid) {
+    if (auto it = actors_.find(uuid); it != std::end(actors_))
+        return it->second;
+
+    auto itemit = find_uuid(base_.item().children(), uuid);
+    if (itemit == base_.item().end() or not is_lightweight(*itemit))
+        return caf::actor();
+
+    auto actor = caf::actor();
+    if (itemit->item_type() == IT_CLIP) {
+        actor = spawn<ClipActor>(lightweight_serialise(*itemit));
+        link_clip_media(actor, itemit->prop().value("media_uuid", Uuid()));
+    } else {
+        actor = spawn<GapActor>(lightweight_serialise(*itemit));
+    }
+    add_item(UuidActor(uuid, actor));
+    media_rates_.erase(uuid);
+
+    // ancestors need the new address
+    itemit->set_actor_addr(actor);
+    mail(event_atom_v, item_atom_v, itemit->make_actor_addr_update(), true)
+        .send(base_.event_group());
+
+    return actor;
+}
+
+JsonStore TrackActor::materialise_clips() {
+    auto changes = JsonStore(R"([])"_json);
+
+    std::vector<Uuid> clips;
+    for (const auto &i : base_.item().children()) {
+        if (i.item_type() == IT_CLIP and is_lightweight(i))
+            clips.push_back(i.uuid());
+    }
+
+    for (const auto &uuid : clips) {
+        materialise(uuid);
+        auto tmp = find_uuid(base_.item().children(), uuid)->make_actor_addr_update();
+        changes.insert(changes.end(), tmp.begin(), tmp.end());
+    }
+
+    return changes;
+}
+
+void TrackActor::link_clip_media(const caf::actor &clip, const Uuid &media_uuid) {
+    // only what the timeline linked us against, the clip is left unlinked otherwise
+    auto it = media_.find(media_uuid);
+    if (it == std::end(media_))
+        return;
+
+    if (auto media = caf::actor_cast<caf::actor>(it->second))
+        mail(link_media_atom_v, UuidActorMap({{media_uuid, media}}), false).send(clip);
+}
+
+void TrackActor::keep_lightweight(Item &item, const JsonStore &value) {
+    const auto base = static_cast<JsonStore>(value.at("base"));
+
+    if (base.at("container").at("type") == "Clip") {
+        auto clip                 = Clip(base);
+        media_rates_[clip.uuid()] = clip.media_rate();
+        item                      = clip.item().clone();
+    } else {
+        item = Gap(base).item().clone();
+    }
+
+    item.set_actor_addr(caf::actor_addr());
+}
+
+bool TrackActor::is_lightweight(const Item &item) const {
+    return (item.item_type() == IT_GAP or item.item_type() == IT_CLIP) and
+           not actors_.count(item.uuid());
+}
+
+JsonStore TrackActor::lightweight_serialise(const Item &item) const {
+    // as a GapActor or ClipActor would serialise it
+    JsonStore jsn;
+
+    if (item.item_type() == IT_CLIP) {
+        auto clip = Clip(item, caf::actor());
+        if (auto it = media_rates_.find(item.uuid()); it != std::end(media_rates_))
+            clip.override_media_rate(it->second);
+        jsn["base"] = clip.serialise();
+    } else {
+        jsn["base"] = Gap(item, caf::actor()).serialise();
+    }
+
+    return jsn;
+}
+
+UuidActor TrackActor::duplicate_lightweight(const Item &item) {
+    auto jsn = lightweight_serialise(item);
+
+    if (item.item_type() == IT_CLIP) {
+        auto dup    = Clip(static_cast<JsonStore>(jsn.at("base"))).duplicate();
+        jsn["base"] = dup.serialise();
+        auto actor  = spawn<ClipActor>(jsn);
+        link_clip_media(actor, dup.media_uuid());
+        return UuidActor(dup.uuid(), actor);
+    }
+
+    auto dup    = Gap(static_cast<JsonStore>(jsn.at("base"))).duplicate();
+    jsn["base"] = dup.serialise();
+    return UuidActor(dup.uuid(), spawn<GapActor>(jsn));
+}
+
+JsonStore TrackActor::serialise_child(caf::scoped_actor &sys, const Item &item) {
+    if (is_lightweight(item))
+        return lightweight_serialise(item);
+    return request_receive<JsonStore>(*sys, item.actor(), serialise_atom_v);
+}
+
+std::pair<Item, JsonStore> TrackActor::make_gap(
+    caf::scoped_actor &sys, const std::string &name, const FrameRateDuration &duration) {
+    auto uuid = Uuid::generate();
+
+    if (lightweight_) {
+        auto gap = Gap(name, duration, uuid);
+        JsonStore blind;
+        blind["base"] = gap.serialise();
+        return std::make_pair(gap.item().clone(), blind);
+    }
+
+    auto gap = spawn<GapActor>(name, duration, uuid);
+    // take ownership
+    add_item(UuidActor(uuid, gap));
+
+    auto item  = request_receive<Item>(*sys, gap, item_atom_v);
+    auto blind = request_receive<JsonStore>(*sys, gap, serialise_atom_v);
+    return std::make_pair(item, blind);
+}
+
 
 void TrackActor::split_item(
     caf::typed_response_promise<JsonStore> rp,
@@ -841,24 +1063,26 @@ void TrackActor::split_item(
         auto orig_end      = orig_start + orig_duration - 1;
 
         if (frame > orig_start and frame <= orig_end) {
+            // adjust start frames if clip.
+            auto item1_range = trimmed_range;
+            auto item2_range = trimmed_range;
+
+            item1_range.set_duration(
+                (frame - item1_range.frame_start().frames()) * item1_range.rate());
+
+            if (item.item_type() != IT_GAP)
+                item2_range.set_start(FrameRate(item2_range.rate() * frame));
+            item2_range.set_duration(FrameRate(
+                item2_range.rate() * (orig_duration - item1_range.frame_duration().frames())));
+
+            if (is_lightweight(item))
+                return split_lightweight_item(rp, itemit, item1_range, item2_range);
+
             // duplicate item to split.
             mail(duplicate_atom_v)
                 .request(item.actor(), infinite)
                 .await(
                     [=](const UuidActor &ua) mutable {
-                        // adjust start frames if clip.
-                        auto item1_range = trimmed_range;
-                        auto item2_range = trimmed_range;
-
-                        item1_range.set_duration(
-                            (frame - item1_range.frame_start().frames()) * item1_range.rate());
-
-                        if (item.item_type() != IT_GAP)
-                            item2_range.set_start(FrameRate(item2_range.rate() * frame));
-                        item2_range.set_duration(FrameRate(
-                            item2_range.rate() *
-                            (orig_duration - item1_range.frame_duration().frames())));
-
                         // set range on new item
                         mail(active_range_atom_v, item2_range)
                             .request(ua.actor(), infinite)
@@ -898,6 +1122,46 @@ void TrackActor::split_item(
     }
 }
 
+void TrackActor::split_lightweight_item(
+    caf::typed_response_promise<JsonStore> rp,
+    const Items::const_iterator &itemit,
+    const FrameRange &range1,
+    const FrameRange &range2) {
+
+    auto it = find_uuid(base_.item().children(), itemit->uuid());
+
+    // second half is a duplicate, kept as an item like the first
+    JsonStore blind;
+    auto dup = Item();
+    if (it->item_type() == IT_CLIP) {
+        auto clip = Clip(static_cast<JsonStore>(lightweight_serialise(*it).at("base")))
+                        .duplicate();
+        clip.item().set_active_range(range2);
+        media_rates_[clip.uuid()] = clip.media_rate();
+        blind["base"]             = clip.serialise();
+        dup                       = clip.item().clone();
+    } else {
+        auto gap = Gap(*it, caf::actor()).duplicate();
+        gap.item().set_active_range(range2);
+        blind["base"] = gap.serialise();
+        dup           = gap.item().clone();
+    }
+
+    auto changes = it->set_active_range(range1);
+    if (changes.is_null())
+        changes = JsonStore(R"([])"_json);
+
+    auto tmp = base_.item().insert(std::next(it), dup, blind);
+    changes.insert(changes.end(), tmp.begin(), tmp.end());
+
+    auto more = base_.item().refresh();
+    if (not more.is_null())
+        changes.insert(changes.end(), more.begin(), more.end());
+
+    mail(event_atom_v, item_atom_v, changes, false).send(base_.event_group());
+    rp.deliver(changes);
+}
+
 void TrackActor::insert_items(
     caf::typed_response_promise<JsonStore> rp, const int index, const UuidActorVector &uav) {
 
@@ -916,36 +1180,34 @@ void TrackActor::insert_items(
 
                     scoped_actor sys{system()};
 
-                    // take ownership
-                    for (const auto &ua : uav)
-                        add_item(ua);
+                    // the responses aren't in the order asked
+                    std::map<Uuid, Item> by_uuid;
+                    for (const auto &i : items)
+                        by_uuid.emplace(i.uuid(), i);
+
+                    // take ownership, they came with actors so they keep them
+                    for (const auto &ua : uav) {
+                        if (by_uuid.count(ua.uuid()))
+                            add_item(ua);
+                    }
 
                     // find insertion point..
                     auto it = std::next(base_.item().begin(), index);
 
                     // insert items..
-                    // our list will be out of order..
                     auto changes = JsonStore(R"([])"_json);
                     for (const auto &ua : uav) {
-                        // find item..
-                        auto found = false;
-                        for (const auto &i : items) {
-                            if (ua.uuid() == i.uuid()) {
-                                // we need to serialise item so undo redo can remove recreate
-                                // it.
-                                auto blind = request_receive<JsonStore>(
-                                    *sys, ua.actor(), serialise_atom_v);
-
-                                auto tmp = base_.item().insert(it, i, blind);
-                                changes.insert(changes.begin(), tmp.begin(), tmp.end());
-                                found = true;
-                                break;
-                            }
-                        }
-
-                        if (not found) {
+                        auto found = by_uuid.find(ua.uuid());
+                        if (found == std::end(by_uuid)) {
                             spdlog::error("item not found for insertion");
+                            continue;
                         }
+
+                        // we need to serialise item so undo redo can remove recreate it.
+                        auto blind =
+                            request_receive<JsonStore>(*sys, ua.actor(), serialise_atom_v);
+                        auto tmp = base_.item().insert(it, found->second, blind);
+                        changes.insert(changes.begin(), tmp.begin(), tmp.end());
                     }
 
                     // add changes to stack
@@ -1099,11 +1361,10 @@ std::pair<JsonStore, std::vector<Item>> TrackActor::remove_items(
                     monitor_.erase(mit);
                 }
 
-                actors_.erase(item.uuid());
-
                 // need to serialise actor..
-                auto blind = request_receive<JsonStore>(*sys, item.actor(), serialise_atom_v);
-                auto tmp   = base_.item().erase(it, blind);
+                auto blind = serialise_child(sys, item);
+                actors_.erase(item.uuid());
+                auto tmp = base_.item().erase(it, blind);
                 changes.insert(changes.end(), tmp.begin(), tmp.end());
                 items.push_back(item.clone());
 
@@ -1119,15 +1380,9 @@ std::pair<JsonStore, std::vector<Item>> TrackActor::remove_items(
 
         // add gap and index isn't last entry.
         if (gap_size.frames() and index != static_cast<int>(base_.item().size())) {
-            JsonStore gap_changes(R"([])"_json);
-            auto uuid = Uuid::generate();
-            auto gap  = spawn<GapActor>("GAP", gap_size, uuid);
-            // take ownership
-            add_item(UuidActor(uuid, gap));
+            auto [item, blind] = make_gap(sys, "GAP", gap_size);
             // where we're going to insert gap..
-            auto it    = std::next(base_.item().begin(), index);
-            auto item  = request_receive<Item>(*sys, gap, item_atom_v);
-            auto blind = request_receive<JsonStore>(*sys, gap, serialise_atom_v);
+            auto it = std::next(base_.item().begin(), index);
 
             auto tmp = base_.item().insert(it, item, blind);
 
@@ -1247,17 +1502,9 @@ void TrackActor::move_items(
             scoped_actor sys{system()};
 
             if (add_gap and gap_size.frames()) {
-
-                JsonStore gap_changes(R"([])"_json);
-
-                auto uuid = Uuid::generate();
-                auto gap  = spawn<GapActor>("GAP", gap_size, uuid);
-                // take ownership
-                add_item(UuidActor(uuid, gap));
+                auto [item, blind] = make_gap(sys, "GAP", gap_size);
                 // where we're going to insert gap..
-                auto it    = std::next(base_.item().begin(), index);
-                auto item  = request_receive<Item>(*sys, gap, item_atom_v);
-                auto blind = request_receive<JsonStore>(*sys, gap, serialise_atom_v);
+                auto it = std::next(base_.item().begin(), index);
 
                 auto tmp = base_.item().insert(it, item, blind);
                 changes.insert(changes.end(), tmp.begin(), tmp.end());
@@ -1630,11 +1877,10 @@ JsonStore TrackActor::merge_gaps() {
             monitor_.erase(mit);
         }
 
-        actors_.erase(item.uuid());
-
         // need to serialise actor..
-        auto blind = request_receive<JsonStore>(*sys, item.actor(), serialise_atom_v);
-        auto tmp   = base_.item().erase(it, blind);
+        auto blind = serialise_child(sys, item);
+        actors_.erase(item.uuid());
+        auto tmp = base_.item().erase(it, blind);
         send_exit(item.actor(), caf::exit_reason::user_shutdown);
         changes.insert(changes.end(), tmp.begin(), tmp.end());
     }
@@ -1650,15 +1896,8 @@ JsonStore TrackActor::merge_gaps() {
                 // spdlog::warn("merging {}", gap_count);
                 scoped_actor sys{system()};
 
-                auto uuid = Uuid::generate();
-                auto gap  = spawn<GapActor>("GAP", gap_duration, uuid);
-
-                // take ownership
-                add_item(UuidActor(uuid, gap));
-
                 // where we're going to insert gap..
-                auto item  = request_receive<Item>(*sys, gap, item_atom_v);
-                auto blind = request_receive<JsonStore>(*sys, gap, serialise_atom_v);
+                auto [item, blind] = make_gap(sys, "GAP", gap_duration);
 
                 auto tmp = base_.item().insert(it, item, blind);
                 changes.insert(changes.end(), tmp.begin(), tmp.end());
@@ -1679,11 +1918,9 @@ JsonStore TrackActor::merge_gaps() {
                         monitor_.erase(mit);
                     }
 
-                    actors_.erase(item.uuid());
-
                     // need to serialise actor..
-                    auto blind =
-                        request_receive<JsonStore>(*sys, item.actor(), serialise_atom_v);
+                    auto blind = serialise_child(sys, item);
+                    actors_.erase(item.uuid());
                     auto tmp = base_.item().erase(gip, blind);
                     send_exit(item.actor(), caf::exit_reason::user_shutdown);
                     changes.insert(changes.end(), tmp.begin(), tmp.end());
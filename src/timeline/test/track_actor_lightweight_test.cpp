@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <caf/all.hpp>
+#include <gtest/gtest.h>
+
+#include "xstudio/atoms.hpp"
+#include "xstudio/timeline/clip.hpp"
+#include "xstudio/timeline/gap.hpp"
+#include "xstudio/timeline/gap_actor.hpp"
+#include "xstudio/timeline/track.hpp"
+#include "xstudio/timeline/track_actor.hpp"
+#include "xstudio/utility/helpers.hpp"
+
+using namespace xstudio;
+using namespace xstudio::utility;
+using namespace xstudio::timeline;
+
+using namespace caf;
+
+#include "xstudio/utility/serialise_headers.hpp"
+
+ACTOR_TEST_SETUP()
+
+namespace {
+// serialised lightweight track of gaps and clips, 10 frames each
+JsonStore track_json(const int count) {
+    const auto range = FrameRange(FrameRateDuration(10, timebase::k_flicks_24fps));
+    auto track       = Track("Track", FrameRate(timebase::k_flicks_24fps));
+
+    JsonStore jsn;
+    jsn["actors"] = R"({})"_json;
+    for (int i = 0; i < count; i++) {
+        JsonStore child;
+        auto item = Item();
+        if (i % 2) {
+            auto clip = Clip("Clip", Uuid::generate(), caf::actor(), Uuid::generate());
+            clip.item().set_range(range, range);
+            child["base"] = clip.serialise();
+            item          = clip.item().clone();
+        } else {
+            auto gap      = Gap("Gap", FrameRateDuration(10, timebase::k_flicks_24fps));
+            child["base"] = gap.serialise();
+            item          = gap.item().clone();
+        }
+        jsn["actors"][to_string(item.uuid())] = child;
+        track.item().insert(track.item().end(), item, child);
+    }
+
+    jsn["base"]        = track.serialise();
+    jsn["lightweight"] = true;
+    return jsn;
+}
+} // namespace
+
+TEST(TrackActorLightweightTest, Test) {
+    fixture f;
+
+    auto t    = f.self->spawn<TrackActor>(track_json(4));
+    auto item = request_receive<Item>(*(f.self), t, item_atom_v);
+    ASSERT_EQ(item.size(), size_t(4));
+    for (const auto &i : item.children())
+        EXPECT_FALSE(i.actor_addr());
+    EXPECT_EQ(item.trimmed_frame_duration().frames(), 40);
+
+    // split a clip and remove leaving a gap, no actors needed
+    request_receive<JsonStore>(*(f.self), t, split_item_at_frame_atom_v, 15);
+    item = request_receive<Item>(*(f.self), t, item_atom_v);
+    ASSERT_EQ(item.size(), size_t(5));
+    EXPECT_EQ(std::next(item.cbegin(), 1)->trimmed_frame_duration().frames(), 5);
+    EXPECT_EQ(std::next(item.cbegin(), 2)->item_type(), IT_CLIP);
+    EXPECT_EQ(std::next(item.cbegin(), 2)->trimmed_frame_duration().frames(), 5);
+
+    request_receive<std::pair<JsonStore, std::vector<Item>>>(
+        *(f.self), t, remove_item_atom_v, 0, true);
+    item = request_receive<Item>(*(f.self), t, item_atom_v);
+    EXPECT_EQ(item.trimmed_frame_duration().frames(), 40);
+    for (const auto &i : item.children())
+        EXPECT_FALSE(i.actor_addr());
+
+    // serialise round trip
+    auto serialise           = request_receive<JsonStore>(*(f.self), t, serialise_atom_v);
+    serialise["lightweight"] = true;
+    Item tmp;
+    auto t2 = f.self->spawn<TrackActor>(serialise, tmp);
+    EXPECT_EQ(item, request_receive<Item>(*(f.self), t2, item_atom_v));
+
+    // actor made when asked for
+    const auto uuid = std::next(item.cbegin(), 1)->uuid();
+    auto clip       = request_receive<UuidActor>(*(f.self), t, item_actor_atom_v, uuid);
+    ASSERT_TRUE(clip.actor());
+    EXPECT_EQ(clip.uuid(), uuid);
+    EXPECT_EQ(request_receive<Item>(*(f.self), clip.actor(), item_atom_v).uuid(), uuid);
+    EXPECT_EQ(
+        request_receive<UuidActor>(*(f.self), t, item_actor_atom_v, uuid).actor(),
+        clip.actor());
+    item = request_receive<Item>(*(f.self), t, item_atom_v);
+    EXPECT_EQ(
+        std::next(item.cbegin(), 1)->actor_addr(),
+        caf::actor_cast<caf::actor_addr>(clip.actor()));
+
+    EXPECT_THROW(
+        request_receive<UuidActor>(*(f.self), t, item_actor_atom_v, Uuid::generate()),
+        std::runtime_error);
+
+    // the rest of the clips, as for playback
+    request_receive<JsonStore>(*(f.self), t, item_actor_atom_v);
+    item = request_receive<Item>(*(f.self), t, item_atom_v);
+    for (const auto &i : item.children())
+        EXPECT_EQ(i.item_type() == IT_CLIP, bool(i.actor_addr()));
+
+    // inserted actors are adopted, not replaced
+    auto gap_uuid = Uuid::generate();
+    auto gap      = f.self->spawn<GapActor>(
+        "Gap", FrameRateDuration(10, timebase::k_flicks_24fps), gap_uuid);
+    request_receive<JsonStore>(
+        *(f.self), t, insert_item_atom_v, 0, UuidActorVector({UuidActor(gap_uuid, gap)}));
+    item = request_receive<Item>(*(f.self), t, item_atom_v);
+    EXPECT_EQ(item.cbegin()->actor_addr(), caf::actor_cast<caf::actor_addr>(gap));
+    EXPECT_EQ(request_receive<Item>(*(f.self), gap, item_atom_v).uuid(), gap_uuid);
+
+    f.self->send_exit(t, caf::exit_reason::user_shutdown);
+    f.self->send_exit(t2, caf::exit_reason::user_shutdown);
+}
@@ -0,0 +1,117 @@
+// SPDX-License-Identifier: Apache-2.0
+
+// Scrolls a synthetic session back and forth, asking for every role of each
+// visible row as a list view does, with and without the row cache. Not run
+// as part of the tests.
+//
+//   json_tree_row_cache_benchmark [rows]
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+
+#include <QString>
+#include <QUuid>
+
+#include "xstudio/ui/qml/json_tree_row_cache_ui.hpp"
+#include "xstudio/utility/logging.hpp"
+#include "xstudio/utility/uuid.hpp"
+
+using namespace xstudio;
+using namespace xstudio::utility;
+using namespace xstudio::ui::qml;
+
+namespace {
+
+enum Roles { nameRole = 256, uuidRole, countRole, flagRole };
+
+JsonTree make_session(const int rows) {
+    JsonTree root(R"({"name": "session"})"_json);
+    for (auto i = 0; i < rows; ++i) {
+        auto row = nlohmann::json::object();
+        row["name"]        = "media_" + std::to_string(i);
+        row["id"]          = Uuid::generate();
+        row["media_count"] = i;
+        row["flag"]        = "#FFFF0000";
+        root.insert(root.end(), JsonTree(row));
+    }
+    return root;
+}
+
+// What SessionModel::data() does without the cache.
+QVariant lookup(const JsonTree &node, const int role) {
+    const auto &j = node.data();
+    switch (role) {
+    case nameRole:
+        return QString::fromStdString(j.at("name").get<std::string>());
+    case uuidRole:
+        return QUuid::fromString(QString::fromStdString(j.at("id").get<std::string>()));
+    case countRole:
+        return j.at("media_count").get<int>();
+    case flagRole:
+        return QString::fromStdString(j.at("flag").get<std::string>());
+    }
+    return QVariant();
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+
+    start_logger(spdlog::level::info);
+
+    const int rows    = argc > 1 ? std::max(std::atoi(argv[1]), 100) : 10000;
+    const int visible = 50;
+    const int passes  = 10;
+
+    const auto session = make_session(rows);
+    std::vector<const JsonTree *> nodes;
+    for (const auto &i : session)
+        nodes.push_back(&i);
+
+    const std::vector<int> roles({nameRole, uuidRole, countRole, flagRole});
+
+    auto scroll = [&](const std::function<QVariant(const JsonTree *, int)> &data) {
+        size_t calls = 0;
+        for (auto pass = 0; pass < passes; ++pass) {
+            for (auto top = 0; top < rows - visible; ++top) {
+                for (auto r = top; r < top + visible; ++r) {
+                    for (const auto role : roles) {
+                        if (data(nodes[r], role).isValid())
+                            calls++;
+                    }
+                }
+            }
+        }
+        return calls;
+    };
+
+    spdlog::stopwatch sw;
+    const auto uncached_calls = scroll(
+        [](const JsonTree *node, const int role) { return lookup(*node, role); });
+    const auto uncached = sw.elapsed().count();
+
+    JSONTreeRowCache cache(roles);
+    sw.reset();
+    const auto cached_calls = scroll([&](const JsonTree *node, const int role) {
+        if (const auto value = cache.find(node, role))
+            return *value;
+        auto result = lookup(*node, role);
+        cache.store(node, role, result);
+        return result;
+    });
+    const auto cached = sw.elapsed().count();
+
+    spdlog::info(
+        "{} data() calls, json {:.3f} seconds, row cache {:.3f} seconds",
+        cached_calls,
+        uncached,
+        cached);
+
+    if (uncached_calls != cached_calls) {
+        spdlog::error("Row cache answered {} of {} calls", cached_calls, uncached_calls);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
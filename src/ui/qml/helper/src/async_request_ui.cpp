@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <algorithm>
+
+#include "xstudio/ui/qml/async_request_ui.hpp"
+
+CAF_PUSH_WARNINGS
+#include <QCoreApplication>
+#include <QThread>
+CAF_POP_WARNINGS
+
+using namespace xstudio;
+using namespace xstudio::ui::qml;
+
+BlockedCallMonitor &BlockedCallMonitor::instance() {
+    static BlockedCallMonitor monitor;
+    return monitor;
+}
+
+void BlockedCallMonitor::record(const char *site, const double seconds) {
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        auto &stats = stats_[site];
+        if (not stats.count_)
+            stats.site_ = site;
+        stats.count_++;
+        stats.total_ += seconds;
+        stats.max_ = std::max(stats.max_, seconds);
+    }
+
+    if (seconds > warn_threshold_)
+        spdlog::warn("{} blocked the UI for {:.3f} seconds", site, seconds);
+}
+
+std::vector<BlockedCallStats> BlockedCallMonitor::stats() const {
+    std::vector<BlockedCallStats> result;
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        result.reserve(stats_.size());
+        for (const auto &i : stats_)
+            result.push_back(i.second);
+    }
+
+    std::sort(result.begin(), result.end(), [](const auto &a, const auto &b) {
+        return a.total_ > b.total_;
+    });
+
+    return result;
+}
+
+void BlockedCallMonitor::reset() {
+    std::lock_guard<std::mutex> l(mutex_);
+    stats_.clear();
+}
+
+BlockedCallTimer::BlockedCallTimer(const char *site)
+    : site_(site),
+      gui_thread_(
+          QCoreApplication::instance() and
+          QThread::currentThread() == QCoreApplication::instance()->thread()) {}
+
+BlockedCallTimer::~BlockedCallTimer() {
+    if (gui_thread_)
+        BlockedCallMonitor::instance().record(site_, sw_.elapsed().count());
+}
+
+void AsyncRequests::finished(const std::string &key, const std::shared_ptr<Pending> &pending) {
+    if (key.empty())
+        return;
+
+    auto it = in_flight_.find(key);
+    if (it != in_flight_.end() and it->second == pending) {
+        in_flight_.erase(it);
+        send_waiting(key);
+    }
+}
+
+void AsyncRequests::send_waiting(const std::string &key) {
+    auto it = waiting_.find(key);
+    if (it != waiting_.end()) {
+        auto pending = it->second;
+        waiting_.erase(it);
+        in_flight_[key] = pending;
+        pending->send_();
+    }
+}
+
+void AsyncRequests::cancel(const std::string &key) {
+    for (auto *requests : {&in_flight_, &waiting_}) {
+        auto it = requests->find(key);
+        if (it != requests->end()) {
+            it->second->cancel();
+            requests->erase(it);
+        }
+    }
+}
+
+void AsyncRequests::cancel_invalid() {
+    for (auto it = waiting_.begin(); it != waiting_.end();) {
+        if (not it->second->wanted()) {
+            it->second->cancel();
+            it = waiting_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // what was waiting on a cancelled request is sent now
+    std::vector<std::string> cancelled;
+    for (auto it = in_flight_.begin(); it != in_flight_.end();) {
+        if (not it->second->wanted()) {
+            it->second->cancel();
+            cancelled.push_back(it->first);
+            it = in_flight_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    for (const auto &i : cancelled)
+        send_waiting(i);
+}
+
+void AsyncRequests::cancel_all() {
+    for (auto *requests : {&in_flight_, &waiting_}) {
+        for (auto &i : *requests)
+            i.second->cancel();
+        requests->clear();
+    }
+}
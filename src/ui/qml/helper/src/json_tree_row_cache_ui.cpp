@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <algorithm>
+#include <stdexcept>
+
+#include "xstudio/ui/qml/json_tree_row_cache_ui.hpp"
+
+using namespace xstudio;
+using namespace xstudio::ui::qml;
+
+JSONTreeRowCache::JSONTreeRowCache(const std::vector<int> &roles) { set_roles(roles); }
+
+void JSONTreeRowCache::set_roles(const std::vector<int> &roles) {
+    if (roles.size() > 64)
+        throw std::runtime_error("JSONTreeRowCache supports at most 64 roles");
+
+    clear();
+    role_column_.clear();
+    columns_.clear();
+
+    if (roles.empty())
+        return;
+
+    const auto [min_role, max_role] = std::minmax_element(roles.begin(), roles.end());
+    first_role_                      = *min_role;
+    role_column_.assign(*max_role - *min_role + 1, -1);
+
+    for (const auto role : roles) {
+        if (role_column_[role - first_role_] < 0) {
+            role_column_[role - first_role_] = static_cast<int>(columns_.size());
+            columns_.emplace_back();
+        }
+    }
+}
+
+const QVariant *JSONTreeRowCache::find(const utility::JsonTree *node, const int role) const {
+    const auto c = column(role);
+    if (c < 0)
+        return nullptr;
+
+    const auto p = slots_.find(node);
+    if (p == slots_.end() or not(valid_[p->second] & (uint64_t(1) << c))) {
+        misses_++;
+        return nullptr;
+    }
+
+    hits_++;
+    return &columns_[c][p->second];
+}
+
+void JSONTreeRowCache::store(
+    const utility::JsonTree *node, const int role, const QVariant &value) {
+    const auto c = column(role);
+    if (c < 0)
+        return;
+
+    auto p = slots_.find(node);
+    if (p == slots_.end()) {
+        uint32_t slot;
+        if (not free_slots_.empty()) {
+            slot = free_slots_.back();
+            free_slots_.pop_back();
+        } else {
+            slot = static_cast<uint32_t>(valid_.size());
+            valid_.push_back(0);
+            for (auto &i : columns_)
+                i.emplace_back();
+        }
+        p = slots_.emplace(node, slot).first;
+    }
+
+    columns_[c][p->second] = value;
+    valid_[p->second] |= uint64_t(1) << c;
+}
+
+void JSONTreeRowCache::invalidate(const utility::JsonTree *node, const bool recursive) {
+    if (slots_.empty())
+        return;
+
+    auto p = slots_.find(node);
+    if (p != slots_.end()) {
+        const auto slot = p->second;
+        valid_[slot]    = 0;
+        // release anything the values hold on to
+        for (auto &i : columns_)
+            i[slot] = QVariant();
+        free_slots_.push_back(slot);
+        slots_.erase(p);
+    }
+
+    if (recursive) {
+        for (auto it = node->cbegin(); it != node->cend(); ++it)
+            invalidate(&(*it), true);
+    }
+}
+
+void JSONTreeRowCache::clear() {
+    slots_.clear();
+    free_slots_.clear();
+    valid_.clear();
+    for (auto &i : columns_)
+        i.clear();
+}
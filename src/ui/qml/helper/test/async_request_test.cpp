@@ -0,0 +1,141 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "xstudio/ui/qml/async_request_ui.hpp"
+#include "xstudio/utility/caf_helpers.hpp"
+
+CAF_PUSH_WARNINGS
+#include <QCoreApplication>
+#include <QStandardItemModel>
+CAF_POP_WARNINGS
+
+using namespace caf;
+using namespace xstudio;
+using namespace xstudio::ui::qml;
+
+ACTOR_TEST_MINIMAL()
+
+namespace {
+
+bool wait_for(const std::function<bool()> &done) {
+    for (auto i = 0; i < 500 and not done(); ++i) {
+        QCoreApplication::processEvents();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return done();
+}
+
+} // namespace
+
+TEST(BlockedCallMonitorTest, Test) {
+    auto &monitor = BlockedCallMonitor::instance();
+    monitor.reset();
+
+    static const char *fast = "fast";
+    static const char *slow = "slow";
+
+    monitor.record(fast, 0.01);
+    monitor.record(fast, 0.02);
+    monitor.record(slow, 0.5);
+
+    const auto stats = monitor.stats();
+    ASSERT_EQ(stats.size(), size_t(2));
+    EXPECT_EQ(stats[0].site_, "slow");
+    EXPECT_EQ(stats[1].count_, size_t(2));
+    EXPECT_NEAR(stats[1].total_, 0.03, 1e-9);
+    EXPECT_NEAR(stats[1].max_, 0.02, 1e-9);
+
+    // not on the Qt thread, there's no application
+    { BlockedCallTimer timer("timer"); }
+    EXPECT_EQ(monitor.stats().size(), size_t(2));
+
+    monitor.reset();
+    EXPECT_TRUE(monitor.stats().empty());
+}
+
+TEST(AsyncRequestsTest, Test) {
+    fixture f;
+    int argc = 0;
+    QCoreApplication app(argc, nullptr);
+    QObject context;
+    AsyncRequests requests(&context);
+
+    std::atomic<int> received{0};
+    auto doubler = f.system.spawn([&received]() -> caf::behavior {
+        return {[&received](const int value) {
+            received++;
+            return value * 2;
+        }};
+    });
+
+    // joined, those made while one is in flight are sent once after it
+    std::vector<int> results;
+    auto future = requests.request<int>(
+        "double", [&](const int v) { results.push_back(v); }, f.system, doubler, 2);
+    requests.request<int>(
+        "double", [&](const int v) { results.push_back(v + 1); }, f.system, doubler, 2);
+    requests.request<int>(
+        "double", [&](const int v) { results.push_back(v + 2); }, f.system, doubler, 2);
+    EXPECT_EQ(requests.in_flight(), size_t(1));
+    EXPECT_EQ(requests.waiting(), size_t(1));
+
+    ASSERT_TRUE(wait_for([&]() { return results.size() == 3; }));
+    EXPECT_EQ(results, std::vector<int>({4, 5, 6}));
+    EXPECT_EQ(received.load(), 2);
+    EXPECT_EQ(future.result(), 4);
+    EXPECT_EQ(requests.in_flight(), size_t(0));
+    EXPECT_EQ(requests.waiting(), size_t(0));
+
+    // replaced, only the newest is sent, after the one in flight
+    results.clear();
+    auto superseded = requests.replace<int>(
+        "set", [&](const int v) { results.push_back(v); }, f.system, doubler, 10);
+    auto dropped = requests.replace<int>(
+        "set", [&](const int v) { results.push_back(v); }, f.system, doubler, 20);
+    requests.replace<int>(
+        "set", [&](const int v) { results.push_back(v); }, f.system, doubler, 30);
+    EXPECT_TRUE(superseded.isCanceled());
+    EXPECT_TRUE(dropped.isCanceled());
+    EXPECT_EQ(requests.in_flight(), size_t(1));
+    EXPECT_EQ(requests.waiting(), size_t(1));
+
+    ASSERT_TRUE(wait_for([&]() { return requests.in_flight() == 0; }));
+    EXPECT_EQ(results, std::vector<int>({60}));
+    EXPECT_EQ(received.load(), 4);
+
+    // tied to an index that goes away
+    QStandardItemModel model;
+    model.appendRow(new QStandardItem("row"));
+    results.clear();
+    requests.request<int>(
+        "row",
+        QPersistentModelIndex(model.index(0, 0)),
+        [&](const int v) { results.push_back(v); },
+        f.system,
+        doubler,
+        3);
+    model.removeRow(0);
+    requests.cancel_invalid();
+    EXPECT_EQ(requests.in_flight(), size_t(0));
+
+    // cancelled
+    auto cancelled = requests.request<int>(
+        "cancel", [&](const int v) { results.push_back(v); }, f.system, doubler, 4);
+    requests.cancel("cancel");
+    EXPECT_TRUE(cancelled.isCanceled());
+
+    ASSERT_TRUE(wait_for([&]() { return received == 6; }));
+    QCoreApplication::processEvents();
+    EXPECT_TRUE(results.empty());
+
+    // errors end up in the future
+    auto failed = requests.request<std::string>(
+        "", [&](const std::string &) { results.push_back(0); }, f.system, doubler, 5);
+    ASSERT_TRUE(wait_for([&]() { return failed.isFinished(); }));
+    EXPECT_THROW(failed.waitForFinished(), XStudioError);
+    EXPECT_TRUE(results.empty());
+
+    f.self->send_exit(doubler, caf::exit_reason::user_shutdown);
+}
@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include <QString>
+#include <QUuid>
+
+#include "xstudio/ui/qml/json_tree_row_cache_ui.hpp"
+#include "xstudio/utility/logging.hpp"
+#include "xstudio/utility/uuid.hpp"
+
+using namespace xstudio;
+using namespace xstudio::utility;
+using namespace xstudio::ui::qml;
+
+namespace {
+
+enum Roles { nameRole = 256, uuidRole, countRole, flagRole, otherRole };
+
+JsonTree make_session(const int rows) {
+    JsonTree root(R"({"name": "session"})"_json);
+    for (auto i = 0; i < rows; ++i) {
+        auto row = nlohmann::json::object();
+        row["name"]        = "media_" + std::to_string(i);
+        row["id"]          = Uuid::generate();
+        row["media_count"] = i;
+        row["flag"]        = "#FFFF0000";
+        root.insert(root.end(), JsonTree(row));
+    }
+    return root;
+}
+
+// What SessionModel::data() does without the cache.
+QVariant lookup(const JsonTree &node, const int role) {
+    const auto &j = node.data();
+    switch (role) {
+    case nameRole:
+        return QString::fromStdString(j.at("name").get<std::string>());
+    case uuidRole:
+        return QUuid::fromString(QString::fromStdString(j.at("id").get<std::string>()));
+    case countRole:
+        return j.at("media_count").get<int>();
+    case flagRole:
+        return QString::fromStdString(j.at("flag").get<std::string>());
+    }
+    return QVariant();
+}
+
+} // namespace
+
+TEST(JSONTreeRowCacheTest, Test) {
+    auto session = make_session(3);
+    auto &row    = *session.begin();
+
+    JSONTreeRowCache cache({nameRole, uuidRole, countRole});
+
+    EXPECT_TRUE(cache.is_cached_role(nameRole));
+    EXPECT_FALSE(cache.is_cached_role(flagRole));
+    EXPECT_FALSE(cache.is_cached_role(Qt::DisplayRole));
+
+    EXPECT_EQ(cache.find(&row, nameRole), nullptr);
+    EXPECT_EQ(cache.misses(), size_t(1));
+
+    cache.store(&row, nameRole, lookup(row, nameRole));
+    cache.store(&row, countRole, lookup(row, countRole));
+    // not a cached role, ignored
+    cache.store(&row, flagRole, lookup(row, flagRole));
+
+    ASSERT_NE(cache.find(&row, nameRole), nullptr);
+    EXPECT_EQ(cache.find(&row, nameRole)->toString(), QString("media_0"));
+    EXPECT_EQ(cache.find(&row, countRole)->toInt(), 0);
+    EXPECT_EQ(cache.find(&row, uuidRole), nullptr);
+    EXPECT_EQ(cache.find(&row, flagRole), nullptr);
+    EXPECT_EQ(cache.hits(), size_t(3));
+    EXPECT_EQ(cache.size(), size_t(1));
+
+    cache.invalidate(&row);
+    EXPECT_EQ(cache.find(&row, nameRole), nullptr);
+    EXPECT_EQ(cache.size(), size_t(0));
+
+    // slots are reused
+    for (const auto &i : session)
+        cache.store(&i, nameRole, lookup(i, nameRole));
+    EXPECT_EQ(cache.size(), size_t(3));
+
+    // recursive from the parent drops all the children
+    cache.invalidate(&session, true);
+    EXPECT_EQ(cache.size(), size_t(0));
+
+    cache.store(&row, nameRole, lookup(row, nameRole));
+    cache.clear();
+    EXPECT_EQ(cache.find(&row, nameRole), nullptr);
+
+    cache.set_roles({flagRole});
+    EXPECT_FALSE(cache.is_cached_role(nameRole));
+    EXPECT_TRUE(cache.is_cached_role(flagRole));
+}
+
+// Scroll a session back and forth, asking for every role of each visible
+// row as a list view does, each row's json is only looked up once.
+TEST(JSONTreeRowCacheTest, Scroll) {
+    const int rows    = 200;
+    const int visible = 20;
+
+    const auto session = make_session(rows);
+    std::vector<const JsonTree *> nodes;
+    for (const auto &i : session)
+        nodes.push_back(&i);
+
+    const std::vector<int> roles({nameRole, uuidRole, countRole, flagRole});
+    JSONTreeRowCache cache(roles);
+
+    for (auto pass = 0; pass < 2; ++pass) {
+        for (auto top = 0; top < rows - visible; ++top) {
+            for (auto r = top; r < top + visible; ++r) {
+                for (const auto role : roles) {
+                    const auto expected = lookup(*nodes[r], role);
+                    if (const auto value = cache.find(nodes[r], role)) {
+                        EXPECT_EQ(*value, expected);
+                    } else {
+                        cache.store(nodes[r], role, expected);
+                    }
+                }
+            }
+        }
+    }
+
+    EXPECT_EQ(cache.misses(), size_t(rows * roles.size()));
+    EXPECT_EQ(cache.size(), size_t(rows));
+}
@@ -73,6 +73,90 @@ SessionModel::SessionModel(QObject *parent) : super(parent) {
     setRoleNames(role_names);
     request_handler_ = new QThreadPool(this);
     request_handler_->setMaxThreadCount(8);
+
+    // roles whose value depends only on the row's own json, these are served
+    // from the row cache once looked up.
+    row_cache_.set_roles(
+        {Qt::DisplayRole,
+         JSONTreeModel::Roles::idRole,
+         Roles::activeDurationRole,
+         Roles::activeRangeValidRole,
+         Roles::activeStartRole,
+         Roles::actorRole,
+         Roles::actorUuidRole,
+         Roles::audioActorUuidRole,
+         Roles::availableDurationRole,
+         Roles::availableStartRole,
+         Roles::bitDepthRole,
+         Roles::bookmarkUuidsRole,
+         Roles::busyRole,
+         Roles::clipMediaUuidRole,
+         Roles::containerUuidRole,
+         Roles::enabledRole,
+         Roles::errorRole,
+         Roles::expandedRole,
+         Roles::formatRole,
+         Roles::groupActorRole,
+         Roles::imageActorUuidRole,
+         Roles::lockedRole,
+         Roles::mediaCountRole,
+         Roles::mediaDisplayInfoRole,
+         Roles::mediaStatusRole,
+         Roles::mtimeRole,
+         Roles::nameRole,
+         Roles::pathRole,
+         Roles::pathShakeRole,
+         Roles::pixelAspectRole,
+         Roles::placeHolderRole,
+         Roles::rateFPSRole,
+         Roles::rateFPSStringRole,
+         Roles::resolutionRole,
+         Roles::rotationRole,
+         Roles::selectionRole,
+         Roles::thumbnailURLRole,
+         Roles::timecodeAsFramesRole,
+         Roles::trimmedDurationRole,
+         Roles::trimmedStartRole,
+         Roles::typeRole,
+         Roles::uuidRole});
+
+    // Every change to a row's json is followed by dataChanged, and these
+    // connections are made before any view's so the cache is invalidated
+    // before views ask for the new values.
+    connect(
+        this,
+        &QAbstractItemModel::dataChanged,
+        this,
+        [this](const QModelIndex &top_left, const QModelIndex &bottom_right) {
+            if (not top_left.isValid())
+                return;
+            for (auto row = top_left.row(); row <= bottom_right.row(); ++row) {
+                const auto i = top_left.siblingAtRow(row);
+                if (i.isValid())
+                    row_cache_.invalidate(indexToTree(i));
+            }
+        });
+
+    connect(
+        this,
+        &QAbstractItemModel::rowsAboutToBeRemoved,
+        this,
+        [this](const QModelIndex &parent, const int first, const int last) {
+            for (auto row = first; row <= last; ++row) {
+                const auto i = index(row, 0, parent);
+                if (i.isValid())
+                    row_cache_.invalidate(indexToTree(i), true);
+            }
+        });
+
+    connect(this, &QAbstractItemModel::modelAboutToBeReset, this, [this]() {
+        row_cache_.clear();
+    });
+
+    // responses for rows that have gone aren't wanted
+    connect(this, &QAbstractItemModel::rowsRemoved, this, [this]() {
+        async_requests_.cancel_invalid();
+    });
 }
 
 void SessionModel::fetchMore(const QModelIndex &parent) {
@@ -257,6 +341,22 @@ bool SessionModel::isChildOf(const QModelIndex &parent, const QModelIndex &child
 }
 
 QVariant SessionModel::data(const QModelIndex &index, int role) const {
+    if (not index.isValid() or not row_cache_.is_cached_role(role))
+        return jsonData(index, role);
+
+    const auto node = static_cast<const utility::JsonTree *>(index.internalPointer());
+    if (const auto value = row_cache_.find(node, role))
+        return *value;
+
+    // invalid results aren't cached, they may be waiting on a requestData
+    auto result = jsonData(index, role);
+    if (result.isValid())
+        row_cache_.store(node, role, result);
+
+    return result;
+}
+
+QVariant SessionModel::jsonData(const QModelIndex &index, int role) const {
     auto result = QVariant();
 
     START_SLOW_WATCHER()
@@ -1345,12 +1445,16 @@ bool SessionModel::setData(const QModelIndex &index, const QVariant &qvalue, int
                         result    = true;
 
                         if (type == "MediaSource") {
-                            scoped_actor sys{system()};
-
-                            auto mr = request_receive<MediaReference>(
-                                *sys, actor, media::media_reference_atom_v);
-                            mr.set_rate(fr);
-                            anon_mail(media::media_reference_atom_v, mr).send(actor);
+                            async_requests_.request<MediaReference>(
+                                "",
+                                [actor, fr](const MediaReference &media_reference) {
+                                    auto mr = media_reference;
+                                    mr.set_rate(fr);
+                                    anon_mail(media::media_reference_atom_v, mr).send(actor);
+                                },
+                                system(),
+                                actor,
+                                media::media_reference_atom_v);
                         } else if (type == "Session") {
                             anon_mail(session::media_rate_atom_v, fr).send(session_actor_);
                         }
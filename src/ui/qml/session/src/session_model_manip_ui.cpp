@@ -93,6 +93,7 @@ SessionModel::removeRows(int row, int count, const bool deep, const QModelIndex
 
 
 bool SessionModel::duplicateRows(int row, int count, const QModelIndex &parent) {
+    BLOCKED_CALL_WATCHER()
     // auto can_duplicate = false;
     auto result = false;
     // spdlog::warn("duplicateRows {} {}", row, count);
@@ -217,6 +218,7 @@ bool SessionModel::duplicateRows(int row, int count, const QModelIndex &parent)
 
 QModelIndexList SessionModel::copyRows(
     const QModelIndexList &indexes, const int row, const QModelIndex &parent) {
+    BLOCKED_CALL_WATCHER()
     // only media to subset and playlists.
     // make sure indexes are valid.. count..
     // if parent is playlist the media needs to be inserted in the media child.
@@ -355,6 +357,7 @@ QModelIndexList SessionModel::moveRows(
     const int q_row,
     const QModelIndex &parent,
     const bool doCopy) {
+    BLOCKED_CALL_WATCHER()
 
     QModelIndexList result;
     try {
@@ -462,6 +465,7 @@ QModelIndexList SessionModel::insertRows(
     const QString &qname,
     const QModelIndex &parent,
     const bool sync) {
+    BLOCKED_CALL_WATCHER()
 
     auto result = QModelIndexList();
 
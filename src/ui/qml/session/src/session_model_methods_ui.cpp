@@ -29,6 +29,7 @@ void SessionModel::removeNotification(const QModelIndex &index, const QUuid &uui
 }
 
 QString SessionModel::getNextName(const QString &nameTemplate) const {
+    BLOCKED_CALL_WATCHER()
     QString result = nameTemplate;
 
     scoped_actor sys{system()};
@@ -218,74 +219,103 @@ Q_INVOKABLE void SessionModel::purgePlaylist(const QModelIndex &index) {
 }
 
 void SessionModel::updateCurrentMediaContainerIndexFromBackend() {
+    // spammed by backend events, so one request is in flight at a time with
+    // at most one more waiting to pick up changes made since it was sent
+    async_requests_.request<UuidActor>(
+        "active_media_container",
+        [this](const UuidActor &playlist) {
+            auto actor_string = QStringFromStd(actorToString(system(), playlist.actor()));
+
+            // playlists are in 2nd row of root of the session model. We only need to go 2
+            // levels deep to see all playlists and subsets/timelines which are children of
+            // playlists
+            auto r = QPersistentModelIndex(
+                searchRecursive(actor_string, "actorRole", index(1, 0), 2));
+
+            if (!r.isValid() && playlist) {
+                // we didn't find the actor in the model ... this could be that the model is
+                // still building so re-try in 250ms
+                QTimer::singleShot(
+                    250, this, SLOT(updateCurrentMediaContainerIndexFromBackend()));
+            }
 
-    scoped_actor sys{system()};
-    try {
-        auto playlist = request_receive<UuidActor>(
-            *sys, session_actor_, session::active_media_container_atom_v);
-        auto actor_string = QStringFromStd(actorToString(system(), playlist.actor()));
-
-        // playlists are in 2nd row of root of the session model. We only need to go 2 levels
-        // deep to see all playlists and subsets/timelines which are children of playlists
-        auto r =
-            QPersistentModelIndex(searchRecursive(actor_string, "actorRole", index(1, 0), 2));
-
-        if (!r.isValid() && playlist) {
-            // we didn't find the actor in the model ... this could be that the model is
-            // still building so re-try in 250ms
-            QTimer::singleShot(250, this, SLOT(updateCurrentMediaContainerIndexFromBackend()));
-        }
-
-        if (r != current_playlist_index_) {
-            current_playlist_index_ = r;
-            emit currentMediaContainerChanged();
-        }
-
-    } catch (const std::exception &e) {
-        spdlog::warn("{} {}", __PRETTY_FUNCTION__, e.what());
-    }
+            if (r != current_playlist_index_) {
+                current_playlist_index_ = r;
+                emit currentMediaContainerChanged();
+            }
+        },
+        system(),
+        session_actor_,
+        session::active_media_container_atom_v);
 }
 
 void SessionModel::updateViewportCurrentMediaContainerIndexFromBackend() {
-    scoped_actor sys{system()};
-    try {
-
-        auto playlist = request_receive<UuidActor>(
-            *sys, session_actor_, session::viewport_active_media_container_atom_v);
-        auto actor_string = QStringFromStd(actorToString(system(), playlist.actor()));
-
-        // playlists are in 2nd row of root of the session model. We only need to go 2 levels
-        // deep to see all playlists and subsets/timelines which are children of playlists
-        auto r =
-            QPersistentModelIndex(searchRecursive(actor_string, "actorRole", index(1, 0), 2));
+    async_requests_.request<UuidActor>(
+        "viewport_active_media_container",
+        [this](const UuidActor &playlist) {
+            auto actor_string = QStringFromStd(actorToString(system(), playlist.actor()));
+
+            // playlists are in 2nd row of root of the session model. We only need to go 2
+            // levels deep to see all playlists and subsets/timelines which are children of
+            // playlists
+            auto r = QPersistentModelIndex(
+                searchRecursive(actor_string, "actorRole", index(1, 0), 2));
+
+            if (!r.isValid() && playlist) {
+                // we didn't find the actor in the model ... this could be that the model is
+                // still building so re-try in 250ms
+                QTimer::singleShot(
+                    250, this, SLOT(updateViewportCurrentMediaContainerIndexFromBackend()));
+            }
 
-        if (!r.isValid() && playlist) {
-            // we didn't find the actor in the model ... this could be that the model is
-            // still building so re-try in 250ms
-            QTimer::singleShot(
-                250, this, SLOT(updateViewportCurrentMediaContainerIndexFromBackend()));
-        }
+            if (r != current_playhead_owner_index_) {
+                current_playhead_owner_index_ = r;
+                emit viewportCurrentMediaContainerIndexChanged();
+            }
+        },
+        system(),
+        session_actor_,
+        session::viewport_active_media_container_atom_v);
+
+    auto playhead_events_actor =
+        system().registry().template get<caf::actor>(global_playhead_events_actor);
+
+    async_requests_.request<caf::actor>(
+        "viewport_playhead",
+        [this](const caf::actor &playhead) {
+            if (playhead)
+                async_requests_.request<utility::Uuid>(
+                    "viewport_playhead_uuid",
+                    [this](const utility::Uuid &uuid) {
+                        on_screen_playhead_uuid_ = QUuidFromUuid(uuid);
+                        emit onScreenPlayheadUuidChanged();
+                    },
+                    system(),
+                    playhead,
+                    utility::uuid_atom_v);
+        },
+        system(),
+        playhead_events_actor,
+        ui::viewport::viewport_playhead_atom_v);
+}
 
-        if (r != current_playhead_owner_index_) {
-            current_playhead_owner_index_ = r;
-            emit viewportCurrentMediaContainerIndexChanged();
-        }
+QVariantList SessionModel::blockedCallStats() const {
+    QVariantList result;
 
-        auto playhead_events_actor =
-            system().registry().template get<caf::actor>(global_playhead_events_actor);
-        auto playhead = request_receive<caf::actor>(
-            *sys, playhead_events_actor, ui::viewport::viewport_playhead_atom_v);
-        if (playhead) {
-            on_screen_playhead_uuid_ = QUuidFromUuid(
-                request_receive<utility::Uuid>(*sys, playhead, utility::uuid_atom_v));
-            emit onScreenPlayheadUuidChanged();
-        }
-
-    } catch (const std::exception &e) {
-        spdlog::debug("{} {}", __PRETTY_FUNCTION__, e.what());
+    for (const auto &i : BlockedCallMonitor::instance().stats()) {
+        QVariantMap entry;
+        entry["site"]  = QStringFromStd(i.site_);
+        entry["count"] = static_cast<qulonglong>(i.count_);
+        entry["total"] = i.total_;
+        entry["max"]   = i.max_;
+        result.append(entry);
     }
+
+    return result;
 }
 
+void SessionModel::resetBlockedCallStats() const { BlockedCallMonitor::instance().reset(); }
+
 
 Q_INVOKABLE void SessionModel::decomposeMedia(const QModelIndexList &indexes) {
     for (const auto &i : indexes) {
@@ -293,18 +323,15 @@ Q_INVOKABLE void SessionModel::decomposeMedia(const QModelIndexList &indexes) {
             auto plindex = getPlaylistIndex(i);
             if (plindex.isValid()) {
                 auto actor = actorFromQString(system(), plindex.data(actorRole).toString());
-                if (actor) {
-                    try {
-                        scoped_actor sys{system()};
-                        request_receive<utility::UuidActorVector>(
-                            *sys,
-                            actor,
-                            media::decompose_atom_v,
-                            UuidFromQUuid(i.data(actorUuidRole).toUuid()));
-                    } catch (std::exception &e) {
-                        spdlog::warn("{} {}", __PRETTY_FUNCTION__, e.what());
-                    }
-                }
+                // the new media arrives through the playlist's change events
+                if (actor)
+                    async_requests_.request<utility::UuidActorVector>(
+                        "",
+                        [](const utility::UuidActorVector &) {},
+                        system(),
+                        actor,
+                        media::decompose_atom_v,
+                        UuidFromQUuid(i.data(actorUuidRole).toUuid()));
             }
         }
     }
@@ -427,6 +454,7 @@ QStringList SessionModel::setMediaSource(
 }
 
 void SessionModel::setSessionActorAddr(const QString &addr) {
+    BLOCKED_CALL_WATCHER()
     try {
         if (addr != session_actor_addr_) {
             scoped_actor sys{system()};
@@ -1662,14 +1690,14 @@ void SessionModel::setCurrentMediaContainer(const QModelIndex &index) {
         auto cuuid  = UuidFromQUuid(index.data(actorUuidRole).toUuid());
         auto cactor = actorFromQString(system(), index.data(actorRole).toString());
 
-        scoped_actor sys{system()};
-        request_receive<bool>(
-            *sys,
+        // only the newest selection is sent, after any still in flight
+        async_requests_.replace<bool>(
+            "set_active_media_container",
+            [this](const bool) { updateCurrentMediaContainerIndexFromBackend(); },
+            system(),
             session_actor_,
             session::active_media_container_atom_v,
             UuidActor(cuuid, cactor));
-
-        updateCurrentMediaContainerIndexFromBackend();
     }
 }
 
@@ -1686,14 +1714,13 @@ void SessionModel::setViewportCurrentMediaContainerIndex(const QModelIndex &inde
             // This is the 'viewed' playlist
             // const bool viewed = true;
 
-            scoped_actor sys{system()};
-            request_receive<bool>(
-                *sys,
+            async_requests_.replace<bool>(
+                "set_viewport_active_media_container",
+                [this](const bool) { updateViewportCurrentMediaContainerIndexFromBackend(); },
+                system(),
                 session_actor_,
                 session::viewport_active_media_container_atom_v,
                 UuidActor(cuuid, cactor));
-
-            updateViewportCurrentMediaContainerIndexFromBackend();
         }
 
     } catch (const std::exception &err) {
@@ -185,6 +185,7 @@ QVariantList SessionModel::mediaFrameToTimelineFrames(
     const QModelIndex &mediaIndex,
     const int logicalMediaFrame,
     const bool skipDisabled) {
+    BLOCKED_CALL_WATCHER()
 
     // given the index of a media item, and a logical frame into that media,
     // we want to return the corresponding timeline logical frames - i.e. the
@@ -375,6 +376,7 @@ int SessionModel::getTimelineFrameFromClip(
 }
 
 int SessionModel::getNextTimelineClipFrame(const QModelIndex &timelineIndex, const int frame) {
+    BLOCKED_CALL_WATCHER()
     auto result = frame;
 
     auto tactor = actorFromQString(system(), timelineIndex.data(actorRole).toString());
@@ -415,6 +417,7 @@ int SessionModel::getNextTimelineClipFrame(const QModelIndex &timelineIndex, con
 
 int SessionModel::getPreviousTimelineClipFrame(
     const QModelIndex &timelineIndex, const int frame) {
+    BLOCKED_CALL_WATCHER()
     auto result = 0;
 
     auto tactor = actorFromQString(system(), timelineIndex.data(actorRole).toString());
@@ -598,6 +601,7 @@ QModelIndex SessionModel::getTimelineIndex(const QModelIndex &index) const {
 }
 
 QVariantList SessionModel::getTimelineExportTypes() const {
+    BLOCKED_CALL_WATCHER()
     auto result = QVariantList();
     caf::scoped_actor sys(system());
     auto global = system().registry().template get<caf::actor>(global_registry);
@@ -612,6 +616,7 @@ QVariantList SessionModel::getTimelineExportTypes() const {
 }
 
 QVariant SessionModel::getTimelineFullRangeAndLoopRangeAndFPS(const QModelIndex &tindex) {
+    BLOCKED_CALL_WATCHER()
 
     QVariant result;
     try {
@@ -645,6 +650,7 @@ QVariant SessionModel::getTimelineFullRangeAndLoopRangeAndFPS(const QModelIndex
 }
 
 QVariantList SessionModel::getAllContainerMediaFPS(const QModelIndex &tindex) {
+    BLOCKED_CALL_WATCHER()
 
     QVariantList result;
     try {
@@ -728,9 +734,15 @@ bool SessionModel::removeTimelineItems(
             auto actor = actorFromQString(system(), track_index.data(actorRole).toString());
 
             if (type == "Audio Track" or type == "Video Track") {
-                scoped_actor sys{system()};
-                request_receive<JsonStore>(
-                    *sys, actor, timeline::erase_item_at_frame_atom_v, frame, duration, false);
+                async_requests_.request<JsonStore>(
+                    "",
+                    [](const JsonStore &) {},
+                    system(),
+                    actor,
+                    timeline::erase_item_at_frame_atom_v,
+                    frame,
+                    duration,
+                    false);
                 result = true;
             }
         }
@@ -975,11 +987,12 @@ bool SessionModel::removeTimelineItems(const QModelIndexList &indexes, const boo
                     if (locked)
                         continue;
 
-                    caf::scoped_actor sys(system());
                     auto pactor =
                         actorFromQString(system(), parent_index.data(actorRole).toString());
                     auto uuid = UuidFromQUuid(i.data(JSONTreeModel::Roles::idRole).toUuid());
 
+                    // items are erased by uuid, so the order the requests are
+                    // handled in doesn't matter
                     if (pactor) {
                         if (type == "Clip") {
                             // replace with gap
@@ -997,11 +1010,23 @@ bool SessionModel::removeTimelineItems(const QModelIndexList &indexes, const boo
                             //     timeline::insert_item_atom_v,
                             //     row,
                             //     UuidActorVector({UuidActor(uuid, gap)}));
-                            request_receive<JsonStore>(
-                                *sys, pactor, timeline::erase_item_atom_v, uuid, not isRipple);
+                            async_requests_.request<JsonStore>(
+                                "",
+                                [](const JsonStore &) {},
+                                system(),
+                                pactor,
+                                timeline::erase_item_atom_v,
+                                uuid,
+                                not isRipple);
                         } else {
-                            request_receive<JsonStore>(
-                                *sys, pactor, timeline::erase_item_atom_v, uuid, false);
+                            async_requests_.request<JsonStore>(
+                                "",
+                                [](const JsonStore &) {},
+                                system(),
+                                pactor,
+                                timeline::erase_item_atom_v,
+                                uuid,
+                                false);
                         }
                     }
                 }
@@ -1410,6 +1435,7 @@ QModelIndex SessionModel::insertTimelineGap(
     const int frames,
     const double rate,
     const QString &qname) {
+    BLOCKED_CALL_WATCHER()
     auto result = QModelIndex();
 
     try {
@@ -1501,6 +1527,7 @@ QModelIndex SessionModel::insertTimelineClip(
     const QModelIndex &parent,
     const QModelIndex &mediaIndex,
     const QString &qname) {
+    BLOCKED_CALL_WATCHER()
     auto result = QModelIndex();
 
     try {
@@ -1556,6 +1583,7 @@ QModelIndex SessionModel::insertTimelineClip(
 }
 
 QModelIndex SessionModel::splitTimelineClip(const int frame, const QModelIndex &index) {
+    BLOCKED_CALL_WATCHER()
     auto result = QModelIndex();
 
     // only makes sense in Clip, Gap / Track ?
@@ -1619,14 +1647,12 @@ bool SessionModel::moveTimelineItem(const QModelIndex &index, const int distance
                                         ? actorFromString(system(), pj.at("actor"))
                                         : caf::actor();
 
-                scoped_actor sys{system()};
-                request_receive<JsonStore>(
-                    *sys,
-                    parent_actor,
-                    timeline::move_item_atom_v,
-                    index.row(),
-                    1,
-                    index.row() + real_distance);
+                // Moves are by row, so they must reach the track in the order
+                // they're made. Sent from this thread, not from a request actor
+                // each, they do.
+                anon_mail(
+                    timeline::move_item_atom_v, index.row(), 1, index.row() + real_distance)
+                    .send(parent_actor);
 
                 result = true;
             }
@@ -1654,9 +1680,11 @@ bool SessionModel::moveRangeTimelineItems(
                                    ? actorFromString(system(), pj.at("actor"))
                                    : caf::actor();
 
-            scoped_actor sys{system()};
-            auto event = request_receive<JsonStore>(
-                *sys,
+            // the model follows from the track's change events
+            async_requests_.request<JsonStore>(
+                "",
+                [](const JsonStore &) {},
+                system(),
                 track_actor,
                 timeline::move_item_at_frame_atom_v,
                 frame,
@@ -1664,8 +1692,6 @@ bool SessionModel::moveRangeTimelineItems(
                 dest,
                 insert,
                 true);
-            if (not wait_for_event(timeline::get_event_id(event).back()))
-                spdlog::warn("event timed out");
 
             result = true;
         }
@@ -74,6 +74,17 @@ caf::actor SessionModel::actorFromIndex(const QModelIndex &index, const bool try
                                           ? actorFromString(system(), j.at("actor"))
                                           : caf::actor();
 
+            // gaps and clips in lightweight tracks have no actor until their track
+            // is asked for one, the track announces it (IA_ADDR) and actorRole
+            // updates, so we don't wait on it here
+            const auto type = j.value("type", "");
+            if (not result and (type == "Gap" or type == "Clip") and
+                index.parent().isValid()) {
+                if (auto track = actorFromIndex(index.parent()))
+                    anon_mail(timeline::item_actor_atom_v, j.at("id").get<utility::Uuid>())
+                        .send(track);
+            }
+
             if (not result and try_parent) {
                 QModelIndex pindex = index.parent();
                 if (pindex.isValid()) {
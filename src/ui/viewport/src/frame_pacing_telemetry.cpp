@@ -0,0 +1,180 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <sstream>
+
+#include "xstudio/ui/viewport/frame_pacing_telemetry.hpp"
+
+using namespace xstudio::ui::viewport;
+using namespace xstudio::utility;
+using namespace xstudio;
+
+namespace {
+
+int64_t to_micros(const timebase::flicks &f) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(f).count();
+}
+
+int64_t to_micros(const utility::time_point &tp) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(tp.time_since_epoch())
+        .count();
+}
+
+// index of the frame that contains the given position, assuming frames are
+// laid out at regular intervals from 'origin'
+int64_t frame_index(
+    const timebase::flicks &position,
+    const timebase::flicks &origin,
+    const timebase::flicks &frame_duration) {
+    const auto d = (position - origin).count();
+    const auto f = frame_duration.count();
+    return d >= 0 ? d / f : -((f - 1 - d) / f);
+}
+
+} // namespace
+
+void FramePacingTelemetry::record(
+    const utility::Uuid &playhead_id, FramePacingSample sample) {
+
+    if (!enabled_ || (!sample.playing_ && !record_when_stopped_))
+        return;
+
+    auto &samples = samples_per_playhead_[playhead_id];
+
+    if (sample.frame_duration_ > timebase::k_flicks_zero_seconds) {
+
+        // how many whole frames is the picked frame away from where it
+        // should be?
+        sample.frames_off_ = int(frame_index(
+            sample.ideal_position_, sample.chosen_position_, sample.frame_duration_));
+
+        if (!samples.empty() && sample.playing_ && samples.back().playing_) {
+            const auto &prev = samples.back();
+            if (prev.chosen_position_ == sample.chosen_position_) {
+                // same frame as last time. That's fine (pulldown) unless
+                // the ideal frame has moved on
+                sample.repeated_ =
+                    frame_index(
+                        sample.ideal_position_,
+                        sample.chosen_position_,
+                        sample.frame_duration_) !=
+                    frame_index(
+                        prev.ideal_position_, sample.chosen_position_, sample.frame_duration_);
+            } else {
+                sample.dropped_ =
+                    std::max(0, std::abs(sample.chosen_frame_ - prev.chosen_frame_) - 1);
+            }
+        }
+    }
+
+    samples.push_back(sample);
+    while (samples.size() > capacity_)
+        samples.pop_front();
+}
+
+void FramePacingTelemetry::set_capacity(const size_t capacity) {
+    capacity_ = std::max(size_t(1), capacity);
+    for (auto &p : samples_per_playhead_) {
+        while (p.second.size() > capacity_)
+            p.second.pop_front();
+    }
+}
+
+const std::deque<FramePacingSample> &
+FramePacingTelemetry::samples(const utility::Uuid &playhead_id) const {
+    static const Samples empty;
+    auto p = samples_per_playhead_.find(playhead_id);
+    if (p == samples_per_playhead_.end())
+        return empty;
+    return p->second;
+}
+
+size_t FramePacingTelemetry::size() const {
+    size_t result = 0;
+    for (const auto &p : samples_per_playhead_)
+        result += p.second.size();
+    return result;
+}
+
+utility::JsonStore FramePacingTelemetry::summary() const {
+
+    utility::JsonStore result(nlohmann::json::object());
+    for (const auto &p : samples_per_playhead_) {
+
+        const auto &samples = p.second;
+        int late = 0, repeated = 0, dropped = 0, misses = 0;
+        int64_t total_read_us = 0, max_read_us = 0, total_depth = 0;
+        for (const auto &s : samples) {
+            // a frame picked ahead of the playhead (e.g. after a seek) isn't late
+            if (s.frames_off_ > 0)
+                late++;
+            if (s.repeated_)
+                repeated++;
+            if (!s.ideal_frame_available_)
+                misses++;
+            dropped += s.dropped_;
+            total_read_us += s.read_duration_.count();
+            max_read_us = std::max(max_read_us, int64_t(s.read_duration_.count()));
+            total_depth += s.queue_depth_;
+        }
+
+        const double n = samples.empty() ? 1.0 : double(samples.size());
+
+        nlohmann::json &j        = result[to_string(p.first)];
+        j["refreshes"]           = samples.size();
+        j["late_frames"]         = late;
+        j["repeated_frames"]     = repeated;
+        j["dropped_frames"]      = dropped;
+        j["cache_misses"]        = misses;
+        j["mean_read_us"]        = double(total_read_us) / n;
+        j["max_read_us"]         = max_read_us;
+        j["mean_queue_depth"]    = double(total_depth) / n;
+        j["smooth_refreshes_pc"] = 100.0 * (n - double(late + repeated)) / n;
+    }
+    return result;
+}
+
+utility::JsonStore FramePacingTelemetry::as_json() const {
+
+    utility::JsonStore result;
+    result["summary"] = summary();
+    result["samples"] = nlohmann::json::object();
+
+    for (const auto &p : samples_per_playhead_) {
+        auto records = nlohmann::json::array();
+        for (const auto &s : p.second) {
+            records.push_back(
+                {{"refresh_us", to_micros(s.refresh_tp_)},
+                 {"ideal_position_us", to_micros(s.ideal_position_)},
+                 {"chosen_position_us", to_micros(s.chosen_position_)},
+                 {"chosen_frame", s.chosen_frame_},
+                 {"media_frame", s.media_frame_},
+                 {"frames_off", s.frames_off_},
+                 {"repeated", s.repeated_},
+                 {"dropped", s.dropped_},
+                 {"cache_hit", s.ideal_frame_available_},
+                 {"read_us", s.read_duration_.count()},
+                 {"queue_depth", s.queue_depth_},
+                 {"playing", s.playing_}});
+        }
+        result["samples"][to_string(p.first)] = records;
+    }
+    return result;
+}
+
+std::string FramePacingTelemetry::as_csv() const {
+
+    std::stringstream ss;
+    ss << "playhead,refresh_us,ideal_position_us,chosen_position_us,chosen_frame,media_frame,"
+          "frames_off,repeated,dropped,cache_hit,read_us,queue_depth,playing\r\n";
+    for (const auto &p : samples_per_playhead_) {
+        const std::string playhead = to_string(p.first);
+        for (const auto &s : p.second) {
+            ss << playhead << "," << to_micros(s.refresh_tp_) << ","
+               << to_micros(s.ideal_position_) << "," << to_micros(s.chosen_position_) << ","
+               << s.chosen_frame_ << "," << s.media_frame_ << "," << s.frames_off_ << ","
+               << int(s.repeated_) << "," << s.dropped_ << "," << int(s.ideal_frame_available_)
+               << "," << s.read_duration_.count() << "," << s.queue_depth_ << ","
+               << int(s.playing_) << "\r\n";
+        }
+    }
+    return ss.str();
+}
@@ -1333,6 +1333,29 @@ caf::message_handler Viewport::message_handler() {
                         .send(colour_pipeline_);
                 },
 
+                [=](frame_pacing_telemetry_atom atom,
+                    const std::string &format) -> result<std::string> {
+                    // frame pacing data is gathered by the frame queue actor, which
+                    // picks the frames that we draw
+                    auto a = caf::actor_cast<caf::event_based_actor *>(self());
+                    return a->mail(atom, format).delegate(display_frames_queue_actor_);
+                },
+
+                [=](frame_pacing_telemetry_atom atom,
+                    const bool enabled,
+                    const bool record_when_stopped) {
+                    anon_mail(atom, enabled, record_when_stopped)
+                        .send(display_frames_queue_actor_);
+                },
+
+                [=](frame_pacing_telemetry_atom atom, const int capacity) {
+                    anon_mail(atom, capacity).send(display_frames_queue_actor_);
+                },
+
+                [=](frame_pacing_telemetry_atom atom, utility::clear_atom clear) {
+                    anon_mail(atom, clear).send(display_frames_queue_actor_);
+                },
+
                 [=](playhead::compare_mode_atom, const std::string &compare_mode) {
                     // the message comes from current playhead when compare mode
                     // is changed
@@ -242,6 +242,32 @@ ViewportFrameQueueActor::ViewportFrameQueueActor(
         [=](utility::event_atom, playhead::velocity_atom, const float velocity) {
             playhead_velocity_ = velocity;
         },
+
+        [=](frame_pacing_telemetry_atom) -> utility::JsonStore {
+            return pacing_telemetry_.as_json();
+        },
+
+        [=](frame_pacing_telemetry_atom, const std::string &format) -> result<std::string> {
+            if (format == "csv")
+                return pacing_telemetry_.as_csv();
+            else if (format == "json")
+                return pacing_telemetry_.as_json().dump(2);
+            else if (format == "summary")
+                return pacing_telemetry_.summary().dump(2);
+            return make_error(xstudio_error::error, "Unknown telemetry format " + format);
+        },
+
+        [=](frame_pacing_telemetry_atom, const bool enabled, const bool record_when_stopped) {
+            pacing_telemetry_.set_enabled(enabled);
+            pacing_telemetry_.set_record_when_stopped(record_when_stopped);
+        },
+
+        [=](frame_pacing_telemetry_atom, const int capacity) {
+            pacing_telemetry_.set_capacity(size_t(std::max(1, capacity)));
+        },
+
+        [=](frame_pacing_telemetry_atom, utility::clear_atom) { pacing_telemetry_.clear(); },
+
         [=](const error &err) mutable {
             spdlog::warn("{} {}", __PRETTY_FUNCTION__, to_string(err));
         },
@@ -274,6 +300,55 @@ xstudio::media_reader::ImageBufPtr ViewportFrameQueueActor::get_least_old_image_
     return least_old_buf;
 }
 
+void ViewportFrameQueueActor::record_frame_pacing(
+    const utility::Uuid &playhead_id,
+    const OrderedImagesToDraw &frames_queued_for_display,
+    const OrderedImagesToDraw::const_iterator &chosen,
+    const timebase::flicks &ideal_position,
+    const utility::time_point &refresh_tp) {
+
+    if (!pacing_telemetry_.enabled())
+        return;
+
+    const media_reader::ImageBufPtr &buf = chosen->second;
+
+    FramePacingSample sample;
+    sample.refresh_tp_      = refresh_tp;
+    sample.ideal_position_  = ideal_position;
+    sample.chosen_position_ = chosen->first;
+    sample.chosen_frame_    = buf.playhead_logical_frame();
+    sample.media_frame_     = buf.frame_id().frame();
+    sample.queue_depth_     = int(frames_queued_for_display.size());
+    sample.playing_         = playing_;
+    if (buf) {
+        sample.read_duration_ = buf->read_duration();
+    }
+
+    // The frame duration on the playhead timeline is the spacing between
+    // neighbouring frames in the queue. If we don't have neighbours, fall back
+    // to the media rate.
+    timebase::flicks frame_duration = buf.frame_id().rate();
+    auto next                       = std::next(chosen);
+    if (next != frames_queued_for_display.end()) {
+        frame_duration = next->first - chosen->first;
+    }
+    if (chosen != frames_queued_for_display.begin()) {
+        const auto d = chosen->first - std::prev(chosen)->first;
+        if (frame_duration <= timebase::k_flicks_zero_seconds || d < frame_duration)
+            frame_duration = d;
+    }
+    sample.frame_duration_ = frame_duration;
+
+    // If the picked frame is not the one that should be on screen, the
+    // ideal frame hadn't made it from the reader/cache to us in time
+    if (frame_duration > timebase::k_flicks_zero_seconds) {
+        sample.ideal_frame_available_ = ideal_position >= chosen->first &&
+                                        ideal_position < chosen->first + frame_duration;
+    }
+
+    pacing_telemetry_.record(playhead_id, sample);
+}
+
 void ViewportFrameQueueActor::drop_old_frames(const utility::time_point out_of_date_threshold) {
 
     // remove old frames from the queue against a threshold
@@ -354,9 +429,11 @@ void ViewportFrameQueueActor::get_frames_for_display(
     // evaluate the position of the playhead at the timepoint when the viewport
     // redraw happens (or, more precisely, when the buffer that it is drawn
     // to is swapped to the display)
-    const auto playhead_position = when_going_on_screen == utility::time_point()
-                                       ? predicted_playhead_position_at_next_video_refresh()
-                                       : predicted_playhead_position(when_going_on_screen);
+    const utility::time_point refresh_tp =
+        when_going_on_screen == utility::time_point()
+            ? next_video_refresh(compute_video_refresh())
+            : when_going_on_screen;
+    const auto playhead_position = predicted_playhead_position(refresh_tp);
 
     media_reader::ImageBufDisplaySet *result =
         new media_reader::ImageBufDisplaySet(sub_playhead_ids_);
@@ -403,6 +480,9 @@ void ViewportFrameQueueActor::get_frames_for_display(
 
         result->add_on_screen_image(playhead_id, r->second);
 
+        record_frame_pacing(
+            playhead_id, frames_queued_for_display, r, playhead_position, refresh_tp);
+
         // now we add 'future frames' - i.e. frames that are not onscreen now
         // but will be going on-screen next. We supply these to the viewport so
         // that it can do asynchronous transfers of data to VRAM, i.e. copying
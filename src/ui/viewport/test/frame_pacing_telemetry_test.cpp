@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include "xstudio/ui/viewport/frame_pacing_telemetry.hpp"
+
+using namespace xstudio;
+using namespace xstudio::ui::viewport;
+using namespace xstudio::utility;
+
+namespace {
+
+FramePacingSample make_sample(
+    const timebase::flicks ideal, const timebase::flicks chosen, const int chosen_frame) {
+    FramePacingSample s;
+    s.refresh_tp_      = utility::clock::now();
+    s.ideal_position_  = ideal;
+    s.chosen_position_ = chosen;
+    s.chosen_frame_    = chosen_frame;
+    s.frame_duration_  = timebase::flicks(29400000); // 24fps
+    s.playing_         = true;
+    return s;
+}
+
+} // namespace
+
+TEST(FramePacingTelemetryTest, Test) {
+
+    const timebase::flicks frame(29400000);
+    const auto playhead = Uuid::generate();
+    FramePacingTelemetry telemetry(4);
+
+    // on time
+    telemetry.record(playhead, make_sample(frame * 0, frame * 0, 0));
+    // still on frame 0, 60Hz pulldown - not a repeat
+    telemetry.record(playhead, make_sample(frame / 2, frame * 0, 0));
+    // playhead has moved to frame 1, but frame 0 shown again - late & repeated
+    telemetry.record(playhead, make_sample(frame * 1, frame * 0, 0));
+    // jump to frame 3 - frames 1 & 2 never shown
+    telemetry.record(playhead, make_sample(frame * 3, frame * 3, 3));
+
+    const auto &samples = telemetry.samples(playhead);
+    EXPECT_EQ(samples.size(), 4);
+    EXPECT_EQ(samples[0].frames_off_, 0);
+    EXPECT_FALSE(samples[1].repeated_);
+    EXPECT_TRUE(samples[2].repeated_);
+    EXPECT_EQ(samples[2].frames_off_, 1);
+    EXPECT_EQ(samples[3].dropped_, 2);
+
+    auto summary = telemetry.summary()[to_string(playhead)];
+    EXPECT_EQ(summary["late_frames"].get<int>(), 1);
+    EXPECT_EQ(summary["repeated_frames"].get<int>(), 1);
+    EXPECT_EQ(summary["dropped_frames"].get<int>(), 2);
+
+    // picked a frame ahead of the playhead - off, but not late
+    telemetry.record(playhead, make_sample(frame * 4, frame * 5, 5));
+    EXPECT_EQ(telemetry.samples(playhead).back().frames_off_, -1);
+    summary = telemetry.summary()[to_string(playhead)];
+    EXPECT_EQ(summary["late_frames"].get<int>(), 1);
+
+    // ring buffer is bounded
+    telemetry.record(playhead, make_sample(frame * 6, frame * 6, 6));
+    EXPECT_EQ(telemetry.size(), 4);
+
+    // header plus one row per sample
+    const auto csv = telemetry.as_csv();
+    EXPECT_EQ(std::count(csv.begin(), csv.end(), '\n'), 5);
+
+    // samples aren't recorded when stopped, by default
+    auto stopped     = make_sample(frame * 7, frame * 7, 7);
+    stopped.playing_ = false;
+    telemetry.record(playhead, stopped);
+    EXPECT_EQ(telemetry.samples(playhead).back().chosen_frame_, 6);
+
+    telemetry.clear();
+    EXPECT_EQ(telemetry.size(), 0);
+}
@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: Apache-2.0
+
+// Time to scan a real directory tree for media, as the media browser would.
+// Not run as part of the tests.
+//
+//   directory_scanner_benchmark path [threads]
+
+#include <cstdlib>
+
+#include "xstudio/utility/directory_scanner.hpp"
+#include "xstudio/utility/logging.hpp"
+
+using namespace xstudio::utility;
+
+int main(int argc, char **argv) {
+
+    start_logger(spdlog::level::info);
+
+    if (argc < 2) {
+        spdlog::error("Usage: {} path [threads]", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    DirectoryScanOptions options;
+    options.max_depth = 6;
+    options.extensions =
+        {".mov", ".exr", ".png", ".mp4", ".jpg", ".jpeg", ".dpx", ".tiff", ".tif"};
+    options.ignore_directories = {".git", ".svn", "__pycache__"};
+    if (argc > 2)
+        options.thread_count = std::atoi(argv[2]);
+
+    size_t items = 0;
+    spdlog::stopwatch sw;
+    DirectoryScanner(options).scan(
+        argv[1], [&](const DirectoryScanResult &result, const DirectoryScanProgress &progress) {
+            items += result.sequences_.size() + result.subdirectories_.size();
+            spdlog::debug(
+                "{} {:.1f}% {} dirs {} items",
+                result.path_,
+                progress.progress_ * 100.0,
+                progress.directories_scanned_,
+                items);
+        });
+
+    spdlog::info(
+        "Scanned {} items in {:.3f} seconds with {} threads",
+        items,
+        sw.elapsed().count(),
+        options.thread_count);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: Apache-2.0
+
+// Time for many threads to remap a few thousand distinct frame paths
+// through forty sites of rules, with and without the memo. Not run as part
+// of the tests.
+//
+//   path_remapper_benchmark [remaps]
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "xstudio/utility/logging.hpp"
+#include "xstudio/utility/path_remapper.hpp"
+
+using namespace xstudio::utility;
+
+namespace {
+
+// forty sites, each mapped forwards and backwards by prefix, and a few regexes
+JsonStore site_rules() {
+    JsonStore rules;
+    rules["rules"] = nlohmann::json::array();
+    for (int i = 0; i < 40; i++) {
+        const auto site = std::to_string(i);
+        rules["rules"].push_back(
+            {"^/mnt/site" + site + "/", "/studio/site" + site + "/local/", true});
+        rules["rules"].push_back(
+            {"^/studio/site" + site + "/local/", "/mnt/site" + site + "/", false});
+    }
+    rules["rules"].push_back({"^/mnt/site3/", "/never/", true});
+    rules["rules"].push_back({"\\\\", "/", true});
+    rules["rules"].push_back({"^/studio/site7/local/(\\w+)/", "/studio/site7/$1/", true});
+    rules["rules"].push_back({"^/studio/site7/", "/studio/seven/", true});
+    rules["rules"].push_back({"^/jobs\\.old/", "/jobs/", true});
+    rules["rules"].push_back({"^", "file:", false});
+    return rules;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+
+    start_logger(spdlog::level::info);
+
+    constexpr int threads = 32;
+    const int remaps      = argc > 1 ? std::max(std::atoi(argv[1]), threads) : 1000000;
+    const int count       = remaps / threads;
+    const auto rules      = site_rules();
+
+    for (const auto memo : {size_t(0), size_t(4096)}) {
+        PathRemapper remapper;
+        remapper.configure(rules);
+        remapper.set_memo_size(memo);
+
+        spdlog::stopwatch sw;
+        std::vector<std::thread> workers;
+        std::atomic<size_t> changed{0};
+        for (int t = 0; t < threads; t++) {
+            workers.emplace_back([&, t]() {
+                size_t n = 0;
+                for (int i = 0; i < count; i++) {
+                    // a few thousand distinct frames
+                    const auto path = "/mnt/site" + std::to_string((t + i) % 40) +
+                                      "/show/shot/plate." + std::to_string(i % 200) + ".exr";
+                    if (remapper.forwards(path) != path)
+                        n++;
+                }
+                changed += n;
+            });
+        }
+        for (auto &w : workers)
+            w.join();
+
+        spdlog::info(
+            "{} remaps on {} threads, memo {}: {:.1f}ms",
+            threads * count,
+            threads,
+            memo,
+            sw.elapsed().count() * 1000.0);
+
+        if (changed != size_t(threads * count)) {
+            spdlog::error("Only {} of {} paths remapped", changed.load(), threads * count);
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
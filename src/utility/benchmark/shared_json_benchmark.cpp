@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: Apache-2.0
+
+// Time per copy, get and edit of the merged preferences and of a session
+// sized document, held as a JsonStore and as a SharedJson. Not run as part
+// of the tests.
+//
+//   shared_json_benchmark [count]
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+
+#include "xstudio/utility/logging.hpp"
+#include "xstudio/utility/shared_json.hpp"
+
+using namespace xstudio::utility;
+using namespace nlohmann;
+
+namespace {
+
+const std::string preference_dir = ROOT_DIR "/share/preference";
+
+// all the preference files, merged as the global store does
+JsonStore preferences() {
+    JsonStore result;
+    for (const auto &entry : std::filesystem::directory_iterator(preference_dir)) {
+        if (entry.path().extension() != ".json")
+            continue;
+        std::ifstream i(entry.path());
+        result.merge(json::parse(i));
+    }
+    return result;
+}
+
+// the shape of a saved session, playlists of media with metadata
+JsonStore session() {
+    JsonStore result;
+    for (int p = 0; p < 20; p++) {
+        auto &playlist   = result["playlists"][std::to_string(p)];
+        playlist["name"] = "playlist " + std::to_string(p);
+        for (int m = 0; m < 250; m++) {
+            auto &media   = playlist["media"][std::to_string(m)];
+            media["name"] = "shot_" + std::to_string(m);
+            media["uri"] =
+                "file:///jobs/show/shot_" + std::to_string(m) + "/plate.####.exr";
+            media["frames"]   = {1001, 1100};
+            media["metadata"] = {
+                {"colour", {{"space", "ACEScg"}, {"view", "sRGB"}}},
+                {"camera", {{"lens", 35}, {"iso", 800}, {"shutter", 180.0}}},
+                {"tags", {"plate", "hero", "v" + std::to_string(m % 7)}}};
+        }
+    }
+    return result;
+}
+
+template <typename F> double time_us(const int count, F &&f) {
+    spdlog::stopwatch sw;
+    for (int i = 0; i < count; i++)
+        f(i);
+    return sw.elapsed().count() * 1000000.0 / count;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+
+    start_logger(spdlog::level::info);
+
+    // the session is ten times the work of the preferences
+    const int count = argc > 1 ? std::max(std::atoi(argv[1]), 10) : 200;
+
+    for (const auto &[name, document] : std::vector<std::pair<std::string, JsonStore>>{
+             {"preferences", preferences()}, {"session", session()}}) {
+
+        const std::string leaf = name == "preferences" ? "/core/image_cache/max_count/value"
+                                                       : "/playlists/7/media/120/name";
+        const std::string subtree =
+            name == "preferences" ? "/core/image_cache" : "/playlists/7/media/120";
+        const auto change = R"({"value": 1, "extra": {"x": [1, 2]}})"_json;
+        const auto patch  = json::array(
+            {{{"op", "replace"}, {"path", leaf}, {"value", 1}},
+             {{"op", "add"}, {"path", subtree + "/added"}, {"value", change}}});
+
+        const auto n    = name == "session" ? count / 10 : count;
+        JsonStore store = document;
+        SharedJson shared(document);
+        size_t checked  = 0;
+
+        // passing a message copies the payload
+        const auto store_copy = time_us(n, [&](int) {
+            JsonStore copy = store;
+            checked += copy.size();
+        });
+        const auto shared_copy = time_us(n, [&](int) {
+            SharedJson copy = shared;
+            checked += copy.size();
+        });
+
+        const auto store_get  = time_us(n, [&](int) { checked += store.get(subtree).size(); });
+        const auto shared_get = time_us(n, [&](int) { checked += shared.get(subtree).size(); });
+
+        // keeping the old value, as an undo history or a subscriber would
+        const auto store_set = time_us(n, [&](int i) {
+            JsonStore next = store;
+            next.set(i, leaf);
+            store = next;
+        });
+        const auto shared_set = time_us(n, [&](int i) { shared = shared.set(json(i), leaf); });
+
+        const auto store_merge = time_us(n, [&](int) {
+            JsonStore next = store;
+            next.merge(change, subtree);
+            store = next;
+        });
+        const auto shared_merge =
+            time_us(n, [&](int) { shared = shared.merge(change, subtree); });
+
+        const auto store_patch  = time_us(n, [&](int) { store = store.patch(patch); });
+        const auto shared_patch = time_us(n, [&](int) { shared = shared.patch(patch); });
+
+        const auto store_remove = time_us(n, [&](int) {
+            JsonStore next = store;
+            next.remove(subtree + "/added");
+            store = next;
+        });
+        const auto shared_remove =
+            time_us(n, [&](int) { shared = shared.remove(subtree + "/added"); });
+
+        spdlog::info(
+            "{} ({}KB), us per operation, JsonStore / SharedJson",
+            name,
+            store.dump().size() / 1024);
+        spdlog::info("  copy   {:.2f} / {:.2f}", store_copy, shared_copy);
+        spdlog::info("  get    {:.2f} / {:.2f}", store_get, shared_get);
+        spdlog::info("  set    {:.2f} / {:.2f}", store_set, shared_set);
+        spdlog::info("  merge  {:.2f} / {:.2f}", store_merge, shared_merge);
+        spdlog::info("  patch  {:.2f} / {:.2f}", store_patch, shared_patch);
+        spdlog::info("  remove {:.2f} / {:.2f}", store_remove, shared_remove);
+
+        if (not checked or shared.json() != store) {
+            spdlog::error("{}: SharedJson and JsonStore differ", name);
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
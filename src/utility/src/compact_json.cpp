@@ -0,0 +1,51 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <zlib.h>
+
+#include "xstudio/utility/compact_json.hpp"
+
+using namespace xstudio::utility;
+
+CompactJson::CompactJson(const nlohmann::json &value)
+    : data_(nlohmann::json::to_msgpack(value)) {
+    data_.shrink_to_fit();
+    encoded_size_ = data_.size();
+}
+
+JsonStore CompactJson::json() const {
+    if (data_.empty())
+        return JsonStore();
+
+    if (not compressed_)
+        return JsonStore(nlohmann::json::from_msgpack(data_));
+
+    std::vector<uint8_t> encoded(encoded_size_);
+    auto size = static_cast<uLongf>(encoded.size());
+    if (uncompress(encoded.data(), &size, data_.data(), static_cast<uLong>(data_.size())) !=
+            Z_OK or
+        size != encoded.size())
+        throw std::runtime_error("Failed to inflate compact JSON");
+
+    return JsonStore(nlohmann::json::from_msgpack(encoded));
+}
+
+void CompactJson::compress(const int level) {
+    if (cold_)
+        return;
+    cold_ = true;
+
+    if (data_.empty())
+        return;
+
+    std::vector<uint8_t> deflated(compressBound(static_cast<uLong>(data_.size())));
+    auto size = static_cast<uLongf>(deflated.size());
+    if (compress2(
+            deflated.data(), &size, data_.data(), static_cast<uLong>(data_.size()), level) !=
+            Z_OK or
+        size >= data_.size())
+        return;
+
+    deflated.resize(size);
+    deflated.shrink_to_fit();
+    data_       = std::move(deflated);
+    compressed_ = true;
+}
@@ -0,0 +1,233 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#ifdef _WIN32
+#include <filesystem>
+#else
+#include <dirent.h>
+#include <fcntl.h>
+#endif
+
+#include "xstudio/utility/directory_scanner.hpp"
+#include "xstudio/utility/string_helpers.hpp"
+
+using namespace xstudio::utility;
+
+namespace {
+
+struct ScanTask {
+    std::string path_;
+    int depth_{0};
+    double weight_{1.0};
+    std::vector<size_t> index_path_;
+};
+
+std::string join_path(const std::string &directory, const std::string_view name) {
+    std::string result;
+    result.reserve(directory.size() + name.size() + 1);
+    result += directory;
+    if (result.empty() or result.back() != '/')
+        result += '/';
+    result += name;
+    return result;
+}
+
+} // namespace
+
+DirectoryScanner::DirectoryScanner(DirectoryScanOptions options)
+    : options_(std::move(options)) {}
+
+bool DirectoryScanner::scan(const std::string &path, const ResultCallback &callback) {
+    cancelled_ = false;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<ScanTask> queue{ScanTask{path, 0, 1.0, {}}};
+    size_t active = 0;
+    DirectoryScanProgress progress;
+
+    std::mutex callback_mutex;
+    std::exception_ptr callback_error;
+
+    auto worker = [&]() {
+        std::unique_lock<std::mutex> l(mutex);
+        while (true) {
+            cv.wait(l, [&] { return cancelled_ or not queue.empty() or not active; });
+            // nothing queued and nothing in flight that could queue more
+            if (cancelled_ or queue.empty())
+                break;
+
+            auto task = std::move(queue.front());
+            queue.pop_front();
+            active++;
+            l.unlock();
+
+            DirectoryScanResult result;
+            result.path_       = task.path_;
+            result.depth_      = task.depth_;
+            result.index_path_ = task.index_path_;
+
+            std::vector<Entry> files;
+            read_directory(task.path_, result.subdirectories_, files);
+            std::sort(result.subdirectories_.begin(), result.subdirectories_.end());
+            result.sequences_ = sequences_from_entries(files);
+
+            const bool descend = options_.max_depth < 0 or task.depth_ < options_.max_depth;
+
+            l.lock();
+            if (descend and not result.subdirectories_.empty()) {
+                const double weight = task.weight_ / result.subdirectories_.size();
+                for (size_t i = 0; i < result.subdirectories_.size(); ++i) {
+                    auto index_path = task.index_path_;
+                    index_path.push_back(i);
+                    queue.push_back(ScanTask{
+                        result.subdirectories_[i],
+                        task.depth_ + 1,
+                        weight,
+                        std::move(index_path)});
+                }
+            } else {
+                progress.progress_ += task.weight_;
+            }
+            progress.directories_scanned_++;
+            progress.files_found_ += files.size();
+            active--;
+            progress.directories_pending_ = queue.size() + active;
+            cv.notify_all();
+            l.unlock();
+
+            if (callback and not cancelled_) {
+                // snapshot progress once we hold the callback lock, so what
+                // the callback sees never goes backwards
+                std::lock_guard<std::mutex> cl(callback_mutex);
+                DirectoryScanProgress snapshot;
+                {
+                    std::lock_guard<std::mutex> pl(mutex);
+                    snapshot = progress;
+                }
+                try {
+                    callback(result, snapshot);
+                } catch (...) {
+                    if (not callback_error)
+                        callback_error = std::current_exception();
+                    cancel();
+                }
+            }
+
+            l.lock();
+        }
+        cv.notify_all();
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < std::max(options_.thread_count, size_t(1)); ++i)
+        threads.emplace_back(worker);
+    worker();
+    for (auto &t : threads)
+        t.join();
+
+    if (callback_error)
+        std::rethrow_exception(callback_error);
+
+    return not cancelled_;
+}
+
+bool DirectoryScanner::wanted_file(const std::string_view name) const {
+    if (options_.extensions.empty())
+        return true;
+
+    const auto dot = name.rfind('.');
+    if (dot == std::string_view::npos)
+        return false;
+
+    return options_.extensions.count(to_lower(std::string(name.substr(dot)))) != 0;
+}
+
+#ifdef _WIN32
+
+void DirectoryScanner::read_directory(
+    const std::string &path,
+    std::vector<std::string> &subdirectories,
+    std::vector<Entry> &files) const {
+
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    for (const auto &entry : fs::directory_iterator(path, ec)) {
+        if (cancelled_)
+            break;
+
+        const auto name = entry.path().filename().string();
+        if (name.empty() or (name[0] == '.' and not options_.include_hidden))
+            continue;
+
+        if (entry.is_directory(ec)) {
+            if (not options_.ignore_directories.count(name))
+                subdirectories.push_back(entry.path().generic_string());
+        } else if (entry.is_regular_file(ec) and wanted_file(name)) {
+            files.emplace_back(entry.path().generic_string());
+            if (options_.stat_files)
+                stat(files.back().name_.c_str(), &files.back().stat_);
+        }
+    }
+}
+
+#else
+
+void DirectoryScanner::read_directory(
+    const std::string &path,
+    std::vector<std::string> &subdirectories,
+    std::vector<Entry> &files) const {
+
+    DIR *dir = opendir(path.c_str());
+    if (not dir)
+        return;
+
+    const int fd = dirfd(dir);
+
+    while (const auto *entry = readdir(dir)) {
+        if (cancelled_)
+            break;
+
+        const std::string_view name(entry->d_name);
+        if (name == "." or name == ".." or (name[0] == '.' and not options_.include_hidden))
+            continue;
+
+        unsigned char type = entry->d_type;
+        struct stat st;
+        bool have_stat = false;
+
+        // only stat when readdir can't tell us what we have
+        if (type == DT_UNKNOWN or (type == DT_LNK and options_.follow_symlinks)) {
+            if (fstatat(fd, entry->d_name, &st, 0) != 0)
+                continue;
+            have_stat = true;
+            if (S_ISDIR(st.st_mode))
+                type = DT_DIR;
+            else if (S_ISREG(st.st_mode))
+                type = DT_REG;
+        }
+
+        if (type == DT_DIR) {
+            if (not options_.ignore_directories.count(std::string(name)))
+                subdirectories.push_back(join_path(path, name));
+        } else if (type == DT_REG and wanted_file(name)) {
+            Entry file(join_path(path, name));
+            if (options_.stat_files) {
+                if (have_stat)
+                    file.stat_ = st;
+                else if (fstatat(fd, entry->d_name, &file.stat_, 0) != 0)
+                    continue;
+            }
+            files.push_back(std::move(file));
+        }
+    }
+
+    closedir(dir);
+}
+
+#endif
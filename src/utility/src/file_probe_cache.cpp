@@ -0,0 +1,509 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <regex>
+#include <vector>
+
+#include "xstudio/utility/file_probe_cache.hpp"
+#include "xstudio/utility/logging.hpp"
+
+namespace fs = std::filesystem;
+
+using namespace xstudio::utility;
+
+namespace {
+// bump if the layout of the cache file changes
+constexpr int cache_file_version = 1;
+
+// The lowest numbered file in dir named head + frame number + tail
+std::optional<std::string>
+first_frame(const std::string &dir, const std::string &head, const std::string &tail) {
+
+    std::optional<std::pair<long long, std::string>> first;
+    std::error_code ec;
+    for (auto i = fs::directory_iterator(dir, ec); !ec && i != fs::directory_iterator();
+         i.increment(ec)) {
+        const auto name = i->path().filename().string();
+        if (name.size() <= head.size() + tail.size() || name.compare(0, head.size(), head) ||
+            name.compare(name.size() - tail.size(), tail.size(), tail))
+            continue;
+
+        const auto number = name.substr(head.size(), name.size() - head.size() - tail.size());
+        const size_t sign = number[0] == '-' ? 1 : 0;
+        if (number.size() == sign ||
+            number.find_first_not_of("0123456789", sign) != std::string::npos)
+            continue;
+
+        const auto frame = std::stoll(number);
+        if (!first || frame < first->first)
+            first = std::make_pair(frame, i->path().string());
+    }
+
+    if (first)
+        return first->second;
+    return {};
+}
+
+} // namespace
+
+FileProbeCache::FileProbeCache(
+    std::string name, const size_t max_count, const std::chrono::seconds flush_period)
+    : name_(std::move(name)),
+      flush_period_(flush_period),
+      max_count_(max_count) {
+    writer_ = std::thread([this]() { run_writer(); });
+}
+
+FileProbeCache::~FileProbeCache() {
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        stopping_ = true;
+    }
+    wake_writer_.notify_one();
+    writer_.join();
+    flush();
+}
+
+void FileProbeCache::set_directory(const std::string &directory) {
+    std::lock_guard<std::mutex> w(write_mutex_);
+    std::unique_lock<std::mutex> l(mutex_);
+    if (directory == directory_)
+        return;
+
+    // changes not yet written go to the old directory
+    const auto old_directory = directory_;
+    const auto old_log       = log_name_;
+    std::vector<std::string> old_changes;
+    nlohmann::json old_entries;
+    if (rewrite_ || (log_name_.empty() && !changes_.empty()))
+        old_entries = snapshot();
+    else
+        old_changes.swap(changes_);
+
+    directory_ = directory;
+    entries_.clear();
+    load();
+    l.unlock();
+
+    if (old_entries.is_null())
+        append(old_directory, old_log, old_changes);
+    else
+        write(old_directory, old_entries);
+}
+
+std::string FileProbeCache::directory() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return directory_;
+}
+
+void FileProbeCache::set_enabled(const bool enabled) {
+    std::lock_guard<std::mutex> l(mutex_);
+    enabled_ = enabled;
+}
+
+bool FileProbeCache::enabled() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return enabled_;
+}
+
+void FileProbeCache::set_max_count(const size_t max_count) {
+    std::lock_guard<std::mutex> l(mutex_);
+    max_count_ = max_count;
+    prune();
+}
+
+size_t FileProbeCache::max_count() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return max_count_;
+}
+
+std::optional<nlohmann::json> FileProbeCache::find(
+    const std::string &path, const std::string &fingerprint, const std::string &sub_key) {
+
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        if (!enabled_ || !entries_.count(entry_key(path, sub_key))) {
+            misses_++;
+            return {};
+        }
+    }
+
+    // stat outside the lock, it may be slow on network storage
+    const auto id = file_identity(path);
+
+    std::lock_guard<std::mutex> l(mutex_);
+    auto p = entries_.find(entry_key(path, sub_key));
+    if (p == entries_.end() || !id || p->second.size_ != id->size_ ||
+        p->second.mtime_ != id->mtime_ || p->second.fingerprint_ != fingerprint) {
+        misses_++;
+        return {};
+    }
+
+    hits_++;
+    p->second.last_used_ = ++usage_counter_;
+    return p->second.data_;
+}
+
+void FileProbeCache::store(
+    const std::string &path,
+    const std::string &fingerprint,
+    const nlohmann::json &data,
+    const std::string &sub_key) {
+
+    if (!enabled())
+        return;
+
+    // files we can't stat (sequence patterns, urls etc) aren't cached
+    const auto id = file_identity(path);
+    if (!id)
+        return;
+
+    std::lock_guard<std::mutex> l(mutex_);
+    const auto key     = entry_key(path, sub_key);
+    auto &entry        = entries_[key];
+    entry.size_        = id->size_;
+    entry.mtime_       = id->mtime_;
+    entry.fingerprint_ = fingerprint;
+    entry.data_        = data;
+    entry.last_used_   = ++usage_counter_;
+    log_change(key, &entry);
+    prune();
+}
+
+void FileProbeCache::erase(const std::string &path, const std::string &sub_key) {
+    std::lock_guard<std::mutex> l(mutex_);
+    const auto key = entry_key(path, sub_key);
+    if (entries_.erase(key))
+        log_change(key, nullptr);
+}
+
+void FileProbeCache::clear() {
+    std::lock_guard<std::mutex> l(mutex_);
+    entries_.clear();
+    changes_.clear();
+    rewrite_ = true;
+}
+
+size_t FileProbeCache::size() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return entries_.size();
+}
+
+size_t FileProbeCache::hits() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return hits_;
+}
+
+size_t FileProbeCache::misses() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return misses_;
+}
+
+bool FileProbeCache::flush() {
+    std::lock_guard<std::mutex> w(write_mutex_);
+    std::string directory, log_name;
+    nlohmann::json entries;
+    std::vector<std::string> lines;
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        if (changes_.empty() && !rewrite_)
+            return true;
+        directory = directory_;
+
+        // Once the log is as long as the cache, loading it costs more than
+        // writing the whole file again. There's no log yet if we haven't
+        // written the file.
+        if (rewrite_ || log_name_.empty() ||
+            log_lines_ + changes_.size() > std::max(entries_.size(), size_t(1024))) {
+            entries = snapshot();
+        } else {
+            log_name = log_name_;
+            lines.swap(changes_);
+            log_lines_ += lines.size();
+        }
+    }
+    if (entries.is_null())
+        return append(directory, log_name, lines);
+    return write(directory, entries);
+}
+
+void FileProbeCache::run_writer() {
+    std::unique_lock<std::mutex> l(mutex_);
+    while (!stopping_) {
+        wake_writer_.wait_for(l, flush_period_, [this]() { return stopping_; });
+        if (stopping_ || (changes_.empty() && !rewrite_))
+            continue;
+        l.unlock();
+        flush();
+        l.lock();
+    }
+}
+
+std::string FileProbeCache::cache_file() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (directory_.empty())
+        return "";
+    return (fs::path(directory_) / (name_ + ".json")).string();
+}
+
+std::optional<FileProbeCache::FileIdentity>
+FileProbeCache::file_identity(const std::string &path) {
+
+    auto stat = [](const std::string &file) -> std::optional<FileIdentity> {
+        std::error_code ec;
+        FileIdentity id;
+        id.size_ = fs::file_size(file, ec);
+        if (ec)
+            return {};
+        const auto mtime = fs::last_write_time(file, ec);
+        if (ec)
+            return {};
+        id.mtime_ = mtime.time_since_epoch().count();
+        return id;
+    };
+
+    if (auto id = stat(path))
+        return id;
+
+    // an image sequence, which we can't stat, is identified by its first frame
+    static const std::regex sequence_re(R"(^(.*?)(\{:0\d+d\}|#+|@+)([^/]*)$)");
+    std::smatch m;
+    if (!std::regex_match(path, m, sequence_re))
+        return {};
+
+    // the first frame found last time, if it's still there
+    std::string first;
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        auto p = first_frames_.find(path);
+        if (p != first_frames_.end())
+            first = p->second;
+    }
+    if (!first.empty()) {
+        if (auto id = stat(first))
+            return id;
+    }
+
+    const auto prefix = m[1].str();
+    const auto slash  = prefix.rfind('/');
+    const auto found  = first_frame(
+        slash == std::string::npos ? "." : prefix.substr(0, slash + 1),
+        slash == std::string::npos ? prefix : prefix.substr(slash + 1),
+        m[3].str());
+
+    std::lock_guard<std::mutex> l(mutex_);
+    if (!found) {
+        first_frames_.erase(path);
+        return {};
+    }
+    first_frames_[path] = *found;
+    return stat(*found);
+}
+
+std::string FileProbeCache::entry_key(const std::string &path, const std::string &sub_key) {
+    return sub_key.empty() ? path : path + "@" + sub_key;
+}
+
+nlohmann::json FileProbeCache::entry_json(const Entry &entry) {
+    return nlohmann::json{
+        {"size", entry.size_},
+        {"mtime", entry.mtime_},
+        {"fingerprint", entry.fingerprint_},
+        {"data", entry.data_},
+        {"used", entry.last_used_}};
+}
+
+FileProbeCache::Entry FileProbeCache::entry_from_json(const nlohmann::json &json) {
+    Entry e;
+    e.size_        = json.at("size").get<uintmax_t>();
+    e.mtime_       = json.at("mtime").get<int64_t>();
+    e.fingerprint_ = json.at("fingerprint").get<std::string>();
+    e.data_        = json.at("data");
+    e.last_used_   = json.value("used", uint64_t(0));
+    return e;
+}
+
+void FileProbeCache::log_change(const std::string &key, const Entry *entry) {
+    // caller holds mutex_
+    if (directory_.empty() || rewrite_)
+        return;
+
+    auto line = entry ? entry_json(*entry) : nlohmann::json{{"erase", true}};
+    line["key"] = key;
+    changes_.push_back(line.dump());
+}
+
+void FileProbeCache::load() {
+    // caller holds mutex_
+    changes_.clear();
+    rewrite_   = false;
+    log_lines_ = 0;
+    log_name_.clear();
+    if (directory_.empty())
+        return;
+
+    const auto file = fs::path(directory_) / (name_ + ".json");
+    std::error_code ec;
+    if (!fs::exists(file, ec))
+        return;
+
+    try {
+        std::ifstream i(file);
+        nlohmann::json j;
+        i >> j;
+
+        if (j.value("version", 0) != cache_file_version)
+            return;
+
+        for (const auto &[key, value] : j.at("entries").items()) {
+            auto e         = entry_from_json(value);
+            usage_counter_ = std::max(usage_counter_, e.last_used_);
+            entries_[key]  = std::move(e);
+        }
+        log_name_ = j.value("log", "");
+        spdlog::debug("Loaded {} entries from {}", entries_.size(), file.string());
+    } catch (const std::exception &e) {
+        spdlog::warn("{} {} {}", __PRETTY_FUNCTION__, file.string(), e.what());
+        entries_.clear();
+        return;
+    }
+
+    if (log_name_.empty())
+        return;
+
+    // then the changes made since it was written
+    std::ifstream log(fs::path(directory_) / log_name_);
+    std::string line;
+    while (std::getline(log, line)) {
+        try {
+            const auto change = nlohmann::json::parse(line);
+            const auto key    = change.at("key").get<std::string>();
+            if (change.value("erase", false)) {
+                entries_.erase(key);
+            } else {
+                auto e         = entry_from_json(change);
+                usage_counter_ = std::max(usage_counter_, e.last_used_);
+                entries_[key]  = std::move(e);
+            }
+            log_lines_++;
+        } catch (const std::exception &e) {
+            // the last line may be partly written if we were killed
+            // while appending it
+            spdlog::debug("{} {} {}", __PRETTY_FUNCTION__, log_name_, e.what());
+            break;
+        }
+    }
+}
+
+nlohmann::json FileProbeCache::snapshot() {
+    // caller holds mutex_
+    changes_.clear();
+    rewrite_   = false;
+    log_lines_ = 0;
+    if (directory_.empty())
+        return {};
+
+    // a new log, the old one is removed once the file naming this one is
+    // written
+    log_name_ = name_ + "." +
+                std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) +
+                ".log";
+
+    nlohmann::json entries = nlohmann::json::object();
+    for (const auto &[key, e] : entries_)
+        entries[key] = entry_json(e);
+    return nlohmann::json{
+        {"version", cache_file_version}, {"log", log_name_}, {"entries", std::move(entries)}};
+}
+
+bool FileProbeCache::write(const std::string &directory, const nlohmann::json &snapshot) const {
+    // caller holds write_mutex_, but not mutex_
+    if (directory.empty() || snapshot.is_null())
+        return true;
+
+    const auto file = fs::path(directory) / (name_ + ".json");
+    // unique temp name, another xstudio instance may be writing the same cache
+    const auto tmp = fs::path(directory) /
+                     (name_ + ".json." +
+                      std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+
+    try {
+        fs::create_directories(directory);
+
+        {
+            std::ofstream o(tmp);
+            o << snapshot;
+            if (!o.good())
+                throw std::runtime_error("Failed to write " + tmp.string());
+        }
+        // readers never see a partly written file
+        fs::rename(tmp, file);
+
+    } catch (const std::exception &e) {
+        std::error_code ec;
+        fs::remove(tmp, ec);
+        spdlog::warn("{} {}", __PRETTY_FUNCTION__, e.what());
+        return false;
+    }
+
+    // logs that went with earlier versions of the file
+    const auto log_name = snapshot.value("log", "");
+    std::error_code ec;
+    for (auto i = fs::directory_iterator(directory, ec); !ec && i != fs::directory_iterator();
+         i.increment(ec)) {
+        const auto name = i->path().filename().string();
+        if (name != log_name && name.size() > name_.size() + 5 &&
+            !name.compare(0, name_.size() + 1, name_ + ".") &&
+            !name.compare(name.size() - 4, 4, ".log")) {
+            std::error_code rec;
+            fs::remove(i->path(), rec);
+        }
+    }
+    return true;
+}
+
+bool FileProbeCache::append(
+    const std::string &directory,
+    const std::string &log_name,
+    const std::vector<std::string> &lines) const {
+    // caller holds write_mutex_, but not mutex_
+    if (directory.empty() || log_name.empty() || lines.empty())
+        return true;
+
+    const auto file = fs::path(directory) / log_name;
+    try {
+        std::ofstream o(file, std::ios::app);
+        for (const auto &line : lines)
+            o << line << "\n";
+        o.flush();
+        if (!o.good())
+            throw std::runtime_error("Failed to write " + file.string());
+    } catch (const std::exception &e) {
+        spdlog::warn("{} {}", __PRETTY_FUNCTION__, e.what());
+        return false;
+    }
+    return true;
+}
+
+void FileProbeCache::prune() {
+    // caller holds mutex_
+    if (entries_.size() <= max_count_)
+        return;
+
+    // drop the least recently used entries, down to 90% of max so that we
+    // aren't pruning on every store
+    std::vector<std::pair<uint64_t, std::string>> by_age;
+    by_age.reserve(entries_.size());
+    for (const auto &[key, e] : entries_)
+        by_age.emplace_back(e.last_used_, key);
+    std::sort(by_age.begin(), by_age.end());
+
+    const size_t target = max_count_ - max_count_ / 10;
+    for (size_t i = 0; entries_.size() > target && i < by_age.size(); ++i)
+        entries_.erase(by_age[i].second);
+
+    // rather than log every erase
+    changes_.clear();
+    rewrite_ = true;
+}
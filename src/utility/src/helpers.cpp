@@ -6,11 +6,14 @@
 #include <pwd.h>
 #include <sys/types.h>
 #endif
+#include <algorithm>
 #include <filesystem>
 #include <limits>
 #include <regex>
 #include <set>
 #include <climits>
+#include <cstring>
+#include <thread>
 
 #include <fmt/format.h>
 
@@ -25,6 +28,7 @@
 /*#include <reproc++/drain.hpp>
 #include <reproc++/reproc.hpp>*/
 
+#include "xstudio/utility/directory_scanner.hpp"
 #include "xstudio/utility/frame_list.hpp"
 #include "xstudio/utility/helpers.hpp"
 #include "xstudio/utility/sequence.hpp"
@@ -55,6 +59,31 @@ std::mutex supported_extensions_mutex;
 std::set<std::string> warned_undefined_envvars_;
 std::mutex warned_undefined_envvars_mutex;
 static PathRemapper s_remapper;
+
+constexpr uint64_t prime1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t prime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t prime3 = 0x165667B19E3779F9ULL;
+
+inline uint64_t rotl(const uint64_t v, const int r) { return (v << r) | (v >> (64 - r)); }
+
+inline uint64_t read64(const uint8_t *p) {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline uint64_t round64(const uint64_t acc, const uint64_t input) {
+    return rotl(acc + input * prime2, 31) * prime1;
+}
+
+inline uint64_t mix64(uint64_t h) {
+    h ^= h >> 33;
+    h *= prime2;
+    h ^= h >> 29;
+    h *= prime3;
+    h ^= h >> 32;
+    return h;
+}
 } // namespace
 
 void xstudio::utility::add_supported_extensions(const std::vector<std::string> &values) {
@@ -669,37 +698,24 @@ xstudio::utility::scan_posix_path(const std::string &path, const int depth) {
     try {
         std::error_code ec;
         if (fs::is_directory(p, ec)) {
-            // read content.
-            try {
-                std::vector<std::string> files;
-                for (const auto &entry : fs::directory_iterator(path)) {
-
-#ifdef _WIN32
-                    const std::string _path     = entry.path().string();
-                    const std::string _filename = entry.path().filename().string();
-                    if (not _filename.empty() and _filename[0] == '.')
-                        continue;
-                    if (fs::is_directory(entry) && (depth > 0 || depth < 0)) {
-                        auto more = scan_posix_path(_path, depth - 1);
-                        items.insert(items.end(), more.begin(), more.end());
-                    } else if (fs::is_regular_file(entry))
-                        files.push_back(std::regex_replace(_path, std::regex("[\]"), "/"));
-#else
-                    const std::string _path     = entry.path();
-                    const std::string _filename = entry.path().filename();
-                    if (not _filename.empty() and _filename[0] == '.')
-                        continue;
-                    if (fs::is_directory(entry) && (depth > 0 || depth < 0)) {
-                        auto more = scan_posix_path(_path, depth - 1);
-                        items.insert(items.end(), more.begin(), more.end());
-                    } else if (fs::is_regular_file(entry))
-                        files.push_back(_path);
-#endif
-                }
-                auto file_items = uri_from_file_list(files);
-                items.insert(items.end(), file_items.begin(), file_items.end());
-            } catch (const std::exception &e) {
-                spdlog::warn("{} {}", __PRETTY_FUNCTION__, e.what());
+            DirectoryScanOptions options;
+            options.max_depth    = depth;
+            options.stat_files   = false;
+            options.thread_count = std::clamp(std::thread::hardware_concurrency(), 4u, 16u);
+
+            std::vector<DirectoryScanResult> results;
+            DirectoryScanner(options).scan(
+                path, [&](const DirectoryScanResult &result, const DirectoryScanProgress &) {
+                    results.push_back(result);
+                });
+
+            // results arrive in whatever order the workers finish
+            std::sort(results.begin(), results.end(), [](const auto &a, const auto &b) {
+                return a.path_ < b.path_;
+            });
+            for (const auto &result : results) {
+                for (const auto &seq : result.sequences_)
+                    items.emplace_back(uri_from_sequence(seq));
             }
         } else if (fs::is_regular_file(p, ec)) {
             items.emplace_back(std::make_pair(posix_path_to_uri(path), FrameList()));
@@ -983,3 +999,39 @@ std::array<unsigned char, 16> xstudio::utility::md5_hash(const void *data, std::
 #endif
     return hash;
 }
+
+uint64_t xstudio::utility::hash_bytes(const void *data, const size_t size, uint64_t seed) {
+    const auto *p   = static_cast<const uint8_t *>(data);
+    const auto *end = p + size;
+    uint64_t h;
+
+    if (size >= 32) {
+        // four independent lanes, so the multiplies can be pipelined
+        uint64_t v1 = seed + prime1 + prime2;
+        uint64_t v2 = seed + prime2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - prime1;
+
+        for (; p + 32 <= end; p += 32) {
+            v1 = round64(v1, read64(p));
+            v2 = round64(v2, read64(p + 8));
+            v3 = round64(v3, read64(p + 16));
+            v4 = round64(v4, read64(p + 24));
+        }
+
+        h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+        for (const auto v : {v1, v2, v3, v4})
+            h = (h ^ round64(0, v)) * prime1 + prime3;
+    } else {
+        h = seed + prime3;
+    }
+
+    h += static_cast<uint64_t>(size);
+
+    for (; p + 8 <= end; p += 8)
+        h = rotl(h ^ round64(0, read64(p)), 27) * prime1 + prime3;
+    for (; p < end; ++p)
+        h = rotl(h ^ (*p * prime3), 11) * prime1;
+
+    return mix64(h);
+}
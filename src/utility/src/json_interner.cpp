@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: Apache-2.0
+#include "xstudio/utility/json_interner.hpp"
+
+using namespace xstudio::utility;
+
+JsonInterner &JsonInterner::instance() {
+    static JsonInterner s_interner;
+    return s_interner;
+}
+
+InternedJson JsonInterner::intern(nlohmann::json value, bool *created) {
+    const auto hash = std::hash<nlohmann::json>{}(value);
+    auto &shard     = shards_[hash % SHARDS];
+
+    std::scoped_lock lock(shard.mutex_);
+
+    auto range = shard.values_.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        auto held = it->second.value.lock();
+        if (held and *held == value) {
+            if (created)
+                *created = false;
+            return InternedJson{std::move(held), it->second.bytes};
+        }
+    }
+
+    InternedJson result;
+    result.bytes = json_size_bytes(value);
+    result.value = std::make_shared<const JsonStore>(std::move(value));
+    shard.values_.emplace(hash, Held{result.value, result.bytes});
+    if (created)
+        *created = true;
+
+    if (shard.values_.size() >= shard.prune_at_)
+        shard.prune();
+
+    return result;
+}
+
+size_t JsonInterner::count() const {
+    size_t result = 0;
+    for (const auto &i : shards_) {
+        std::scoped_lock lock(i.mutex_);
+        result += i.values_.size();
+    }
+    return result;
+}
+
+void JsonInterner::Shard::prune() {
+    for (auto it = values_.begin(); it != values_.end();) {
+        if (it->second.value.expired())
+            it = values_.erase(it);
+        else
+            ++it;
+    }
+    // prune again when the live values have doubled
+    prune_at_ = std::max(size_t(64), values_.size() * 2);
+}
+
+InternedJson JsonSourceInterner::intern(const std::string &slot, nlohmann::json value) {
+    auto it = last_.find(slot);
+    if (it != std::end(last_) and *(it->second.value) == value)
+        return it->second;
+
+    auto result = interner_->intern(std::move(value));
+    if (it != std::end(last_))
+        it->second = result;
+    else
+        last_.emplace(slot, result);
+    return result;
+}
+
+size_t xstudio::utility::json_size_bytes(const nlohmann::json &value) {
+    // roughly what libstdc++ allocates for each: map nodes hold a key and a
+    // value with four pointers and a colour, strings over 15 characters
+    // allocate their text
+    constexpr size_t map_node = 32 + sizeof(std::string) + sizeof(nlohmann::json);
+
+    auto string_size = [](const std::string &s) {
+        return s.size() > 15 ? s.capacity() + 1 : size_t(0);
+    };
+
+    switch (value.type()) {
+    case nlohmann::json::value_t::object: {
+        size_t result = sizeof(nlohmann::json) + sizeof(nlohmann::json::object_t);
+        for (auto it = value.begin(); it != value.end(); ++it)
+            result += map_node + string_size(it.key()) + json_size_bytes(it.value()) -
+                      sizeof(nlohmann::json);
+        return result;
+    }
+    case nlohmann::json::value_t::array: {
+        const auto &array = value.get_ref<const nlohmann::json::array_t &>();
+        size_t result     = sizeof(nlohmann::json) + sizeof(nlohmann::json::array_t) +
+                        (array.capacity() - array.size()) * sizeof(nlohmann::json);
+        for (const auto &i : array)
+            result += json_size_bytes(i);
+        return result;
+    }
+    case nlohmann::json::value_t::string:
+        return sizeof(nlohmann::json) + sizeof(std::string) +
+               string_size(value.get_ref<const std::string &>());
+    case nlohmann::json::value_t::binary:
+        return sizeof(nlohmann::json) + sizeof(nlohmann::json::binary_t) +
+               value.get_binary().capacity();
+    default:
+        return sizeof(nlohmann::json);
+    }
+}
@@ -1,5 +1,7 @@
 // SPDX-License-Identifier: Apache-2.0
 // #include <iostream>
+#include <cctype>
+#include <optional>
 #include <zstr.hpp>
 #include "xstudio/utility/json_store.hpp"
 #include "xstudio/utility/helpers.hpp"
@@ -20,14 +22,29 @@ void JsonStore::set(const nlohmann::json &json, const std::string &path) {
 // void JsonStore::set(const JsonStore &json, const std::string &path) { set(json, path); }
 
 bool JsonStore::remove(const std::string &path) {
+    // erase in place, patching would copy the whole tree
     try {
-        *this = patch(
-            json::parse(
-                std::string(R"([{"op": "remove", "path": ")") + path + std::string("\"}]")));
+        const auto ptr = json_pointer(path);
+        if (ptr.empty())
+            return false;
+
+        auto &parent    = at(ptr.parent_pointer());
+        const auto &key = ptr.back();
+
+        if (parent.is_object())
+            return parent.erase(key) != 0;
+
+        if (parent.is_array()) {
+            size_t pos       = 0;
+            const auto index = std::stoull(key, &pos);
+            if (pos != key.size() or index >= parent.size())
+                return false;
+            parent.erase(index);
+            return true;
+        }
     } catch (...) {
-        return false;
     }
-    return true;
+    return false;
 }
 
 JsonStore xstudio::utility::open_session(const caf::uri &path) {
@@ -35,25 +52,223 @@ JsonStore xstudio::utility::open_session(const caf::uri &path) {
 }
 
 JsonStore xstudio::utility::open_session(const std::string &path) {
+    spdlog::stopwatch sw;
 
+    std::string text;
+    {
 #ifdef _WIN32
-    zstr::ifstream i(path, std::ios::binary);
-    i >> std::noskipws;
-    const std::string uncompressed(
-        (std::istreambuf_iterator<char>(i)), std::istreambuf_iterator<char>());
-    return JsonStore(nlohmann::json::parse(uncompressed));
+        zstr::ifstream i(path, std::ios::binary);
 #else
-    JsonStore js;
-    zstr::ifstream i(path);
-    i >> js;
-    return js;
+        zstr::ifstream i(path);
 #endif
+        std::array<char, 1 << 16> buffer;
+        while (i.read(buffer.data(), buffer.size()) or i.gcount())
+            text.append(buffer.data(), i.gcount());
+    }
+    const auto read = sw.elapsed().count();
+
+    sw.reset();
+    auto result = parse_session(text);
+
+    spdlog::info(
+        "Session {} ({:.1f}MB) read in {:.3} seconds, parsed in {:.3} seconds.",
+        path,
+        text.size() / (1024.0 * 1024.0),
+        read,
+        sw);
+
+    return result;
+}
+
+namespace {
+
+size_t skip_space(const std::string &text, size_t pos) {
+    while (pos < text.size() and std::isspace(static_cast<unsigned char>(text[pos])))
+        pos++;
+    return pos;
+}
+
+// end of the string starting at pos, or npos
+size_t skip_string(const std::string &text, size_t pos) {
+    while ((pos = text.find_first_of("\"\\", pos + 1)) != std::string::npos) {
+        if (text[pos] == '"')
+            return pos + 1;
+        pos++;
+    }
+    return pos;
+}
+
+// end of the value starting at pos, or npos
+size_t skip_value(const std::string &text, size_t pos) {
+    if (pos >= text.size())
+        return std::string::npos;
+
+    if (text[pos] == '"')
+        return skip_string(text, pos);
+
+    if (text[pos] != '{' and text[pos] != '[')
+        return std::min(text.find_first_of(",}] \t\r\n", pos), text.size());
+
+    size_t depth = 0;
+    while (pos != std::string::npos) {
+        switch (text[pos]) {
+        case '"':
+            pos = skip_string(text, pos);
+            continue;
+        case '{':
+        case '[':
+            depth++;
+            break;
+        default:
+            if (--depth == 0)
+                return pos + 1;
+        }
+        pos = text.find_first_of("\"{}[]", pos + 1);
+    }
+    return pos;
+}
+
+struct Member {
+    std::string key;
+    size_t begin;
+    size_t end;
+    // if the value is an object that was asked for
+    std::vector<Member> members;
+};
+
+// the keys and value extents of the object at pos, without parsing the
+// values. The members of the value of nested are found as well.
+std::optional<std::vector<Member>>
+object_members(const std::string &text, size_t pos, const std::string &nested = "") {
+    if (pos >= text.size() or text[pos] != '{')
+        return {};
+
+    std::vector<Member> result;
+    pos = skip_space(text, pos + 1);
+    if (pos < text.size() and text[pos] == '}')
+        return result;
+
+    while (pos < text.size() and text[pos] == '"') {
+        const auto key_end = skip_string(text, pos);
+        if (key_end == std::string::npos)
+            return {};
+
+        Member member;
+        const auto key = nlohmann::json::parse(text.begin() + pos, text.begin() + key_end);
+        member.key     = key.get<std::string>();
+
+        pos = skip_space(text, key_end);
+        if (pos >= text.size() or text[pos] != ':')
+            return {};
+
+        member.begin = skip_space(text, pos + 1);
+        if (not nested.empty() and member.key == nested and text[member.begin] == '{') {
+            auto members = object_members(text, member.begin);
+            if (not members)
+                return {};
+            member.members = std::move(*members);
+            // the closing brace
+            member.end = member.members.empty()
+                             ? skip_value(text, member.begin)
+                             : skip_space(text, member.members.back().end) + 1;
+        } else {
+            member.end = skip_value(text, member.begin);
+        }
+        if (member.end == std::string::npos)
+            return {};
+
+        pos = skip_space(text, member.end);
+        result.emplace_back(std::move(member));
+
+        if (pos < text.size() and text[pos] == '}')
+            return result;
+        if (pos >= text.size() or text[pos] != ',')
+            return {};
+        pos = skip_space(text, pos + 1);
+    }
+
+    return {};
+}
+
+// a value parsed on its own, with its nested actors, if any, cut out and
+// parsed as pieces of their own
+struct Piece {
+    size_t begin;
+    size_t end;
+    // the text with the actors replaced by {}, if they were cut out
+    std::string rest;
+    std::vector<std::pair<std::string, size_t>> actors;
+};
+
+// splits the value at [begin, end) into pieces, down to depth levels of
+// nested actors, parents before their children. Returns its piece's index.
+size_t split_actors(
+    const std::string &text,
+    const size_t begin,
+    const size_t end,
+    const int depth,
+    std::vector<Piece> &pieces) {
+    const auto index = pieces.size();
+    pieces.push_back(Piece{begin, end, {}, {}});
+    if (not depth)
+        return index;
+
+    const auto members = object_members(text, skip_space(text, begin), "actors");
+    if (not members)
+        return index;
+
+    const auto actors = std::find_if(
+        members->begin(), members->end(), [](const auto &m) { return m.key == "actors"; });
+    if (actors == members->end() or actors->members.empty())
+        return index;
+
+    pieces[index].rest = text.substr(begin, actors->begin - begin) + "{}" +
+                         text.substr(actors->end, end - actors->end);
+    for (const auto &m : actors->members) {
+        const auto child = split_actors(text, m.begin, m.end, depth - 1, pieces);
+        pieces[index].actors.emplace_back(m.key, child);
+    }
+    return index;
+}
+
+} // namespace
+
+JsonStore xstudio::utility::parse_session(const std::string &text) {
+    // Playlists, and the media and containers in them, are independent, so
+    // find where each one is with a quick scan and parse them concurrently.
+    // Anything unexpected gets a plain parse, which also reports errors
+    // properly.
+    std::vector<Piece> pieces;
+    split_actors(text, 0, text.size(), 2, pieces);
+
+    if (pieces.size() > 2) {
+        std::vector<nlohmann::json> parsed(pieces.size());
+        parallel_for(pieces.size(), [&](const size_t i) {
+            const auto &p = pieces[i];
+            parsed[i]     = p.actors.empty() ? nlohmann::json::parse(
+                                               text.begin() + p.begin, text.begin() + p.end)
+                                             : nlohmann::json::parse(p.rest);
+        });
+
+        // children come after their parents, so fill them in from the back
+        for (auto i = pieces.size(); i--;) {
+            if (pieces[i].actors.empty())
+                continue;
+            auto &dest = parsed[i]["actors"];
+            for (const auto &[key, child] : pieces[i].actors)
+                dest[key] = std::move(parsed[child]);
+        }
+
+        // JsonStore has no move constructor
+        return JsonStore(std::move(parsed.front()));
+    }
+
+    return JsonStore(nlohmann::json::parse(text));
 }
 
 
 void JsonStore::parse_string(const std::string &data) {
-    auto n = nlohmann::json::parse(data);
-    *this  = nlohmann::json::parse(data);
+    *this = nlohmann::json::parse(data);
 }
 
 // void JsonStore::merge(const JsonStore &json, const std::string &path) {
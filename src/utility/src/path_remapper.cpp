@@ -1,20 +1,173 @@
 // SPDX-License-Identifier: Apache-2.0
 
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <optional>
+#include <unordered_map>
+
 #include "xstudio/atoms.hpp"
 #include "xstudio/utility/path_remapper.hpp"
 
 namespace xstudio::utility {
 
-std::string PathRemapper::forwards(const std::string &path) { return remap(path, true); }
+namespace {
 
-std::string PathRemapper::backwards(const std::string &path) { return remap(path, false); }
+// the text a regex matches, if it is "^" then plain or escaped characters
+std::optional<std::string> literal_prefix(const std::string &regex) {
+    if (regex.empty() or regex.front() != '^')
+        return {};
 
-std::string PathRemapper::remap(const std::string &path, const bool forward) {
+    std::string result;
+    for (size_t i = 1; i < regex.size(); ++i) {
+        const auto c = regex[i];
+        if (c == '\\') {
+            // \d, \w, \1 etc aren't literals
+            if (++i == regex.size() or std::isalnum(static_cast<unsigned char>(regex[i])))
+                return {};
+            result.push_back(regex[i]);
+        } else if (std::strchr(".^$|()[]{}*+?", c)) {
+            return {};
+        } else {
+            result.push_back(c);
+        }
+    }
+    return result;
+}
 
-    std::scoped_lock lock(mutex_);
+// unique across remappers, so a cache can't mistake one for another
+std::atomic<uint64_t> s_generation{0};
+
+// remappers a thread keeps caches for before starting again
+constexpr size_t MAX_CACHES = 16;
+
+} // namespace
+
+struct PathRemapper::Rules {
+    struct Rule {
+        bool literal_{false};
+        std::string prefix_;
+        std::regex regex_;
+        std::string replacement_;
+    };
+
+    // the rules for one direction, applied in order as regex_replace would
+    class Direction {
+      public:
+        void add(const std::string &search, const std::string &replace);
+        // after the last add()
+        void compile();
+        [[nodiscard]] std::string apply(std::string path) const;
+
+      private:
+        struct Node {
+            std::map<char, size_t> children_;
+            // literal rules with this prefix, in order
+            std::vector<size_t> rules_;
+        };
+
+        std::vector<Rule> rules_;
+        // first regex rule at or after each rule
+        std::vector<size_t> next_regex_;
+        std::vector<Node> trie_{1};
+    };
+
+    std::string remap(const std::string &path, const bool forward) const;
+
+    Direction forward_;
+    Direction backward_;
+
+    std::map<std::string, std::string> forward_map_;
+    std::map<std::string, std::string> backward_map_;
+
+    uint64_t generation_{++s_generation};
+};
+
+struct PathRemapper::Cache {
+    uint64_t generation_{0};
+    std::shared_ptr<const Rules> rules_;
+    std::unordered_map<std::string, std::string> forward_;
+    std::unordered_map<std::string, std::string> backward_;
+};
+
+void PathRemapper::Rules::Direction::add(
+    const std::string &search, const std::string &replace) {
+    Rule rule;
+    rule.replacement_ = replace;
+
+    // a '$' in the replacement may refer to the match
+    const auto prefix = literal_prefix(search);
+    if (prefix and replace.find('$') == std::string::npos) {
+        rule.literal_ = true;
+        rule.prefix_  = *prefix;
+
+        size_t node = 0;
+        for (const auto c : rule.prefix_) {
+            auto it = trie_[node].children_.find(c);
+            if (it == trie_[node].children_.end()) {
+                trie_.emplace_back();
+                it = trie_[node].children_.emplace(c, trie_.size() - 1).first;
+            }
+            node = it->second;
+        }
+        trie_[node].rules_.push_back(rules_.size());
+    } else {
+        rule.regex_ = std::regex(search);
+    }
+
+    rules_.emplace_back(std::move(rule));
+}
+
+void PathRemapper::Rules::Direction::compile() {
+    next_regex_.resize(rules_.size());
+    auto next = rules_.size();
+    for (auto i = rules_.size(); i > 0; --i) {
+        if (not rules_[i - 1].literal_)
+            next = i - 1;
+        next_regex_[i - 1] = next;
+    }
+}
+
+std::string PathRemapper::Rules::Direction::apply(std::string path) const {
+    size_t i = 0;
+    while (i < rules_.size()) {
+        if (not rules_[i].literal_) {
+            path = std::regex_replace(path, rules_[i].regex_, rules_[i].replacement_);
+            i++;
+            continue;
+        }
 
-    const auto &remap = (forward ? forward_regex_ : backward_regex_);
-    auto p            = path;
+        // the first literal rule from here, up to the next regex, that
+        // matches the path
+        const auto end = next_regex_[i];
+        auto best      = end;
+        size_t node    = 0;
+        for (size_t c = 0;; ++c) {
+            const auto &rules = trie_[node].rules_;
+            auto r            = std::lower_bound(rules.begin(), rules.end(), i);
+            if (r != rules.end() and *r < best)
+                best = *r;
+
+            if (c == path.size())
+                break;
+            auto it = trie_[node].children_.find(path[c]);
+            if (it == trie_[node].children_.end())
+                break;
+            node = it->second;
+        }
+
+        if (best == end) {
+            i = end;
+        } else {
+            path.replace(0, rules_[best].prefix_.size(), rules_[best].replacement_);
+            i = best + 1;
+        }
+    }
+    return path;
+}
+
+std::string PathRemapper::Rules::remap(const std::string &path, const bool forward) const {
+    auto p = path;
 
     // are we in danger of flip / flopping forever ?
     if (forward) {
@@ -25,9 +178,7 @@ std::string PathRemapper::remap(const std::string &path, const bool forward) {
         }
     }
 
-    for (const auto &r : remap) {
-        p = std::regex_replace(p, r.first, r.second);
-    }
+    p = (forward ? forward_ : backward_).apply(std::move(p));
 
     // are we in danger of flip / flopping forever ?
     if (not forward) {
@@ -38,18 +189,71 @@ std::string PathRemapper::remap(const std::string &path, const bool forward) {
         }
     }
 
-    // if(p != path) {
-    // 	spdlog::warn("remap forward {} {} -> {}", forward, path, p);
-    // }
-
     return p;
 }
 
+PathRemapper::PathRemapper()
+    : rules_(std::make_shared<Rules>()), generation_(rules_->generation_) {}
+
+std::string PathRemapper::forwards(const std::string &path) { return remap(path, true); }
+
+std::string PathRemapper::backwards(const std::string &path) { return remap(path, false); }
+
+PathRemapper::Cache &PathRemapper::cache() {
+    // keyed by address, a remapper reusing a dead one's gets a new generation
+    thread_local std::unordered_map<const PathRemapper *, Cache> t_caches;
+
+    if (t_caches.size() >= MAX_CACHES and not t_caches.count(this))
+        t_caches.clear();
+
+    auto &cache = t_caches[this];
+    if (cache.generation_ != generation_.load(std::memory_order_acquire)) {
+        {
+            std::scoped_lock lock(mutex_);
+            cache.rules_ = rules_;
+        }
+        cache.generation_ = cache.rules_->generation_;
+        cache.forward_.clear();
+        cache.backward_.clear();
+    }
+
+    return cache;
+}
+
+std::string PathRemapper::remap(const std::string &path, const bool forward) {
+    auto &cache          = this->cache();
+    const auto memo_size = memo_size_.load(std::memory_order_relaxed);
+
+    if (not memo_size)
+        return cache.rules_->remap(path, forward);
+
+    auto &results = forward ? cache.forward_ : cache.backward_;
+    auto it       = results.find(path);
+    if (it != results.end())
+        return it->second;
+
+    auto result = cache.rules_->remap(path, forward);
+    if (results.size() >= memo_size)
+        results.clear();
+    results.emplace(path, result);
+
+    return result;
+}
+
+void PathRemapper::publish(std::shared_ptr<Rules> rules) {
+    // with mutex_ held
+    rules->generation_ = ++s_generation;
+    rules_             = std::move(rules);
+    generation_.store(rules_->generation_, std::memory_order_release);
+}
+
 void PathRemapper::add_path_mapping(const std::string &from, const std::string &to) {
     // spdlog::warn("add_path_mapping {} -> {}", from, to);
     std::scoped_lock lock(mutex_);
-    forward_map_.emplace(std::make_pair(from, to));
-    backward_map_.emplace(std::make_pair(to, from));
+    auto rules = std::make_shared<Rules>(*rules_);
+    rules->forward_map_.emplace(std::make_pair(from, to));
+    rules->backward_map_.emplace(std::make_pair(to, from));
+    publish(rules);
 }
 
 
@@ -71,8 +275,10 @@ void PathRemapper::configure(const utility::JsonStore &jsn) {
             }
         }
 
-        forward_regex_.clear();
-        backward_regex_.clear();
+        // path mappings are kept, rules replaced
+        auto rules           = std::make_shared<Rules>();
+        rules->forward_map_  = rules_->forward_map_;
+        rules->backward_map_ = rules_->backward_map_;
 
         for (auto p = jsn.begin(); p != jsn.end(); ++p) {
             auto f = p.value();
@@ -80,15 +286,18 @@ void PathRemapper::configure(const utility::JsonStore &jsn) {
                 continue;
             for (const auto &e : f) {
                 if (e.at(2).get<bool>())
-                    forward_regex_.emplace_back(
-                        e.at(0).get<std::string>(), e.at(1).get<std::string>());
+                    rules->forward_.add(e.at(0).get<std::string>(), e.at(1).get<std::string>());
                 else {
-                    backward_regex_.emplace_back(
+                    rules->backward_.add(
                         e.at(0).get<std::string>(), e.at(1).get<std::string>());
                 }
             }
         }
 
+        rules->forward_.compile();
+        rules->backward_.compile();
+        publish(rules);
+
     } catch (std::exception &e) {
         spdlog::warn("{} {} -- \n\n{}\n\n", __PRETTY_FUNCTION__, e.what(), jsn.dump(2));
     }
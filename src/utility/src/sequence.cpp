@@ -40,10 +40,31 @@ namespace fs = std::filesystem;
 using namespace xstudio::utility;
 namespace xstudio::utility {
 
+UriSequence uri_from_sequence(const Sequence &sequence) {
+    static const std::regex percent_match(R"(%0(\d+)d)", std::regex::optimize);
+
+    // convert sequence into uri
+    if (sequence.is_sequence()) {
+        std::string path_fmt_spec =
+            std::regex_replace(sequence.name_, percent_match, "{:0$1d}");
+        // If no frame padding is detected, path_fmt_spec will now have {:00d} in it,
+        // which we want to replace with {:d} as fmtlib will not accept {:00d} as a format
+        // specifier.
+        size_t start_pos = path_fmt_spec.find("{:00d}");
+        if (start_pos != std::string::npos) {
+            // no padding, add default.
+            path_fmt_spec = path_fmt_spec.replace(start_pos, 6, "{:d}");
+        }
+        return std::make_pair(
+            posix_path_to_uri(path_fmt_spec, true), FrameList(sequence.frames_));
+    }
+
+    return std::make_pair(posix_path_to_uri(sequence.name_, true), FrameList());
+}
+
 // parse file list and derive items.
 std::vector<std::pair<caf::uri, FrameList>>
 uri_from_file_list(const std::vector<std::string> &paths) {
-    static const std::regex percent_match(R"(%0(\d+)d)", std::regex::optimize);
     std::vector<std::pair<caf::uri, FrameList>> result;
 
     std::vector<Entry> entries;
@@ -53,24 +74,10 @@ uri_from_file_list(const std::vector<std::string> &paths) {
     }
 
     auto sequences = sequences_from_entries(entries);
-    for (const auto &i : sequences) {
-        // convert sequence into uri
-        if (i.is_sequence()) {
-            std::string path_fmt_spec = std::regex_replace(i.name_, percent_match, "{:0$1d}");
-            // If no frame padding is detected, path_fmt_spec will now have {:00d} in it,
-            // which we want to replace with {:d} as fmtlib will not accept {:00d} as a format
-            // specifier.
-            size_t start_pos = path_fmt_spec.find("{:00d}");
-            if (start_pos != std::string::npos) {
-                // no padding, add default.
-                path_fmt_spec = path_fmt_spec.replace(start_pos, 6, "{:d}");
-            }
-            result.emplace_back(
-                std::make_pair(posix_path_to_uri(path_fmt_spec, true), FrameList(i.frames_)));
-        } else {
-            result.emplace_back(std::make_pair(posix_path_to_uri(i.name_, true), FrameList()));
-        }
-    }
+    result.reserve(sequences.size());
+    for (const auto &i : sequences)
+        result.emplace_back(uri_from_sequence(i));
+
     return result;
 }
 
@@ -246,44 +253,99 @@ struct DefaultSequenceHelper {
 };
 
 
-std::optional<DefaultSequenceHelper> create_default_seq(const Entry &entry) {
-    std::cmatch m;
-    try {
-        static const std::regex bare_number(R"(()([-]?\d+)())", std::regex::optimize);
-        static const std::regex number_and_ext(R"(()([-]?\d+)(\.[^.]+))", std::regex::optimize);
-        static const std::regex body_dot_number_and_double_ext(
-            R"((.+\.)([-]?\d+)(\.[^.\d]{1,4}\.[^.]{1,3}))", std::regex::optimize);
-        static const std::regex body_dot_number_and_ext(
-            R"((.+\.)([-]?\d+)(\.[^.]+))", std::regex::optimize);
-        static const std::regex body_no_dot_number_and_ext(
-            R"((.+[^0-9])(\d+)(\.[^.]+))", std::regex::optimize);
-
-        if (std::regex_match(entry.name_.c_str(), m, bare_number) or
-            std::regex_match(entry.name_.c_str(), m, number_and_ext) or
-            std::regex_match(entry.name_.c_str(), m, body_dot_number_and_double_ext) or
-            std::regex_match(entry.name_.c_str(), m, body_dot_number_and_ext) or
-            std::regex_match(entry.name_.c_str(), m, body_no_dot_number_and_ext)) {
-
-            // skip versions..
-            if (ends_with(m[1].str(), "_v"))
-                return {};
-            DefaultSequenceHelper seq;
-            seq.head_ = escape_percentage(m[1].str());
-            seq.tail_ = escape_percentage(m[3].str());
-            seq.name_ = seq.head_ + "#" + seq.tail_;
-            seq.frames_.insert(std::atoi(m[2].str().c_str()));
-            seq.frame_str_ = m[2].str();
-            seq.pad_       = pad_size(m[2].str());
-            seq.pad_str_   = pad_spec(seq.pad_);
-            seq.entries_.push_back(entry);
-            return seq;
-        }
+namespace {
+
+bool is_digit(const char c) { return c >= '0' and c <= '9'; }
+
+bool all_digits(const std::string_view str) {
+    return not str.empty() and std::all_of(str.begin(), str.end(), is_digit);
+}
+
+bool is_frame_number(std::string_view str) {
+    if (not str.empty() and str.front() == '-')
+        str.remove_prefix(1);
+    return all_digits(str);
+}
 
+// as '.' in a regex, which won't match line breaks
+bool no_line_breaks(const std::string_view str) {
+    return str.find_first_of("\r\n") == std::string_view::npos;
+}
+
+} // namespace
+
+std::optional<FrameNumberSplit> split_frame_number(const std::string_view name) {
+    // 0001
+    if (is_frame_number(name))
+        return FrameNumberSplit{name.substr(0, 0), name, name.substr(name.size())};
+
+    const auto last_dot = name.rfind('.');
+    if (last_dot == std::string_view::npos or last_dot + 1 == name.size())
         return {};
-    } catch (const std::exception &err) {
-        spdlog::warn("{} {}", __PRETTY_FUNCTION__, err.what());
+
+    const auto stem = name.substr(0, last_dot);
+    const auto ext  = name.substr(last_dot);
+
+    // 0001.ext
+    if (is_frame_number(stem))
+        return FrameNumberSplit{name.substr(0, 0), stem, ext};
+
+    const auto dot = stem.rfind('.');
+    if (dot != std::string_view::npos) {
+        // body.0001.ext1.ext where ext1 is up to 4 non digits and ext up to 3 chars
+        const auto ext1 = stem.substr(dot + 1);
+        if (ext.size() <= 4 and not ext1.empty() and ext1.size() <= 4 and
+            std::none_of(ext1.begin(), ext1.end(), is_digit)) {
+            const auto dot2 = stem.rfind('.', dot - 1);
+            if (dot != 0 and dot2 != std::string_view::npos and dot2 != 0 and
+                is_frame_number(stem.substr(dot2 + 1, dot - dot2 - 1)) and
+                no_line_breaks(name.substr(0, dot2)))
+                return FrameNumberSplit{
+                    name.substr(0, dot2 + 1),
+                    stem.substr(dot2 + 1, dot - dot2 - 1),
+                    name.substr(dot)};
+        }
+
+        // body.0001.ext
+        if (dot != 0 and is_frame_number(stem.substr(dot + 1)) and
+            no_line_breaks(name.substr(0, dot)))
+            return FrameNumberSplit{name.substr(0, dot + 1), stem.substr(dot + 1), ext};
     }
-    return {};
+
+    // body0001.ext, the body must end in a non digit
+    auto first_digit = stem.size();
+    while (first_digit and is_digit(stem[first_digit - 1]))
+        first_digit--;
+
+    if (first_digit < 2 or first_digit == stem.size() or
+        not no_line_breaks(stem.substr(0, first_digit - 1)))
+        return {};
+
+    return FrameNumberSplit{stem.substr(0, first_digit), stem.substr(first_digit), ext};
+}
+
+std::optional<DefaultSequenceHelper> create_default_seq(const Entry &entry) {
+    const auto split = split_frame_number(entry.name_);
+    if (not split)
+        return {};
+
+    const std::string head(split->head_);
+    const std::string frame(split->frame_);
+
+    // skip versions..
+    if (ends_with(head, "_v"))
+        return {};
+
+    DefaultSequenceHelper seq;
+    seq.head_ = escape_percentage(head);
+    seq.tail_ = escape_percentage(std::string(split->tail_));
+    seq.name_ = seq.head_ + "#" + seq.tail_;
+    seq.frames_.insert(std::atoi(frame.c_str()));
+    seq.frame_str_ = frame;
+    seq.pad_       = pad_size(frame);
+    seq.pad_str_   = pad_spec(seq.pad_);
+    seq.entries_.push_back(entry);
+    return seq;
 }
 
 std::vector<Sequence> default_collapse_sequences(const std::vector<Entry> &entries) {
@@ -0,0 +1,404 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+
+#include "xstudio/utility/shared_json.hpp"
+
+using namespace xstudio::utility;
+
+struct SharedJson::Node {
+    nlohmann::json::value_t type_{nlohmann::json::value_t::null};
+    // for anything but objects and arrays
+    nlohmann::json value_;
+    std::map<std::string, NodePtr> object_;
+    std::vector<NodePtr> array_;
+};
+
+namespace {
+
+// JSON pointer to unescaped reference tokens
+std::vector<std::string> split_pointer(const std::string &path) {
+    std::vector<std::string> result;
+    if (path.empty())
+        return result;
+
+    if (path.front() != '/')
+        throw std::invalid_argument("JSON pointer must be empty or begin with '/': " + path);
+
+    size_t start = 1;
+    while (true) {
+        const auto end = path.find('/', start);
+        auto token     = path.substr(start, end == std::string::npos ? end : end - start);
+
+        for (auto i = token.find('~'); i != std::string::npos; i = token.find('~', i + 1)) {
+            if (i + 1 == token.size() or (token[i + 1] != '0' and token[i + 1] != '1'))
+                throw std::invalid_argument("Bad escape in JSON pointer: " + path);
+            token.replace(i, 2, token[i + 1] == '0' ? "~" : "/");
+        }
+        result.emplace_back(std::move(token));
+
+        if (end == std::string::npos)
+            break;
+        start = end + 1;
+    }
+    return result;
+}
+
+// digits without leading zeros
+std::optional<size_t> array_index(const std::string &token) {
+    if (token.empty() or (token.size() > 1 and token.front() == '0'))
+        return {};
+
+    size_t result = 0;
+    for (const auto c : token) {
+        if (c < '0' or c > '9')
+            return {};
+        result = result * 10 + (c - '0');
+    }
+    return result;
+}
+
+bool is_container(const nlohmann::json::value_t type) {
+    return type == nlohmann::json::value_t::object or type == nlohmann::json::value_t::array;
+}
+
+} // namespace
+
+const SharedJson::NodePtr &SharedJson::null_node() {
+    static const NodePtr s_null = std::make_shared<const Node>();
+    return s_null;
+}
+
+template <typename J> SharedJson::NodePtr SharedJson::make_node(J &&json) {
+    if (json.is_null())
+        return null_node();
+
+    auto node   = std::make_shared<Node>();
+    node->type_ = json.type();
+
+    if (json.is_object()) {
+        for (auto it = json.begin(); it != json.end(); ++it)
+            node->object_.emplace_hint(node->object_.end(), it.key(), make_node(*it));
+    } else if (json.is_array()) {
+        node->array_.reserve(json.size());
+        for (auto &i : json)
+            node->array_.emplace_back(make_node(i));
+    } else if constexpr (std::is_const_v<std::remove_reference_t<J>>) {
+        node->value_ = json;
+    } else {
+        node->value_ = std::move(json);
+    }
+
+    return node;
+}
+
+SharedJson::SharedJson(const nlohmann::json &json) : node_(make_node(json)) {}
+
+SharedJson::SharedJson(nlohmann::json &&json) : node_(make_node(json)) {}
+
+nlohmann::json SharedJson::make_json(const Node &node) {
+    if (node.type_ == nlohmann::json::value_t::object) {
+        nlohmann::json::object_t result;
+        for (const auto &i : node.object_)
+            result.emplace_hint(result.end(), i.first, make_json(*i.second));
+        return nlohmann::json(std::move(result));
+    }
+
+    if (node.type_ == nlohmann::json::value_t::array) {
+        nlohmann::json::array_t result;
+        result.reserve(node.array_.size());
+        for (const auto &i : node.array_)
+            result.emplace_back(make_json(*i));
+        return nlohmann::json(std::move(result));
+    }
+
+    return node.value_;
+}
+
+JsonStore SharedJson::json() const { return JsonStore(make_json(*node_)); }
+
+nlohmann::json::value_t SharedJson::type() const { return node_->type_; }
+
+size_t SharedJson::size() const {
+    switch (node_->type_) {
+    case nlohmann::json::value_t::null:
+        return 0;
+    case nlohmann::json::value_t::object:
+        return node_->object_.size();
+    case nlohmann::json::value_t::array:
+        return node_->array_.size();
+    default:
+        return 1;
+    }
+}
+
+SharedJson::NodePtr SharedJson::find(const std::vector<std::string> &path) const {
+    auto node = node_;
+    for (const auto &token : path) {
+        if (node->type_ == nlohmann::json::value_t::object) {
+            auto it = node->object_.find(token);
+            if (it == node->object_.end())
+                return nullptr;
+            node = it->second;
+        } else if (node->type_ == nlohmann::json::value_t::array) {
+            const auto index = array_index(token);
+            if (not index or *index >= node->array_.size())
+                return nullptr;
+            node = node->array_[*index];
+        } else {
+            return nullptr;
+        }
+    }
+    return node;
+}
+
+SharedJson SharedJson::get(const std::string &path) const {
+    auto node = find(split_pointer(path));
+    if (not node)
+        throw std::out_of_range("No value at " + path);
+    return SharedJson(std::move(node));
+}
+
+bool SharedJson::contains(const std::string &path) const {
+    try {
+        return find(split_pointer(path)) != nullptr;
+    } catch (const std::invalid_argument &) {
+    }
+    return false;
+}
+
+SharedJson::NodePtr SharedJson::set_at(
+    const NodePtr &node,
+    const std::vector<std::string> &path,
+    const size_t depth,
+    const NodePtr &value,
+    const bool insert) {
+    if (depth == path.size())
+        return value;
+
+    const auto &token = path[depth];
+    auto result       = std::make_shared<Node>(*node);
+
+    // as nlohmann::json, null becomes an array if indexed by a number
+    if (result->type_ == nlohmann::json::value_t::null)
+        result->type_ = array_index(token) ? nlohmann::json::value_t::array
+                                           : nlohmann::json::value_t::object;
+
+    if (result->type_ == nlohmann::json::value_t::object) {
+        auto it    = result->object_.find(token);
+        auto child = set_at(
+            it == result->object_.end() ? null_node() : it->second,
+            path,
+            depth + 1,
+            value,
+            insert);
+        result->object_.insert_or_assign(token, std::move(child));
+
+    } else if (result->type_ == nlohmann::json::value_t::array) {
+        auto &array      = result->array_;
+        const auto index = token == "-" ? array.size() : array_index(token);
+        if (not index)
+            throw std::invalid_argument("Bad array index " + token);
+
+        if (insert and depth + 1 == path.size()) {
+            if (*index > array.size())
+                throw std::out_of_range("Array index " + token + " out of range");
+            array.insert(array.begin() + *index, value);
+        } else {
+            if (*index >= array.size())
+                array.resize(*index + 1, null_node());
+            array[*index] = set_at(array[*index], path, depth + 1, value, insert);
+        }
+
+    } else {
+        throw std::invalid_argument(
+            "Cannot set " + token + " in a " + std::string(make_json(*node).type_name()));
+    }
+
+    return result;
+}
+
+SharedJson SharedJson::set(const SharedJson &value, const std::string &path) const {
+    return SharedJson(set_at(node_, split_pointer(path), 0, value.node_, false));
+}
+
+SharedJson SharedJson::add(const SharedJson &value, const std::string &path) const {
+    auto tokens = split_pointer(path);
+    if (tokens.empty())
+        return value;
+
+    // unlike set, the parent must exist
+    const auto leaf = tokens.back();
+    tokens.pop_back();
+    const auto parent = find(tokens);
+    if (not parent or not is_container(parent->type_))
+        throw std::out_of_range("No container for " + path);
+    tokens.push_back(leaf);
+
+    return SharedJson(set_at(node_, tokens, 0, value.node_, true));
+}
+
+SharedJson::NodePtr SharedJson::remove_at(
+    const NodePtr &node, const std::vector<std::string> &path, const size_t depth) {
+    const auto &token = path[depth];
+    const auto last   = depth + 1 == path.size();
+
+    if (node->type_ == nlohmann::json::value_t::object) {
+        auto it = node->object_.find(token);
+        if (it == node->object_.end())
+            return nullptr;
+
+        NodePtr child;
+        if (not last and not(child = remove_at(it->second, path, depth + 1)))
+            return nullptr;
+
+        auto result = std::make_shared<Node>(*node);
+        if (last)
+            result->object_.erase(token);
+        else
+            result->object_[token] = std::move(child);
+        return result;
+    }
+
+    if (node->type_ == nlohmann::json::value_t::array) {
+        const auto index = array_index(token);
+        if (not index or *index >= node->array_.size())
+            return nullptr;
+
+        NodePtr child;
+        if (not last and not(child = remove_at(node->array_[*index], path, depth + 1)))
+            return nullptr;
+
+        auto result = std::make_shared<Node>(*node);
+        if (last)
+            result->array_.erase(result->array_.begin() + *index);
+        else
+            result->array_[*index] = std::move(child);
+        return result;
+    }
+
+    return nullptr;
+}
+
+SharedJson SharedJson::remove(const std::string &path, bool *removed) const {
+    const auto tokens = split_pointer(path);
+    auto node         = tokens.empty() ? nullptr : remove_at(node_, tokens, 0);
+
+    if (removed)
+        *removed = node != nullptr;
+
+    return node ? SharedJson(std::move(node)) : *this;
+}
+
+SharedJson::NodePtr SharedJson::merge_nodes(const NodePtr &node, const NodePtr &value) {
+    if (node->type_ != value->type_ or not is_container(node->type_))
+        return value;
+
+    auto result = std::make_shared<Node>(*node);
+
+    if (node->type_ == nlohmann::json::value_t::object) {
+        for (const auto &i : value->object_) {
+            auto it = result->object_.find(i.first);
+            if (it == result->object_.end())
+                result->object_.emplace(i);
+            else
+                it->second = merge_nodes(it->second, i.second);
+        }
+    } else {
+        auto &array = result->array_;
+        for (size_t i = 0; i < value->array_.size(); i++) {
+            if (i < array.size())
+                array[i] = merge_nodes(array[i], value->array_[i]);
+            else
+                array.push_back(value->array_[i]);
+        }
+    }
+
+    return result;
+}
+
+SharedJson SharedJson::merge(const SharedJson &value, const std::string &path) const {
+    const auto tokens = split_pointer(path);
+    const auto node   = find(tokens);
+
+    if (not node)
+        return set(value, path);
+
+    return SharedJson(set_at(node_, tokens, 0, merge_nodes(node, value.node_), false));
+}
+
+SharedJson SharedJson::patch(const nlohmann::json &patch) const {
+    if (not patch.is_array())
+        throw std::invalid_argument("JSON patch must be an array");
+
+    auto result = *this;
+
+    for (const auto &operation : patch) {
+        const auto op   = operation.at("op").get<std::string>();
+        const auto path = operation.at("path").get<std::string>();
+
+        if (op == "add") {
+            result = result.add(SharedJson(operation.at("value")), path);
+        } else if (op == "remove") {
+            auto removed = false;
+            result       = result.remove(path, &removed);
+            if (not removed)
+                throw std::out_of_range("No value to remove at " + path);
+        } else if (op == "replace") {
+            if (not result.contains(path))
+                throw std::out_of_range("No value to replace at " + path);
+            result = result.set(SharedJson(operation.at("value")), path);
+        } else if (op == "move") {
+            const auto from  = operation.at("from").get<std::string>();
+            const auto value = result.get(from);
+            result           = result.remove(from).add(value, path);
+        } else if (op == "copy") {
+            result = result.add(result.get(operation.at("from").get<std::string>()), path);
+        } else if (op == "test") {
+            if (result.get(path) != SharedJson(operation.at("value")))
+                throw std::invalid_argument("JSON patch test failed at " + path);
+        } else {
+            throw std::invalid_argument("Unknown JSON patch operation " + op);
+        }
+    }
+
+    return result;
+}
+
+bool SharedJson::equal(const NodePtr &a, const NodePtr &b) {
+    if (a == b)
+        return true;
+
+    // numbers of different types may still be equal
+    if (not is_container(a->type_) and not is_container(b->type_))
+        return a->value_ == b->value_;
+
+    if (a->type_ != b->type_)
+        return false;
+
+    if (a->type_ == nlohmann::json::value_t::object) {
+        if (a->object_.size() != b->object_.size())
+            return false;
+        auto j = b->object_.begin();
+        for (auto i = a->object_.begin(); i != a->object_.end(); ++i, ++j) {
+            if (i->first != j->first or not equal(i->second, j->second))
+                return false;
+        }
+        return true;
+    }
+
+    if (a->array_.size() != b->array_.size())
+        return false;
+    for (size_t i = 0; i < a->array_.size(); i++) {
+        if (not equal(a->array_[i], b->array_[i]))
+            return false;
+    }
+    return true;
+}
+
+bool SharedJson::operator==(const SharedJson &other) const { return equal(node_, other.node_); }
+
+void xstudio::utility::to_json(nlohmann::json &j, const SharedJson &c) { j = c.json(); }
+
+void xstudio::utility::from_json(const nlohmann::json &j, SharedJson &c) { c = SharedJson(j); }
@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <map>
+
+#include <fmt/format.h>
+
+#include "xstudio/utility/directory_scanner.hpp"
+
+using namespace xstudio::utility;
+namespace fs = std::filesystem;
+
+namespace {
+
+void touch(const fs::path &path) {
+    fs::create_directories(path.parent_path());
+    std::ofstream o(path);
+    o << "x";
+}
+
+} // namespace
+
+TEST(DirectoryScannerTest, Test) {
+
+    const auto root = fs::temp_directory_path() / "xstudio_directory_scanner_test";
+    fs::remove_all(root);
+
+    for (int i = 1; i <= 10; ++i)
+        touch(root / "a" / fmt::format("shot.{:04d}.exr", i));
+    touch(root / "a" / "notes.txt");
+    touch(root / "b" / "c" / "movie.mov");
+    touch(root / "b" / ".hidden.exr");
+    touch(root / ".git" / "ignored.exr");
+    touch(root / "skip" / "ignored.exr");
+
+    DirectoryScanOptions options;
+    options.thread_count       = 3;
+    options.extensions         = {".exr", ".mov"};
+    options.ignore_directories = {"skip"};
+
+    std::map<std::string, DirectoryScanResult> results;
+    double progress = 0.0;
+
+    DirectoryScanner scanner(options);
+    EXPECT_TRUE(scanner.scan(
+        root.string(),
+        [&](const DirectoryScanResult &result, const DirectoryScanProgress &p) {
+            results[fs::relative(result.path_, root).string()] = result;
+            EXPECT_GE(p.progress_, progress);
+            progress = p.progress_;
+        }));
+
+    EXPECT_NEAR(progress, 1.0, 1e-9);
+    ASSERT_EQ(results.size(), size_t(4));
+
+    const auto &top = results["."];
+    ASSERT_EQ(top.subdirectories_.size(), size_t(2));
+    EXPECT_EQ(top.subdirectories_[0], (root / "a").string());
+    EXPECT_EQ(top.subdirectories_[1], (root / "b").string());
+    EXPECT_TRUE(top.sequences_.empty());
+
+    const auto &a = results["a"];
+    ASSERT_EQ(a.sequences_.size(), size_t(1));
+    EXPECT_EQ(a.sequences_[0].name_, (root / "a" / "shot.%04d.exr").string());
+    EXPECT_EQ(a.sequences_[0].frames_, "1-10");
+    EXPECT_EQ(a.sequences_[0].count_, size_t(10));
+    EXPECT_EQ(a.sequences_[0].apparent_size_, 10);
+
+    EXPECT_TRUE(results["b"].sequences_.empty());
+
+    const auto &c = results["b/c"];
+    EXPECT_EQ(c.depth_, 2);
+    EXPECT_EQ(c.index_path_, std::vector<size_t>({1, 0}));
+    ASSERT_EQ(c.sequences_.size(), size_t(1));
+    EXPECT_FALSE(c.sequences_[0].is_sequence());
+
+    // depth limited
+    options.max_depth = 0;
+    results.clear();
+    DirectoryScanner(options).scan(
+        root.string(), [&](const DirectoryScanResult &result, const DirectoryScanProgress &) {
+            results[result.path_] = result;
+        });
+    EXPECT_EQ(results.size(), size_t(1));
+
+    // cancelled from the callback
+    options.max_depth    = -1;
+    options.thread_count = 1;
+    size_t count         = 0;
+    DirectoryScanner cancelled(options);
+    EXPECT_FALSE(cancelled.scan(
+        root.string(), [&](const DirectoryScanResult &, const DirectoryScanProgress &) {
+            count++;
+            cancelled.cancel();
+        }));
+    EXPECT_EQ(count, size_t(1));
+
+    fs::remove_all(root);
+}
@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+#include "xstudio/utility/file_probe_cache.hpp"
+
+using namespace xstudio::utility;
+namespace fs = std::filesystem;
+
+namespace {
+
+void write_file(const fs::path &path, const std::string &content) {
+    std::ofstream o(path);
+    o << content;
+}
+
+} // namespace
+
+TEST(FileProbeCacheTest, Test) {
+
+    const auto dir = fs::temp_directory_path() / "xstudio_file_probe_cache_test";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    const auto media = (dir / "media.mov").string();
+    write_file(media, "0123456789");
+
+    const nlohmann::json detail{{"reader", "FFMPEG"}, {"streams", 2}};
+
+    {
+        FileProbeCache cache("media_detail");
+        cache.set_directory((dir / "cache").string());
+        EXPECT_EQ(cache.size(), size_t(0));
+        EXPECT_FALSE(cache.find(media, "ffmpeg@1.0.0"));
+
+        cache.store(media, "ffmpeg@1.0.0", detail);
+        cache.store(media, "ffmpeg@1.0.0", nlohmann::json(12), "12");
+        EXPECT_EQ(cache.size(), size_t(2));
+
+        auto hit = cache.find(media, "ffmpeg@1.0.0");
+        ASSERT_TRUE(hit);
+        EXPECT_EQ(*hit, detail);
+        EXPECT_EQ(*cache.find(media, "ffmpeg@1.0.0", "12"), nlohmann::json(12));
+
+        // different plugin versions, different answer
+        EXPECT_FALSE(cache.find(media, "ffmpeg@1.1.0"));
+
+        // files we can't stat aren't cached
+        cache.store((dir / "missing.####.exr").string(), "ffmpeg@1.0.0", detail);
+        EXPECT_EQ(cache.size(), size_t(2));
+
+        EXPECT_TRUE(cache.flush());
+        EXPECT_TRUE(fs::exists(cache.cache_file()));
+    }
+
+    {
+        // persisted
+        FileProbeCache cache("media_detail");
+        cache.set_directory((dir / "cache").string());
+        EXPECT_EQ(cache.size(), size_t(2));
+        auto hit = cache.find(media, "ffmpeg@1.0.0");
+        ASSERT_TRUE(hit);
+        EXPECT_EQ(*hit, detail);
+
+        // file changed size, entry is stale
+        write_file(media, "0123456789abcdef");
+        EXPECT_FALSE(cache.find(media, "ffmpeg@1.0.0"));
+
+        cache.set_enabled(false);
+        cache.store(media, "ffmpeg@1.0.0", detail);
+        EXPECT_FALSE(cache.find(media, "ffmpeg@1.0.0"));
+        cache.set_enabled(true);
+        cache.store(media, "ffmpeg@1.0.0", detail);
+        EXPECT_TRUE(cache.find(media, "ffmpeg@1.0.0"));
+    }
+
+    {
+        // changes made since the file was written come back from its log
+        FileProbeCache cache("media_detail");
+        cache.set_directory((dir / "cache").string());
+        EXPECT_EQ(cache.size(), size_t(2));
+        EXPECT_TRUE(cache.find(media, "ffmpeg@1.0.0"));
+        cache.erase(media, "12");
+    }
+
+    {
+        FileProbeCache cache("media_detail");
+        cache.set_directory((dir / "cache").string());
+        EXPECT_EQ(cache.size(), size_t(1));
+        EXPECT_FALSE(cache.find(media, "ffmpeg@1.0.0", "12"));
+    }
+
+    {
+        // least recently used entries dropped when over max count
+        FileProbeCache cache("pruned", 10);
+        for (int i = 0; i < 20; ++i) {
+            const auto f = (dir / (std::to_string(i) + ".exr")).string();
+            write_file(f, "x");
+            cache.store(f, "exr", nlohmann::json(i));
+        }
+        EXPECT_LE(cache.size(), size_t(10));
+        EXPECT_TRUE(cache.find((dir / "19.exr").string(), "exr"));
+        EXPECT_FALSE(cache.find((dir / "0.exr").string(), "exr"));
+    }
+
+    {
+        // sequences are identified by their first frame
+        FileProbeCache cache("sequence");
+        fs::create_directories(dir / "seq");
+        for (int i = 1001; i < 1004; ++i)
+            write_file(dir / "seq" / ("shot." + std::to_string(i) + ".exr"), "x");
+        write_file(dir / "seq" / "shot.1000.jpg", "x");
+
+        const auto seq = (dir / "seq" / "shot.{:04d}.exr").string();
+        cache.store(seq, "exr", detail);
+        cache.store((dir / "seq" / "shot.####.exr").string(), "exr", detail);
+        EXPECT_EQ(cache.size(), size_t(2));
+        EXPECT_TRUE(cache.find(seq, "exr"));
+        EXPECT_TRUE(cache.find((dir / "seq" / "shot.####.exr").string(), "exr"));
+
+        write_file(dir / "seq" / "shot.1001.exr", "xx");
+        EXPECT_FALSE(cache.find(seq, "exr"));
+
+        // first frame gone, the next one takes over
+        cache.store(seq, "exr", detail);
+        fs::remove(dir / "seq" / "shot.1001.exr");
+        EXPECT_FALSE(cache.find(seq, "exr"));
+        cache.store(seq, "exr", detail);
+        EXPECT_TRUE(cache.find(seq, "exr"));
+
+        EXPECT_EQ(cache.hits(), size_t(3));
+        EXPECT_EQ(cache.misses(), size_t(2));
+    }
+
+    fs::remove_all(dir);
+}
@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include "xstudio/utility/json_interner.hpp"
+
+using namespace xstudio::utility;
+
+TEST(JsonInternerTest, Test) {
+    JsonInterner interner;
+    bool created = false;
+
+    auto a = interner.intern(R"({"channels": ["R", "G", "B"], "frame": 1})"_json, &created);
+    EXPECT_TRUE(created);
+    auto b = interner.intern(R"({"frame": 1, "channels": ["R", "G", "B"]})"_json, &created);
+    EXPECT_FALSE(created);
+    EXPECT_EQ(a.value.get(), b.value.get());
+    EXPECT_EQ(a.bytes, json_size_bytes(*a.value));
+
+    auto c = interner.intern(R"({"channels": ["R", "G", "B"], "frame": 2})"_json, &created);
+    EXPECT_TRUE(created);
+    EXPECT_NE(a.value.get(), c.value.get());
+    EXPECT_EQ(interner.count(), size_t(2));
+
+    // freed with the last user, then made again
+    a.value.reset();
+    b.value.reset();
+    a = interner.intern(R"({"channels": ["R", "G", "B"], "frame": 1})"_json, &created);
+    EXPECT_TRUE(created);
+
+    // values held weakly are pruned as more are added
+    for (int i = 0; i < 5000; i++)
+        interner.intern(nlohmann::json(i));
+    EXPECT_LT(interner.count(), size_t(2100));
+}
+
+TEST(JsonInternerTest, Source) {
+    JsonInterner interner;
+    JsonSourceInterner source(interner);
+
+    auto a = source.intern("owner", "someone");
+    auto b = source.intern("owner", "someone");
+    EXPECT_EQ(a.value.get(), b.value.get());
+
+    // slots are separate, but share through the interner
+    auto c = source.intern("creator", "someone");
+    EXPECT_EQ(a.value.get(), c.value.get());
+
+    auto d = source.intern("owner", "someone else");
+    EXPECT_NE(a.value.get(), d.value.get());
+    EXPECT_EQ(*d.value, nlohmann::json("someone else"));
+    EXPECT_EQ(interner.intern("someone else").value.get(), d.value.get());
+}
+
+TEST(JsonInternerTest, Size) {
+    const auto small = json_size_bytes(nlohmann::json(1));
+    EXPECT_EQ(small, sizeof(nlohmann::json));
+    EXPECT_GT(json_size_bytes(nlohmann::json(std::string(100, 'x'))), small + 100);
+
+    const auto object = R"({"a": 1, "b": [1, 2, 3], "c": {"d": "e"}})"_json;
+    EXPECT_GT(json_size_bytes(object), 8 * sizeof(nlohmann::json));
+    EXPECT_LT(json_size_bytes(object), size_t(2048));
+}
@@ -28,6 +28,16 @@ TEST(JsonStoreTest, Test) {
     EXPECT_THROW(static_cast<void>(j.get("/hello")), nlohmann::detail::exception)
         << "Should be null";
 
+    j["list"] = {0, 1, 2};
+    EXPECT_TRUE(j.remove("/list/1"));
+    EXPECT_EQ(j.get("/list"), json({0, 2}));
+    EXPECT_FALSE(j.remove("/list/2"));
+    EXPECT_FALSE(j.remove("/list/-"));
+    EXPECT_FALSE(j.remove("/hello"));
+    EXPECT_FALSE(j.remove("/hell/x"));
+    EXPECT_FALSE(j.remove(""));
+    j.remove("/list");
+
     j["test"] = {{"currency", "UK"}};
 
     EXPECT_EQ(j.get("/test/currency"), "UK") << "Should be UK";
@@ -63,3 +73,41 @@ TEST(JsonStoreTest, Test) {
     j = R"({"test": {"one": 3 }})"_json;
     j.merge(R"({"test": {"two": 3 }, "doube":[1]})"_json);
 }
+
+TEST(JsonStoreTest, ParseSession) {
+    json session = R"({
+        "base": {"container": {"type": "Session", "name": "a \"quoted\" {name}"}},
+        "store": {"list": [1, 2.5, true, null, "]"]},
+        "actors": {}
+    })"_json;
+    for (int i = 0; i < 10; i++) {
+        session["actors"]["playlist " + std::to_string(i)] = {
+            {"base", {{"container", {{"type", "Playlist"}, {"name", "\\\\ }\" "}}}}},
+            {"actors", {{"media", {{"frames", {i, i + 100}}}}}}};
+    }
+
+    for (const auto indent : {-1, 4}) {
+        const auto text = session.dump(indent);
+        EXPECT_EQ(parse_session(text), session);
+        EXPECT_EQ(parse_session(text + "\n"), session);
+    }
+    // one playlist, split at its media
+    json playlist = R"({"base": {}, "actors": {}})"_json;
+    for (int i = 0; i < 10; i++)
+        playlist["actors"]["media " + std::to_string(i)] = {{"frames", {i, i + 100}}};
+    session["actors"] = {{"playlist", playlist}};
+    EXPECT_EQ(parse_session(session.dump()), session);
+
+    EXPECT_EQ(parse_session(R"({"actors": {"a": 1}})"), R"({"actors": {"a": 1}})"_json);
+    EXPECT_EQ(parse_session("[1, 2]"), json({1, 2}));
+
+    for (const auto &bad : std::vector<std::string>{
+             R"({"actors": {"a": {}, "b": {]}})",
+             R"({"actors": {"a": {}, "b": {}}} x)",
+             R"({"actors": {"a": {}, "b": {}}, "c": [})",
+             R"({"actors": {"a": {}, "b": "})",
+             R"({"actors": {"a": {"actors": {"m": {], "n": {}}}}})",
+             R"({"actors": {"a": {"actors": {"m": {}, "n": {}} x}}})"}) {
+        EXPECT_THROW(static_cast<void>(parse_session(bad)), json::exception) << bad;
+    }
+}
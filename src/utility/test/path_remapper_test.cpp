@@ -0,0 +1,117 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+
+#include "xstudio/utility/path_remapper.hpp"
+
+using namespace xstudio::utility;
+
+namespace {
+
+// every rule as a regex, as PathRemapper used to
+std::string regex_remap(const JsonStore &rules, const std::string &path, const bool forward) {
+    auto p = path;
+    for (const auto &r : rules["rules"]) {
+        if (r.at(2).get<bool>() == forward)
+            p = std::regex_replace(
+                p, std::regex(r.at(0).get<std::string>()), r.at(1).get<std::string>());
+    }
+    return p;
+}
+
+// forty sites, each mapped forwards and backwards by prefix, and a few regexes
+JsonStore site_rules() {
+    JsonStore rules;
+    rules["rules"] = nlohmann::json::array();
+    for (int i = 0; i < 40; i++) {
+        const auto site = std::to_string(i);
+        rules["rules"].push_back(
+            {"^/mnt/site" + site + "/", "/studio/site" + site + "/local/", true});
+        rules["rules"].push_back(
+            {"^/studio/site" + site + "/local/", "/mnt/site" + site + "/", false});
+    }
+    rules["rules"].push_back({"^/mnt/site3/", "/never/", true});
+    rules["rules"].push_back({"\\\\", "/", true});
+    rules["rules"].push_back({"^/studio/site7/local/(\\w+)/", "/studio/site7/$1/", true});
+    rules["rules"].push_back({"^/studio/site7/", "/studio/seven/", true});
+    rules["rules"].push_back({"^/jobs\\.old/", "/jobs/", true});
+    rules["rules"].push_back({"^", "file:", false});
+    return rules;
+}
+
+} // namespace
+
+TEST(PathRemapperTest, Test) {
+    const auto rules = site_rules();
+    PathRemapper remapper;
+    remapper.configure(rules);
+
+    for (const auto &path : std::vector<std::string>{
+             "/mnt/site3/show/shot/file.exr",
+             "/mnt/site7/show/shot/file.exr",
+             "/mnt/site12/show/shot/file.exr",
+             "/mnt/site1/",
+             "/mnt/site",
+             "/studio/site5/local/show/file.exr",
+             "/jobs.old/show/file.exr",
+             "/jobs_old/show/file.exr",
+             "C:\\show\\file.exr",
+             "",
+             "/other/file.exr"}) {
+        EXPECT_EQ(remapper.forwards(path), regex_remap(rules, path, true)) << path;
+        EXPECT_EQ(remapper.backwards(path), regex_remap(rules, path, false)) << path;
+        // remembered
+        EXPECT_EQ(remapper.forwards(path), regex_remap(rules, path, true)) << path;
+    }
+    EXPECT_EQ(
+        remapper.forwards("/mnt/site7/show/file.exr"), "/studio/seven/show/file.exr");
+    EXPECT_EQ(remapper.backwards("/studio/site1/local/a"), "file:/mnt/site1/a");
+
+    remapper.add_path_mapping("/virtual/file.exr", "/mnt/site2/file.exr");
+    EXPECT_EQ(remapper.forwards("/virtual/file.exr"), "/studio/site2/local/file.exr");
+    EXPECT_EQ(remapper.backwards("/studio/site2/local/file.exr"), "file:/mnt/site2/file.exr");
+
+    // reconfiguring replaces earlier results, keeps path mappings
+    JsonStore other;
+    other["rules"] = {{"^/mnt/", "/net/", true}};
+    remapper.configure(other);
+    EXPECT_EQ(remapper.forwards("/mnt/site7/show/file.exr"), "/net/site7/show/file.exr");
+    EXPECT_EQ(remapper.forwards("/virtual/file.exr"), "/net/site2/file.exr");
+
+    // bad rules are ignored
+    JsonStore bad;
+    bad["rules"] = nlohmann::json::array({nlohmann::json::array({"^/mnt/", "/bad/"})});
+    remapper.configure(bad);
+    EXPECT_EQ(remapper.forwards("/mnt/a"), "/net/a");
+}
+
+TEST(PathRemapperTest, Instances) {
+    // each remapper keeps its own results on a thread
+    JsonStore a_rules;
+    a_rules["rules"] = {{"^/mnt/", "/a/", true}};
+    JsonStore b_rules;
+    b_rules["rules"] = {{"^/mnt/", "/b/", true}};
+
+    auto a = std::make_unique<PathRemapper>();
+    PathRemapper b;
+    a->configure(a_rules);
+    b.configure(b_rules);
+
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(a->forwards("/mnt/file.exr"), "/a/file.exr");
+        EXPECT_EQ(b.forwards("/mnt/file.exr"), "/b/file.exr");
+    }
+
+    // one made where another was isn't given its results
+    a.reset();
+    auto c = std::make_unique<PathRemapper>();
+    EXPECT_EQ(c->forwards("/mnt/file.exr"), "/mnt/file.exr");
+
+    // changes are seen by other threads
+    b.configure(a_rules);
+    std::string result;
+    std::thread([&]() { result = b.forwards("/mnt/file.exr"); }).join();
+    EXPECT_EQ(result, "/a/file.exr");
+    EXPECT_EQ(b.forwards("/mnt/file.exr"), "/a/file.exr");
+}
@@ -1,4 +1,7 @@
 // SPDX-License-Identifier: Apache-2.0
+#include <algorithm>
+
+#include "xstudio/utility/frame_list.hpp"
 #include "xstudio/utility/sequence.hpp"
 #include <gtest/gtest.h>
 
@@ -14,3 +17,52 @@ TEST(PadTest, Test) {
     EXPECT_EQ(pad_spec(pad_size("100")), "%00d");
     EXPECT_EQ(pad_spec(pad_size("1")), "%00d");
 }
+
+TEST(SplitFrameNumberTest, Test) {
+    auto check = [](const std::string &name,
+                    const std::string &head,
+                    const std::string &frame,
+                    const std::string &tail) {
+        const auto split = split_frame_number(name);
+        ASSERT_TRUE(split) << name;
+        EXPECT_EQ(split->head_, head) << name;
+        EXPECT_EQ(split->frame_, frame) << name;
+        EXPECT_EQ(split->tail_, tail) << name;
+    };
+
+    check("0001", "", "0001", "");
+    check("-01", "", "-01", "");
+    check("0001.exr", "", "0001", ".exr");
+    check("/a/shot.1001.exr", "/a/shot.", "1001", ".exr");
+    check("/a/shot.-0010.exr", "/a/shot.", "-0010", ".exr");
+    check("/a/shot.1001.exr.gz", "/a/shot.", "1001", ".exr.gz");
+    check("/a/shot_1001.exr", "/a/shot_", "1001", ".exr");
+    check("/a/shot.v2.1001.dpx", "/a/shot.v2.", "1001", ".dpx");
+    check("/a/shot_v002.exr", "/a/shot_v", "002", ".exr");
+
+    EXPECT_FALSE(split_frame_number("/a/shot.exr"));
+    EXPECT_FALSE(split_frame_number("/a/shot.1001."));
+    EXPECT_FALSE(split_frame_number("/a/shot-.exr"));
+}
+
+TEST(UriFromFileListTest, Test) {
+    const auto items = uri_from_file_list(
+        {"/a/shot.1001.exr",
+         "/a/shot.1002.exr",
+         "/a/shot.1003.exr",
+         "/a/shot_v001.exr",
+         "/a/shot_v002.exr",
+         "/a/movie.mov"});
+
+    // versions and movies aren't sequences
+    ASSERT_EQ(items.size(), size_t(4));
+    EXPECT_EQ(
+        std::count_if(
+            items.begin(), items.end(), [](const auto &i) { return i.second.empty(); }),
+        3);
+    for (const auto &i : items) {
+        if (not i.second.empty()) {
+            EXPECT_EQ(to_string(i.second), "1001-1003");
+        }
+    }
+}
@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+#include "xstudio/utility/shared_json.hpp"
+
+using namespace xstudio::utility;
+using namespace nlohmann;
+
+namespace {
+
+const std::string preference_dir = ROOT_DIR "/share/preference";
+
+// all the preference files, merged as the global store does
+JsonStore preferences() {
+    JsonStore result;
+    for (const auto &entry : std::filesystem::directory_iterator(preference_dir)) {
+        if (entry.path().extension() != ".json")
+            continue;
+        std::ifstream i(entry.path());
+        result.merge(json::parse(i));
+    }
+    return result;
+}
+
+} // namespace
+
+TEST(SharedJsonTest, Test) {
+    const auto source = R"({
+        "a": {"b": 1, "c": [1, 2, {"d": "e"}]},
+        "f~g/h": true,
+        "i": null,
+        "j": {}
+    })"_json;
+
+    const SharedJson j(source);
+    EXPECT_EQ(j.json(), source);
+    EXPECT_EQ(j.size(), size_t(4));
+    EXPECT_TRUE(j.is_object());
+    EXPECT_EQ(j.get<int>("/a/b"), 1);
+    EXPECT_EQ(j.get<std::string>("/a/c/2/d"), "e");
+    EXPECT_TRUE(j.get<bool>("/f~0g~1h"));
+    EXPECT_TRUE(j.get("/i").is_null());
+    EXPECT_TRUE(j.contains("/j"));
+    EXPECT_FALSE(j.contains("/a/c/3"));
+    EXPECT_FALSE(j.contains("/a/c/01"));
+    EXPECT_THROW(static_cast<void>(j.get("/x")), std::out_of_range);
+    EXPECT_THROW(static_cast<void>(j.get("x")), std::invalid_argument);
+
+    // changes leave the original alone and share the rest
+    const auto k = j.set(json(2), "/a/c/0");
+    EXPECT_EQ(j.get<int>("/a/c/0"), 1);
+    EXPECT_EQ(k.get<int>("/a/c/0"), 2);
+    EXPECT_TRUE(k.get("/a/c/2").shares(j.get("/a/c/2")));
+    EXPECT_TRUE(k.get("/j").shares(j.get("/j")));
+    EXPECT_FALSE(k.get("/a").shares(j.get("/a")));
+    EXPECT_NE(j, k);
+
+    // paths are created as nlohmann::json would
+    auto expected = source;
+    expected[json::json_pointer("/x/0/y")] = 3;
+    expected[json::json_pointer("/a/c/5")] = 4;
+    EXPECT_EQ(j.set(json(3), "/x/0/y").set(json(4), "/a/c/5").json(), expected);
+    EXPECT_THROW(static_cast<void>(j.set(json(1), "/a/b/c")), std::invalid_argument);
+    EXPECT_EQ(j.set(json(1)).json(), json(1));
+
+    auto removed = false;
+    EXPECT_FALSE(j.remove("/a/c/1", &removed).contains("/a/c/2"));
+    EXPECT_TRUE(removed);
+    EXPECT_EQ(j.remove("/a/c/1").get<std::string>("/a/c/1/d"), "e");
+    EXPECT_TRUE(j.remove("/a/x", &removed).shares(j));
+    EXPECT_FALSE(removed);
+    EXPECT_TRUE(j.remove("", &removed).shares(j));
+    EXPECT_FALSE(removed);
+
+    // equal without sharing, numbers compare by value
+    EXPECT_EQ(SharedJson(source), j);
+    EXPECT_EQ(SharedJson(json(1)), SharedJson(json(1.0)));
+    EXPECT_NE(SharedJson(json::object()), SharedJson(json::array()));
+
+    // serialised as json
+    json s = k;
+    EXPECT_EQ(s, k.json());
+    EXPECT_EQ(s.get<SharedJson>(), k);
+}
+
+TEST(SharedJsonTest, Merge) {
+    const auto a = R"({"test": {"one": 3, "list": [1, {"x": 1}], "empty": {}}})"_json;
+    const auto b = R"({"test": {"two": 3, "list": [2, {"y": 2}, 3]}, "double": [1]})"_json;
+
+    JsonStore expected(a);
+    expected.merge(b);
+    EXPECT_EQ(SharedJson(a).merge(b).json(), expected);
+
+    expected = JsonStore(a);
+    expected.merge(b, "/test/new");
+    EXPECT_EQ(SharedJson(a).merge(b, "/test/new").json(), expected);
+
+    // the preferences, each file merged over the rest
+    const auto prefs = preferences();
+    const SharedJson shared(prefs);
+    for (const auto &entry : std::filesystem::directory_iterator(preference_dir)) {
+        if (entry.path().extension() != ".json")
+            continue;
+        std::ifstream i(entry.path());
+        const auto file = json::parse(i);
+
+        auto merged = prefs;
+        merged.merge(file);
+        EXPECT_EQ(shared.merge(file).json(), merged) << entry.path();
+    }
+}
+
+TEST(SharedJsonTest, Patch) {
+    const auto source = R"({"a": {"b": [1, 2, 3], "c": "d"}, "e": 1})"_json;
+    const auto patch  = R"([
+        {"op": "add", "path": "/a/b/1", "value": 9},
+        {"op": "add", "path": "/a/b/-", "value": 10},
+        {"op": "remove", "path": "/a/b/0"},
+        {"op": "replace", "path": "/e", "value": {"f": 2}},
+        {"op": "move", "from": "/a/c", "path": "/g"},
+        {"op": "copy", "from": "/e", "path": "/a/h"},
+        {"op": "test", "path": "/a/h/f", "value": 2}
+    ])"_json;
+
+    EXPECT_EQ(SharedJson(source).patch(patch).json(), source.patch(patch));
+
+    for (const auto &bad : std::vector<json>{
+             R"([{"op": "remove", "path": "/x"}])"_json,
+             R"([{"op": "replace", "path": "/x", "value": 1}])"_json,
+             R"([{"op": "add", "path": "/x/y", "value": 1}])"_json,
+             R"([{"op": "add", "path": "/a/b/4", "value": 1}])"_json,
+             R"([{"op": "test", "path": "/e", "value": 2}])"_json,
+             R"([{"op": "other", "path": "/e"}])"_json}) {
+        EXPECT_ANY_THROW(static_cast<void>(source.patch(bad))) << bad.dump();
+        EXPECT_ANY_THROW(static_cast<void>(SharedJson(source).patch(bad))) << bad.dump();
+    }
+}
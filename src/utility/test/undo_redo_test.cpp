@@ -160,3 +160,150 @@ TEST(UndoRedoMapTest, Test) {
     EXPECT_EQ(*(h.redo(2)), 5);
     EXPECT_FALSE(h.redo(2));
 }
+
+TEST(JsonUndoRedoMapTest, Test) {
+    auto h = JsonUndoRedoMap<int>();
+    h.set_hot_count(2);
+
+    EXPECT_TRUE(h.empty());
+    EXPECT_FALSE(h.undo());
+    EXPECT_FALSE(h.redo());
+
+    h.push(1, JsonStore(1));
+    h.push(2, JsonStore(2));
+    h.push(3, JsonStore(3));
+    h.push(3, JsonStore(4));
+    h.push(4, JsonStore(5));
+
+    EXPECT_FALSE(h.undo(5));
+    EXPECT_FALSE(h.undo(4));
+
+    EXPECT_EQ(*(h.undo(2)), 5);
+    EXPECT_EQ(*(h.undo(2)), 4);
+    EXPECT_EQ(*(h.undo(2)), 3);
+
+    EXPECT_FALSE(h.undo(2));
+
+    EXPECT_EQ(*(h.redo(2)), 3);
+    EXPECT_EQ(*(h.redo(2)), 4);
+    EXPECT_EQ(*(h.redo(2)), 5);
+    EXPECT_FALSE(h.redo(2));
+
+    h.clear();
+    EXPECT_EQ(h.bytes(), size_t(0));
+    h.push(1, JsonStore(1));
+    h.push(2, JsonStore(2));
+    EXPECT_TRUE(h.undo());
+    h.push(3, JsonStore(3));
+    EXPECT_FALSE(h.redo());
+    EXPECT_EQ(h.count(), size_t(2));
+    h.set_max_count(1);
+    EXPECT_EQ(*(h.undo()), 3);
+    EXPECT_FALSE(h.undo());
+}
+
+namespace {
+// events like a bulk insert, big and repetitive
+JsonStore bulk_event(const int i) {
+    JsonStore event;
+    event["id"] = i;
+    for (int c = 0; c < 200; c++)
+        event["blind"].push_back(
+            {{"name", "clip " + std::to_string(c)},
+             {"type", "Clip"},
+             {"active_range", {{"rate", 1.0 / 24.0}, {"start", c * 24}, {"duration", 24}}}});
+    return event;
+}
+} // namespace
+
+TEST(JsonUndoRedoMapTest, Budget) {
+    auto h = JsonUndoRedoMap<int>();
+    h.set_hot_count(4);
+    for (int i = 0; i < 20; i++)
+        h.push(i, bulk_event(i));
+
+    auto stats = h.stats();
+    EXPECT_EQ(stats["count"].get<size_t>(), size_t(20));
+    EXPECT_EQ(stats["compressed_count"].get<size_t>(), size_t(16));
+    EXPECT_EQ(stats["bytes"].get<size_t>(), h.bytes());
+    EXPECT_EQ(UndoRedoBudget::bytes(), h.bytes());
+    // well under the MessagePack, which is well under the JSON text
+    EXPECT_LT(h.bytes(), stats["encoded_bytes"].get<size_t>() / 3);
+    EXPECT_LT(h.bytes(), size_t(20 * bulk_event(0).dump().size() / 4));
+
+    // undo through hot and cold entries
+    for (int i = 19; i >= 10; i--)
+        EXPECT_EQ(*(h.undo()), bulk_event(i));
+    for (int i = 10; i < 20; i++)
+        EXPECT_EQ(*(h.redo()), bulk_event(i));
+
+    // budget of about half drops the oldest, keeping the newest
+    const auto bytes = h.bytes();
+    UndoRedoBudget::set_max_bytes(bytes / 2);
+    h.trim();
+    EXPECT_LE(h.bytes(), bytes / 2);
+    EXPECT_LT(h.count(), size_t(20));
+    EXPECT_EQ(h.stats()["evicted"].get<size_t>(), 20 - h.count());
+    EXPECT_EQ(*(h.undo()), bulk_event(19));
+
+    // redo entries go first, the furthest first
+    const auto count = h.count();
+    UndoRedoBudget::set_max_bytes(h.bytes() - 1);
+    EXPECT_EQ(*(h.undo()), bulk_event(18));
+    EXPECT_EQ(h.count(), count - 1);
+    EXPECT_EQ(h.stats()["redo_count"].get<size_t>(), size_t(1));
+    EXPECT_EQ(*(h.redo()), bulk_event(18));
+
+    // the newest is kept over budget
+    UndoRedoBudget::set_max_bytes(1);
+    h.trim();
+    EXPECT_EQ(h.count(), size_t(1));
+    EXPECT_EQ(*(h.undo()), bulk_event(18));
+    EXPECT_EQ(h.bytes(), h.stats()["bytes"].get<size_t>());
+
+    h.clear();
+    EXPECT_EQ(UndoRedoBudget::bytes(), size_t(0));
+    UndoRedoBudget::set_max_bytes(std::numeric_limits<size_t>::max());
+}
+
+TEST(JsonUndoRedoMapTest, SharedBudget) {
+    auto a = JsonUndoRedoMap<int>();
+    auto b = JsonUndoRedoMap<int>();
+    for (int i = 0; i < 10; i++) {
+        a.push(i, bulk_event(i));
+        b.push(i, bulk_event(i));
+    }
+    EXPECT_EQ(UndoRedoBudget::bytes(), a.bytes() + b.bytes());
+
+    // the one changing, over its share, pays
+    const auto max = UndoRedoBudget::bytes() / 2;
+    UndoRedoBudget::set_max_bytes(max);
+    b.push(10, bulk_event(10));
+    EXPECT_EQ(a.count(), size_t(10));
+    EXPECT_LT(b.count(), size_t(11));
+    EXPECT_TRUE(b.bytes() <= max / 2 or UndoRedoBudget::bytes() <= max);
+
+    {
+        auto c = b;
+        EXPECT_EQ(UndoRedoBudget::bytes(), a.bytes() + 2 * b.bytes());
+    }
+    EXPECT_EQ(UndoRedoBudget::bytes(), a.bytes() + b.bytes());
+
+    UndoRedoBudget::set_max_bytes(std::numeric_limits<size_t>::max());
+}
+
+TEST(CompactJsonTest, Test) {
+    JsonStore value(
+        R"({"a": [1, 2.5, "three", null, true], "b": {"c": "dddddddddddddddd"}})"_json);
+
+    auto c = CompactJson(value);
+    EXPECT_FALSE(c.cold());
+    EXPECT_EQ(c.json(), value);
+    EXPECT_EQ(c.size_bytes(), c.encoded_size());
+
+    c.compress();
+    EXPECT_TRUE(c.cold());
+    EXPECT_EQ(c.json(), value);
+
+    EXPECT_EQ(CompactJson().json(), JsonStore());
+}